@@ -0,0 +1,127 @@
+/**
+ * AgentE Unreal Engine Client — Adjustment Queue
+ *
+ * See AgentEAdjustmentQueue.h.
+ */
+
+#include "AgentEAdjustmentQueue.h"
+
+void FAgentEAdjustmentQueue::EnqueueAdjustment(int32 Parameter, float Value, const float* CurrentValue)
+{
+    check(Parameter != INDEX_NONE);
+    while (!PendingIndex.IsValidIndex(Parameter))
+    {
+        PendingIndex.Add(INDEX_NONE);
+    }
+
+    float From = Value;
+    if (PendingIndex[Parameter] != INDEX_NONE)
+    {
+        // Last write wins; an interpolation in progress retargets from where it is
+        From = Pending[PendingIndex[Parameter]].Current();
+    }
+    else if (HasLastApplied.IsValidIndex(Parameter) && HasLastApplied[Parameter])
+    {
+        From = LastApplied[Parameter];
+    }
+    else if (CurrentValue)
+    {
+        From = *CurrentValue;
+    }
+
+    FPending Entry;
+    Entry.Parameter = Parameter;
+    Entry.From = From;
+    Entry.To = Value;
+    Entry.Steps = From == Value ? 1 : InterpolationFrames;
+
+    if (PendingIndex[Parameter] != INDEX_NONE)
+    {
+        Pending[PendingIndex[Parameter]] = Entry;
+    }
+    else
+    {
+        PendingIndex[Parameter] = Pending.Add(Entry);
+    }
+}
+
+void FAgentEAdjustmentQueue::EnqueueAlert(int32 Principle, int32 Name, int32 Severity)
+{
+    Alerts.Add({ Principle, Name, Severity });
+}
+
+void FAgentEAdjustmentQueue::RemovePending(int32 Index)
+{
+    PendingIndex[Pending[Index].Parameter] = INDEX_NONE;
+    Pending.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    if (Pending.IsValidIndex(Index))
+    {
+        PendingIndex[Pending[Index].Parameter] = Index;
+    }
+}
+
+int32 FAgentEAdjustmentQueue::Drain(double BudgetSeconds, FApplyAdjustment ApplyAdjustment, FApplyAlert ApplyAlert)
+{
+    const double Deadline = FPlatformTime::Seconds() + BudgetSeconds;
+    int32 Applied = 0;
+    auto OutOfTime = [&Applied, Deadline]() { return Applied > 0 && FPlatformTime::Seconds() >= Deadline; };
+
+    // One step per queued adjustment per frame at most, so interpolation runs at frame rate
+    const int32 ToVisit = Pending.Num();
+    for (int32 Visited = 0; Visited < ToVisit && !Pending.IsEmpty() && !OutOfTime(); ++Visited)
+    {
+        if (Cursor >= Pending.Num())
+        {
+            Cursor = 0;
+        }
+        FPending& Entry = Pending[Cursor];
+        ++Entry.Step;
+        const float Value = Entry.Current();
+        const int32 Parameter = Entry.Parameter;
+
+        if (!LastApplied.IsValidIndex(Parameter))
+        {
+            LastApplied.SetNumZeroed(Parameter + 1);
+            HasLastApplied.Add(false, Parameter + 1 - HasLastApplied.Num());
+        }
+        LastApplied[Parameter] = Value;
+        HasLastApplied[Parameter] = true;
+
+        if (Entry.Step >= Entry.Steps)
+        {
+            // The swapped-in entry now sits at Cursor and is visited next
+            RemovePending(Cursor);
+        }
+        else
+        {
+            ++Cursor;
+        }
+
+        // After the bookkeeping, so a handler that enqueues sees consistent state
+        ApplyAdjustment(Parameter, Value);
+        ++Applied;
+    }
+
+    while (NextAlert < Alerts.Num() && !OutOfTime())
+    {
+        const FQueuedAlert Alert = Alerts[NextAlert++];
+        ApplyAlert(Alert.Principle, Alert.Name, Alert.Severity);
+        ++Applied;
+    }
+    if (NextAlert == Alerts.Num())
+    {
+        Alerts.Reset();
+        NextAlert = 0;
+    }
+
+    return Applied;
+}
+
+void FAgentEAdjustmentQueue::Reset()
+{
+    Pending.Reset();
+    PendingIndex.Reset();
+    Alerts.Reset();
+    NextAlert = 0;
+    Cursor = 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * AgentE Unreal Engine Client — Adjustment Queue
+ *
+ * Spreads a big reply over frames: adjustments and alerts are queued when a
+ * reply is applied and drained once per frame under a time budget, so a
+ * large rebalance doesn't land as one long callback.
+ *
+ *   - Adjustments for the same key merge (last write wins) — a newer plan
+ *     replaces a queued value instead of applying both.
+ *   - With InterpolationFrames > 1 a change is applied in that many equal
+ *     steps, one per frame, starting from the value last applied (or read
+ *     from the key's binding). Retargeting mid-way continues from the
+ *     current step value.
+ *   - Alerts are delivered in order after the frame's adjustments.
+ *
+ * Every drain applies at least one item, so the queue always makes progress.
+ * Game thread only.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAgentEAdjustmentQueue
+{
+public:
+    using FApplyAdjustment = TFunctionRef<void(int32 Parameter, float Value)>;
+    using FApplyAlert = TFunctionRef<void(int32 Principle, int32 Name, int32 Severity)>;
+
+    void SetInterpolationFrames(int32 Frames) { InterpolationFrames = FMath::Max(1, Frames); }
+
+    /** Queue Value for Parameter; CurrentValue, when known, is where interpolation starts */
+    void EnqueueAdjustment(int32 Parameter, float Value, const float* CurrentValue = nullptr);
+    void EnqueueAlert(int32 Principle, int32 Name, int32 Severity);
+
+    /** Apply queued work until BudgetSeconds have passed; returns items applied */
+    int32 Drain(double BudgetSeconds, FApplyAdjustment ApplyAdjustment, FApplyAlert ApplyAlert);
+
+    bool IsEmpty() const { return Pending.IsEmpty() && NextAlert == Alerts.Num(); }
+    int32 NumPendingAdjustments() const { return Pending.Num(); }
+
+    void Reset();
+
+private:
+    struct FPending
+    {
+        int32 Parameter = INDEX_NONE;
+        float From = 0.f;
+        float To = 0.f;
+        int32 Step = 0;
+        int32 Steps = 1;
+
+        float Current() const { return Step >= Steps ? To : FMath::Lerp(From, To, float(Step) / float(Steps)); }
+    };
+
+    struct FQueuedAlert
+    {
+        int32 Principle;
+        int32 Name;
+        int32 Severity;
+    };
+
+    int32 InterpolationFrames = 1;
+
+    /** Adjustments in progress; order across keys is not kept */
+    TArray<FPending> Pending;
+
+    /** Parameter handle → index in Pending, INDEX_NONE when not queued */
+    TArray<int32> PendingIndex;
+
+    /** Last value applied per parameter handle, for interpolation starts */
+    TArray<float> LastApplied;
+    TBitArray<> HasLastApplied;
+
+    /** Round-robin position in Pending, so a tight budget starves no key */
+    int32 Cursor = 0;
+
+    TArray<FQueuedAlert> Alerts;
+    int32 NextAlert = 0;
+
+    void RemovePending(int32 Index);
+};
@@ -0,0 +1,146 @@
+/**
+ * AgentE Unreal Engine Client — Pre-Aggregation
+ *
+ * See AgentEAggregator.h.
+ */
+
+#include "AgentEAggregator.h"
+#include "Algo/Sort.h"
+
+static double SumLanes(const VectorRegister4Double& Vector)
+{
+    alignas(32) double Lanes[4];
+    VectorStoreAligned(Vector, Lanes);
+    return (Lanes[0] + Lanes[1]) + (Lanes[2] + Lanes[3]);
+}
+
+/** Sum of Num doubles; two accumulators keep both adders busy */
+static double VectorSum(const double* Data, int32 Num)
+{
+    VectorRegister4Double Acc0 = VectorZeroDouble();
+    VectorRegister4Double Acc1 = VectorZeroDouble();
+    int32 I = 0;
+    for (; I + 8 <= Num; I += 8)
+    {
+        Acc0 = VectorAdd(Acc0, VectorLoad(Data + I));
+        Acc1 = VectorAdd(Acc1, VectorLoad(Data + I + 4));
+    }
+    double Sum = SumLanes(VectorAdd(Acc0, Acc1));
+    for (; I < Num; ++I)
+    {
+        Sum += Data[I];
+    }
+    return Sum;
+}
+
+/** Σ (2i + 1 − Num) · Sorted[i], the Observer's Gini numerator */
+static double GiniNumerator(const double* Sorted, int32 Num)
+{
+    const double Base = 1.0 - double(Num);
+    VectorRegister4Double Coeff = MakeVectorRegisterDouble(Base, Base + 2.0, Base + 4.0, Base + 6.0);
+    const VectorRegister4Double Step = MakeVectorRegisterDouble(8.0, 8.0, 8.0, 8.0);
+    VectorRegister4Double Acc = VectorZeroDouble();
+    int32 I = 0;
+    for (; I + 4 <= Num; I += 4)
+    {
+        Acc = VectorMultiplyAdd(Coeff, VectorLoad(Sorted + I), Acc);
+        Coeff = VectorAdd(Coeff, Step);
+    }
+    double Sum = SumLanes(Acc);
+    for (; I < Num; ++I)
+    {
+        Sum += (2.0 * double(I) + Base) * Sorted[I];
+    }
+    return Sum;
+}
+
+static double Median(const TArray<double>& Sorted)
+{
+    const int32 Num = Sorted.Num();
+    if (Num == 0)
+    {
+        return 0.0;
+    }
+    const int32 Mid = Num / 2;
+    return Num % 2 == 0 ? (Sorted[Mid - 1] + Sorted[Mid]) / 2.0 : Sorted[Mid];
+}
+
+TSharedRef<const FAgentEAggregates, ESPMode::ThreadSafe> FAgentEAggregator::Compute(const FAgentEEconomyState& S)
+{
+    TSharedRef<FAgentEAggregates, ESPMode::ThreadSafe> Out = Results.Acquire();
+    const int32 NumAgents = S.NumAgents();
+    const int32 NumRoles = S.Roles().Num();
+    Out->Population = NumAgents;
+    Out->SupplyByCurrency.Reset();
+    Out->GiniByCurrency.Reset();
+    Out->MedianByCurrency.Reset();
+    Out->Top10ShareByCurrency.Reset();
+    Out->SupplyByResource.Reset();
+
+    // Change-tracked: counts and supplies are already kept, and a balance column
+    // untouched since the previous snapshot keeps its distribution metrics
+    const bool bTracked = S.IsTrackingChanges();
+    const bool bFollows = bTracked && Last.IsValid()
+        && LastSerial + 1 == S.GetChangeSerial() && LastEpoch == S.GetSchemaEpoch();
+
+    Out->CountByRole.Reset();
+    if (bTracked)
+    {
+        Out->CountByRole.Append(S.GetTotals().CountByRole);
+        Out->SupplyByResource.Append(S.GetTotals().SupplyByResource);
+    }
+    else
+    {
+        // A histogram doesn't vectorize; one pass over the uint16 column
+        Out->CountByRole.AddZeroed(NumRoles);
+        for (const uint16 Role : S.AgentRoles)
+        {
+            if (Role < NumRoles)
+            {
+                ++Out->CountByRole[Role];
+            }
+        }
+
+        for (const TArray<double>& Column : S.Inventories)
+        {
+            Out->SupplyByResource.Add(VectorSum(Column.GetData(), Column.Num()));
+        }
+    }
+
+    for (int32 C = 0; C < S.Balances.Num(); ++C)
+    {
+        const TArray<double>& Column = S.Balances[C];
+        const int32 Num = Column.Num();
+        const double Supply = bTracked ? S.GetTotals().SupplyByCurrency[C] : VectorSum(Column.GetData(), Num);
+        Out->SupplyByCurrency.Add(Supply);
+
+        if (bFollows && !S.GetChanges().BalanceColumns[C])
+        {
+            Out->MedianByCurrency.Add(Last->MedianByCurrency[C]);
+            Out->GiniByCurrency.Add(Last->GiniByCurrency[C]);
+            Out->Top10ShareByCurrency.Add(Last->Top10ShareByCurrency[C]);
+            continue;
+        }
+
+        Sorted.Reset(Num);
+        Sorted.Append(Column);
+        Algo::Sort(Sorted);
+
+        Out->MedianByCurrency.Add(Median(Sorted));
+
+        const double Gini = Num > 0 && Supply != 0.0
+            ? FMath::Min(1.0, FMath::Abs(GiniNumerator(Sorted.GetData(), Num)) / (double(Num) * Supply))
+            : 0.0;
+        Out->GiniByCurrency.Add(Gini);
+
+        // Same cut as the Observer: everything from index floor(0.9 · n) up
+        const int32 Top = int32(FMath::FloorToDouble(double(Num) * 0.9));
+        const double TopSum = VectorSum(Sorted.GetData() + Top, Num - Top);
+        Out->Top10ShareByCurrency.Add(Supply > 0.0 ? TopSum / Supply : 0.0);
+    }
+
+    Last = Out;
+    LastSerial = S.GetChangeSerial();
+    LastEpoch = S.GetSchemaEpoch();
+    return Out;
+}
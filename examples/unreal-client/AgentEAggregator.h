@@ -0,0 +1,46 @@
+/**
+ * AgentE Unreal Engine Client — Pre-Aggregation
+ *
+ * Computes the Observer's per-agent metrics in-process, straight from the
+ * state's columns: supply per currency and resource, agents per role, and
+ * each currency's Gini, median and top-10% share, with the Observer's
+ * definitions. They go out as the `aggregates` block, which the server
+ * uses instead of looping over agent records. Pair it with bSampleAgents
+ * to cut those records down as well.
+ *
+ * Column sums and the Gini weighted sum run four doubles at a time on
+ * VectorRegister4Double. The distribution metrics need each balance column
+ * sorted; that happens in a scratch copy reused between ticks, and results
+ * are written into recycled FAgentEAggregates. For a change-tracked state
+ * the counts and supplies come from its running totals, and only balance
+ * columns changed since the previous snapshot are sorted again.
+ *
+ * Touched only by the send tasks.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AgentEEconomyState.h"
+#include "AgentERecycler.h"
+
+class FAgentEAggregator
+{
+public:
+    TSharedRef<const FAgentEAggregates, ESPMode::ThreadSafe> Compute(const FAgentEEconomyState& State);
+
+    /** Results Compute could not recycle (TAgentERecycler::GetAllocations) */
+    int64 GetAllocations() const { return Results.GetAllocations(); }
+
+private:
+    /** One balance column, sorted */
+    TArray<double> Sorted;
+
+    /** Snapshots keep theirs until they are recycled too, so this outnumbers the client's snapshot pool */
+    TAgentERecycler<FAgentEAggregates> Results { 10 };
+
+    /** Previous result and the change serial / schema epoch it was computed for */
+    TSharedPtr<const FAgentEAggregates, ESPMode::ThreadSafe> Last;
+    uint64 LastSerial = 0;
+    uint32 LastEpoch = 0;
+};
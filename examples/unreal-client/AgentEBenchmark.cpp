@@ -0,0 +1,625 @@
+/**
+ * AgentE Unreal Engine Client — Benchmarks
+ *
+ * See AgentEBenchmark.h.
+ */
+
+#include "AgentEBenchmark.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/App.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include <atomic>
+#include "AgentEClient.h"
+#include "AgentEJsonReader.h"
+#include "AgentEMsgPack.h"
+
+// ─── Allocation Counting ────────────────────────────────────────────────────
+
+/** Forwards to the allocator it replaces, counting calls and live bytes */
+class FAgentECountingMalloc final : public FMalloc
+{
+public:
+    explicit FAgentECountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+    std::atomic<int64> Allocations { 0 };
+    std::atomic<int64> AllocatedBytes { 0 };
+
+    /**
+     * Relative to when counting started — frees of older blocks can take it
+     * below zero. Stays 0 when the allocator can't report block sizes.
+     */
+    std::atomic<int64> LiveBytes { 0 };
+    std::atomic<int64> PeakBytes { 0 };
+
+    virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+    {
+        return Track(Inner->Malloc(Count, Alignment), Count);
+    }
+    virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+    {
+        return Track(Inner->TryMalloc(Count, Alignment), Count);
+    }
+    virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+    {
+        Untrack(Original);
+        return Track(Inner->Realloc(Original, Count, Alignment), Count);
+    }
+    virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+    {
+        Untrack(Original);
+        return Track(Inner->TryRealloc(Original, Count, Alignment), Count);
+    }
+    virtual void Free(void* Original) override
+    {
+        Untrack(Original);
+        Inner->Free(Original);
+    }
+
+    virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+    virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+    virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+    virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+    virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+    virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+    virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+    virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+private:
+    FMalloc* Inner;
+
+    void* Track(void* Ptr, SIZE_T Count)
+    {
+        if (!Ptr)
+        {
+            return Ptr;
+        }
+        Allocations.fetch_add(1, std::memory_order_relaxed);
+        AllocatedBytes.fetch_add(int64(Count), std::memory_order_relaxed);
+        SIZE_T Size = 0;
+        if (Inner->GetAllocationSize(Ptr, Size))
+        {
+            const int64 Live = LiveBytes.fetch_add(int64(Size), std::memory_order_relaxed) + int64(Size);
+            int64 Peak = PeakBytes.load(std::memory_order_relaxed);
+            while (Live > Peak && !PeakBytes.compare_exchange_weak(Peak, Live, std::memory_order_relaxed))
+            {
+            }
+        }
+        return Ptr;
+    }
+
+    void Untrack(void* Ptr)
+    {
+        SIZE_T Size = 0;
+        if (Ptr && Inner->GetAllocationSize(Ptr, Size))
+        {
+            LiveBytes.fetch_sub(int64(Size), std::memory_order_relaxed);
+        }
+    }
+};
+
+// ─── Synthetic Economies ────────────────────────────────────────────────────
+
+static TArray<FString> NumberedNames(const TCHAR* Prefix, int32 Count)
+{
+    TArray<FString> Names;
+    for (int32 I = 0; I < Count; ++I)
+    {
+        Names.Add(FString::Printf(TEXT("%s_%d"), Prefix, I));
+    }
+    return Names;
+}
+
+/**
+ * Agents with skewed balances (a few rich, most poor) and sparse
+ * inventories (most resources zero, which the wire format omits).
+ */
+static void FillEconomy(FAgentEEconomyState& State, const FAgentEBenchmarkSettings& Settings, int32 Agents)
+{
+    FRandomStream Rng(int32(Settings.Seed));
+    State.SetSchema(NumberedNames(TEXT("role"), Settings.Roles),
+        NumberedNames(TEXT("resource"), Settings.Resources), NumberedNames(TEXT("currency"), Settings.Currencies));
+
+    for (int32 A = 0; A < Agents; ++A)
+    {
+        const int32 Index = State.AddAgent(FString::Printf(TEXT("agent_%07d"), A), uint16(A % Settings.Roles));
+        for (TArray<double>& Column : State.Balances)
+        {
+            const double U = FMath::Max(Rng.GetFraction(), 1e-6);
+            Column[Index] = FMath::RoundToDouble(100.0 / FMath::Sqrt(U));
+        }
+        for (TArray<double>& Column : State.Inventories)
+        {
+            Column[Index] = Rng.GetFraction() < 0.3 ? double(Rng.RandRange(1, 50)) : 0.0;
+        }
+    }
+    for (TArray<double>& Row : State.MarketPrices)
+    {
+        for (double& Price : Row)
+        {
+            Price = FMath::RoundToDouble(Rng.FRandRange(1.0, 100.0) * 100.0) / 100.0;
+        }
+    }
+}
+
+/** FillEconomy's names with the default settings, as a game would declare its own */
+struct FAgentEBenchCurrencies { static constexpr const ANSICHAR* Names[] = { "currency_0", "currency_1", "currency_2" }; };
+struct FAgentEBenchResources
+{
+    static constexpr const ANSICHAR* Names[] = {
+        "resource_0", "resource_1", "resource_2", "resource_3", "resource_4", "resource_5", "resource_6", "resource_7" };
+};
+struct FAgentEBenchRoles
+{
+    static constexpr const ANSICHAR* Names[] = { "role_0", "role_1", "role_2", "role_3", "role_4", "role_5" };
+};
+using FAgentEBenchSchema = TAgentEStateSchema<FAgentEBenchCurrencies, FAgentEBenchResources, FAgentEBenchRoles>;
+
+/** Shift the balances (and some inventories) of Fraction of the agents, as a tick of trading would */
+static void ChangeSome(FAgentEEconomyState& State, double Fraction, uint32 Seed)
+{
+    FRandomStream Rng(int32(Seed ^ 0x5EED));
+    const int32 Agents = State.NumAgents();
+    const int32 Changes = FMath::Max(1, int32(Agents * Fraction));
+    for (int32 C = 0; C < Changes; ++C)
+    {
+        const int32 A = Rng.RandRange(0, Agents - 1);
+        State.AddBalance(A, C % State.Balances.Num(), double(Rng.RandRange(1, 20)));
+        if (State.Inventories.Num() > 0 && (C & 3) == 0)
+        {
+            State.AddInventory(A, C % State.Inventories.Num(), 1.0);
+        }
+    }
+}
+
+/** A busy tick reply: 32 adjustments, 4 alerts, plus reasoning, evidence and metrics the client skips */
+static void WriteJsonReply(FAgentEJsonWriter& W)
+{
+    W.Reset();
+    W.BeginObject();
+    W.Key("health"); W.Value(int64(72));
+    W.Key("tick"); W.Value(int64(1000));
+    W.Key("seq"); W.Value(int64(1000));
+    W.Key("adjustments");
+    W.BeginArray();
+    for (int32 I = 0; I < 32; ++I)
+    {
+        W.BeginObject();
+        W.Key("parameter"); W.Value(FStringView(*FString::Printf(TEXT("parameter_%d"), I)));
+        W.Key("value"); W.Value(0.05 * I);
+        W.Key("reasoning"); W.Value("Supply is concentrating; nudging the rate back toward target");
+        W.EndObject();
+    }
+    W.EndArray();
+    W.Key("alerts");
+    W.BeginArray();
+    for (int32 I = 0; I < 4; ++I)
+    {
+        W.BeginObject();
+        W.Key("principleId"); W.Value(FStringView(*FString::Printf(TEXT("P%d"), I + 1)));
+        W.Key("principleName"); W.Value(FStringView(*FString::Printf(TEXT("Principle %d"), I + 1)));
+        W.Key("severity"); W.Value(int64(3 + I));
+        W.Key("evidence"); W.BeginObject(); W.Key("gini"); W.Value(0.61); W.Key("threshold"); W.Value(0.5); W.EndObject();
+        W.EndObject();
+    }
+    W.EndArray();
+    W.Key("metrics");
+    W.BeginObject();
+    for (int32 I = 0; I < 64; ++I)
+    {
+        W.Key(FStringView(*FString::Printf(TEXT("metric_%d"), I))); W.Value(1.5 * I);
+    }
+    W.EndObject();
+    W.EndObject();
+}
+
+static void WriteBinaryReply(FAgentEMsgPackWriter& W)
+{
+    W.Reset();
+    W.BeginMap(6);
+    W.Str("health"); W.Int(72);
+    W.Str("tick"); W.Int(1000);
+    W.Str("seq"); W.Int(1000);
+    W.Str("adjustments");
+    W.BeginArray(32);
+    for (int32 I = 0; I < 32; ++I)
+    {
+        W.BeginMap(3);
+        W.Str("parameter"); W.Str(FString::Printf(TEXT("parameter_%d"), I));
+        W.Str("value"); W.Double(0.05 * I);
+        W.Str("reasoning"); W.Str("Supply is concentrating; nudging the rate back toward target");
+    }
+    W.Str("alerts");
+    W.BeginArray(4);
+    for (int32 I = 0; I < 4; ++I)
+    {
+        W.BeginMap(4);
+        W.Str("principleId"); W.Str(FString::Printf(TEXT("P%d"), I + 1));
+        W.Str("principleName"); W.Str(FString::Printf(TEXT("Principle %d"), I + 1));
+        W.Str("severity"); W.Int(3 + I);
+        W.Str("evidence"); W.BeginMap(2); W.Str("gini"); W.Double(0.61); W.Str("threshold"); W.Double(0.5);
+    }
+    W.Str("metrics");
+    W.BeginMap(64);
+    for (int32 I = 0; I < 64; ++I)
+    {
+        W.Str(FString::Printf(TEXT("metric_%d"), I)); W.Double(1.5 * I);
+    }
+}
+
+// ─── Runner ─────────────────────────────────────────────────────────────────
+
+/**
+ * Run Fn once untimed, then until MinSeconds and MinIterations are both
+ * reached. Fn returns the bytes it produced, or -1 when it failed.
+ */
+static FAgentEBenchmarkResult RunCase(
+    const TCHAR* Case, int32 Agents, const FAgentEBenchmarkSettings& Settings, TFunctionRef<int64()> Fn)
+{
+    FAgentEBenchmarkResult Result;
+    Result.Case = Case;
+    Result.Agents = Agents;
+    Result.Bytes = Fn();
+    Result.bOk = Result.Bytes >= 0;
+
+    TArray<double> Times;
+    Times.Reserve(Settings.MaxIterations);
+
+    FMalloc* Previous = GMalloc;
+    FAgentECountingMalloc Counter(Previous);
+    GMalloc = &Counter;
+
+    const double Start = FPlatformTime::Seconds();
+    while (Times.Num() < Settings.MaxIterations
+        && (Times.Num() < Settings.MinIterations || FPlatformTime::Seconds() - Start < Settings.MinSeconds))
+    {
+        const uint64 Begin = FPlatformTime::Cycles64();
+        const int64 Bytes = Fn();
+        Times.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Begin));
+        Result.bOk &= Bytes >= 0;
+    }
+
+    GMalloc = Previous;
+
+    const int32 N = Times.Num();
+    Result.Iterations = N;
+    if (N == 0)
+    {
+        return Result;
+    }
+    double Total = 0.0;
+    for (double T : Times)
+    {
+        Total += T;
+    }
+    Times.Sort();
+    Result.MeanMs = Total / N;
+    Result.MedianMs = N % 2 ? Times[N / 2] : 0.5 * (Times[N / 2 - 1] + Times[N / 2]);
+    Result.MinMs = Times[0];
+    Result.MaxMs = Times.Last();
+    Result.MegabytesPerSecond = Result.MedianMs > 0.0 ? double(Result.Bytes) / (1024.0 * 1024.0) / (Result.MedianMs / 1000.0) : 0.0;
+    Result.AllocationsPerIteration = double(Counter.Allocations.load()) / N;
+    Result.AllocatedBytesPerIteration = double(Counter.AllocatedBytes.load()) / N;
+    Result.PeakHeapBytes = FMath::Max<int64>(0, Counter.PeakBytes.load());
+    return Result;
+}
+
+TArray<FAgentEBenchmarkResult> AgentERunBenchmarks(const FAgentEBenchmarkSettings& Settings)
+{
+    TArray<FAgentEBenchmarkResult> Results;
+
+    for (const int32 Agents : Settings.AgentCounts)
+    {
+        FAgentEEconomyState Source;
+        FillEconomy(Source, Settings, Agents);
+
+        // Into a recycled snapshot, as UAgentEClient captures: no allocations once warm
+        FAgentEEconomyState Copy;
+        Results.Add(RunCase(TEXT("capture"), Agents, Settings, [&Source, &Copy]() -> int64 {
+            Copy.CopyFrom(Source);
+            int64 Bytes = Copy.AgentRoles.Num() * int64(sizeof(uint16));
+            for (const TArray<double>& Column : Copy.Balances)
+            {
+                Bytes += Column.Num() * int64(sizeof(double));
+            }
+            for (const TArray<double>& Column : Copy.Inventories)
+            {
+                Bytes += Column.Num() * int64(sizeof(double));
+            }
+            return Bytes;
+        }));
+
+        // The send task's view: an immutable snapshot, and the one after it
+        TSharedRef<const FAgentEEconomyState, ESPMode::ThreadSafe> Base =
+            MakeShared<FAgentEEconomyState, ESPMode::ThreadSafe>(Source);
+        TSharedRef<FAgentEEconomyState, ESPMode::ThreadSafe> NextMutable =
+            MakeShared<FAgentEEconomyState, ESPMode::ThreadSafe>(Source);
+        ChangeSome(*NextMutable, Settings.ChangedFraction, Settings.Seed);
+        TSharedRef<const FAgentEEconomyState, ESPMode::ThreadSafe> Next = NextMutable;
+
+        {
+            FAgentEJsonWriter Writer;
+            FAgentEJsonNames Names;
+            Names.Bind(Base);
+            Results.Add(RunCase(TEXT("tick_json"), Agents, Settings, [&]() -> int64 {
+                AgentEWriteTickBody(Writer, *Base, 1000, 1000, nullptr, &Names);
+                return Writer.Num() > 0 ? Writer.Num() : -1;
+            }));
+        }
+        if (FAgentEBenchSchema::Matches(*Base))
+        {
+            // The first run must match tick_json byte for byte
+            FAgentEJsonWriter Writer;
+            FAgentEJsonWriter Generic;
+            FAgentEJsonNames Names;
+            Names.Bind(Base);
+            AgentEWriteTickBody(Generic, *Base, 1000, 1000, nullptr, &Names);
+            bool bChecked = false;
+            Results.Add(RunCase(TEXT("tick_json_schema"), Agents, Settings, [&]() -> int64 {
+                AgentEWriteSchemaTickBody<FAgentEBenchSchema>(Writer, *Base, 1000, 1000, nullptr, &Names);
+                if (!bChecked)
+                {
+                    bChecked = true;
+                    if (Writer.GetBuffer() != Generic.GetBuffer())
+                    {
+                        return -1;
+                    }
+                }
+                return Writer.Num() > 0 ? Writer.Num() : -1;
+            }));
+        }
+        {
+            FAgentEJsonWriter Writer;
+            FAgentEJsonNames Names;
+            Names.Bind(Next);
+            Results.Add(RunCase(TEXT("delta_json"), Agents, Settings, [&]() -> int64 {
+                return AgentEWriteDeltaBody(Writer, *Base, *Next, 1001, 1001, 1000, nullptr, &Names) ? Writer.Num() : -1;
+            }));
+        }
+        {
+            // The same change, recorded by the mutation hooks
+            FAgentEEconomyState Tracked(Source);
+            Tracked.TrackChanges();
+            TSharedRef<const FAgentEEconomyState, ESPMode::ThreadSafe> TrackedBase =
+                MakeShared<FAgentEEconomyState, ESPMode::ThreadSafe>(Tracked);
+            Tracked.ClearChanges();
+            ChangeSome(Tracked, Settings.ChangedFraction, Settings.Seed);
+            TSharedRef<const FAgentEEconomyState, ESPMode::ThreadSafe> TrackedNext =
+                MakeShared<FAgentEEconomyState, ESPMode::ThreadSafe>(Tracked);
+
+            FAgentEJsonWriter Writer;
+            FAgentEJsonNames Names;
+            Names.Bind(TrackedNext);
+            Results.Add(RunCase(TEXT("delta_json_tracked"), Agents, Settings, [&]() -> int64 {
+                return AgentEWriteDeltaBody(Writer, *TrackedBase, *TrackedNext, 1001, 1001, 1000, nullptr, &Names) ? Writer.Num() : -1;
+            }));
+        }
+        {
+            FAgentEMsgPackWriter Writer;
+            FAgentEWireNames Names;
+            Results.Add(RunCase(TEXT("tick_binary"), Agents, Settings, [&]() -> int64 {
+                AgentEWriteBinaryTickBody(Writer, Names, Base, 1000, 1000);
+                return Writer.Num() > 0 ? Writer.Num() : -1;
+            }));
+        }
+
+        UE_LOG(LogTemp, Display, TEXT("[AgentE] Benchmarked %d agents"), Agents);
+    }
+
+    // Reply size doesn't depend on the economy, so the parse cases run once
+    FAgentEKeyTable Keys;
+    {
+        FAgentEJsonWriter Reply;
+        WriteJsonReply(Reply);
+        Results.Add(RunCase(TEXT("parse_json"), 0, Settings, [&]() -> int64 {
+            FAgentETickResult Result;
+            bool bResync = false;
+            const bool bOk = AgentEParseTickReply(Reply.GetBuffer(), /*bBinary*/ false, Keys, Result, bResync);
+            return bOk && Result.Adjustments.Num() == 32 && Result.Alerts.Num() == 4 ? Reply.Num() : -1;
+        }));
+    }
+    {
+        FAgentEMsgPackWriter Reply;
+        WriteBinaryReply(Reply);
+        Results.Add(RunCase(TEXT("parse_binary"), 0, Settings, [&]() -> int64 {
+            FAgentETickResult Result;
+            bool bResync = false;
+            const bool bOk = AgentEParseTickReply(Reply.GetBuffer(), /*bBinary*/ true, Keys, Result, bResync);
+            return bOk && Result.Adjustments.Num() == 32 && Result.Alerts.Num() == 4 ? Reply.Num() : -1;
+        }));
+    }
+
+    return Results;
+}
+
+// ─── Result Files ───────────────────────────────────────────────────────────
+
+void AgentEWriteBenchmarkJson(FAgentEJsonWriter& W, TConstArrayView<FAgentEBenchmarkResult> Results)
+{
+    W.Reset();
+    W.BeginObject();
+    W.Key("version"); W.Value(int64(1));
+    W.Key("platform"); W.Value(FStringView(FPlatformProperties::IniPlatformName()));
+    W.Key("cpu"); W.Value(FStringView(FPlatformMisc::GetCPUBrand().TrimStartAndEnd()));
+    W.Key("config"); W.Value(FStringView(LexToString(FApp::GetBuildConfiguration())));
+    W.Key("results");
+    W.BeginArray();
+    for (const FAgentEBenchmarkResult& R : Results)
+    {
+        W.BeginObject();
+        W.Key("case"); W.Value(FStringView(R.Case));
+        W.Key("agents"); W.Value(int64(R.Agents));
+        W.Key("iterations"); W.Value(int64(R.Iterations));
+        W.Key("medianMs"); W.Value(R.MedianMs);
+        W.Key("meanMs"); W.Value(R.MeanMs);
+        W.Key("minMs"); W.Value(R.MinMs);
+        W.Key("maxMs"); W.Value(R.MaxMs);
+        W.Key("bytes"); W.Value(R.Bytes);
+        W.Key("mbPerSecond"); W.Value(R.MegabytesPerSecond);
+        W.Key("allocationsPerIteration"); W.Value(R.AllocationsPerIteration);
+        W.Key("allocatedBytesPerIteration"); W.Value(R.AllocatedBytesPerIteration);
+        W.Key("peakHeapBytes"); W.Value(R.PeakHeapBytes);
+        W.Key("ok"); W.Value(R.bOk);
+        W.EndObject();
+    }
+    W.EndArray();
+    W.EndObject();
+}
+
+bool AgentEReadBenchmarkJson(TConstArrayView<uint8> Json, TArray<FAgentEBenchmarkResult>& OutResults)
+{
+    FAgentEJsonReader R(Json.GetData(), Json.Num());
+    bool bSawResults = false;
+    if (!R.BeginObject())
+    {
+        return false;
+    }
+    FUtf8StringView Key;
+    while (R.NextKey(Key))
+    {
+        if (!AgentEKeyIs(Key, "results") || !R.BeginArray())
+        {
+            R.Skip();
+            continue;
+        }
+        bSawResults = true;
+        while (R.NextElement() && R.BeginObject())
+        {
+            FAgentEBenchmarkResult& Out = OutResults.AddDefaulted_GetRef();
+            FUtf8StringView Field;
+            while (R.NextKey(Field))
+            {
+                double Number = 0.0;
+                bool bFlag = false;
+                if (AgentEKeyIs(Field, "case")) R.ReadString(Out.Case);
+                else if (AgentEKeyIs(Field, "agents") && R.ReadNumber(Number)) Out.Agents = int32(Number);
+                else if (AgentEKeyIs(Field, "iterations") && R.ReadNumber(Number)) Out.Iterations = int32(Number);
+                else if (AgentEKeyIs(Field, "medianMs") && R.ReadNumber(Number)) Out.MedianMs = Number;
+                else if (AgentEKeyIs(Field, "meanMs") && R.ReadNumber(Number)) Out.MeanMs = Number;
+                else if (AgentEKeyIs(Field, "minMs") && R.ReadNumber(Number)) Out.MinMs = Number;
+                else if (AgentEKeyIs(Field, "maxMs") && R.ReadNumber(Number)) Out.MaxMs = Number;
+                else if (AgentEKeyIs(Field, "bytes") && R.ReadNumber(Number)) Out.Bytes = int64(Number);
+                else if (AgentEKeyIs(Field, "mbPerSecond") && R.ReadNumber(Number)) Out.MegabytesPerSecond = Number;
+                else if (AgentEKeyIs(Field, "allocationsPerIteration") && R.ReadNumber(Number)) Out.AllocationsPerIteration = Number;
+                else if (AgentEKeyIs(Field, "allocatedBytesPerIteration") && R.ReadNumber(Number)) Out.AllocatedBytesPerIteration = Number;
+                else if (AgentEKeyIs(Field, "peakHeapBytes") && R.ReadNumber(Number)) Out.PeakHeapBytes = int64(Number);
+                else if (AgentEKeyIs(Field, "ok") && R.ReadBool(bFlag)) Out.bOk = bFlag;
+                else R.Skip();
+            }
+        }
+    }
+    return bSawResults && !R.HasError();
+}
+
+// ─── Commandlet ─────────────────────────────────────────────────────────────
+
+UAgentEBenchmarkCommandlet::UAgentEBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UAgentEBenchmarkCommandlet::Main(const FString& Params)
+{
+    FAgentEBenchmarkSettings Settings;
+
+    FString Agents;
+    if (FParse::Value(*Params, TEXT("Agents="), Agents, /*bShouldStopOnSeparator*/ false))
+    {
+        TArray<FString> Counts;
+        Agents.ParseIntoArray(Counts, TEXT(","));
+        Settings.AgentCounts.Reset();
+        for (const FString& Count : Counts)
+        {
+            Settings.AgentCounts.Add(FMath::Max(1, FCString::Atoi(*Count)));
+        }
+    }
+    FParse::Value(*Params, TEXT("MinSeconds="), Settings.MinSeconds);
+    FParse::Value(*Params, TEXT("MinIterations="), Settings.MinIterations);
+    FString Output = FPaths::ProjectSavedDir() / TEXT("AgentE") / TEXT("Benchmark.json");
+    FParse::Value(*Params, TEXT("Output="), Output);
+    FString BaselinePath;
+    FParse::Value(*Params, TEXT("Baseline="), BaselinePath);
+    double Tolerance = 0.25;
+    FParse::Value(*Params, TEXT("Tolerance="), Tolerance);
+
+    const TArray<FAgentEBenchmarkResult> Results = AgentERunBenchmarks(Settings);
+
+    int32 Failures = 0;
+    for (const FAgentEBenchmarkResult& R : Results)
+    {
+        UE_LOG(LogTemp, Display, TEXT("[AgentE] %-12s %8d agents  median %9.3f ms  %8.1f MB/s  %8.1f allocs  peak %lld B%s"),
+            *R.Case, R.Agents, R.MedianMs, R.MegabytesPerSecond, R.AllocationsPerIteration, R.PeakHeapBytes,
+            R.bOk ? TEXT("") : TEXT("  FAILED"));
+        Failures += R.bOk ? 0 : 1;
+    }
+
+    FAgentEJsonWriter Writer;
+    AgentEWriteBenchmarkJson(Writer, Results);
+    if (!FFileHelper::SaveArrayToFile(Writer.GetBuffer(), *Output))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[AgentE] Can't write %s"), *Output);
+        return 1;
+    }
+    UE_LOG(LogTemp, Display, TEXT("[AgentE] Results written to %s"), *Output);
+
+    if (!BaselinePath.IsEmpty())
+    {
+        TArray<uint8> Json;
+        TArray<FAgentEBenchmarkResult> Baseline;
+        if (!FFileHelper::LoadFileToArray(Json, *BaselinePath) || !AgentEReadBenchmarkJson(Json, Baseline))
+        {
+            UE_LOG(LogTemp, Error, TEXT("[AgentE] Can't read baseline %s"), *BaselinePath);
+            return 1;
+        }
+        for (const FAgentEBenchmarkResult& R : Results)
+        {
+            const FAgentEBenchmarkResult* Before = Baseline.FindByPredicate([&R](const FAgentEBenchmarkResult& B) {
+                return B.Case == R.Case && B.Agents == R.Agents;
+            });
+            if (Before && Before->MedianMs > 0.0 && R.MedianMs > Before->MedianMs * (1.0 + Tolerance))
+            {
+                UE_LOG(LogTemp, Error, TEXT("[AgentE] Regression: %s at %d agents, %.3f ms -> %.3f ms (+%.0f%%)"),
+                    *R.Case, R.Agents, Before->MedianMs, R.MedianMs, (R.MedianMs / Before->MedianMs - 1.0) * 100.0);
+                ++Failures;
+            }
+        }
+    }
+
+    return Failures > 0 ? 1 : 0;
+}
+
+// ─── Automation Test ────────────────────────────────────────────────────────
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAgentEBenchmarkTest, "AgentE.Benchmark",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FAgentEBenchmarkTest::RunTest(const FString& Parameters)
+{
+    // 1M agents is the commandlet's job; a perf pass shouldn't take minutes
+    FAgentEBenchmarkSettings Settings;
+    Settings.AgentCounts = { 1000, 10000, 100000 };
+    Settings.MinSeconds = 0.5;
+
+    const TArray<FAgentEBenchmarkResult> Results = AgentERunBenchmarks(Settings);
+    for (const FAgentEBenchmarkResult& R : Results)
+    {
+        AddInfo(FString::Printf(TEXT("%s %d agents: median %.3f ms, %.1f MB/s, %.1f allocs, peak %lld B"),
+            *R.Case, R.Agents, R.MedianMs, R.MegabytesPerSecond, R.AllocationsPerIteration, R.PeakHeapBytes));
+        TestTrue(FString::Printf(TEXT("%s at %d agents"), *R.Case, R.Agents), R.bOk);
+    }
+
+    FAgentEJsonWriter Writer;
+    AgentEWriteBenchmarkJson(Writer, Results);
+    FFileHelper::SaveArrayToFile(Writer.GetBuffer(), *(FPaths::ProjectSavedDir() / TEXT("AgentE") / TEXT("Benchmark.json")));
+    return true;
+}
+
+#endif
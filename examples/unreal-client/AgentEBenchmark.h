@@ -0,0 +1,110 @@
+/**
+ * AgentE Unreal Engine Client — Benchmarks
+ *
+ * Throughput, allocations and peak heap of the client's hot paths on
+ * synthetic economies, so a regression shows up before it reaches a live
+ * server:
+ *   - capture:      the EconomyState copy each send starts from
+ *   - tick_json:    AgentEWriteTickBody, agent IDs pre-encoded
+ *   - tick_json_schema: the same body from AgentEWriteSchemaTickBody, with
+ *                   the default schema settings only; fails if the bytes differ
+ *   - delta_json:   AgentEWriteDeltaBody with a few percent of agents changed
+ *   - delta_json_tracked: the same delta from change-tracked states
+ *   - tick_binary:  AgentEWriteBinaryTickBody with the name table already sent
+ *   - parse_json / parse_binary: AgentEParseTickReply on a tick reply
+ *
+ * Every case runs once untimed first, so buffers have grown and names are
+ * interned: the numbers are the steady state a running client sees.
+ * Allocations are counted by a proxy in front of GMalloc for the timed
+ * iterations; run with nothing else busy, since other threads' allocations
+ * are counted too.
+ *
+ * Two entry points: the AgentE.Benchmark automation test (perf filter,
+ * up to 100k agents) and the headless commandlet
+ *
+ *   UnrealEditor-Cmd MyGame.uproject -run=AgentEBenchmark
+ *       [-Agents=1000,10000,100000,1000000] [-MinSeconds=1] [-Output=Path.json]
+ *       [-Baseline=Path.json] [-Tolerance=0.25]
+ *
+ * which writes the results as JSON and, given a baseline from an earlier
+ * run, exits non-zero when a case's median got slower than the tolerance.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AgentEBenchmark.generated.h"
+
+class FAgentEJsonWriter;
+
+struct FAgentEBenchmarkSettings
+{
+    TArray<int32> AgentCounts = { 1000, 10000, 100000, 1000000 };
+    int32 Roles = 6;
+    int32 Resources = 8;
+    int32 Currencies = 3;
+
+    /** Agents whose balances change between the delta's base and its state */
+    double ChangedFraction = 0.05;
+
+    /** Each case runs for at least this long, and at least MinIterations times */
+    double MinSeconds = 1.0;
+    int32 MinIterations = 3;
+    int32 MaxIterations = 10000;
+
+    uint32 Seed = 0xA6E17;
+};
+
+struct FAgentEBenchmarkResult
+{
+    FString Case;
+
+    /** 0 for the parse cases, whose reply doesn't grow with the economy */
+    int32 Agents = 0;
+    int32 Iterations = 0;
+
+    double MedianMs = 0.0;
+    double MeanMs = 0.0;
+    double MinMs = 0.0;
+    double MaxMs = 0.0;
+
+    /** Bytes written (or parsed) per iteration */
+    int64 Bytes = 0;
+    double MegabytesPerSecond = 0.0;
+
+    double AllocationsPerIteration = 0.0;
+    double AllocatedBytesPerIteration = 0.0;
+
+    /** Highest live heap above the case's starting point */
+    int64 PeakHeapBytes = 0;
+
+    /** The case produced what it should (body written, reply parsed) */
+    bool bOk = true;
+};
+
+/** Run every case for every agent count in Settings */
+TArray<FAgentEBenchmarkResult> AgentERunBenchmarks(const FAgentEBenchmarkSettings& Settings);
+
+/**
+ * Write `{"version":1,"platform":...,"results":[...]}` into Writer (reset
+ * first); one object per result with the fields of FAgentEBenchmarkResult.
+ */
+void AgentEWriteBenchmarkJson(FAgentEJsonWriter& Writer, TConstArrayView<FAgentEBenchmarkResult> Results);
+
+/**
+ * Read results written by AgentEWriteBenchmarkJson back. False when the
+ * file is not a benchmark result file.
+ */
+bool AgentEReadBenchmarkJson(TConstArrayView<uint8> Json, TArray<FAgentEBenchmarkResult>& OutResults);
+
+UCLASS()
+class UAgentEBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UAgentEBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
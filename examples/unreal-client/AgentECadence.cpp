@@ -0,0 +1,80 @@
+/**
+ * AgentE Unreal Engine Client — Adaptive Send Cadence
+ *
+ * See AgentECadence.h.
+ */
+
+#include "AgentECadence.h"
+
+static constexpr float MaxBackoff = 16.f;
+
+/** Per clean reply: backoff decays, base interval closes this much of its gap */
+static constexpr float BackoffDecay = 0.9f;
+static constexpr float BaseApproach = 0.25f;
+
+void FAgentECadence::Reset(const FAgentECadenceSettings& InSettings)
+{
+    Settings = InSettings;
+    Settings.MinInterval = FMath::Max(0.01f, Settings.MinInterval);
+    Settings.MaxInterval = FMath::Max(Settings.MinInterval, Settings.MaxInterval);
+    Settings.TargetInterval = FMath::Clamp(Settings.TargetInterval, Settings.MinInterval, Settings.MaxInterval);
+
+    BaseInterval = Settings.TargetInterval;
+    Backoff = 1.f;
+    SmoothedRtt = 0.0;
+    BaselineRtt = 0.0;
+    PreviousHealth = -1;
+}
+
+float FAgentECadence::GetInterval() const
+{
+    const float Interval = FMath::Max(BaseInterval * Backoff, float(SmoothedRtt));
+    return FMath::Clamp(Interval, Settings.MinInterval, Settings.MaxInterval);
+}
+
+void FAgentECadence::OnRoundTrip(double RttSeconds)
+{
+    if (RttSeconds < 0.0)
+    {
+        return;
+    }
+    if (SmoothedRtt == 0.0)
+    {
+        SmoothedRtt = BaselineRtt = RttSeconds;
+        return;
+    }
+
+    // Fast and slow averages: the fast one running well above the slow one is a degrading server
+    SmoothedRtt += (RttSeconds - SmoothedRtt) * 0.2;
+    BaselineRtt += (RttSeconds - BaselineRtt) * 0.02;
+
+    if (SmoothedRtt > BaselineRtt * 1.5 && SmoothedRtt > 0.05)
+    {
+        Backoff = FMath::Min(MaxBackoff, Backoff * 1.25f);
+    }
+    else
+    {
+        Backoff = FMath::Max(1.f, Backoff * BackoffDecay);
+    }
+}
+
+void FAgentECadence::OnBackoff(float Factor)
+{
+    Backoff = FMath::Clamp(Backoff * Factor, 1.f, MaxBackoff);
+}
+
+void FAgentECadence::OnTickResult(int32 Health, int32 MaxAlertSeverity)
+{
+    const bool bFalling = PreviousHealth >= 0 && Health <= PreviousHealth - 10;
+    PreviousHealth = Health;
+
+    if (Health <= Settings.UrgentHealth || bFalling || MaxAlertSeverity >= Settings.SevereAlert)
+    {
+        // React at once; the economy needs watching now
+        BaseInterval = Settings.MinInterval;
+        return;
+    }
+
+    const float Desired = (Health >= 90 && MaxAlertSeverity == 0) ? Settings.MaxInterval : Settings.TargetInterval;
+    BaseInterval += (Desired - BaseInterval) * BaseApproach;
+}
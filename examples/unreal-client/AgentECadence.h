@@ -0,0 +1,62 @@
+/**
+ * AgentE Unreal Engine Client — Adaptive Send Cadence
+ *
+ * Picks the wall-clock spacing between tick sends from what the replies say:
+ *
+ *   - Economy: a low or falling health score, or a severe alert, pulls the
+ *     interval down to the minimum; a healthy economy drifts up to the
+ *     maximum; anything else settles on the target.
+ *   - Server: rate-limit errors, failures and rising round-trip times
+ *     multiply a backoff factor that decays again on clean replies. The
+ *     interval never drops below the smoothed RTT.
+ *
+ * Game thread only.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAgentECadenceSettings
+{
+    float MinInterval = 0.25f;
+    float TargetInterval = 1.f;
+    float MaxInterval = 5.f;
+
+    /** Health at or below this is urgent */
+    int32 UrgentHealth = 50;
+
+    /** Alerts at or above this severity (1-10) are urgent */
+    int32 SevereAlert = 7;
+};
+
+class FAgentECadence
+{
+public:
+    void Reset(const FAgentECadenceSettings& InSettings);
+
+    /** Seconds until the next send */
+    float GetInterval() const;
+
+    /** A reply arrived RttSeconds after its send */
+    void OnRoundTrip(double RttSeconds);
+
+    /** The server rate-limited (Factor 2) or the send failed (smaller factor) */
+    void OnBackoff(float Factor);
+
+    /** A tick result was applied */
+    void OnTickResult(int32 Health, int32 MaxAlertSeverity);
+
+private:
+    FAgentECadenceSettings Settings;
+
+    /** Interval the economy asks for, moving toward the desired one */
+    float BaseInterval = 1.f;
+
+    /** Congestion multiplier, >= 1 */
+    float Backoff = 1.f;
+
+    double SmoothedRtt = 0.0;
+    double BaselineRtt = 0.0;
+    int32 PreviousHealth = -1;
+};
@@ -2,14 +2,23 @@
  * AgentE Unreal Engine Client — Implementation
  *
  * See AgentEClient.h for setup instructions.
- * TODO: Replace BuildStateJson() with your actual economy data.
  */
 
 #include "AgentEClient.h"
 #include "HttpModule.h"
 #include "Interfaces/IHttpResponse.h"
+#include "Async/Async.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Compression.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "AgentEJsonReader.h"
+#include "AgentESubsystem.h"
+#include "AgentESharedMemory.h"
+#include "Engine/Engine.h"
 
 UAgentEClient::UAgentEClient()
+    : SendContext(MakeShared<FAgentESendContext, ESPMode::ThreadSafe>())
 {
     PrimaryComponentTick.bCanEverTick = false;
 }
@@ -17,148 +26,1789 @@ UAgentEClient::UAgentEClient()
 void UAgentEClient::BeginPlay()
 {
     Super::BeginPlay();
+    StartClient();
+}
+
+void UAgentEClient::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    StopClient();
+    Super::EndPlay(EndPlayReason);
+}
+
+void UAgentEClient::StartClient()
+{
+    if (bTrackChanges)
+    {
+        EconomyState.TrackChanges();
+    }
+
+    TWeakObjectPtr<UAgentEClient> WeakThis(this);
+    TSharedRef<FAgentESendContext, ESPMode::ThreadSafe> Context = SendContext;
+    FAgentEReplyHandler Handler = [WeakThis, Context](int32 StatusCode, TConstArrayView<uint8> Body, bool bBinary) {
+        HandleTickResponse(WeakThis, Context, StatusCode, Body, bBinary);
+    };
+
+    // The shared uplink tags bodies with the shard itself
+    const bool bOwnShard = !bUseSharedUplink && !ShardId.IsEmpty();
+    SendContext->Shard = bOwnShard ? ShardId : FString();
+    SendContext->ShardPrefix = bOwnShard ? AgentEShardPrefix(ShardId) : TArray<uint8>();
+
+    if (bUseSharedUplink)
+    {
+        if (Encoding != EAgentEEncoding::Json || Transport != EAgentETransport::Http)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[AgentE] Shared uplink sends JSON over HTTP; Transport and Encoding ignored"));
+            Encoding = EAgentEEncoding::Json;
+        }
+        const FString Shard = ShardId.IsEmpty() ? GetNameSafe(GetOwner()) : ShardId;
+        ActiveTransport = GEngine->GetEngineSubsystem<UAgentESubsystem>()->RegisterShard(
+            ServerUrl, Shard, MoveTemp(Handler), UplinkBatchWindow, bCompressTicks ? CompressionThresholdBytes : -1);
+        if (!ActiveTransport.IsValid())
+        {
+            UE_LOG(LogTemp, Error, TEXT("[AgentE] Could not join the shared uplink as shard '%s'; client disabled"), *Shard);
+            return;
+        }
+    }
+    else
+    {
+        switch (Transport)
+        {
+        case EAgentETransport::WebSocket:
+            ActiveTransport = MakeShared<FAgentEWebSocketTransport, ESPMode::ThreadSafe>(
+                WebSocketUrl.IsEmpty() ? FAgentEWebSocketTransport::ToWebSocketUrl(ServerUrl) : WebSocketUrl,
+                Encoding, ReconnectInitialDelay, ReconnectMaxDelay,
+                BulkChunkKilobytes * 1024, BulkKilobytesPerFrame * 1024, MoveTemp(Handler),
+                [Context](double QueuedSeconds) { Context->Stats.AddStage(EAgentEStage::BulkWait, QueuedSeconds); });
+            break;
+        case EAgentETransport::SharedMemory:
+            if (Encoding != EAgentEEncoding::MessagePack)
+            {
+                UE_LOG(LogTemp, Log, TEXT("[AgentE] Shared-memory transport sends MessagePack; Encoding ignored"));
+                Encoding = EAgentEEncoding::MessagePack;
+            }
+            ActiveTransport = MakeShared<FAgentESharedMemoryTransport, ESPMode::ThreadSafe>(
+                SharedMemoryPort, SharedMemoryRingKilobytes * 1024, ReconnectInitialDelay, ReconnectMaxDelay,
+                MoveTemp(Handler));
+            break;
+        case EAgentETransport::Http:
+        default:
+            ActiveTransport = MakeShared<FAgentEHttpTransport, ESPMode::ThreadSafe>(ServerUrl, Encoding, MoveTemp(Handler));
+            break;
+        }
+    }
+    ActiveTransport->Connect();
+
+    if (bSubscribeToPushes)
+    {
+        FAgentEJsonWriter Writer;
+        Writer.BeginObject();
+        Writer.Key("type");
+        Writer.Value("subscribe");
+        Writer.EndObject();
+        if (!ActiveTransport->Subscribe(Writer.GetBuffer()))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[AgentE] Pushes need the WebSocket transport; bSubscribeToPushes ignored"));
+        }
+    }
+
+    FAgentECadenceSettings CadenceSettings;
+    CadenceSettings.MinInterval = MinSendInterval;
+    CadenceSettings.TargetInterval = TargetSendInterval;
+    CadenceSettings.MaxInterval = MaxSendInterval;
+    CadenceSettings.UrgentHealth = UrgentHealth;
+    CadenceSettings.SevereAlert = SevereAlertSeverity;
+    Cadence.Reset(CadenceSettings);
+    NextSendTime = 0.0;
+
+    EventStream = MakeShared<FAgentEEventStream, ESPMode::ThreadSafe>(EventRingCapacity, EventOverflow, EventSampleRate);
+    LastEventFlushTime = FPlatformTime::Seconds();
+    EventFlushHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateUObject(this, &UAgentEClient::TickEventFlusher));
+
+    FAgentELocalRulesSettings RulesSettings;
+    RulesSettings.NetFlowWarnThreshold = LocalNetFlowThreshold;
+    RulesSettings.MaxAdjustmentPercent = LocalMaxAdjustmentPercent;
+    RulesSettings.CooldownSeconds = LocalRulesCooldown;
+    RulesSettings.HistorySize = AdjustmentHistorySize;
+    TMap<int32, int32> RuleParameters;
+    for (const TPair<FName, FName>& It : LocalRuleParameters)
+    {
+        RuleParameters.Add(Context->Keys.FindOrAdd(It.Key), Context->Keys.FindOrAdd(It.Value));
+    }
+    LocalRules.Configure(RulesSettings, Context->Keys, RuleParameters);
+    Context->bCollectLocalFlows = bUseLocalRules;
+    bLocalRulesEngaged = false;
+
+    AdjustmentQueue.Reset();
+    AdjustmentQueue.SetInterpolationFrames(AdjustmentInterpolationFrames);
+    AdjustmentTickHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateUObject(this, &UAgentEClient::TickAdjustmentQueue));
+
+    if (bSpoolWhenOffline)
+    {
+        const FString Path = SpoolFile.IsEmpty()
+            ? FPaths::ProjectSavedDir() / TEXT("AgentE") / TEXT("Spool.bin") : SpoolFile;
+        const int64 Capacity = int64(FMath::Max(1, SpoolMaxMegabytes)) << 20;
+        // Bodies replay verbatim, so they must match this session's wire format
+        const uint32 Format = uint32(Encoding) | (ActiveTransport->GetTickMessageType() ? 0x100u : 0u);
+
+        // File I/O stays on the send chain, like every other spool access
+        LastSendTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+            [Context, Path, Capacity, Format]()
+            {
+                FAgentESendContext& Ctx = *Context;
+                Ctx.bSpoolOpen = Ctx.Spool.Open(Path, Capacity, Format);
+                Ctx.SpoolPending = Ctx.Spool.Num();
+                Ctx.Seq = FMath::Max(Ctx.Seq, Ctx.Spool.GetLastSeq());
+            },
+            UE::Tasks::Prerequisites(LastSendTask));
+
+        NextReplayTime = 0.0;
+        NextProbeTime = 0.0;
+        ReplayBackoff = 1.f;
+        SpoolTickHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateUObject(this, &UAgentEClient::TickSpool));
+    }
+
     UE_LOG(LogTemp, Log, TEXT("[AgentE] Client initialized, server: %s"), *ServerUrl);
 }
 
+void UAgentEClient::StopClient()
+{
+    if (EventFlushHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(EventFlushHandle);
+        EventFlushHandle.Reset();
+    }
+    FlushEvents();
+
+    if (AdjustmentTickHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(AdjustmentTickHandle);
+        AdjustmentTickHandle.Reset();
+    }
+    AdjustmentQueue.Reset();
+
+    if (SpoolTickHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(SpoolTickHandle);
+        SpoolTickHandle.Reset();
+        TSharedRef<FAgentESendContext, ESPMode::ThreadSafe> Context = SendContext;
+        LastSendTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+            [Context]()
+            {
+                Context->bSpoolOpen = false;
+                Context->Spool.Close();
+            },
+            UE::Tasks::Prerequisites(LastSendTask));
+    }
+
+    if (ActiveTransport.IsValid())
+    {
+        ActiveTransport->Shutdown();
+        ActiveTransport.Reset();
+    }
+}
+
 // ─── Game Loop Integration ──────────────────────────────────────────────────
 
 void UAgentEClient::OnGameTick()
 {
-    TickCounter++;
-    if (TickCounter % TickInterval == 0)
+    const int32 Tick = TickCounter.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (!bAdaptiveCadence)
     {
+        if (Tick % FMath::Max(1, TickInterval) == 0)
+        {
+            SendTick();
+        }
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    if (Now >= NextSendTime)
+    {
+        NextSendTime = Now + Cadence.GetInterval();
         SendTick();
     }
 }
 
-// ─── HTTP Communication ─────────────────────────────────────────────────────
+// ─── Event Streaming ────────────────────────────────────────────────────────
+
+/** Send task only. Body, or a copy in Ctx.ShardedBody addressed to Ctx.Shard (JSON bodies) */
+static const TArray<uint8>& WithShard(FAgentESendContext& Ctx, const TArray<uint8>& Body)
+{
+    if (Ctx.ShardPrefix.IsEmpty())
+    {
+        return Body;
+    }
+    Ctx.ShardedBody.Reset();
+    AgentESpliceShard(Ctx.ShardedBody, Ctx.ShardPrefix, Body);
+    return Ctx.ShardedBody;
+}
+
+void UAgentEClient::RecordEvent(const FAgentEEvent& Event)
+{
+    if (EventStream.IsValid())
+    {
+        EventStream->Record(Event);
+    }
+}
+
+FAgentEEventStats UAgentEClient::GetEventStats() const
+{
+    return EventStream.IsValid() ? EventStream->GetStats() : FAgentEEventStats();
+}
+
+TArray<FAgentEAdjustmentRecord> UAgentEClient::GetAdjustmentHistory() const
+{
+    TArray<FAgentECachedAdjustment> History;
+    LocalRules.GetHistory(History);
+
+    const FAgentEKeyTable& Keys = SendContext->Keys;
+    const double Now = FPlatformTime::Seconds();
+    TArray<FAgentEAdjustmentRecord> Out;
+    Out.Reserve(History.Num());
+    for (const FAgentECachedAdjustment& Entry : History)
+    {
+        FAgentEAdjustmentRecord& Record = Out.AddDefaulted_GetRef();
+        Record.Parameter = Keys.GetString(Entry.Parameter);
+        Record.Value = Entry.Value;
+        if (Entry.Principle != INDEX_NONE)
+        {
+            Record.Principle = Keys.GetString(Entry.Principle);
+        }
+        Record.Tick = Entry.Tick;
+        Record.bLocal = Entry.bLocal;
+        Record.AgeSeconds = float(Now - Entry.Time);
+    }
+    return Out;
+}
+
+FAgentEClientStats UAgentEClient::GetClientStats() const
+{
+    FAgentEClientStats Stats = SendContext->Stats.Snapshot();
+    Stats.InFlight = SendContext->InFlight.load();
+    Stats.EventsDropped = GetEventStats().TotalLost();
+    Stats.SpoolPending = SendContext->SpoolPending.load();
+    return Stats;
+}
+
+bool UAgentEClient::TickEventFlusher(float DeltaTime)
+{
+    const double Now = FPlatformTime::Seconds();
+    if (EventStream.IsValid()
+        && (EventStream->ConsumeFlushRequest() || Now - LastEventFlushTime >= EventFlushInterval))
+    {
+        FlushEvents();
+    }
+    return true;
+}
+
+void UAgentEClient::FlushEvents()
+{
+    if (!ActiveTransport.IsValid() || !EventStream.IsValid())
+    {
+        return;
+    }
+    LastEventFlushTime = FPlatformTime::Seconds();
+
+    TSharedRef<FAgentEEventStream, ESPMode::ThreadSafe> Stream = EventStream.ToSharedRef();
+    TSharedRef<FAgentESendContext, ESPMode::ThreadSafe> Context = SendContext;
+    TSharedRef<IAgentETransport, ESPMode::ThreadSafe> Link = ActiveTransport.ToSharedRef();
+    const int32 MaxPerBatch = FMath::Clamp(MaxEventsPerBatch, 1, 1000);
+
+    // Same chain as the tick sends: one consumer for the stream, and on a
+    // WebSocket the events reach the server before the next tick does
+    LastSendTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+        [Stream, Context, Link, MaxPerBatch]()
+        {
+            FAgentESendContext& Ctx = *Context;
+            for (;;)
+            {
+                Ctx.EventBatch.Reset();
+                const int32 Count = Stream->Drain(Ctx.EventBatch, MaxPerBatch);
+                if (Count == 0)
+                {
+                    break;
+                }
+                if (Ctx.bCollectLocalFlows.load(std::memory_order_relaxed))
+                {
+                    FScopeLock Lock(&Ctx.LocalFlowsLock);
+                    for (const FAgentEEvent& Event : Ctx.EventBatch)
+                    {
+                        Ctx.LocalFlows.Add(Event);
+                    }
+                }
+                AgentEWriteEventsBody(Ctx.EventWriter, Ctx.EventBatch, Link->GetEventsMessageType());
+                const TArray<uint8>& EventsBody = WithShard(Ctx, Ctx.EventWriter.GetBuffer());
+                if (Ctx.bServerUnreachable.load() || !Ctx.Spool.IsEmpty())
+                {
+                    // Queued behind the spooled ticks so the replay keeps the order
+                    Ctx.Spool.Push(EAgentESpoolRecord::Events, Ctx.Seq, EventsBody);
+                    Ctx.SpoolPending = Ctx.Spool.Num();
+                }
+                else
+                {
+                    Link->SendEvents(EventsBody);
+                    Ctx.Stats.AddEventsSent(EventsBody.Num());
+                }
+                if (Count < MaxPerBatch)
+                {
+                    break;
+                }
+            }
+
+            const int64 Lost = Stream->GetStats().TotalLost();
+            if (Lost > Ctx.ReportedEventsLost)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("[AgentE] %lld events lost to full buffers (%lld total)"),
+                    Lost - Ctx.ReportedEventsLost, Lost);
+                Ctx.ReportedEventsLost = Lost;
+                Ctx.Stats.SetEventsDropped(Lost);
+            }
+        },
+        UE::Tasks::Prerequisites(LastSendTask));
+}
+
+// ─── Server Communication ───────────────────────────────────────────────────
+
+/** Send task only. Pool misses and allocations so far in the aggregator and sampler */
+static int64 CountSendAllocations(const FAgentESendContext& Ctx)
+{
+    return Ctx.Aggregator.GetAllocations() + Ctx.Sampler.GetAllocations();
+}
+
+/** Send task only. Bytes reserved by the reused body buffers */
+static int64 SendBufferCapacity(const FAgentESendContext& Ctx)
+{
+    return int64(Ctx.Writer.GetBuffer().Max()) + Ctx.BinaryWriter.GetBuffer().Max() + Ctx.CompressedBody.Max()
+        + Ctx.ShardedBody.Max();
+}
+
+/**
+ * Send task only. Gzip Body into Ctx.CompressedBody when it is at least
+ * Threshold bytes (Threshold < 0: never) and compression actually pays;
+ * otherwise send it as is.
+ */
+static void SendTickBody(FAgentESendContext& Ctx, IAgentETransport& Link, const TArray<uint8>& Body, int32 Threshold)
+{
+    if (Threshold >= 0 && Body.Num() >= Threshold)
+    {
+        AGENTE_STAGE_SCOPE(Ctx.Stats, Compress);
+        int32 CompressedSize = int32(FCompression::CompressMemoryBound(NAME_Gzip, Body.Num()));
+        Ctx.CompressedBody.SetNumUninitialized(CompressedSize, EAllowShrinking::No);
+        if (FCompression::CompressMemory(NAME_Gzip, Ctx.CompressedBody.GetData(), CompressedSize,
+                Body.GetData(), Body.Num(), COMPRESS_BiasSpeed)
+            && CompressedSize < Body.Num() - Body.Num() / 10)
+        {
+            Ctx.CompressedBody.SetNum(CompressedSize, EAllowShrinking::No);
+            Link.SendTick(Ctx.CompressedBody, /*bGzip*/ true);
+            Ctx.Stats.AddTickSent(CompressedSize);
+            return;
+        }
+    }
+    Link.SendTick(Body, /*bGzip*/ false);
+    Ctx.Stats.AddTickSent(Body.Num());
+}
+
+/**
+ * Send task only. Append State to the spool as a full body under Seq.
+ * A binary body gets a fresh name table: the server it replays to may
+ * have restarted and forgotten the names.
+ */
+static void SpoolTickBody(
+    FAgentESendContext& Ctx, const TSharedRef<const FAgentEEconomyState, ESPMode::ThreadSafe>& State,
+    int32 Tick, int64 Seq, bool bBinary, const ANSICHAR* MessageType)
+{
+    if (bBinary)
+    {
+        Ctx.WireNames.Reset();
+        AgentEWriteBinaryTickBody(Ctx.BinaryWriter, Ctx.WireNames, State, Tick, Seq, Ctx.Shard);
+        Ctx.Spool.Push(EAgentESpoolRecord::Tick, Seq, Ctx.BinaryWriter.GetBuffer());
+    }
+    else
+    {
+        Ctx.WriteTickBody.load()(Ctx.Writer, *State, Tick, Seq, MessageType, &Ctx.JsonNames);
+        Ctx.Spool.Push(EAgentESpoolRecord::Tick, Seq, WithShard(Ctx, Ctx.Writer.GetBuffer()));
+    }
+    Ctx.SpoolPending = Ctx.Spool.Num();
+
+    const int64 Dropped = Ctx.Spool.GetDropped();
+    if (Dropped > Ctx.ReportedSpoolDropped)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[AgentE] Spool full, %lld oldest records dropped (%lld total)"),
+            Dropped - Ctx.ReportedSpoolDropped, Dropped);
+        Ctx.ReportedSpoolDropped = Dropped;
+    }
+}
 
 void UAgentEClient::SendTick()
 {
-    FString StateJson = BuildStateJson();
-    FString Body = FString::Printf(TEXT("{\"state\":%s}"), *StateJson);
+    if (!ActiveTransport.IsValid())
+    {
+        return;
+    }
 
-    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request =
-        FHttpModule::Get().CreateRequest();
+    // Recorded events go first so the server ingests them into this tick
+    FlushEvents();
 
-    Request->SetURL(ServerUrl + TEXT("/tick"));
-    Request->SetVerb(TEXT("POST"));
-    Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-    Request->SetContentAsString(Body);
-    Request->OnProcessRequestComplete().BindUObject(
-        this, &UAgentEClient::HandleTickResponse);
+    if (bUseLocalRules)
+    {
+        RunLocalRules(FPlatformTime::Seconds());
+    }
 
-    Request->ProcessRequest();
+    // Server unreachable, or spooled ticks still replaying: this one queues behind them
+    FAgentESendContext& Ctx = *SendContext;
+    const bool bToSpool = Ctx.bServerUnreachable.load() || Ctx.SpoolPending.load() > 0;
+
+    // In-flight cap: a slow server gets a bounded, predictable send rate
+    const double Now = FPlatformTime::Seconds();
+    if (!bToSpool && Ctx.InFlight.load() >= FMath::Max(1, MaxInFlight))
+    {
+        if (Now - Ctx.LastProgressTime.load() < InFlightTimeout)
+        {
+            // Events stay in RecentTransactions and go with the next send
+            bSendQueued = CoalescePolicy == EAgentECoalescePolicy::SendLatestWhenFree;
+            UE_LOG(LogTemp, Verbose, TEXT("[AgentE] Tick coalesced, %d in flight"), Ctx.InFlight.load());
+            return;
+        }
+        UE_LOG(LogTemp, Warning, TEXT("[AgentE] No reply for %.1fs, presuming %d tick(s) lost"),
+            Now - Ctx.LastProgressTime.load(), Ctx.InFlight.load());
+        Ctx.InFlight = 0;
+        Ctx.bForceFullSnapshot = true;
+    }
+    if (!bToSpool)
+    {
+        const int32 Pending = Ctx.InFlight.fetch_add(1);
+        if (Pending == 0)
+        {
+            Ctx.LastProgressTime = Now;
+        }
+        Ctx.Stats.SetInFlight(Pending + 1);
+    }
+    bSendQueued = false;
+
+    // Game thread: one snapshot copy (shared name table + column memcpy) into a recycled snapshot
+    const int64 SnapshotMisses = Snapshots.GetAllocations();
+    TSharedRef<FAgentEEconomyState, ESPMode::ThreadSafe> Snapshot = Snapshots.Acquire();
+    {
+        AGENTE_STAGE_SCOPE(Ctx.Stats, Capture);
+        const bool bGrew = Snapshot->CopyFrom(EconomyState);
+        EconomyState.RecentTransactions.Reset();
+        EconomyState.ClearChanges();
+        Ctx.Stats.AddTransientAllocations(Snapshots.GetAllocations() - SnapshotMisses + (bGrew ? 1 : 0));
+    }
+
+    const int32 Tick = TickCounter.load(std::memory_order_relaxed);
+    TSharedRef<FAgentESendContext, ESPMode::ThreadSafe> Context = SendContext;
+    TSharedRef<IAgentETransport, ESPMode::ThreadSafe> Link = ActiveTransport.ToSharedRef();
+    const bool bBinary = Encoding == EAgentEEncoding::MessagePack;
+    const bool bDelta = bUseDeltaSnapshots && !bBinary;
+    const int32 FullEvery = FMath::Max(1, FullSnapshotInterval);
+    const int32 CompressAbove = bCompressTicks && Link->SupportsCompression() ? CompressionThresholdBytes : -1;
+
+    const bool bSample = bSampleAgents;
+    const bool bAggregate = bPreAggregate;
+    FAgentESamplingSettings Sampling;
+    Sampling.MaxAgents = FMath::Max(1, SampleMaxAgents);
+    Sampling.MinAgentsPerRole = FMath::Max(1, SampleMinAgentsPerRole);
+    Sampling.Seed = uint32(SampleSeed);
+
+    // Worker: serialize + hand to the transport. Chained on the previous send
+    // so the send context is never touched by two tasks at once.
+    LastSendTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+        [Snapshot, Context, Link, Tick, bBinary, bDelta, FullEvery, CompressAbove, bSample, bAggregate, Sampling, bToSpool]()
+        {
+            FAgentESendContext& Ctx = *Context;
+            const TArray<uint8>* Out = nullptr;
+
+            // Everything below reuses the context's pools and buffers; count whatever did not
+            const int64 Allocations = CountSendAllocations(Ctx);
+            const int64 Capacity = SendBufferCapacity(Ctx);
+            ON_SCOPE_EXIT
+            {
+                Ctx.Stats.AddTransientAllocations(CountSendAllocations(Ctx) - Allocations
+                    + (SendBufferCapacity(Ctx) > Capacity ? 1 : 0));
+            };
+            {
+                AGENTE_STAGE_SCOPE(Ctx.Stats, Serialize);
+
+                // The snapshot is this task's alone until it is published below
+                if (bAggregate)
+                {
+                    Snapshot->Aggregates = Ctx.Aggregator.Compute(*Snapshot);
+                }
+                TSharedRef<const FAgentEEconomyState, ESPMode::ThreadSafe> Body = Snapshot;
+                if (bSample)
+                {
+                    // Exact aggregates over the full snapshot, then only the sample is serialized
+                    Body = Ctx.Sampler.Sample(Body, Sampling);
+                }
+                const int64 BaseSeq = Ctx.Seq;
+                const int64 Seq = BaseSeq + 1;
+                const ANSICHAR* MessageType = Link->GetTickMessageType();
+                if (!bBinary)
+                {
+                    Ctx.JsonNames.Bind(Body);
+                }
+
+                if (bToSpool)
+                {
+                    // The send that failed may have been the newest one; it goes first
+                    if (Ctx.bSpoolLastSent.exchange(false) && Ctx.LastSent.IsValid() && Ctx.Seq > Ctx.LastAppliedSeq.load())
+                    {
+                        SpoolTickBody(Ctx, Ctx.LastSent.ToSharedRef(), Ctx.LastSentTick, Ctx.Seq, bBinary, MessageType);
+                    }
+                    SpoolTickBody(Ctx, Body, Tick, Seq, bBinary, MessageType);
+                    Ctx.LastSent = Body;
+                    Ctx.LastSentTick = Tick;
+                    Ctx.Seq = Seq;
+                    return;
+                }
+
+                if (bBinary)
+                {
+                    // Binary bodies are compact full snapshots; names are sent once per session
+                    if (Ctx.bResetWireNames.exchange(false))
+                    {
+                        Ctx.WireNames.Reset();
+                    }
+                    AgentEWriteBinaryTickBody(Ctx.BinaryWriter, Ctx.WireNames, Body, Tick, Seq, Ctx.Shard);
+                    Out = &Ctx.BinaryWriter.GetBuffer();
+                }
+                else
+                {
+                    // UTF-8 straight from the typed arrays; no FString body, no TCHAR→UTF-8 pass
+                    const bool bForceFull = Ctx.bForceFullSnapshot.exchange(false)
+                        || !Ctx.LastSent.IsValid() || Ctx.SendsSinceFull + 1 >= FullEvery;
+                    if (bDelta && !bForceFull
+                        && AgentEWriteDeltaBody(Ctx.Writer, *Ctx.LastSent, *Body, Tick, Seq, BaseSeq, MessageType, &Ctx.JsonNames))
+                    {
+                        ++Ctx.SendsSinceFull;
+                    }
+                    else
+                    {
+                        Ctx.WriteTickBody.load()(Ctx.Writer, *Body, Tick, Seq, MessageType, &Ctx.JsonNames);
+                        Ctx.SendsSinceFull = 0;
+                    }
+                    Out = &WithShard(Ctx, Ctx.Writer.GetBuffer());
+                }
+                Ctx.LastSent = Body;
+                Ctx.LastSentTick = Tick;
+                Ctx.Seq = Seq;
+
+                Ctx.SentAt[Seq % 16] = FPlatformTime::Seconds();
+                Ctx.SentSeq[Seq % 16] = Seq;
+            }
+            SendTickBody(Ctx, *Link, *Out, CompressAbove);
+        },
+        UE::Tasks::Prerequisites(LastSendTask));
 }
 
+/** A control message unanswered for this long is taken as lost (say, with the WebSocket that carried it) */
+static constexpr double ControlReplyTimeout = 10.0;
+
 void UAgentEClient::CheckHealth()
 {
+    RequestHealth(/*bBypassCache*/ false);
+}
+
+FAgentEHealthInfo UAgentEClient::GetLastHealthInfo() const
+{
+    FAgentEHealthInfo Info = HealthInfo;
+    Info.AgeSeconds = Info.bValid ? float(FPlatformTime::Seconds() - HealthCheckedAt) : 0.f;
+    return Info;
+}
+
+void UAgentEClient::RequestHealth(bool bBypassCache)
+{
+    if (!bBypassCache && HealthInfo.bValid && FPlatformTime::Seconds() - HealthCheckedAt < HealthCacheSeconds)
+    {
+        OnHealthChecked.Broadcast(GetLastHealthInfo());
+        return;
+    }
+    if (bHealthRequestInFlight && FPlatformTime::Seconds() - HealthSentAt < ControlReplyTimeout)
+    {
+        return; // its answer goes to every listener
+    }
+    bHealthRequestInFlight = true;
+    HealthSentAt = FPlatformTime::Seconds();
+
+    if (ActiveTransport.IsValid())
+    {
+        FAgentEJsonWriter Writer;
+        Writer.BeginObject();
+        Writer.Key("type");
+        Writer.Value("health");
+        if (HealthInfo.bValid && !HealthETag.IsEmpty())
+        {
+            Writer.Key("ifNoneMatch");
+            Writer.Value(FStringView(HealthETag));
+        }
+        Writer.EndObject();
+        if (ActiveTransport->SendControl(Writer.GetBuffer()))
+        {
+            return; // health_result comes back through HandleControlReply
+        }
+    }
+
     TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request =
         FHttpModule::Get().CreateRequest();
 
     Request->SetURL(ServerUrl + TEXT("/health"));
     Request->SetVerb(TEXT("GET"));
+    if (HealthInfo.bValid && !HealthETag.IsEmpty())
+    {
+        Request->SetHeader(TEXT("If-None-Match"), HealthETag);
+    }
+    TWeakObjectPtr<UAgentEClient> WeakThis(this);
     Request->OnProcessRequestComplete().BindLambda(
-        [](FHttpRequestPtr, FHttpResponsePtr Response, bool bSuccess) {
-            if (bSuccess && Response.IsValid())
+        [WeakThis](FHttpRequestPtr, FHttpResponsePtr Response, bool bSuccess) {
+            if (UAgentEClient* This = WeakThis.Get())
             {
-                UE_LOG(LogTemp, Log, TEXT("[AgentE] Health: %s"),
-                    *Response->GetContentAsString());
+                This->OnHealthResponse(Response, bSuccess);
             }
         });
 
     Request->ProcessRequest();
 }
 
-// ─── State Building ─────────────────────────────────────────────────────────
-// TODO: Replace this with your actual economy data
+void UAgentEClient::ApproveDecision(const FString& DecisionId)
+{
+    SendDecision(DecisionId, /*bApprove*/ true, FString());
+}
+
+void UAgentEClient::RejectDecision(const FString& DecisionId, const FString& Reason)
+{
+    SendDecision(DecisionId, /*bApprove*/ false, Reason);
+}
 
-FString UAgentEClient::BuildStateJson()
+void UAgentEClient::SendDecision(const FString& DecisionId, bool bApprove, const FString& Reason)
 {
-    // Build JSON from your game's economy state
-    // In production, use FJsonObject for proper serialization
+    // One writer for both routes: the WebSocket message is the HTTP body plus its type
+    auto WriteBody = [&](FAgentEJsonWriter& Writer, bool bTyped) {
+        Writer.BeginObject();
+        if (bTyped)
+        {
+            Writer.Key("type");
+            Writer.Value(bApprove ? "approve" : "reject");
+        }
+        Writer.Key("decisionId");
+        Writer.Value(FStringView(DecisionId));
+        if (!bApprove && !Reason.IsEmpty())
+        {
+            Writer.Key("reason");
+            Writer.Value(FStringView(Reason));
+        }
+        Writer.EndObject();
+    };
 
-    return FString::Printf(TEXT(R"({
-        "tick": %d,
-        "roles": ["role_a", "role_b", "role_c"],
-        "resources": ["resource_x", "resource_y"],
-        "currencies": ["currency_a"],
-        "agentBalances": {
-            "agent_1": { "currency_a": 150 },
-            "agent_2": { "currency_a": 80 }
-        },
-        "agentRoles": {
-            "agent_1": "role_a",
-            "agent_2": "role_b"
-        },
-        "agentInventories": {
-            "agent_1": { "resource_x": 2 },
-            "agent_2": { "resource_y": 5 }
-        },
-        "marketPrices": {
-            "currency_a": { "resource_x": 15, "resource_y": 50 }
-        },
-        "recentTransactions": []
-    })"), TickCounter);
+    DecisionsSentAt.Add(DecisionId, FPlatformTime::Seconds());
+    FAgentEJsonWriter Writer;
+    if (ActiveTransport.IsValid())
+    {
+        WriteBody(Writer, /*bTyped*/ true);
+        if (ActiveTransport->SendControl(Writer.GetBuffer()))
+        {
+            return; // decision_result comes back through HandleControlReply
+        }
+        Writer.Reset();
+    }
+    WriteBody(Writer, /*bTyped*/ false);
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request =
+        FHttpModule::Get().CreateRequest();
+
+    Request->SetURL(ServerUrl + (bApprove ? TEXT("/approve") : TEXT("/reject")));
+    Request->SetVerb(TEXT("POST"));
+    Request->SetHeader(TEXT("Content-Type"), TEXT("application/json; charset=utf-8"));
+    Request->SetContent(Writer.GetBuffer());
+    TWeakObjectPtr<UAgentEClient> WeakThis(this);
+    Request->OnProcessRequestComplete().BindLambda(
+        [WeakThis, DecisionId, bApprove](FHttpRequestPtr, FHttpResponsePtr Response, bool bSuccess) {
+            if (UAgentEClient* This = WeakThis.Get())
+            {
+                This->OnDecisionResponse(DecisionId, bApprove, Response, bSuccess);
+            }
+        });
+
+    Request->ProcessRequest();
 }
 
-// ─── Response Handling ──────────────────────────────────────────────────────
+// ─── Offline Spool ──────────────────────────────────────────────────────────
 
-void UAgentEClient::HandleTickResponse(FHttpResponsePtr Response, bool bSuccess)
+bool UAgentEClient::TickSpool(float DeltaTime)
 {
-    if (!bSuccess || !Response.IsValid())
+    FAgentESendContext& Ctx = *SendContext;
+    const double Now = FPlatformTime::Seconds();
+    if (Ctx.bServerUnreachable.load())
     {
-        UE_LOG(LogTemp, Warning, TEXT("[AgentE] Tick request failed"));
-        return;
+        if (Now >= NextProbeTime)
+        {
+            NextProbeTime = Now + SpoolProbeInterval;
+            RequestHealth(/*bBypassCache*/ true);
+        }
+        return true;
     }
+    if (Ctx.bReplayInFlight.load() && Now - ReplayStartTime >= InFlightTimeout)
+    {
+        // Same presumption as a live send: no reply this long means lost, so retry
+        UE_LOG(LogTemp, Warning, TEXT("[AgentE] No reply to a replayed tick for %.1fs, retrying"), Now - ReplayStartTime);
+        Ctx.InFlight = 0;
+        Ctx.bReplayInFlight = false;
+    }
+    if (Ctx.SpoolPending.load() > 0 && !Ctx.bReplayInFlight.load() && Now >= NextReplayTime)
+    {
+        NextReplayTime = Now + SpoolReplayInterval * ReplayBackoff;
+        ReplayStartTime = Now;
+        ReplaySpooled();
+    }
+    return true;
+}
 
-    TSharedPtr<FJsonObject> JsonObject;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(
-        Response->GetContentAsString());
-
-    if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+void UAgentEClient::ReplaySpooled()
+{
+    TSharedRef<FAgentESendContext, ESPMode::ThreadSafe> Context = SendContext;
+    if (!ActiveTransport.IsValid())
     {
-        UE_LOG(LogTemp, Warning, TEXT("[AgentE] Failed to parse response"));
         return;
     }
+    TSharedRef<IAgentETransport, ESPMode::ThreadSafe> Link = ActiveTransport.ToSharedRef();
+    const int32 CompressAbove = bCompressTicks && Link->SupportsCompression() ? CompressionThresholdBytes : -1;
+    Context->bReplayInFlight = true;
 
-    // Update health
-    LastHealth = JsonObject->GetIntegerField(TEXT("health"));
-    UE_LOG(LogTemp, Log, TEXT("[AgentE] Health: %d/100"), LastHealth);
-
-    // Process adjustments
-    const TArray<TSharedPtr<FJsonValue>>* Adjustments;
-    if (JsonObject->TryGetArrayField(TEXT("adjustments"), Adjustments))
-    {
-        for (const auto& AdjValue : *Adjustments)
+    // One record per call, oldest first, on the same chain as live sends
+    LastSendTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+        [Context, Link, CompressAbove]()
         {
-            TSharedPtr<FJsonObject> Adj = AdjValue->AsObject();
-            if (Adj.IsValid())
+            FAgentESendContext& Ctx = *Context;
+            if (Ctx.bReplayDone.exchange(false))
             {
-                FString Key = Adj->GetStringField(TEXT("key"));
-                float Value = Adj->GetNumberField(TEXT("value"));
+                Ctx.Spool.Pop();
+            }
 
-                UE_LOG(LogTemp, Log, TEXT("[AgentE] Adjust %s -> %f"), *Key, Value);
-                OnAdjustmentReceived.Broadcast(Key, Value);
+            EAgentESpoolRecord Kind = EAgentESpoolRecord::Tick;
+            int64 Seq = 0;
+            if (!Ctx.Spool.Peek(Kind, Seq, Ctx.ReplayBody))
+            {
+                Ctx.SpoolPending = Ctx.Spool.Num();
+                if (Ctx.Spool.IsEmpty())
+                {
+                    // Live sends resume on top of whatever the replay left as the server's base
+                    Ctx.bForceFullSnapshot = true;
+                    Ctx.bResetWireNames = true;
+                    UE_LOG(LogTemp, Log, TEXT("[AgentE] Spool replayed"));
+                }
+                Ctx.bReplayInFlight = false;
+                return;
             }
-        }
-    }
 
-    // Process alerts
-    const TArray<TSharedPtr<FJsonValue>>* Alerts;
-    if (JsonObject->TryGetArrayField(TEXT("alerts"), Alerts))
-    {
-        for (const auto& AlertValue : *Alerts)
-        {
-            TSharedPtr<FJsonObject> Alert = AlertValue->AsObject();
-            if (Alert.IsValid())
+            if (Kind == EAgentESpoolRecord::Events)
             {
-                FString Principle = Alert->GetStringField(TEXT("principle"));
-                FString Name = Alert->GetStringField(TEXT("name"));
-                int32 Severity = Alert->GetIntegerField(TEXT("severity"));
+                // Event batches get no reply to wait for
+                Link->SendEvents(Ctx.ReplayBody);
+                Ctx.Stats.AddEventsSent(Ctx.ReplayBody.Num());
+                Ctx.Spool.Pop();
+                Ctx.SpoolPending = Ctx.Spool.Num();
+                Ctx.bReplayInFlight = false;
+                return;
+            }
 
-                OnAlertReceived.Broadcast(Principle, Name, Severity);
+            const int32 Pending = Ctx.InFlight.fetch_add(1);
+            if (Pending == 0)
+            {
+                Ctx.LastProgressTime = FPlatformTime::Seconds();
             }
+            Ctx.Stats.SetInFlight(Pending + 1);
+            Ctx.SentAt[Seq % 16] = FPlatformTime::Seconds();
+            Ctx.SentSeq[Seq % 16] = Seq;
+            SendTickBody(Ctx, *Link, Ctx.ReplayBody, CompressAbove);
+        },
+        UE::Tasks::Prerequisites(LastSendTask));
+}
+
+// ─── Response Handling ──────────────────────────────────────────────────────
+//
+// One pull parser for both wire formats: FAgentEJsonReader and
+// FAgentEMsgPackReader share method names, so the field dispatch below is
+// written once. Only health, seq, tick, adjustments, alerts and warnings
+// (plus type/message/code/replyTo for WebSocket frames) are read; everything else —
+// decisions, metrics, alert evidence, ... — is skipped without being built.
+// Keys are matched as UTF-8 views and names resolve to FAgentEKeyTable
+// handles, so a reply allocates nothing once its keys have been seen.
+
+/** The "type" field of a reply; HTTP bodies have none */
+enum class EAgentEReplyType : uint8
+{
+    None,
+    TickResult,
+    ValidationWarning,
+    Error,
+    ValidationError,
+    ControlResult,
+    Push,
+    Other,
+};
+
+static EAgentEReplyType ReplyTypeOf(FUtf8StringView Type)
+{
+    if (AgentEKeyIs(Type, "tick_result")) return EAgentEReplyType::TickResult;
+    if (AgentEKeyIs(Type, "validation_warning")) return EAgentEReplyType::ValidationWarning;
+    if (AgentEKeyIs(Type, "error")) return EAgentEReplyType::Error;
+    if (AgentEKeyIs(Type, "validation_error")) return EAgentEReplyType::ValidationError;
+    if (AgentEKeyIs(Type, "health_result") || AgentEKeyIs(Type, "decision_result")) return EAgentEReplyType::ControlResult;
+    if (AgentEKeyIs(Type, "adjustment") || AgentEKeyIs(Type, "alert")) return EAgentEReplyType::Push;
+    return EAgentEReplyType::Other;
+}
+
+/** Calls Fn(Key) for each field of the next map; Fn must consume the value */
+template <typename FieldFn>
+static bool ForEachField(FAgentEMsgPackReader& R, FieldFn&& Fn)
+{
+    uint32 Fields = 0;
+    if (!R.ReadMapHeader(Fields))
+    {
+        return false;
+    }
+    for (uint32 F = 0; F < Fields && !R.HasError(); ++F)
+    {
+        FUtf8StringView Key;
+        if (R.ReadStringView(Key))
+        {
+            Fn(Key);
         }
     }
+    return !R.HasError();
 }
+
+template <typename FieldFn>
+static bool ForEachField(FAgentEJsonReader& R, FieldFn&& Fn)
+{
+    if (!R.BeginObject())
+    {
+        return false;
+    }
+    FUtf8StringView Key;
+    while (R.NextKey(Key))
+    {
+        Fn(Key);
+    }
+    return !R.HasError();
+}
+
+/** Calls Fn() for each element of the next array; Fn must consume it */
+template <typename ElementFn>
+static bool ForEachElement(FAgentEMsgPackReader& R, ElementFn&& Fn)
+{
+    uint32 Count = 0;
+    if (!R.ReadArrayHeader(Count))
+    {
+        return false;
+    }
+    for (uint32 I = 0; I < Count && !R.HasError(); ++I)
+    {
+        Fn();
+    }
+    return !R.HasError();
+}
+
+template <typename ElementFn>
+static bool ForEachElement(FAgentEJsonReader& R, ElementFn&& Fn)
+{
+    if (!R.BeginArray())
+    {
+        return false;
+    }
+    while (R.NextElement())
+    {
+        Fn();
+    }
+    return !R.HasError();
+}
+
+template <typename ReaderT>
+static bool ReadKeyHandle(ReaderT& R, FAgentEKeyTable& Keys, int32& OutHandle)
+{
+    FUtf8StringView View;
+    if (!R.ReadStringView(View))
+    {
+        return false;
+    }
+    OutHandle = Keys.FindOrAdd(View);
+    return true;
+}
+
+template <typename ReaderT>
+static bool ReadAdjustments(ReaderT& R, FAgentEKeyTable& Keys, FAgentETickResult& Out)
+{
+    return ForEachElement(R, [&]() {
+        FAgentEParsedAdjustment Entry;
+        bool bHaveParameter = false;
+        ForEachField(R, [&](FUtf8StringView Key) {
+            double Number = 0.0;
+            const bool bParameter = AgentEKeyIs(Key, "parameter");
+            // Older servers sent "key" instead of "parameter"
+            if (bParameter || (AgentEKeyIs(Key, "key") && !bHaveParameter))
+            {
+                bHaveParameter |= bParameter;
+                ReadKeyHandle(R, Keys, Entry.Parameter);
+            }
+            else if (AgentEKeyIs(Key, "value") && R.ReadNumber(Number))
+            {
+                Entry.Value = float(Number);
+            }
+            else if (AgentEKeyIs(Key, "principle"))
+            {
+                ReadKeyHandle(R, Keys, Entry.Principle);
+            }
+            else
+            {
+                R.Skip();
+            }
+        });
+        if (Entry.Parameter != INDEX_NONE)
+        {
+            Out.Adjustments.Add(Entry);
+        }
+    });
+}
+
+template <typename ReaderT>
+static bool ReadAlerts(ReaderT& R, FAgentEKeyTable& Keys, FAgentETickResult& Out)
+{
+    return ForEachElement(R, [&]() {
+        FAgentEParsedAlert Entry;
+        ForEachField(R, [&](FUtf8StringView Key) {
+            double Number = 0.0;
+            if (AgentEKeyIs(Key, "principleId"))
+            {
+                ReadKeyHandle(R, Keys, Entry.Principle);
+            }
+            else if (AgentEKeyIs(Key, "principleName"))
+            {
+                ReadKeyHandle(R, Keys, Entry.Name);
+            }
+            else if (AgentEKeyIs(Key, "severity") && R.ReadNumber(Number))
+            {
+                Entry.Severity = int32(Number);
+            }
+            else
+            {
+                R.Skip();
+            }
+        });
+        if (Entry.Principle != INDEX_NONE)
+        {
+            Out.Alerts.Add(Entry);
+        }
+    });
+}
+
+/** Warnings are rare and free-form, so they stay FStrings */
+template <typename ReaderT>
+static bool ReadWarnings(ReaderT& R, FAgentETickResult& Out)
+{
+    return ForEachElement(R, [&]() {
+        TPair<FString, FString>& Entry = Out.Warnings.AddDefaulted_GetRef();
+        ForEachField(R, [&](FUtf8StringView Key) {
+            if (AgentEKeyIs(Key, "path"))
+            {
+                R.ReadString(Entry.Key);
+            }
+            else if (AgentEKeyIs(Key, "message"))
+            {
+                R.ReadString(Entry.Value);
+            }
+            else
+            {
+                R.Skip();
+            }
+        });
+    });
+}
+
+/** What the top level says beyond the tick outcome; keys may come in any order */
+struct FAgentEReplyFields
+{
+    EAgentEReplyType Type = EAgentEReplyType::None;
+    bool bHasHealth = false;
+    bool bRateLimitedCode = false;
+
+    /** An error carrying replyTo "tick": the answer to a tick send */
+    bool bReplyToTick = false;
+
+    /** Error replies only */
+    FString Message;
+};
+
+template <typename ReaderT>
+static bool ReadReply(ReaderT& R, FAgentEKeyTable& Keys, FAgentETickResult& Out, FAgentEReplyFields& Fields)
+{
+    return ForEachField(R, [&](FUtf8StringView Key) {
+        double Number = 0.0;
+        FUtf8StringView View;
+        if (AgentEKeyIs(Key, "type"))
+        {
+            if (R.ReadStringView(View))
+            {
+                Fields.Type = ReplyTypeOf(View);
+            }
+        }
+        else if (AgentEKeyIs(Key, "message"))
+        {
+            R.ReadString(Fields.Message);
+        }
+        else if (AgentEKeyIs(Key, "code"))
+        {
+            if (R.ReadStringView(View))
+            {
+                Fields.bRateLimitedCode = AgentEKeyIs(View, "rate_limited");
+            }
+        }
+        else if (AgentEKeyIs(Key, "replyTo"))
+        {
+            if (R.ReadStringView(View))
+            {
+                Fields.bReplyToTick = AgentEKeyIs(View, "tick");
+            }
+        }
+        else if (AgentEKeyIs(Key, "health") && R.ReadNumber(Number))
+        {
+            Out.Health = int32(Number);
+            Fields.bHasHealth = true;
+        }
+        else if (AgentEKeyIs(Key, "seq") && R.ReadNumber(Number))
+        {
+            Out.Seq = int64(Number);
+        }
+        else if (AgentEKeyIs(Key, "tick") && R.ReadNumber(Number))
+        {
+            Out.Tick = int64(Number);
+        }
+        else if (AgentEKeyIs(Key, "processingMs") && R.ReadNumber(Number))
+        {
+            Out.ServerMs = Number;
+        }
+        else if (AgentEKeyIs(Key, "adjustments"))
+        {
+            ReadAdjustments(R, Keys, Out);
+        }
+        else if (AgentEKeyIs(Key, "alerts"))
+        {
+            ReadAlerts(R, Keys, Out);
+        }
+        else if (AgentEKeyIs(Key, "validationWarnings"))
+        {
+            ReadWarnings(R, Out);
+        }
+        else
+        {
+            R.Skip();
+        }
+    });
+}
+
+bool AgentEParseTickReply(
+    TConstArrayView<uint8> Body, bool bBinary, FAgentEKeyTable& Keys, FAgentETickResult& Out, bool& bOutResync)
+{
+    FAgentEReplyFields Fields;
+    bOutResync = false;
+
+    if (bBinary)
+    {
+        FAgentEMsgPackReader R(Body.GetData(), Body.Num());
+        if (!ReadReply(R, Keys, Out, Fields))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        FAgentEJsonReader R(Body.GetData(), Body.Num());
+        if (!ReadReply(R, Keys, Out, Fields))
+        {
+            return false;
+        }
+    }
+
+    switch (Fields.Type)
+    {
+    case EAgentEReplyType::None:
+    case EAgentEReplyType::TickResult:
+        Out.bHasTick = Fields.bHasHealth;
+        return true;
+
+    case EAgentEReplyType::ValidationWarning:
+        // Precedes the tick_result for the same send
+        Out.bTickReply = false;
+        return true;
+
+    case EAgentEReplyType::Error:
+        if (!Fields.bReplyToTick)
+        {
+            // About events, a chunk or an unknown message: no tick is answered,
+            // so no slot is freed, no resync and no backoff
+            Out = FAgentETickResult();
+            Out.bTickReply = false;
+            Out.Error = MoveTemp(Fields.Message);
+            return true;
+        }
+        {
+            const int64 Seq = Out.Seq;
+            Out = FAgentETickResult();
+            Out.Seq = Seq;
+        }
+        Out.Error = MoveTemp(Fields.Message);
+        Out.bRateLimited = Fields.bRateLimitedCode || Out.Error.StartsWith(TEXT("Rate limited"));
+        // A rate-limited JSON tick was dropped, so the delta base never reached the
+        // server; a binary frame was decoded (names applied) before the check
+        bOutResync = !bBinary || !Out.bRateLimited;
+        return true;
+
+    case EAgentEReplyType::ValidationError:
+        Out = FAgentETickResult();
+        Out.Error = TEXT("Server rejected state (validation_error)");
+        bOutResync = true;
+        return true;
+
+    case EAgentEReplyType::ControlResult:
+        Out = FAgentETickResult();
+        Out.bTickReply = false;
+        Out.bControlReply = true;
+        return true;
+
+    case EAgentEReplyType::Push:
+        // Same adjustments / alerts arrays as a tick reply; tick is the economy's latest
+        Out.bTickReply = false;
+        Out.bPush = true;
+        return true;
+
+    default:
+        // events_ack, narration, ... are not tick replies
+        Out = FAgentETickResult();
+        Out.bTickReply = false;
+        return true;
+    }
+}
+
+/** Reads Key's value if it is a GET /health field (health, tick, mode, activePlans, uptime in ms) */
+static bool ReadHealthField(FAgentEJsonReader& R, FUtf8StringView Key, FAgentEHealthInfo& Out, bool& bOutHaveHealth)
+{
+    double Number = 0.0;
+    if (AgentEKeyIs(Key, "mode"))
+    {
+        R.ReadString(Out.Mode);
+        return true;
+    }
+    if (!AgentEKeyIs(Key, "health") && !AgentEKeyIs(Key, "tick")
+        && !AgentEKeyIs(Key, "activePlans") && !AgentEKeyIs(Key, "uptime"))
+    {
+        return false;
+    }
+    if (R.ReadNumber(Number))
+    {
+        if (AgentEKeyIs(Key, "health")) { Out.Health = int32(Number); bOutHaveHealth = true; }
+        else if (AgentEKeyIs(Key, "tick")) { Out.Tick = int32(Number); }
+        else if (AgentEKeyIs(Key, "activePlans")) { Out.ActivePlans = int32(Number); }
+        else { Out.UptimeSeconds = float(Number / 1000.0); }
+    }
+    return true;
+}
+
+/** GET /health body */
+static bool ParseHealthReply(TConstArrayView<uint8> Body, FAgentEHealthInfo& Out)
+{
+    FAgentEJsonReader R(Body.GetData(), Body.Num());
+    bool bHaveHealth = false;
+    const bool bOk = ForEachField(R, [&](FUtf8StringView Key) {
+        if (!ReadHealthField(R, Key, Out, bHaveHealth))
+        {
+            R.Skip();
+        }
+    });
+    return bOk && bHaveHealth;
+}
+
+/** A health_result or decision_result message, or a POST /approve | /reject body */
+struct FAgentEControlReply
+{
+    bool bDecision = false;
+
+    FAgentEHealthInfo Health;
+    bool bHaveHealth = false;
+    bool bNotModified = false;
+    FString ETag;
+
+    FString DecisionId;
+    bool bApproved = false;
+    int32 Status = 0;
+    FString Error;
+};
+
+static bool ParseControlReply(TConstArrayView<uint8> Body, FAgentEControlReply& Out)
+{
+    FAgentEJsonReader R(Body.GetData(), Body.Num());
+    return ForEachField(R, [&](FUtf8StringView Key) {
+        double Number = 0.0;
+        FUtf8StringView View;
+        if (ReadHealthField(R, Key, Out.Health, Out.bHaveHealth))
+        {
+            return;
+        }
+        if (AgentEKeyIs(Key, "type"))
+        {
+            if (R.ReadStringView(View))
+            {
+                Out.bDecision = AgentEKeyIs(View, "decision_result");
+            }
+        }
+        else if (AgentEKeyIs(Key, "action"))
+        {
+            if (R.ReadStringView(View))
+            {
+                Out.bApproved = AgentEKeyIs(View, "approve");
+            }
+        }
+        else if (AgentEKeyIs(Key, "notModified"))
+        {
+            R.ReadBool(Out.bNotModified);
+        }
+        else if (AgentEKeyIs(Key, "etag"))
+        {
+            R.ReadString(Out.ETag);
+        }
+        else if (AgentEKeyIs(Key, "decisionId"))
+        {
+            R.ReadString(Out.DecisionId);
+        }
+        else if (AgentEKeyIs(Key, "error"))
+        {
+            R.ReadString(Out.Error);
+        }
+        else if (AgentEKeyIs(Key, "status") && R.ReadNumber(Number))
+        {
+            Out.Status = int32(Number);
+        }
+        else
+        {
+            R.Skip();
+        }
+    });
+}
+
+void UAgentEClient::OnHealthResponse(FHttpResponsePtr Response, bool bSuccess)
+{
+    bHealthRequestInFlight = false;
+    if (!bSuccess || !Response.IsValid())
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("[AgentE] Health check failed"));
+        return;
+    }
+
+    const int32 Code = Response->GetResponseCode();
+    if (Code == EHttpResponseCodes::NotModified)
+    {
+        ApplyHealth(nullptr, HealthETag);
+        return;
+    }
+    FAgentEHealthInfo Info;
+    if (!EHttpResponseCodes::IsOk(Code) || !ParseHealthReply(Response->GetContent(), Info))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[AgentE] Health check failed (%d)"), Code);
+        return;
+    }
+    ApplyHealth(&Info, Response->GetHeader(TEXT("ETag")));
+}
+
+/** Info is null when the server confirmed the cached result (304, notModified) */
+void UAgentEClient::ApplyHealth(const FAgentEHealthInfo* Info, const FString& ETag)
+{
+    const double Now = FPlatformTime::Seconds();
+    SendContext->Stats.AddStage(EAgentEStage::ControlRoundTrip, Now - HealthSentAt);
+    if (!Info)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("[AgentE] Health unchanged"));
+    }
+    else
+    {
+        HealthInfo = *Info;
+        HealthInfo.bValid = true;
+        HealthETag = ETag;
+        LastHealth.store(HealthInfo.Health, std::memory_order_relaxed);
+        UE_LOG(LogTemp, Log, TEXT("[AgentE] Health: %d/100 (tick %d, %s, %d active plans)"),
+            HealthInfo.Health, HealthInfo.Tick, *HealthInfo.Mode, HealthInfo.ActivePlans);
+    }
+    HealthCheckedAt = Now;
+
+    // Any answer means the server is back; the spool starts replaying
+    FAgentESendContext& Ctx = *SendContext;
+    if (Ctx.bServerUnreachable.exchange(false))
+    {
+        UE_LOG(LogTemp, Log, TEXT("[AgentE] Server reachable again, replaying %d spooled records"),
+            Ctx.SpoolPending.load());
+    }
+
+    if (HealthInfo.bValid)
+    {
+        OnHealthChecked.Broadcast(GetLastHealthInfo());
+    }
+}
+
+void UAgentEClient::OnDecisionResponse(const FString& DecisionId, bool bApprove, FHttpResponsePtr Response, bool bSuccess)
+{
+    if (!bSuccess || !Response.IsValid())
+    {
+        ApplyDecisionResult(DecisionId, bApprove, 0, TEXT("request_failed"));
+        return;
+    }
+    FAgentEControlReply Reply;
+    ParseControlReply(Response->GetContent(), Reply);
+    ApplyDecisionResult(DecisionId, bApprove, Response->GetResponseCode(), Reply.Error);
+}
+
+void UAgentEClient::ApplyDecisionResult(const FString& DecisionId, bool bApproved, int32 Status, const FString& Error)
+{
+    double SentAt = 0.0;
+    if (DecisionsSentAt.RemoveAndCopyValue(DecisionId, SentAt) && Status != 0)
+    {
+        SendContext->Stats.AddStage(EAgentEStage::ControlRoundTrip, FPlatformTime::Seconds() - SentAt);
+    }
+    if (EHttpResponseCodes::IsOk(Status))
+    {
+        UE_LOG(LogTemp, Log, TEXT("[AgentE] Decision %s %s"), *DecisionId, bApproved ? TEXT("approved") : TEXT("rejected"));
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[AgentE] Decision %s not %s (%d): %s"), *DecisionId,
+            bApproved ? TEXT("approved") : TEXT("rejected"), Status, *Error);
+    }
+    OnDecisionResult.Broadcast(DecisionId, bApproved, Status, Error);
+}
+
+void UAgentEClient::HandleControlReply(TConstArrayView<uint8> Body)
+{
+    FAgentEControlReply Reply;
+    if (!ParseControlReply(Body, Reply))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[AgentE] Failed to parse control reply"));
+        return;
+    }
+    if (Reply.bDecision)
+    {
+        ApplyDecisionResult(Reply.DecisionId, Reply.bApproved, Reply.Status, Reply.Error);
+        return;
+    }
+
+    bHealthRequestInFlight = false;
+    if (Reply.bNotModified)
+    {
+        ApplyHealth(nullptr, HealthETag);
+    }
+    else if (Reply.bHaveHealth)
+    {
+        ApplyHealth(&Reply.Health, Reply.ETag);
+    }
+}
+
+/** True when a newer reply was already applied. Otherwise records this one as newest. */
+static bool IsStaleReply(FAgentESendContext& Ctx, const FAgentETickResult& Result)
+{
+    // seq is per send; tick is the fallback for servers that don't echo it
+    std::atomic<int64>& Newest = Result.Seq >= 0 ? Ctx.LastAppliedSeq : Ctx.LastAppliedTick;
+    const int64 Key = Result.Seq >= 0 ? Result.Seq : Result.Tick;
+    if (Key < 0)
+    {
+        return false;
+    }
+    int64 Prev = Newest.load();
+    do
+    {
+        if (Key <= Prev)
+        {
+            return true;
+        }
+    } while (!Newest.compare_exchange_weak(Prev, Key));
+    return false;
+}
+
+void UAgentEClient::HandleTickResponse(
+    TWeakObjectPtr<UAgentEClient> WeakThis, const TSharedRef<FAgentESendContext, ESPMode::ThreadSafe>& Context,
+    int32 StatusCode, TConstArrayView<uint8> Body, bool bBinary)
+{
+    FAgentETickResult Result;
+
+    // While the spool drains, the only tick on the wire is the replayed one
+    const bool bReplay = Context->bReplayInFlight.load();
+
+    if (StatusCode == 0)
+    {
+        // The server may not have this snapshot (or its new names) — don't build on it
+        Context->bForceFullSnapshot = true;
+        Context->bResetWireNames = true;
+        Result.Error = TEXT("Tick request failed");
+        if (Context->bSpoolOpen.load() && !Context->bServerUnreachable.exchange(true))
+        {
+            Context->bSpoolLastSent = !bReplay;
+            UE_LOG(LogTemp, Warning, TEXT("[AgentE] Server unreachable, spooling ticks until it answers"));
+        }
+    }
+    else if (StatusCode == 409)
+    {
+        // delta_base_mismatch or dictionary_mismatch
+        Context->bForceFullSnapshot = true;
+        Context->bResetWireNames = true;
+        UE_LOG(LogTemp, Log, TEXT("[AgentE] Server out of sync, next send is a full snapshot"));
+    }
+    else if (!EHttpResponseCodes::IsOk(StatusCode))
+    {
+        Context->bForceFullSnapshot = true;
+        Context->bResetWireNames = true;
+        Result.Error = FString::Printf(TEXT("Tick rejected (%d): %s"), StatusCode,
+            bBinary ? TEXT("<binary>") : *FString(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Body.GetData()), Body.Num())));
+    }
+    else
+    {
+        AGENTE_STAGE_SCOPE(Context->Stats, Parse);
+        bool bResync = false;
+        if (!AgentEParseTickReply(Body, bBinary, Context->Keys, Result, bResync))
+        {
+            Result = FAgentETickResult();
+            Result.Error = bBinary ? TEXT("Failed to parse binary response") : TEXT("Failed to parse response");
+        }
+        if (bResync)
+        {
+            Context->bForceFullSnapshot = true;
+            if (bBinary)
+            {
+                Context->bResetWireNames = true;
+            }
+        }
+    }
+
+    if (Result.bControlReply)
+    {
+        // Small and rare: copied, and parsed on the game thread with the state it updates
+        auto Handle = [WeakThis, Reply = TArray<uint8>(Body)]() {
+            if (UAgentEClient* This = WeakThis.Get())
+            {
+                This->HandleControlReply(Reply);
+            }
+        };
+        if (IsInGameThread())
+        {
+            Handle();
+        }
+        else
+        {
+            AsyncTask(ENamedThreads::GameThread, MoveTemp(Handle));
+        }
+        return;
+    }
+
+    if (Result.Seq >= 0 && Context->SentSeq[Result.Seq % 16].load() == Result.Seq)
+    {
+        Result.RttSeconds = FPlatformTime::Seconds() - Context->SentAt[Result.Seq % 16].load();
+        Context->Stats.AddStage(EAgentEStage::RoundTrip, Result.RttSeconds);
+    }
+    if (Result.bTickReply && Result.ServerMs >= 0.0)
+    {
+        Context->Stats.AddStage(EAgentEStage::ServerProcessing, Result.ServerMs / 1000.0);
+    }
+
+    if (bReplay && Result.bTickReply)
+    {
+        // Accepted or rejected for good: the record is done. Otherwise it is retried.
+        Context->bReplayDone = StatusCode != 0 && StatusCode < 500 && !Result.bRateLimited;
+        Context->bReplayInFlight = false;
+        Result.bReplay = true;
+    }
+
+    if (Result.bTickReply)
+    {
+        int32 Pending = Context->InFlight.load();
+        while (Pending > 0 && !Context->InFlight.compare_exchange_weak(Pending, Pending - 1))
+        {
+        }
+        Context->LastProgressTime = FPlatformTime::Seconds();
+        Context->Stats.SetInFlight(FMath::Max(Pending - 1, 0));
+        Context->Stats.AddReply(Body.Num(), !EHttpResponseCodes::IsOk(StatusCode) || !Result.Error.IsEmpty(), Result.bRateLimited);
+    }
+
+    // With several sends in flight, replies can overtake each other
+    if (Result.bHasTick && IsStaleReply(*Context, Result))
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("[AgentE] Dropping stale reply (seq %lld, tick %lld)"), Result.Seq, Result.Tick);
+        Result.bHasTick = false;
+    }
+
+    if (!Result.bTickReply && !Result.bHasTick && !Result.bPush && Result.Warnings.IsEmpty() && Result.Error.IsEmpty())
+    {
+        return;
+    }
+
+    auto Apply = [WeakThis, Result = MoveTemp(Result)]() {
+        if (UAgentEClient* This = WeakThis.Get())
+        {
+            This->ApplyTickResult(Result);
+            if (Result.bTickReply)
+            {
+                This->OnTickSlotFreed();
+            }
+        }
+    };
+    if (IsInGameThread())
+    {
+        Apply();
+    }
+    else
+    {
+        AsyncTask(ENamedThreads::GameThread, MoveTemp(Apply));
+    }
+}
+
+void UAgentEClient::OnTickSlotFreed()
+{
+    if (bSendQueued)
+    {
+        SendTick();
+    }
+}
+
+void UAgentEClient::ApplyTickResult(const FAgentETickResult& Result)
+{
+    if (Result.bTickReply)
+    {
+        OnTickReply.Broadcast(Result);
+    }
+
+    AGENTE_STAGE_SCOPE(SendContext->Stats, Dispatch);
+
+    // Cadence first, so the next send is spaced by what this reply says
+    if (Result.bRateLimited)
+    {
+        Cadence.OnBackoff(2.f);
+    }
+    else if (Result.bTickReply && !Result.Error.IsEmpty())
+    {
+        Cadence.OnBackoff(1.25f);
+    }
+    Cadence.OnRoundTrip(Result.RttSeconds);
+    if (Result.bReplay)
+    {
+        ReplayBackoff = Result.bRateLimited ? FMath::Min(ReplayBackoff * 2.f, 32.f) : 1.f;
+    }
+    if (Result.bHasTick && !Result.bReplay)
+    {
+        int32 MaxSeverity = 0;
+        for (const FAgentEParsedAlert& Alert : Result.Alerts)
+        {
+            MaxSeverity = FMath::Max(MaxSeverity, Alert.Severity);
+        }
+        Cadence.OnTickResult(Result.Health, MaxSeverity);
+    }
+
+    if (!Result.Error.IsEmpty())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[AgentE] %s"), *Result.Error);
+        if (Result.bTickReply)
+        {
+            OnTickError.Broadcast(Result.Error);
+        }
+    }
+
+    for (const TPair<FString, FString>& Warning : Result.Warnings)
+    {
+        UE_LOG(LogTemp, Log, TEXT("[AgentE] Validation warning %s: %s"), *Warning.Key, *Warning.Value);
+        OnValidationWarning.Broadcast(Warning.Key, Warning.Value);
+    }
+
+    if (Result.bPush)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("[AgentE] Pushed: %d adjustments, %d alerts (tick %lld)"),
+            Result.Adjustments.Num(), Result.Alerts.Num(), Result.Tick);
+        DeliverServerResult(Result);
+        return;
+    }
+
+    // A replayed tick's health and adjustments describe an economy that has moved on
+    if (!Result.bHasTick || Result.bReplay)
+    {
+        return;
+    }
+
+    // Update health
+    LastHealth.store(Result.Health, std::memory_order_relaxed);
+    UE_LOG(LogTemp, Log, TEXT("[AgentE] Health: %d/100"), Result.Health);
+    DeliverServerResult(Result);
+}
+
+void UAgentEClient::DeliverServerResult(const FAgentETickResult& Result)
+{
+    // The server is authoritative again: undo the local rules' moves before its own plan lands
+    if (LocalRules.HasLocalChanges() || bLocalRulesEngaged)
+    {
+        LocalDecisions.Reset();
+        LocalRules.TakeRestores(LocalDecisions);
+        UE_LOG(LogTemp, Log, TEXT("[AgentE] Server answering again, restoring %d locally adjusted parameters"),
+            LocalDecisions.Num());
+        for (const TPair<int32, float>& Restore : LocalDecisions)
+        {
+            DeliverAdjustment(Restore.Key, Restore.Value);
+        }
+        bLocalRulesEngaged = false;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    for (const FAgentEParsedAdjustment& Adj : Result.Adjustments)
+    {
+        LocalRules.RecordServer(Adj.Parameter, Adj.Value, Adj.Principle, Result.Tick, Now);
+        DeliverAdjustment(Adj.Parameter, Adj.Value);
+    }
+
+    // Alerts follow the adjustments, through the queue whenever adjustments use it
+    const bool bQueued = AdjustmentFrameBudgetMs > 0.f || AdjustmentInterpolationFrames > 1;
+    for (const FAgentEParsedAlert& Alert : Result.Alerts)
+    {
+        if (bQueued)
+        {
+            AdjustmentQueue.EnqueueAlert(Alert.Principle, Alert.Name, Alert.Severity);
+        }
+        else
+        {
+            ApplyAlert(Alert.Principle, Alert.Name, Alert.Severity);
+        }
+    }
+}
+
+void UAgentEClient::RunLocalRules(double Now)
+{
+    FAgentESendContext& Ctx = *SendContext;
+
+    // Every send opens a new window, so the flows cover the time since the previous one
+    LocalFlowsScratch.Reset();
+    {
+        FScopeLock Lock(&Ctx.LocalFlowsLock);
+        Swap(LocalFlowsScratch, Ctx.LocalFlows);
+    }
+    for (const FAgentEEvent& Event : EconomyState.RecentTransactions)
+    {
+        LocalFlowsScratch.Add(Event);
+    }
+
+    const bool bDegraded = Ctx.bServerUnreachable.load()
+        || (Ctx.InFlight.load() > 0 && Now - Ctx.LastProgressTime.load() >= LocalRulesAfterSeconds);
+    if (!bDegraded)
+    {
+        return;
+    }
+    if (!bLocalRulesEngaged)
+    {
+        bLocalRulesEngaged = true;
+        UE_LOG(LogTemp, Warning, TEXT("[AgentE] Server degraded, local rules engaged"));
+    }
+
+    AGENTE_STAGE_SCOPE(Ctx.Stats, LocalRules);
+    LocalDecisions.Reset();
+    LocalRules.Evaluate(EconomyState, LocalFlowsScratch, Now,
+        [this](int32 Parameter, float& OutValue) { return Bindings.TryGetValue(Parameter, OutValue); },
+        LocalDecisions);
+    for (const TPair<int32, float>& Decision : LocalDecisions)
+    {
+        UE_LOG(LogTemp, Log, TEXT("[AgentE] Local rules: %s -> %f"), *Ctx.Keys.GetString(Decision.Key), Decision.Value);
+        DeliverAdjustment(Decision.Key, Decision.Value);
+    }
+}
+
+void UAgentEClient::DeliverAdjustment(int32 Parameter, float Value)
+{
+    if (AdjustmentFrameBudgetMs <= 0.f && AdjustmentInterpolationFrames <= 1)
+    {
+        ApplyAdjustment(Parameter, Value);
+        return;
+    }
+
+    // Queued: TickAdjustmentQueue applies it over the next frames
+    float Current = 0.f;
+    const bool bKnown = AdjustmentInterpolationFrames > 1 && Bindings.TryGetValue(Parameter, Current);
+    AdjustmentQueue.EnqueueAdjustment(Parameter, Value, bKnown ? &Current : nullptr);
+}
+
+bool UAgentEClient::TickAdjustmentQueue(float DeltaTime)
+{
+    if (!AdjustmentQueue.IsEmpty())
+    {
+        AGENTE_STAGE_SCOPE(SendContext->Stats, Dispatch);
+
+        // No budget with interpolation on: every step of every key, once per frame
+        const double Budget = AdjustmentFrameBudgetMs > 0.f ? AdjustmentFrameBudgetMs / 1000.0 : DBL_MAX;
+        AdjustmentQueue.Drain(Budget,
+            [this](int32 Parameter, float Value) { ApplyAdjustment(Parameter, Value); },
+            [this](int32 Principle, int32 Name, int32 Severity) { ApplyAlert(Principle, Name, Severity); });
+    }
+    return true;
+}
+
+void UAgentEClient::ApplyAdjustment(int32 Parameter, float Value)
+{
+    const FString& Key = SendContext->Keys.GetString(Parameter);
+    UE_LOG(LogTemp, Verbose, TEXT("[AgentE] Adjust %s -> %f"), *Key, Value);
+
+    // Bound keys go straight to their owners; the string broadcast is for the rest
+    const bool bBound = Bindings.Dispatch(Parameter, Value);
+    if (!bBound || bBroadcastBoundAdjustments)
+    {
+        OnAdjustmentReceived.Broadcast(Key, Value);
+    }
+}
+
+void UAgentEClient::ApplyAlert(int32 Principle, int32 Name, int32 Severity)
+{
+    const FAgentEKeyTable& Keys = SendContext->Keys;
+    OnAlertReceived.Broadcast(Keys.GetString(Principle), Keys.GetString(Name), Severity);
+}
+
+// ─── Automation Test ────────────────────────────────────────────────────────
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAgentEParseErrorReplyTest, "AgentE.Client.ParseErrorReply",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FAgentEParseErrorReplyTest::RunTest(const FString& Parameters)
+{
+    FAgentEKeyTable Keys;
+    auto Parse = [&Keys](const TCHAR* Json, FAgentETickResult& Out, bool& bOutResync) {
+        const FTCHARToUTF8 Utf8(Json);
+        return AgentEParseTickReply(
+            TConstArrayView<uint8>(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length()), /*bBinary*/ false, Keys, Out, bOutResync);
+    };
+
+    // Errors about events or unknown messages answer no tick
+    for (const TCHAR* Frame : {
+        TEXT(R"({"type":"error","message":"Missing \"events\" array"})"),
+        TEXT(R"({"type":"error","message":"Unknown message type: \"foo\""})"),
+        TEXT(R"({"type":"error","code":"invalid_chunk","message":"Truncated chunk header"})") })
+    {
+        FAgentETickResult Result;
+        bool bResync = true;
+        TestTrue(TEXT("Parsed"), Parse(Frame, Result, bResync));
+        TestFalse(TEXT("Not a tick reply"), Result.bTickReply);
+        TestFalse(TEXT("No resync"), bResync);
+        TestFalse(TEXT("Not rate-limited"), Result.bRateLimited);
+        TestFalse(TEXT("Error kept for the log"), Result.Error.IsEmpty());
+    }
+
+    // A tick's own error still frees its slot
+    FAgentETickResult Result;
+    bool bResync = false;
+    TestTrue(TEXT("Parsed"), Parse(
+        TEXT(R"({"type":"error","replyTo":"tick","seq":7,"code":"rate_limited","message":"Rate limited - min 100ms between ticks"})"),
+        Result, bResync));
+    TestTrue(TEXT("Tick reply"), Result.bTickReply);
+    TestTrue(TEXT("Rate-limited"), Result.bRateLimited);
+    TestEqual(TEXT("Seq echoed"), Result.Seq, int64(7));
+    TestTrue(TEXT("JSON tick dropped, so resync"), bResync);
+    return true;
+}
+
+#endif
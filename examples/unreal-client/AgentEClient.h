@@ -7,8 +7,14 @@
  * Setup:
  *   1. Start AgentE server: npx @agent-e/server --port 3000
  *   2. Add AgentEClient component to an Actor
- *   3. Implement BuildStateJson() with your actual economy data
- *   4. Handle OnAdjustmentReceived to modify your economy params
+ *   3. Fill GetEconomyState() with your economy (SetSchema + AddAgent,
+ *      then write balances/inventories/prices in place as they change;
+ *      look indices up once with FindAgent/FindCurrency and keep them).
+ *      With bTrackChanges, write through SetBalance/AddInventory/SetRole/
+ *      SetPrice instead, so sends only look at what changed.
+ *   4. Call RecordEvent for trades, mints, burns, ... (any thread)
+ *   5. Bind your economy params with BindParameter (or handle
+ *      OnAdjustmentReceived) so adjustments change them
  */
 
 #pragma once
@@ -16,7 +22,24 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Http.h"
-#include "Json.h"
+#include "Tasks/Task.h"
+#include <atomic>
+#include "AgentEEconomyState.h"
+#include "AgentERecycler.h"
+#include "AgentEStateWriter.h"
+#include "AgentEStateSchema.h"
+#include "AgentEMsgPack.h"
+#include "AgentEEventStream.h"
+#include "AgentECadence.h"
+#include "AgentEKeyTable.h"
+#include "AgentEParameterBindings.h"
+#include "AgentEAdjustmentQueue.h"
+#include "AgentELocalRules.h"
+#include "AgentESampler.h"
+#include "AgentEAggregator.h"
+#include "AgentESpool.h"
+#include "AgentEStats.h"
+#include "AgentETransport.h"
 #include "AgentEClient.generated.h"
 
 USTRUCT(BlueprintType)
@@ -46,12 +69,277 @@ struct FAlert
     int32 Severity;
 };
 
+/** Last GET /health result, as cached by the client */
+USTRUCT(BlueprintType)
+struct FAgentEHealthInfo
+{
+    GENERATED_BODY()
+
+    /** False until a check has succeeded */
+    UPROPERTY(BlueprintReadOnly)
+    bool bValid = false;
+
+    UPROPERTY(BlueprintReadOnly)
+    int32 Health = 100;
+
+    UPROPERTY(BlueprintReadOnly)
+    int32 Tick = 0;
+
+    /** "autonomous" or "advisor" */
+    UPROPERTY(BlueprintReadOnly)
+    FString Mode;
+
+    UPROPERTY(BlueprintReadOnly)
+    int32 ActivePlans = 0;
+
+    /** Server uptime when the fields were last sent (a 304 doesn't resend them) */
+    UPROPERTY(BlueprintReadOnly)
+    float UptimeSeconds = 0.f;
+
+    /** Seconds since the server last confirmed these fields */
+    UPROPERTY(BlueprintReadOnly)
+    float AgeSeconds = 0.f;
+};
+
+/** Adjustment as parsed off the wire — Parameter and Principle are FAgentEKeyTable handles */
+struct FAgentEParsedAdjustment
+{
+    int32 Parameter = INDEX_NONE;
+    float Value = 0.f;
+
+    /** The principle whose decision made it; INDEX_NONE when the server didn't say */
+    int32 Principle = INDEX_NONE;
+};
+
+/** One adjustment from the client's history, server or local (see AgentELocalRules.h) */
+USTRUCT(BlueprintType)
+struct FAgentEAdjustmentRecord
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly)
+    FString Parameter;
+
+    UPROPERTY(BlueprintReadOnly)
+    float Value = 0.f;
+
+    /** Principle id ("P12"); empty when unknown */
+    UPROPERTY(BlueprintReadOnly)
+    FString Principle;
+
+    /** Tick of the server reply; -1 for local adjustments */
+    UPROPERTY(BlueprintReadOnly)
+    int64 Tick = -1;
+
+    /** Decided by the local rules rather than the server */
+    UPROPERTY(BlueprintReadOnly)
+    bool bLocal = false;
+
+    UPROPERTY(BlueprintReadOnly)
+    float AgeSeconds = 0.f;
+};
+
+/** Alert as parsed off the wire — Principle and Name are FAgentEKeyTable handles */
+struct FAgentEParsedAlert
+{
+    int32 Principle = INDEX_NONE;
+    int32 Name = INDEX_NONE;
+    int32 Severity = 0;
+};
+
+/**
+ * Parsed tick reply (HTTP body or WebSocket frame) — built off the game
+ * thread, applied on it. Strings are key handles and the arrays are inline,
+ * so a typical reply is parsed and posted without a heap allocation.
+ */
+struct FAgentETickResult
+{
+    /** False for replies that carry no tick outcome (warnings, errors) */
+    bool bHasTick = false;
+    int32 Health = 100;
+    TArray<FAgentEParsedAdjustment, TInlineAllocator<16>> Adjustments;
+    TArray<FAgentEParsedAlert, TInlineAllocator<8>> Alerts;
+
+    /** validationWarnings as (path, message) */
+    TArray<TPair<FString, FString>> Warnings;
+
+    /** Non-empty when the server (or the transport) reported an error */
+    FString Error;
+
+    /** Echoed seq and tick; -1 when absent */
+    int64 Seq = -1;
+    int64 Tick = -1;
+
+    /** Answers a tick send (frees an in-flight slot); false for warnings, acks, broadcasts and errors about other messages */
+    bool bTickReply = true;
+
+    /** health_result or decision_result: an answer on the control lane, not about a tick */
+    bool bControlReply = false;
+
+    /** An adjustment or alert push: adjustments or alerts to apply, with no health or cadence */
+    bool bPush = false;
+
+    /** The server dropped the tick for arriving too soon */
+    bool bRateLimited = false;
+
+    /** Answers a spooled tick: the economy has moved on, so only cadence and errors count */
+    bool bReplay = false;
+
+    /** Seconds since the matching send; -1 when unknown */
+    double RttSeconds = -1.0;
+
+    /** The server's own time for the tick (its processingMs); -1 when it didn't say */
+    double ServerMs = -1.0;
+};
+
+/**
+ * Parse one reply — an HTTP body (no "type") or a WebSocket frame — in
+ * either wire format. Returns false for malformed input. bOutResync is set
+ * when the next send should be a full snapshot (and, for MessagePack, carry
+ * a fresh name dictionary). Any thread; Keys is thread-safe.
+ */
+bool AgentEParseTickReply(
+    TConstArrayView<uint8> Body, bool bBinary, FAgentEKeyTable& Keys, FAgentETickResult& Out, bool& bOutResync);
+
+/**
+ * Send-pipeline state. Touched only by the send tasks (which run one at a
+ * time), except the atomics, Keys and Stats, which reply threads and the
+ * game thread use too.
+ */
+struct FAgentESendContext
+{
+    /** Reused UTF-8 body buffer — reset, never freed, between sends */
+    FAgentEJsonWriter Writer;
+
+    /** Agent IDs already encoded for Writer */
+    FAgentEJsonNames JsonNames;
+
+    /** Full JSON bodies: AgentEWriteTickBody, or a schema's writer after UseStateSchema */
+    std::atomic<FAgentETickBodyWriter> WriteTickBody { &AgentEWriteTickBody };
+
+    /** Reused events-batch buffer and drain scratch */
+    FAgentEJsonWriter EventWriter;
+    TArray<FAgentEEvent> EventBatch;
+
+    /** FAgentEEventStats::TotalLost() when last logged */
+    int64 ReportedEventsLost = 0;
+
+    /** Reused MessagePack body buffer and the names the server has seen */
+    FAgentEMsgPackWriter BinaryWriter;
+    FAgentEWireNames WireNames;
+
+    /**
+     * ShardId on a direct transport (empty: the main economy). JSON bodies go
+     * out with ShardPrefix spliced in, via ShardedBody; binary ones carry
+     * Shard. Set before the first send.
+     */
+    FString Shard;
+    TArray<uint8> ShardPrefix;
+    TArray<uint8> ShardedBody;
+
+    /** Last snapshot sent — the base the next delta is diffed against */
+    TSharedPtr<const FAgentEEconomyState, ESPMode::ThreadSafe> LastSent;
+
+    /** Reused gzip output buffer */
+    TArray<uint8> CompressedBody;
+
+    /** Previous sample and its slots, when bSampleAgents is on */
+    FAgentESampler Sampler;
+
+    /** Sort scratch for bPreAggregate */
+    FAgentEAggregator Aggregator;
+
+    /** Sequence number and tick of LastSent */
+    int64 Seq = 0;
+    int32 LastSentTick = 0;
+
+    /** Bodies held back while the server is unreachable (bSpoolWhenOffline), and replay scratch */
+    FAgentESpool Spool;
+    TArray<uint8> ReplayBody;
+
+    /** FAgentESpool::GetDropped() when last logged */
+    int64 ReportedSpoolDropped = 0;
+
+    /** Spool is open / Spool.Num(), for the game and reply threads */
+    std::atomic<bool> bSpoolOpen { false };
+    std::atomic<int32> SpoolPending { 0 };
+
+    /** A send failed before the server answered; ticks and events spool until a probe succeeds */
+    std::atomic<bool> bServerUnreachable { false };
+
+    /** Set with bServerUnreachable: LastSent may never have arrived, so it is spooled first */
+    std::atomic<bool> bSpoolLastSent { false };
+
+    /** The oldest spooled tick is on the wire / was answered for good and can be popped */
+    std::atomic<bool> bReplayInFlight { false };
+    std::atomic<bool> bReplayDone { false };
+
+    int32 SendsSinceFull = 0;
+
+    /** Set when the server reports a delta gap or a send fails */
+    std::atomic<bool> bForceFullSnapshot { true };
+
+    /** Set when the server may be missing names we think it has */
+    std::atomic<bool> bResetWireNames { false };
+
+    /** Tick sends without a reply yet */
+    std::atomic<int32> InFlight { 0 };
+
+    /** Last send into an idle pipeline or last reply, FPlatformTime::Seconds() */
+    std::atomic<double> LastProgressTime { 0.0 };
+
+    /** Send time per seq, for round-trip times (slot = seq % 16) */
+    std::atomic<int64> SentSeq[16] = {};
+    std::atomic<double> SentAt[16] = {};
+
+    /** Newest seq / tick applied — older replies are stale */
+    std::atomic<int64> LastAppliedSeq { -1 };
+    std::atomic<int64> LastAppliedTick { -1 };
+
+    /** Parameter keys and principle ids/names seen in replies (thread-safe) */
+    FAgentEKeyTable Keys;
+
+    /** Stage timings and traffic counters (thread-safe) */
+    FAgentEStatsRecorder Stats;
+
+    /** Event flows for the local rules, added by the event flusher; LocalFlowsLock guards them */
+    std::atomic<bool> bCollectLocalFlows { false };
+    FCriticalSection LocalFlowsLock;
+    FAgentELocalFlows LocalFlows;
+};
+
+/** What OnGameTick does when MaxInFlight tick sends are unanswered */
+UENUM(BlueprintType)
+enum class EAgentECoalescePolicy : uint8
+{
+    /** Drop this send; its events ride along with the next one */
+    SkipWhileBusy,
+
+    /** Remember that a send is due and send the newest state once a reply frees a slot */
+    SendLatestWhenFree,
+};
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(
     FOnAdjustmentReceived, const FString&, Key, float, Value);
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(
     FOnAlertReceived, const FString&, Principle, const FString&, Name, int32, Severity);
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(
+    FOnValidationWarning, const FString&, Path, const FString&, Message);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(
+    FOnTickError, const FString&, Message);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(
+    FOnHealthChecked, const FAgentEHealthInfo&, Info);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(
+    FOnDecisionResult, const FString&, DecisionId, bool, bApproved, int32, Status, const FString&, Error);
+
+DECLARE_MULTICAST_DELEGATE_OneParam(
+    FOnAgentETickReply, const FAgentETickResult&);
+
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class YOURGAME_API UAgentEClient : public UActorComponent
 {
@@ -66,13 +354,260 @@ public:
     UPROPERTY(EditAnywhere, Category = "AgentE")
     FString ServerUrl = TEXT("http://localhost:3000");
 
-    /** Send tick every N game ticks */
+    /** How ticks reach the server */
     UPROPERTY(EditAnywhere, Category = "AgentE")
+    EAgentETransport Transport = EAgentETransport::Http;
+
+    /** Wire format for ticks and their replies */
+    UPROPERTY(EditAnywhere, Category = "AgentE")
+    EAgentEEncoding Encoding = EAgentEEncoding::Json;
+
+    /** WebSocket URL; empty derives ws(s):// from ServerUrl */
+    UPROPERTY(EditAnywhere, Category = "AgentE|WebSocket", meta = (EditCondition = "Transport == EAgentETransport::WebSocket"))
+    FString WebSocketUrl;
+
+    /** First reconnect delay in seconds; doubles per failed attempt */
+    UPROPERTY(EditAnywhere, Category = "AgentE|WebSocket", meta = (ClampMin = "0.1"))
+    float ReconnectInitialDelay = 1.f;
+
+    /** Upper bound for the reconnect delay in seconds */
+    UPROPERTY(EditAnywhere, Category = "AgentE|WebSocket", meta = (ClampMin = "0.1"))
+    float ReconnectMaxDelay = 30.f;
+
+    /** Ticks and event batches larger than this (KB) go out as chunk frames, so control messages can pass them */
+    UPROPERTY(EditAnywhere, Category = "AgentE|WebSocket", meta = (EditCondition = "Transport == EAgentETransport::WebSocket", ClampMin = "1"))
+    int32 BulkChunkKilobytes = 64;
+
+    /** Bulk bytes (KB) handed to the socket per frame; the rest of a large tick follows on later frames */
+    UPROPERTY(EditAnywhere, Category = "AgentE|WebSocket", meta = (EditCondition = "Transport == EAgentETransport::WebSocket", ClampMin = "1"))
+    int32 BulkKilobytesPerFrame = 256;
+
+    /**
+     * Have the server push adjustments and alerts as it produces them (from
+     * any tick source, or an approval) rather than only in tick replies, so
+     * the send interval can be long without decisions landing late
+     */
+    UPROPERTY(EditAnywhere, Category = "AgentE|WebSocket", meta = (EditCondition = "Transport == EAgentETransport::WebSocket"))
+    bool bSubscribeToPushes = false;
+
+    /** Server's shared-memory doorbell port (its `sharedMemoryPort`) */
+    UPROPERTY(EditAnywhere, Category = "AgentE|SharedMemory", meta = (EditCondition = "Transport == EAgentETransport::SharedMemory"))
+    int32 SharedMemoryPort = 3101;
+
+    /** Size of each shared-memory ring in KB, rounded up to a power of two; a tick body must fit */
+    UPROPERTY(EditAnywhere, Category = "AgentE|SharedMemory", meta = (EditCondition = "Transport == EAgentETransport::SharedMemory", ClampMin = "64", ClampMax = "262144"))
+    int32 SharedMemoryRingKilobytes = 8192;
+
+    /**
+     * Send through the process's shared uplink (UAgentESubsystem) instead of
+     * a connection of this component's own: ticks of every component on the
+     * same ServerUrl go out together as POST /tick/batch, each under its
+     * ShardId. JSON over HTTP only — Transport and Encoding are ignored.
+     */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Uplink")
+    bool bUseSharedUplink = false;
+
+    /**
+     * This economy's shard on the server. On the shared uplink, empty uses
+     * the owning actor's name; on a connection of its own, empty ticks the
+     * server's main economy and anything else that shard's (every body
+     * carries `shard`).
+     */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Uplink")
+    FString ShardId;
+
+    /** Longest a tick waits in the uplink for the other shards' ticks, in seconds */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Uplink", meta = (EditCondition = "bUseSharedUplink", ClampMin = "0"))
+    float UplinkBatchWindow = 0.05f;
+
+    /** Send tick every N game ticks (when bAdaptiveCadence is off) */
+    UPROPERTY(EditAnywhere, Category = "AgentE", meta = (EditCondition = "!bAdaptiveCadence"))
     int32 TickInterval = 5;
 
+    /** Space sends by wall-clock time, adapting to economy health and server load */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Cadence")
+    bool bAdaptiveCadence = true;
+
+    /** Shortest spacing in seconds — used while the economy is in trouble (server minimum: 0.1) */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Cadence", meta = (EditCondition = "bAdaptiveCadence", ClampMin = "0.1"))
+    float MinSendInterval = 0.25f;
+
+    /** Spacing in seconds for an economy that is neither healthy nor in trouble */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Cadence", meta = (EditCondition = "bAdaptiveCadence", ClampMin = "0.1"))
+    float TargetSendInterval = 1.f;
+
+    /** Longest spacing in seconds — a healthy economy, or a server that needs relief */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Cadence", meta = (EditCondition = "bAdaptiveCadence", ClampMin = "0.1"))
+    float MaxSendInterval = 5.f;
+
+    /** Health at or below this sends at MinSendInterval */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Cadence", meta = (EditCondition = "bAdaptiveCadence", ClampMin = "0", ClampMax = "100"))
+    int32 UrgentHealth = 50;
+
+    /** Alerts at or above this severity (1-10) send at MinSendInterval */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Cadence", meta = (EditCondition = "bAdaptiveCadence", ClampMin = "1", ClampMax = "10"))
+    int32 SevereAlertSeverity = 7;
+
+    /** Tick sends that may await a reply at once */
+    UPROPERTY(EditAnywhere, Category = "AgentE", meta = (ClampMin = "1"))
+    int32 MaxInFlight = 1;
+
+    /** What happens to a send while MaxInFlight are unanswered */
+    UPROPERTY(EditAnywhere, Category = "AgentE")
+    EAgentECoalescePolicy CoalescePolicy = EAgentECoalescePolicy::SendLatestWhenFree;
+
+    /** Seconds without any reply before unanswered sends are presumed lost */
+    UPROPERTY(EditAnywhere, Category = "AgentE", meta = (ClampMin = "0.5"))
+    float InFlightTimeout = 10.f;
+
+    /** Send only what changed since the last snapshot the server accepted (JSON only) */
+    UPROPERTY(EditAnywhere, Category = "AgentE")
+    bool bUseDeltaSnapshots = true;
+
+    /** Force a full snapshot every N sends, even without a reported gap */
+    UPROPERTY(EditAnywhere, Category = "AgentE", meta = (EditCondition = "bUseDeltaSnapshots", ClampMin = "1"))
+    int32 FullSnapshotInterval = 60;
+
+    /**
+     * Record what the SetBalance / AddInventory / SetRole hooks change, and
+     * keep totals and role counts as they go: deltas then visit only changed
+     * agents, and pre-aggregation and sampling skip their full passes. Every
+     * write to balances, inventories and roles must then go through the
+     * hooks (here or on GetEconomyState()).
+     */
+    UPROPERTY(EditAnywhere, Category = "AgentE")
+    bool bTrackChanges = false;
+
+    /** Gzip tick bodies over HTTP (Content-Encoding: gzip), compressed on the send task */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Compression")
+    bool bCompressTicks = false;
+
+    /** Bodies smaller than this many bytes go out uncompressed */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Compression", meta = (EditCondition = "bCompressTicks", ClampMin = "0"))
+    int32 CompressionThresholdBytes = 16 * 1024;
+
+    /**
+     * Send a stratified sample of the agents plus exact totals and role
+     * counts instead of every agent, so body size stops growing with the
+     * population (see AgentESampler.h)
+     */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Sampling")
+    bool bSampleAgents = false;
+
+    /** Roughly how many agents each body carries */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Sampling", meta = (EditCondition = "bSampleAgents", ClampMin = "1"))
+    int32 SampleMaxAgents = 5000;
+
+    /** Agents kept per role, however small its share (unless the role has fewer) */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Sampling", meta = (EditCondition = "bSampleAgents", ClampMin = "1"))
+    int32 SampleMinAgentsPerRole = 50;
+
+    /** Picks which agents are sampled; keep it fixed for a session */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Sampling", meta = (EditCondition = "bSampleAgents"))
+    int32 SampleSeed = 0;
+
+    /**
+     * Compute supply, role counts, Gini, median and top-10% share on the
+     * send task and send them as the `aggregates` block; the server uses it
+     * in place of its per-agent loops (see AgentEAggregator.h)
+     */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Sampling")
+    bool bPreAggregate = false;
+
+    /** Events each producing thread can buffer between flushes */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Events", meta = (ClampMin = "16"))
+    int32 EventRingCapacity = 4096;
+
+    /** What a full per-thread buffer does with new events */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Events")
+    EAgentEEventOverflow EventOverflow = EAgentEEventOverflow::DropNewest;
+
+    /** Sample policy: keep 1 in N events once a buffer is 3/4 full */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Events", meta = (ClampMin = "1", EditCondition = "EventOverflow == EAgentEEventOverflow::Sample"))
+    int32 EventSampleRate = 4;
+
+    /** Upper bound on events per batch frame (server maximum: 1000) */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Events", meta = (ClampMin = "1", ClampMax = "1000"))
+    int32 MaxEventsPerBatch = 500;
+
+    /** Seconds between event flushes; a ring filling up flushes sooner */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Events", meta = (ClampMin = "0.01"))
+    float EventFlushInterval = 0.25f;
+
+    /** Milliseconds per frame for applying queued adjustments and alerts; 0 applies a whole reply at once */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Adjustments", meta = (ClampMin = "0"))
+    float AdjustmentFrameBudgetMs = 2.f;
+
+    /** Spread each adjustment's change over this many frames (1 = jump straight to the value) */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Adjustments", meta = (ClampMin = "1"))
+    int32 AdjustmentInterpolationFrames = 1;
+
+    /**
+     * When a tick send fails before the server answers, keep ticks and event
+     * batches in an on-disk ring instead of sending them, and replay them in
+     * order once /health answers again (see AgentESpool.h)
+     */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Spool")
+    bool bSpoolWhenOffline = false;
+
+    /** Spool file; empty uses Saved/AgentE/Spool.bin */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Spool", meta = (EditCondition = "bSpoolWhenOffline"))
+    FString SpoolFile;
+
+    /** Disk cap for the spool; when it is full the oldest records go */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Spool", meta = (EditCondition = "bSpoolWhenOffline", ClampMin = "1"))
+    int32 SpoolMaxMegabytes = 64;
+
+    /** Seconds between replayed records, doubled per rate-limit reply (server minimum: 0.1) */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Spool", meta = (EditCondition = "bSpoolWhenOffline", ClampMin = "0.1"))
+    float SpoolReplayInterval = 0.2f;
+
+    /** Seconds between /health probes while the server is unreachable */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Spool", meta = (EditCondition = "bSpoolWhenOffline", ClampMin = "0.1"))
+    float SpoolProbeInterval = 2.f;
+
+    /** CheckHealth answers from the cache for this many seconds; then it revalidates (If-None-Match) */
+    UPROPERTY(EditAnywhere, Category = "AgentE|Health", meta = (ClampMin = "0"))
+    float HealthCacheSeconds = 5.f;
+
+    /** Also broadcast OnAdjustmentReceived for keys that have a binding */
+    UPROPERTY(EditAnywhere, Category = "AgentE")
+    bool bBroadcastBoundAdjustments = false;
+
+    /**
+     * While the server is unreachable or a reply is LocalRulesAfterSeconds
+     * overdue, check a few principles in-process and adjust parameters
+     * locally; the server's next reply puts its values back
+     * (see AgentELocalRules.h)
+     */
+    UPROPERTY(EditAnywhere, Category = "AgentE|LocalRules")
+    bool bUseLocalRules = false;
+
+    UPROPERTY(EditAnywhere, Category = "AgentE|LocalRules", meta = (EditCondition = "bUseLocalRules", ClampMin = "0.1"))
+    float LocalRulesAfterSeconds = 5.f;
+
+    /** Seconds between two local moves of one parameter */
+    UPROPERTY(EditAnywhere, Category = "AgentE|LocalRules", meta = (EditCondition = "bUseLocalRules", ClampMin = "0"))
+    float LocalRulesCooldown = 10.f;
+
+    /** Parameter to move per principle ("P12", "P1") until the server has adjusted one for it */
+    UPROPERTY(EditAnywhere, Category = "AgentE|LocalRules", meta = (EditCondition = "bUseLocalRules"))
+    TMap<FName, FName> LocalRuleParameters;
+
+    /** The server's netFlowWarnThreshold and maxAdjustmentPercent, if you changed them */
+    UPROPERTY(EditAnywhere, Category = "AgentE|LocalRules", meta = (EditCondition = "bUseLocalRules", ClampMin = "0"))
+    float LocalNetFlowThreshold = 10.f;
+
+    UPROPERTY(EditAnywhere, Category = "AgentE|LocalRules", meta = (EditCondition = "bUseLocalRules", ClampMin = "0", ClampMax = "1"))
+    float LocalMaxAdjustmentPercent = 0.15f;
+
+    /** Adjustments kept for GetAdjustmentHistory, server and local */
+    UPROPERTY(EditAnywhere, Category = "AgentE|LocalRules", meta = (ClampMin = "1"))
+    int32 AdjustmentHistorySize = 64;
+
     // ─── Events ─────────────────────────────────────────────────────────
 
-    /** Fired for each parameter adjustment returned by AgentE */
+    /** Fired for each parameter adjustment returned by AgentE that no binding handled */
     UPROPERTY(BlueprintAssignable, Category = "AgentE")
     FOnAdjustmentReceived OnAdjustmentReceived;
 
@@ -80,28 +615,288 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "AgentE")
     FOnAlertReceived OnAlertReceived;
 
+    /** Fired for each state validation warning the server reports */
+    UPROPERTY(BlueprintAssignable, Category = "AgentE")
+    FOnValidationWarning OnValidationWarning;
+
+    /** Fired when a tick fails: transport error, rejection, or server error message */
+    UPROPERTY(BlueprintAssignable, Category = "AgentE")
+    FOnTickError OnTickError;
+
+    /** Fired when CheckHealth has a result, cached or from the server */
+    UPROPERTY(BlueprintAssignable, Category = "AgentE")
+    FOnHealthChecked OnHealthChecked;
+
+    /** Fired with the server's answer to ApproveDecision / RejectDecision: status 200, or the error and its status (0: no answer) */
+    UPROPERTY(BlueprintAssignable, Category = "AgentE|Advisor")
+    FOnDecisionResult OnDecisionResult;
+
+    /**
+     * Native only: every answer to a tick send — success, error, rate limit
+     * or transport failure — with its round trip and server time, on the
+     * game thread before it is applied. What the load test measures with.
+     */
+    FOnAgentETickReply OnTickReply;
+
     // ─── Public API ─────────────────────────────────────────────────────
 
-    /** Call from your game loop every tick */
+    /**
+     * Connect and start the background tickers; BeginPlay and EndPlay call
+     * these. Call them yourself only for a component that is never
+     * registered with a world, such as the load test's virtual clients
+     * (set ShardId first: there is no owning actor to name the shard).
+     */
+    void StartClient();
+    void StopClient();
+
+    /** Call from your game loop every tick; decides when a send is due */
     UFUNCTION(BlueprintCallable, Category = "AgentE")
     void OnGameTick();
 
-    /** Check server health */
+    /**
+     * Record one economic event. Safe and lock-free from any thread between
+     * BeginPlay and EndPlay; batches stream to the server in the background
+     * (POST /events or the WebSocket `events` message) instead of riding in
+     * the tick snapshot. A full per-thread buffer applies EventOverflow.
+     */
+    UFUNCTION(BlueprintCallable, Category = "AgentE")
+    void RecordEvent(const FAgentEEvent& Event);
+
+    /** Recorded / dropped / sent event counts. Any thread. */
+    UFUNCTION(BlueprintPure, Category = "AgentE")
+    FAgentEEventStats GetEventStats() const;
+
+    /** Send everything recorded so far now (also done before each tick) */
+    UFUNCTION(BlueprintCallable, Category = "AgentE")
+    void FlushEvents();
+
+    /**
+     * Intern a parameter key before the first reply mentions it, so even
+     * its first adjustment is matched without allocating. Returns its handle.
+     */
+    int32 RegisterParameter(const FString& Key) { return SendContext->Keys.FindOrAdd(Key); }
+
+    /**
+     * Bind a parameter key once; adjustments for it then write Target or
+     * call Setter directly, with no string compare and no delegate. With an
+     * Owner, the binding ends when Owner is destroyed. Game thread.
+     */
+    FAgentEBindingId BindParameter(FName Key, float* Target, const UObject* Owner = nullptr)
+    {
+        return Bindings.BindFloat(SendContext->Keys.FindOrAdd(Key), Target, Owner);
+    }
+    FAgentEBindingId BindParameter(FName Key, TFunction<void(float)> Setter, const UObject* Owner = nullptr)
+    {
+        return Bindings.BindSetter(SendContext->Keys.FindOrAdd(Key), MoveTemp(Setter), Owner);
+    }
+
+    /** Bind a parameter key to a numeric property of Target, e.g. "TradeTax" or "Economy.TradeTax" */
+    UFUNCTION(BlueprintCallable, Category = "AgentE")
+    bool BindParameterToProperty(FName Key, UObject* Target, const FString& PropertyPath)
+    {
+        return Bindings.BindProperty(SendContext->Keys.FindOrAdd(Key), Target, PropertyPath).IsValid();
+    }
+
+    void UnbindParameter(FAgentEBindingId Id) { Bindings.Unbind(Id); }
+
+    /** Remove every binding owned by (or targeting) Owner */
+    UFUNCTION(BlueprintCallable, Category = "AgentE")
+    void UnbindParameters(UObject* Owner) { Bindings.UnbindAll(Owner); }
+
+    /**
+     * Check server health; the result arrives through OnHealthChecked. Within
+     * HealthCacheSeconds of the last answer the cached result is used; after
+     * that the server is asked with If-None-Match and answers 304 Not Modified
+     * when nothing changed. Calls while a check is in flight share it.
+     */
     UFUNCTION(BlueprintCallable, Category = "AgentE")
     void CheckHealth();
 
-    /** Get the last known economy health score (0-100) */
+    /** The last health check result (bValid false before the first one) */
+    UFUNCTION(BlueprintPure, Category = "AgentE")
+    FAgentEHealthInfo GetLastHealthInfo() const;
+
+    /**
+     * Approve or reject a decision pending in advisor mode (see /pending).
+     * Over a connected WebSocket these ride the control lane, ahead of any
+     * tick upload in progress; otherwise they are POST /approve and
+     * POST /reject. Health checks take the same route. The answer arrives
+     * through OnDecisionResult.
+     */
+    UFUNCTION(BlueprintCallable, Category = "AgentE|Advisor")
+    void ApproveDecision(const FString& DecisionId);
+
+    UFUNCTION(BlueprintCallable, Category = "AgentE|Advisor")
+    void RejectDecision(const FString& DecisionId, const FString& Reason);
+
+    /**
+     * Per-stage timings, traffic and failure counts since BeginPlay or
+     * ResetClientStats. The same numbers feed `stat AgentE` and the
+     * AgentE/* counters in Unreal Insights. Any thread.
+     */
+    UFUNCTION(BlueprintPure, Category = "AgentE")
+    FAgentEClientStats GetClientStats() const;
+
+    /** Recent adjustments, oldest first, with the principle behind each — the local rules' cache */
+    UFUNCTION(BlueprintPure, Category = "AgentE|LocalRules")
+    TArray<FAgentEAdjustmentRecord> GetAdjustmentHistory() const;
+
+    /** Zero the timings and counters GetClientStats reports */
+    UFUNCTION(BlueprintCallable, Category = "AgentE")
+    void ResetClientStats() { SendContext->Stats.Reset(); }
+
+    /** Seconds between sends the adaptive cadence currently aims for */
+    UFUNCTION(BlueprintPure, Category = "AgentE")
+    float GetCurrentSendInterval() const { return Cadence.GetInterval(); }
+
+    /** Get the last known economy health score (0-100). Any thread. */
     UFUNCTION(BlueprintPure, Category = "AgentE")
-    int32 GetLastHealth() const { return LastHealth; }
+    int32 GetLastHealth() const { return LastHealth.load(std::memory_order_relaxed); }
+
+    /**
+     * Typed economy arrays — owned by the component, filled by the game on the
+     * game thread. Each send snapshots them (shared names + column memcpy) and
+     * serializes the snapshot on a worker task.
+     */
+    FAgentEEconomyState& GetEconomyState() { return EconomyState; }
+    const FAgentEEconomyState& GetEconomyState() const { return EconomyState; }
+
+    /**
+     * Give the economy SchemaT's currencies, resources and roles (see
+     * AgentEStateSchema.h) and write full JSON snapshots with its specialized
+     * writer. Call instead of SetSchema; existing agents are kept. Game thread.
+     */
+    template <typename SchemaT>
+    void UseStateSchema()
+    {
+        SchemaT::Apply(EconomyState);
+        SendContext->WriteTickBody = &AgentEWriteSchemaTickBody<SchemaT>;
+    }
+
+    /** Mutation hooks on GetEconomyState(), change-tracked with bTrackChanges. Game thread. */
+    UFUNCTION(BlueprintCallable, Category = "AgentE|State")
+    void SetBalance(int32 AgentIndex, int32 CurrencyIndex, double Value) { EconomyState.SetBalance(AgentIndex, CurrencyIndex, Value); }
+
+    UFUNCTION(BlueprintCallable, Category = "AgentE|State")
+    void AddBalance(int32 AgentIndex, int32 CurrencyIndex, double Delta) { EconomyState.AddBalance(AgentIndex, CurrencyIndex, Delta); }
+
+    UFUNCTION(BlueprintCallable, Category = "AgentE|State")
+    void SetInventory(int32 AgentIndex, int32 ResourceIndex, double Quantity) { EconomyState.SetInventory(AgentIndex, ResourceIndex, Quantity); }
+
+    UFUNCTION(BlueprintCallable, Category = "AgentE|State")
+    void AddInventory(int32 AgentIndex, int32 ResourceIndex, double Delta) { EconomyState.AddInventory(AgentIndex, ResourceIndex, Delta); }
+
+    UFUNCTION(BlueprintCallable, Category = "AgentE|State")
+    void SetRole(int32 AgentIndex, int32 RoleIndex) { EconomyState.SetRole(AgentIndex, uint16(RoleIndex)); }
+
+    UFUNCTION(BlueprintCallable, Category = "AgentE|State")
+    void SetPrice(int32 CurrencyIndex, int32 ResourceIndex, double Price) { EconomyState.SetPrice(CurrencyIndex, ResourceIndex, Price); }
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
-    int32 TickCounter = 0;
-    int32 LastHealth = 100;
+    /** Atomic so worker threads can read them; only the game thread writes */
+    std::atomic<int32> TickCounter { 0 };
+    std::atomic<int32> LastHealth { 100 };
+
+    FAgentEEconomyState EconomyState;
+
+    /**
+     * Snapshots handed to send tasks, reused once the send context lets go
+     * of them. The delta base, the name caches and the sampler's hash
+     * source can each hold one, plus the sends still queued; game thread only.
+     */
+    TAgentERecycler<FAgentEEconomyState> Snapshots { 6 };
+
+    TSharedRef<FAgentESendContext, ESPMode::ThreadSafe> SendContext;
+
+    /** Created in BeginPlay from the Transport setting */
+    TSharedPtr<IAgentETransport, ESPMode::ThreadSafe> ActiveTransport;
+
+    /** Created in BeginPlay; outlives EndPlay so late producers stay safe */
+    TSharedPtr<FAgentEEventStream, ESPMode::ThreadSafe> EventStream;
+
+    FTSTicker::FDelegateHandle EventFlushHandle;
+    double LastEventFlushTime = 0.0;
+
+    FAgentECadence Cadence;
+
+    /** Per-key adjustment targets, indexed by SendContext->Keys handle */
+    FAgentEParameterBindings Bindings;
+
+    /** Recent adjustments and the in-process rules; game thread only */
+    FAgentELocalRules LocalRules;
+    FAgentELocalFlows LocalFlowsScratch;
+    TArray<TPair<int32, float>> LocalDecisions;
+    bool bLocalRulesEngaged = false;
+
+    /** Adjustments and alerts waiting for frame budget */
+    FAgentEAdjustmentQueue AdjustmentQueue;
+    FTSTicker::FDelegateHandle AdjustmentTickHandle;
+
+    /** FPlatformTime::Seconds() of the next adaptive send */
+    double NextSendTime = 0.0;
+
+    /** Spool replay and probing; game thread only */
+    FTSTicker::FDelegateHandle SpoolTickHandle;
+    double NextReplayTime = 0.0;
+    double NextProbeTime = 0.0;
+    double ReplayStartTime = 0.0;
+    float ReplayBackoff = 1.f;
+
+    /** Cached health check; game thread only */
+    FAgentEHealthInfo HealthInfo;
+    FString HealthETag;
+    double HealthCheckedAt = 0.0;
+    bool bHealthRequestInFlight = false;
+
+    /** When the health check / each decision in flight was sent, for ControlRoundTrip; game thread only */
+    double HealthSentAt = 0.0;
+    TMap<FString, double> DecisionsSentAt;
+
+    /** A send was coalesced under SendLatestWhenFree; game thread only */
+    bool bSendQueued = false;
+
+    /** Send tasks chain on this, so only one task ever touches SendContext */
+    UE::Tasks::FTask LastSendTask;
 
     void SendTick();
-    void HandleTickResponse(FHttpResponsePtr Response, bool bSuccess);
-    FString BuildStateJson();
+    bool TickEventFlusher(float DeltaTime);
+    bool TickAdjustmentQueue(float DeltaTime);
+    bool TickSpool(float DeltaTime);
+    void ReplaySpooled();
+
+    /** GET /health (or the WebSocket `health` message), revalidating the cache; bBypassCache skips the fresh-cache shortcut */
+    void RequestHealth(bool bBypassCache);
+    void OnHealthResponse(FHttpResponsePtr Response, bool bSuccess);
+    void ApplyHealth(const FAgentEHealthInfo* Info, const FString& ETag);
+
+    void SendDecision(const FString& DecisionId, bool bApprove, const FString& Reason);
+    void OnDecisionResponse(const FString& DecisionId, bool bApprove, FHttpResponsePtr Response, bool bSuccess);
+    void ApplyDecisionResult(const FString& DecisionId, bool bApproved, int32 Status, const FString& Error);
+
+    /** Game thread: a health_result or decision_result that arrived on the tick reply path */
+    void HandleControlReply(TConstArrayView<uint8> Body);
+    void ApplyTickResult(const FAgentETickResult& Result);
+
+    /** Game thread: a tick reply's or push's adjustments and alerts, after any local moves are undone */
+    void DeliverServerResult(const FAgentETickResult& Result);
+
+    /** Game thread, before a send: the local rules, when the server looks degraded */
+    void RunLocalRules(double Now);
+
+    /** Apply now, or queue for TickAdjustmentQueue when a frame budget or interpolation is set */
+    void DeliverAdjustment(int32 Parameter, float Value);
+    void ApplyAdjustment(int32 Parameter, float Value);
+    void ApplyAlert(int32 Principle, int32 Name, int32 Severity);
+
+    /** Game thread, after a tick reply: send a coalesced tick if one is due */
+    void OnTickSlotFreed();
+
+    /** Runs on the transport's reply thread; hops to the game thread only to broadcast */
+    static void HandleTickResponse(
+        TWeakObjectPtr<UAgentEClient> WeakThis, const TSharedRef<FAgentESendContext, ESPMode::ThreadSafe>& Context,
+        int32 StatusCode, TConstArrayView<uint8> Body, bool bBinary);
 };
@@ -0,0 +1,401 @@
+/**
+ * AgentE Unreal Engine Client — Economy State
+ *
+ * See AgentEEconomyState.h for the column layout.
+ */
+
+#include "AgentEEconomyState.h"
+
+const ANSICHAR* AgentEEventTypeName(EAgentEEventType Type)
+{
+    switch (Type)
+    {
+    case EAgentEEventType::Trade:      return "trade";
+    case EAgentEEventType::Mint:       return "mint";
+    case EAgentEEventType::Burn:       return "burn";
+    case EAgentEEventType::Transfer:   return "transfer";
+    case EAgentEEventType::Produce:    return "produce";
+    case EAgentEEventType::Consume:    return "consume";
+    case EAgentEEventType::RoleChange: return "role_change";
+    case EAgentEEventType::Enter:      return "enter";
+    case EAgentEEventType::Churn:      return "churn";
+    }
+    return "trade";
+}
+
+FAgentEEconomyState::FAgentEEconomyState()
+    : Names(MakeShared<FAgentENameTable, ESPMode::ThreadSafe>())
+{
+}
+
+FAgentENameTable& FAgentEEconomyState::MutableNames()
+{
+    if (!Names.IsUnique())
+    {
+        Names = MakeShared<FAgentENameTable, ESPMode::ThreadSafe>(*Names);
+    }
+    return *Names;
+}
+
+void FAgentEEconomyState::SetSchema(
+    TArray<FString> InRoles, TArray<FString> InResources, TArray<FString> InCurrencies)
+{
+    FAgentENameTable& Table = MutableNames();
+    ++SchemaEpoch;
+    Table.Roles = MoveTemp(InRoles);
+    Table.Resources = MoveTemp(InResources);
+    Table.Currencies = MoveTemp(InCurrencies);
+
+    auto Intern = [](const TArray<FString>& From, TArray<FName>& To) {
+        To.Reset(From.Num());
+        for (const FString& Name : From)
+        {
+            To.Add(FName(*Name));
+        }
+    };
+    Intern(Table.Roles, Table.RoleNames);
+    Intern(Table.Resources, Table.ResourceNames);
+    Intern(Table.Currencies, Table.CurrencyNames);
+
+    const int32 Agents = NumAgents();
+
+    Balances.SetNum(Table.Currencies.Num());
+    for (TArray<double>& Column : Balances)
+    {
+        Column.SetNumZeroed(Agents);
+    }
+
+    Inventories.SetNum(Table.Resources.Num());
+    for (TArray<double>& Column : Inventories)
+    {
+        Column.SetNumZeroed(Agents);
+    }
+
+    MarketPrices.SetNum(Table.Currencies.Num());
+    for (TArray<double>& Row : MarketPrices)
+    {
+        Row.SetNumZeroed(Table.Resources.Num());
+    }
+
+    if (IsTrackingChanges())
+    {
+        ResetTracking();
+    }
+}
+
+int32 FAgentEEconomyState::FindAgent(FName AgentId) const
+{
+    const int32* Index = Names->AgentIndex.Find(AgentId);
+    return Index ? *Index : INDEX_NONE;
+}
+
+int32 FAgentEEconomyState::AddAgent(const FString& AgentId, uint16 RoleIndex)
+{
+    return AddAgent(FName(*AgentId), AgentId, RoleIndex);
+}
+
+int32 FAgentEEconomyState::AddAgent(FName AgentId, uint16 RoleIndex)
+{
+    return AddAgent(AgentId, AgentId.ToString(), RoleIndex);
+}
+
+int32 FAgentEEconomyState::AddAgent(FName AgentId, const FString& DisplayId, uint16 RoleIndex)
+{
+    // Checked before MutableNames so a repeat add doesn't detach the table
+    const int32 Existing = FindAgent(AgentId);
+    if (Existing != INDEX_NONE)
+    {
+        return Existing;
+    }
+
+    FAgentENameTable& Table = MutableNames();
+    const int32 Index = Table.AgentIds.Add(DisplayId);
+    Table.AgentNames.Add(AgentId);
+    Table.AgentIndex.Add(AgentId, Index);
+    AgentRoles.Add(RoleIndex);
+    for (TArray<double>& Column : Balances)
+    {
+        Column.Add(0.0);
+    }
+    for (TArray<double>& Column : Inventories)
+    {
+        Column.Add(0.0);
+    }
+
+    if (IsTrackingChanges())
+    {
+        Changes.Agents.Add(false);
+        Changes.Roles.Add(false);
+        for (TBitArray<>& Bits : Changes.Balances)
+        {
+            Bits.Add(false);
+        }
+        for (TBitArray<>& Bits : Changes.Inventories)
+        {
+            Bits.Add(false);
+        }
+        MarkAgentSlot(Index);
+        if (Totals.CountByRole.IsValidIndex(RoleIndex))
+        {
+            ++Totals.CountByRole[RoleIndex];
+        }
+    }
+    return Index;
+}
+
+void FAgentEEconomyState::RemoveAgent(int32 AgentIndex)
+{
+    if (!AgentIds().IsValidIndex(AgentIndex))
+    {
+        return;
+    }
+    if (IsTrackingChanges())
+    {
+        // The agent's values leave the totals; the swapped-in agent is marked below
+        for (int32 C = 0; C < Balances.Num(); ++C)
+        {
+            Totals.SupplyByCurrency[C] -= Balances[C][AgentIndex];
+        }
+        for (int32 R = 0; R < Inventories.Num(); ++R)
+        {
+            Totals.SupplyByResource[R] -= Inventories[R][AgentIndex];
+        }
+        if (Totals.CountByRole.IsValidIndex(AgentRoles[AgentIndex]))
+        {
+            --Totals.CountByRole[AgentRoles[AgentIndex]];
+        }
+    }
+
+    FAgentENameTable& Table = MutableNames();
+    Table.AgentIndex.Remove(Table.AgentNames[AgentIndex]);
+    Table.AgentIds.RemoveAtSwap(AgentIndex, 1, EAllowShrinking::No);
+    Table.AgentNames.RemoveAtSwap(AgentIndex, 1, EAllowShrinking::No);
+    if (Table.AgentNames.IsValidIndex(AgentIndex))
+    {
+        Table.AgentIndex.Add(Table.AgentNames[AgentIndex], AgentIndex);
+    }
+    AgentRoles.RemoveAtSwap(AgentIndex, 1, EAllowShrinking::No);
+    for (TArray<double>& Column : Balances)
+    {
+        Column.RemoveAtSwap(AgentIndex, 1, EAllowShrinking::No);
+    }
+    for (TArray<double>& Column : Inventories)
+    {
+        Column.RemoveAtSwap(AgentIndex, 1, EAllowShrinking::No);
+    }
+
+    if (IsTrackingChanges())
+    {
+        Changes.Agents.RemoveAtSwap(AgentIndex);
+        Changes.Roles.RemoveAtSwap(AgentIndex);
+        for (TBitArray<>& Bits : Changes.Balances)
+        {
+            Bits.RemoveAtSwap(AgentIndex);
+        }
+        for (TBitArray<>& Bits : Changes.Inventories)
+        {
+            Bits.RemoveAtSwap(AgentIndex);
+        }
+        // Every column lost a value, even when no agent moves into the slot
+        Changes.BalanceColumns.SetRange(0, Changes.BalanceColumns.Num(), true);
+        Changes.InventoryColumns.SetRange(0, Changes.InventoryColumns.Num(), true);
+        if (AgentIndex < NumAgents())
+        {
+            MarkAgentSlot(AgentIndex);
+        }
+    }
+}
+
+bool FAgentEEconomyState::RemoveAgent(FName AgentId)
+{
+    const int32 Index = FindAgent(AgentId);
+    if (Index == INDEX_NONE)
+    {
+        return false;
+    }
+    RemoveAgent(Index);
+    return true;
+}
+
+void FAgentEEconomyState::ResetAgents()
+{
+    ++SchemaEpoch;
+    FAgentENameTable& Table = MutableNames();
+    Table.AgentIds.Reset();
+    Table.AgentNames.Reset();
+    Table.AgentIndex.Reset();
+    AgentRoles.Reset();
+    for (TArray<double>& Column : Balances)
+    {
+        Column.Reset();
+    }
+    for (TArray<double>& Column : Inventories)
+    {
+        Column.Reset();
+    }
+    RecentTransactions.Reset();
+
+    if (IsTrackingChanges())
+    {
+        ResetTracking();
+    }
+}
+
+// ─── Change Tracking ────────────────────────────────────────────────────────
+
+void FAgentEEconomyState::TrackChanges()
+{
+    if (!IsTrackingChanges())
+    {
+        ChangeSerial = 1;
+        ResetTracking();
+    }
+}
+
+void FAgentEEconomyState::ResetTracking()
+{
+    const int32 Agents = NumAgents();
+    Changes.Agents.Init(false, Agents);
+    Changes.Roles.Init(false, Agents);
+    Changes.Balances.SetNum(Balances.Num());
+    for (TBitArray<>& Bits : Changes.Balances)
+    {
+        Bits.Init(false, Agents);
+    }
+    Changes.Inventories.SetNum(Inventories.Num());
+    for (TBitArray<>& Bits : Changes.Inventories)
+    {
+        Bits.Init(false, Agents);
+    }
+    Changes.BalanceColumns.Init(false, Balances.Num());
+    Changes.InventoryColumns.Init(false, Inventories.Num());
+
+    // The one full pass; the hooks keep these current from here on
+    auto Sum = [](const TArray<double>& Column) {
+        double Total = 0.0;
+        for (const double V : Column)
+        {
+            Total += V;
+        }
+        return Total;
+    };
+    Totals.SupplyByCurrency.Reset();
+    for (const TArray<double>& Column : Balances)
+    {
+        Totals.SupplyByCurrency.Add(Sum(Column));
+    }
+    Totals.SupplyByResource.Reset();
+    for (const TArray<double>& Column : Inventories)
+    {
+        Totals.SupplyByResource.Add(Sum(Column));
+    }
+    Totals.CountByRole.Init(0, Roles().Num());
+    for (const uint16 Role : AgentRoles)
+    {
+        if (Totals.CountByRole.IsValidIndex(Role))
+        {
+            ++Totals.CountByRole[Role];
+        }
+    }
+}
+
+void FAgentEEconomyState::MarkAgentSlot(int32 AgentIndex)
+{
+    Changes.Agents[AgentIndex] = true;
+    Changes.Roles[AgentIndex] = true;
+    for (TBitArray<>& Bits : Changes.Balances)
+    {
+        Bits[AgentIndex] = true;
+    }
+    for (TBitArray<>& Bits : Changes.Inventories)
+    {
+        Bits[AgentIndex] = true;
+    }
+    Changes.BalanceColumns.SetRange(0, Changes.BalanceColumns.Num(), true);
+    Changes.InventoryColumns.SetRange(0, Changes.InventoryColumns.Num(), true);
+}
+
+void FAgentEEconomyState::ClearChanges()
+{
+    if (!IsTrackingChanges())
+    {
+        return;
+    }
+    ++ChangeSerial;
+
+    // Column bits are only ever set together with the agent's bit
+    for (TConstSetBitIterator<> It(Changes.Agents); It; ++It)
+    {
+        const int32 A = It.GetIndex();
+        Changes.Roles[A] = false;
+        for (TBitArray<>& Bits : Changes.Balances)
+        {
+            Bits[A] = false;
+        }
+        for (TBitArray<>& Bits : Changes.Inventories)
+        {
+            Bits[A] = false;
+        }
+    }
+    Changes.Agents.SetRange(0, Changes.Agents.Num(), false);
+    Changes.BalanceColumns.SetRange(0, Changes.BalanceColumns.Num(), false);
+    Changes.InventoryColumns.SetRange(0, Changes.InventoryColumns.Num(), false);
+}
+
+void FAgentEEconomyState::SetRole(int32 AgentIndex, uint16 RoleIndex)
+{
+    uint16& Slot = AgentRoles[AgentIndex];
+    if (IsTrackingChanges() && Slot != RoleIndex)
+    {
+        if (Totals.CountByRole.IsValidIndex(Slot))
+        {
+            --Totals.CountByRole[Slot];
+        }
+        if (Totals.CountByRole.IsValidIndex(RoleIndex))
+        {
+            ++Totals.CountByRole[RoleIndex];
+        }
+        Changes.Roles[AgentIndex] = true;
+        Changes.Agents[AgentIndex] = true;
+    }
+    Slot = RoleIndex;
+}
+
+/** Dst = Src without giving up Dst's allocation; true when it had to grow */
+template <typename ElementType>
+static bool CopyInto(TArray<ElementType>& Dst, const TArray<ElementType>& Src)
+{
+    const bool bGrew = Dst.Max() < Src.Num();
+    Dst.Reset();
+    Dst.Append(Src);
+    return bGrew;
+}
+
+static bool CopyColumns(TArray<TArray<double>>& Dst, const TArray<TArray<double>>& Src)
+{
+    bool bGrew = Dst.Max() < Src.Num();
+    Dst.SetNum(Src.Num(), EAllowShrinking::No);
+    for (int32 i = 0; i < Src.Num(); ++i)
+    {
+        bGrew |= CopyInto(Dst[i], Src[i]);
+    }
+    return bGrew;
+}
+
+bool FAgentEEconomyState::CopyFrom(const FAgentEEconomyState& Other)
+{
+    Names = Other.Names;
+    SchemaEpoch = Other.SchemaEpoch;
+    Sampling = Other.Sampling;
+    Aggregates = Other.Aggregates;
+    ChangeSerial = Other.ChangeSerial;
+    Changes = Other.Changes;
+    Totals = Other.Totals;
+
+    bool bGrew = CopyInto(AgentRoles, Other.AgentRoles);
+    bGrew |= CopyColumns(Balances, Other.Balances);
+    bGrew |= CopyColumns(Inventories, Other.Inventories);
+    bGrew |= CopyColumns(MarketPrices, Other.MarketPrices);
+    bGrew |= CopyInto(RecentTransactions, Other.RecentTransactions);
+    return bGrew;
+}
@@ -0,0 +1,333 @@
+/**
+ * AgentE Unreal Engine Client — Economy State
+ *
+ * Typed, column-oriented copy of the EconomyState the server expects.
+ * The game fills these arrays (usually once at load, then in place as
+ * values change) and UAgentEClient serializes them straight to UTF-8.
+ *
+ * Layout:
+ *   - Names (roles, resources, currencies, agent IDs) are stored once, in a
+ *     shared copy-on-write table. Copying the state shares the table; the
+ *     next SetSchema/AddAgent detaches it.
+ *   - Every name is also interned as an FName with an index lookup, so the
+ *     game finds an agent's (or currency's) index once and then addresses
+ *     columns by index; serializers compare and intern FNames, not strings.
+ *     Like any FName, IDs that differ only by case are the same agent.
+ *   - Per-agent values are columns indexed by agent index, one column
+ *     per currency / resource, so a column is a contiguous TArray<double>.
+ *   - Agent roles are indices into Roles.
+ *   - A sampled snapshot (see AgentESampler.h) holds a subset of the agents
+ *     plus exact aggregates over all of them in Sampling.
+ *   - A pre-aggregated snapshot (see AgentEAggregator.h) also carries the
+ *     distribution metrics over all agents in Aggregates.
+ *   - With change tracking on (TrackChanges), the mutation hooks — SetBalance,
+ *     AddInventory, SetRole, ... — also mark what they change in per-column
+ *     bitsets and keep per-currency/resource totals and role counts up to
+ *     date, so deltas and aggregates look only at what changed. Writes that
+ *     bypass the hooks are then invisible to both.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AgentEEconomyState.generated.h"
+
+/** Mirrors the server's EconomicEventType union */
+UENUM(BlueprintType)
+enum class EAgentEEventType : uint8
+{
+    Trade,
+    Mint,
+    Burn,
+    Transfer,
+    Produce,
+    Consume,
+    RoleChange,
+    Enter,
+    Churn,
+};
+
+/** Wire name for an event type ("trade", "role_change", ...) */
+const ANSICHAR* AgentEEventTypeName(EAgentEEventType Type);
+
+/** One economic event — serialized into recentTransactions */
+USTRUCT(BlueprintType)
+struct FAgentEEvent
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadWrite)
+    EAgentEEventType Type = EAgentEEventType::Trade;
+
+    /** Tick or unix ms — the game decides, the server only compares */
+    UPROPERTY(BlueprintReadWrite)
+    int64 Timestamp = 0;
+
+    UPROPERTY(BlueprintReadWrite)
+    FName Actor;
+
+    UPROPERTY(BlueprintReadWrite)
+    FName Role;
+
+    UPROPERTY(BlueprintReadWrite)
+    FName Resource;
+
+    UPROPERTY(BlueprintReadWrite)
+    FName Currency;
+
+    UPROPERTY(BlueprintReadWrite)
+    float Amount = 0.f;
+
+    UPROPERTY(BlueprintReadWrite)
+    float Price = 0.f;
+
+    UPROPERTY(BlueprintReadWrite)
+    FName From;
+
+    UPROPERTY(BlueprintReadWrite)
+    FName To;
+};
+
+/** Immutable once shared — see FAgentEEconomyState::MutableNames() */
+struct FAgentENameTable
+{
+    TArray<FString> Roles;
+    TArray<FString> Resources;
+    TArray<FString> Currencies;
+
+    /** Agent IDs, indexed by agent index */
+    TArray<FString> AgentIds;
+
+    /** The same names as FNames, index for index */
+    TArray<FName> RoleNames;
+    TArray<FName> ResourceNames;
+    TArray<FName> CurrencyNames;
+    TArray<FName> AgentNames;
+
+    /** Agent ID → agent index, kept in step with RemoveAgent's swaps */
+    TMap<FName, int32> AgentIndex;
+};
+
+/**
+ * Exact aggregates over the whole population, sent next to a sampled set of
+ * agents. Arrays are indexed like the state's Roles / Currencies / Resources.
+ */
+struct FAgentESampleInfo
+{
+    int32 Population = 0;
+
+    /** Fraction of each role's agents in the sample, (0, 1] */
+    TArray<double> RateByRole;
+    TArray<int32> CountByRole;
+
+    TArray<double> SupplyByCurrency;
+    TArray<double> SupplyByResource;
+};
+
+/**
+ * The Observer's per-agent metrics, computed over every agent on the client.
+ * Per-currency arrays are indexed like Currencies, per-resource like
+ * Resources, CountByRole like Roles.
+ */
+struct FAgentEAggregates
+{
+    int32 Population = 0;
+    TArray<int32> CountByRole;
+
+    TArray<double> SupplyByCurrency;
+    TArray<double> GiniByCurrency;
+    TArray<double> MedianByCurrency;
+    TArray<double> Top10ShareByCurrency;
+
+    TArray<double> SupplyByResource;
+};
+
+/**
+ * What changed since the previous capture, when change tracking is on. Bit
+ * arrays are indexed by agent, column flags by currency / resource.
+ */
+struct FAgentEChangeSet
+{
+    /** Agents with any changed value, and slots whose agent was added, removed or swapped in */
+    TBitArray<> Agents;
+    TBitArray<> Roles;
+
+    /** [Currency] / [Resource]: agents whose value in that column changed */
+    TArray<TBitArray<>> Balances;
+    TArray<TBitArray<>> Inventories;
+
+    /** Columns with any change, agents added or removed included */
+    TBitArray<> BalanceColumns;
+    TBitArray<> InventoryColumns;
+};
+
+/** Running totals over every agent, kept by the mutation hooks while change tracking is on */
+struct FAgentETotals
+{
+    TArray<double> SupplyByCurrency;
+    TArray<double> SupplyByResource;
+    TArray<int32> CountByRole;
+};
+
+/**
+ * Copying is cheap by design: the name table is shared and the columns are
+ * POD, so a copy is a refcount bump plus one memcpy per column. That copy is
+ * the snapshot UAgentEClient hands to its send task; CopyFrom makes it into
+ * a recycled snapshot without reallocating its columns.
+ */
+struct FAgentEEconomyState
+{
+    FAgentEEconomyState();
+
+    const TArray<FString>& Roles() const { return Names->Roles; }
+    const TArray<FString>& Resources() const { return Names->Resources; }
+    const TArray<FString>& Currencies() const { return Names->Currencies; }
+    const TArray<FString>& AgentIds() const { return Names->AgentIds; }
+
+    /** Role index (into Roles) per agent */
+    TArray<uint16> AgentRoles;
+
+    /** [Currency][Agent] balances */
+    TArray<TArray<double>> Balances;
+
+    /** [Resource][Agent] quantities — zeros are omitted on the wire */
+    TArray<TArray<double>> Inventories;
+
+    /** [Currency][Resource] prices */
+    TArray<TArray<double>> MarketPrices;
+
+    /** Events since the last send — cleared after each tick is built */
+    TArray<FAgentEEvent> RecentTransactions;
+
+    /** Set on sampled snapshots only; the agents above are then a sample */
+    TSharedPtr<const FAgentESampleInfo, ESPMode::ThreadSafe> Sampling;
+
+    /** Set on pre-aggregated snapshots only, by the send task */
+    TSharedPtr<const FAgentEAggregates, ESPMode::ThreadSafe> Aggregates;
+
+    /** Agent IDs as FNames, indexed by agent index */
+    TConstArrayView<FName> AgentNames() const { return Names->AgentNames; }
+
+    int32 NumAgents() const { return Names->AgentIds.Num(); }
+
+    /** Index of an agent / role / resource / currency, INDEX_NONE when absent */
+    int32 FindAgent(FName AgentId) const;
+    int32 FindRole(FName Role) const { return Names->RoleNames.IndexOfByKey(Role); }
+    int32 FindResource(FName Resource) const { return Names->ResourceNames.IndexOfByKey(Resource); }
+    int32 FindCurrency(FName Currency) const { return Names->CurrencyNames.IndexOfByKey(Currency); }
+
+    /** Declare currencies/resources and size the price table. Existing agents are kept. */
+    void SetSchema(TArray<FString> InRoles, TArray<FString> InResources, TArray<FString> InCurrencies);
+
+    /**
+     * Append an agent with zeroed balances and inventory; returns its index.
+     * An ID that is already present is not added again: its index is returned.
+     */
+    int32 AddAgent(const FString& AgentId, uint16 RoleIndex);
+    int32 AddAgent(FName AgentId, uint16 RoleIndex);
+
+    /** Remove an agent by swapping the last agent into its slot */
+    void RemoveAgent(int32 AgentIndex);
+
+    /** Remove an agent by ID; false if it is not present */
+    bool RemoveAgent(FName AgentId);
+
+    /** Drop all agents and events, keeping schema and allocations */
+    void ResetAgents();
+
+    /**
+     * Become a copy of Other, reusing this state's array capacity. Returns
+     * true when an array had to grow — the only case in which it allocates.
+     */
+    bool CopyFrom(const FAgentEEconomyState& Other);
+
+    /** True when both states share one agent ID table (no adds/removes in between) */
+    bool SharesAgentIds(const FAgentEEconomyState& Other) const { return Names == Other.Names; }
+
+    /** Bumped by SetSchema/ResetAgents — deltas only apply within one epoch */
+    uint32 GetSchemaEpoch() const { return SchemaEpoch; }
+
+    // ── Change tracking ──
+
+    /**
+     * Start recording changes: totals are computed once from the columns,
+     * then kept up to date by the hooks below, which must from now on carry
+     * every write to AgentRoles, Balances and Inventories.
+     */
+    void TrackChanges();
+    bool IsTrackingChanges() const { return ChangeSerial != 0; }
+
+    /**
+     * Changes since the previous ClearChanges. A snapshot's changes are
+     * relative to the snapshot whose serial is one lower.
+     */
+    const FAgentEChangeSet& GetChanges() const { return Changes; }
+    uint64 GetChangeSerial() const { return ChangeSerial; }
+
+    /** Valid only while tracking changes */
+    const FAgentETotals& GetTotals() const { return Totals; }
+
+    /** Start the next change set; costs O(changed agents), done after each capture */
+    void ClearChanges();
+
+    /** Mutation hooks: write one value and, while tracking, record the change */
+    void SetBalance(int32 AgentIndex, int32 CurrencyIndex, double Value)
+    {
+        double& Slot = Balances[CurrencyIndex][AgentIndex];
+        if (IsTrackingChanges() && Slot != Value)
+        {
+            Totals.SupplyByCurrency[CurrencyIndex] += Value - Slot;
+            Changes.Balances[CurrencyIndex][AgentIndex] = true;
+            Changes.BalanceColumns[CurrencyIndex] = true;
+            Changes.Agents[AgentIndex] = true;
+        }
+        Slot = Value;
+    }
+    void AddBalance(int32 AgentIndex, int32 CurrencyIndex, double Delta)
+    {
+        SetBalance(AgentIndex, CurrencyIndex, Balances[CurrencyIndex][AgentIndex] + Delta);
+    }
+    void SetInventory(int32 AgentIndex, int32 ResourceIndex, double Quantity)
+    {
+        double& Slot = Inventories[ResourceIndex][AgentIndex];
+        if (IsTrackingChanges() && Slot != Quantity)
+        {
+            Totals.SupplyByResource[ResourceIndex] += Quantity - Slot;
+            Changes.Inventories[ResourceIndex][AgentIndex] = true;
+            Changes.InventoryColumns[ResourceIndex] = true;
+            Changes.Agents[AgentIndex] = true;
+        }
+        Slot = Quantity;
+    }
+    void AddInventory(int32 AgentIndex, int32 ResourceIndex, double Delta)
+    {
+        SetInventory(AgentIndex, ResourceIndex, Inventories[ResourceIndex][AgentIndex] + Delta);
+    }
+    void SetRole(int32 AgentIndex, uint16 RoleIndex);
+
+    /** Prices go out whole in every body; no tracking needed */
+    void SetPrice(int32 CurrencyIndex, int32 ResourceIndex, double Price)
+    {
+        MarketPrices[CurrencyIndex][ResourceIndex] = Price;
+    }
+
+private:
+    TSharedRef<FAgentENameTable, ESPMode::ThreadSafe> Names;
+    uint32 SchemaEpoch = 0;
+
+    /** 0 while not tracking; bumped by ClearChanges */
+    uint64 ChangeSerial = 0;
+    FAgentEChangeSet Changes;
+    FAgentETotals Totals;
+
+    /** Tracking only: size the change set to the schema and agents, clear it, recount the totals */
+    void ResetTracking();
+
+    /** Tracking only: an agent slot's values all changed (added, removed or swapped in) */
+    void MarkAgentSlot(int32 AgentIndex);
+
+    /** Clone the name table if a snapshot still references it */
+    FAgentENameTable& MutableNames();
+
+    int32 AddAgent(FName AgentId, const FString& DisplayId, uint16 RoleIndex);
+};
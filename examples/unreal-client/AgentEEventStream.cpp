@@ -0,0 +1,193 @@
+/**
+ * AgentE Unreal Engine Client — Event Stream
+ *
+ * See AgentEEventStream.h.
+ *
+ * Slots are guarded by a per-slot sequence number (a seqlock): DropOldest
+ * lets a producer lap the consumer, so the consumer copies a slot and keeps
+ * the copy only if the slot's sequence was unchanged across the copy.
+ */
+
+#include "AgentEEventStream.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/ScopeLock.h"
+
+static std::atomic<uint64> GNextStreamId { 1 };
+
+/** Last ring this thread recorded into — one stream per game is the common case */
+struct FAgentEThreadRingCache
+{
+    uint64 StreamId = 0;
+    void* Ring = nullptr;
+};
+static thread_local FAgentEThreadRingCache GThreadRing;
+
+FAgentEEventStream::FRing::FRing(uint32 Capacity, uint32 InThreadId)
+    : Mask(Capacity - 1)
+    , ThreadId(InThreadId)
+{
+    // FSlot holds an atomic, so build in place instead of copying
+    Slots.SetNum(Capacity);
+}
+
+FAgentEEventStream::FAgentEEventStream(int32 InRingCapacity, EAgentEEventOverflow InOverflow, int32 InSampleRate)
+    : StreamId(GNextStreamId.fetch_add(1, std::memory_order_relaxed))
+    , RingCapacity(FMath::RoundUpToPowerOfTwo(uint32(FMath::Max(InRingCapacity, 16))))
+    , Overflow(InOverflow)
+    , SampleRate(uint32(FMath::Max(InSampleRate, 1)))
+{
+}
+
+FAgentEEventStream::FRing& FAgentEEventStream::RingForThisThread()
+{
+    if (GThreadRing.StreamId == StreamId)
+    {
+        return *static_cast<FRing*>(GThreadRing.Ring);
+    }
+
+    const uint32 ThreadId = FPlatformTLS::GetCurrentThreadId();
+    FRing* Ring = nullptr;
+    {
+        FScopeLock Lock(&RegistryLock);
+        for (const TUniquePtr<FRing>& Existing : Rings)
+        {
+            if (Existing->ThreadId == ThreadId)
+            {
+                Ring = Existing.Get();
+                break;
+            }
+        }
+        if (!Ring)
+        {
+            Ring = Rings.Add_GetRef(MakeUnique<FRing>(RingCapacity, ThreadId)).Get();
+        }
+    }
+
+    GThreadRing.StreamId = StreamId;
+    GThreadRing.Ring = Ring;
+    return *Ring;
+}
+
+bool FAgentEEventStream::Record(const FAgentEEvent& Event)
+{
+    FRing& Ring = RingForThisThread();
+    const uint64 Capacity = uint64(Ring.Mask) + 1;
+
+    const uint64 Head = Ring.Head.load(std::memory_order_relaxed);
+    if (Overflow != EAgentEEventOverflow::DropOldest)
+    {
+        const uint64 Used = Head - Ring.Tail.load(std::memory_order_acquire);
+        if (Used >= Capacity)
+        {
+            Bump(Ring.DroppedFull);
+            bFlushRequested.store(true, std::memory_order_relaxed);
+            return false;
+        }
+        if (Overflow == EAgentEEventOverflow::Sample && Used >= Capacity - Capacity / 4)
+        {
+            if (Ring.SamplePhase++ % SampleRate != 0)
+            {
+                Bump(Ring.SampledOut);
+                return false;
+            }
+        }
+        if (Used + 1 == Capacity / 2)
+        {
+            bFlushRequested.store(true, std::memory_order_relaxed);
+        }
+    }
+    else if ((Head & (Capacity / 2 - 1)) == 0)
+    {
+        // No tail read on this path; ask for a flush every half ring instead
+        bFlushRequested.store(true, std::memory_order_relaxed);
+    }
+
+    FSlot& Slot = Ring.Slots[Head & Ring.Mask];
+    Slot.Seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    Slot.Event = Event;
+    Slot.Seq.store(Head + 1, std::memory_order_release);
+
+    Ring.Head.store(Head + 1, std::memory_order_release);
+    Bump(Ring.Recorded);
+    return true;
+}
+
+int32 FAgentEEventStream::Drain(TArray<FAgentEEvent>& Out, int32 MaxEvents)
+{
+    TArray<FRing*, TInlineAllocator<16>> Snapshot;
+    {
+        FScopeLock Lock(&RegistryLock);
+        for (const TUniquePtr<FRing>& Ring : Rings)
+        {
+            Snapshot.Add(Ring.Get());
+        }
+    }
+    if (Snapshot.IsEmpty())
+    {
+        return 0;
+    }
+
+    int32 Taken = 0;
+    const int32 Start = NextRing % Snapshot.Num();
+    for (int32 I = 0; I < Snapshot.Num() && Taken < MaxEvents; ++I)
+    {
+        FRing& Ring = *Snapshot[(Start + I) % Snapshot.Num()];
+        const uint64 Capacity = uint64(Ring.Mask) + 1;
+        uint64 Tail = Ring.Tail.load(std::memory_order_relaxed);
+        const uint64 Head = Ring.Head.load(std::memory_order_acquire);
+
+        // Lapped (DropOldest): everything older than one ring is gone
+        uint64 Lost = 0;
+        if (Head - Tail > Capacity)
+        {
+            Lost += Head - Capacity - Tail;
+            Tail = Head - Capacity;
+        }
+
+        while (Tail < Head && Taken < MaxEvents)
+        {
+            const FSlot& Slot = Ring.Slots[Tail & Ring.Mask];
+            const uint64 Before = Slot.Seq.load(std::memory_order_acquire);
+            if (Before == Tail + 1)
+            {
+                FAgentEEvent Copy = Slot.Event;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (Slot.Seq.load(std::memory_order_relaxed) == Before)
+                {
+                    Out.Add(Copy);
+                    ++Taken;
+                    ++Tail;
+                    continue;
+                }
+            }
+            // Overwritten (or being overwritten) since Head was read
+            ++Lost;
+            ++Tail;
+        }
+
+        Ring.Tail.store(Tail, std::memory_order_release);
+        if (Lost > 0)
+        {
+            Bump(Ring.Overwritten, Lost);
+        }
+    }
+    NextRing = Start + 1;
+    Drained.fetch_add(uint64(Taken), std::memory_order_relaxed);
+    return Taken;
+}
+
+FAgentEEventStats FAgentEEventStream::GetStats() const
+{
+    FAgentEEventStats Stats;
+    FScopeLock Lock(&RegistryLock);
+    for (const TUniquePtr<FRing>& Ring : Rings)
+    {
+        Stats.Recorded += int64(Ring->Recorded.load(std::memory_order_relaxed));
+        Stats.DroppedFull += int64(Ring->DroppedFull.load(std::memory_order_relaxed));
+        Stats.SampledOut += int64(Ring->SampledOut.load(std::memory_order_relaxed));
+        Stats.Overwritten += int64(Ring->Overwritten.load(std::memory_order_relaxed));
+    }
+    Stats.Drained = int64(Drained.load(std::memory_order_relaxed));
+    return Stats;
+}
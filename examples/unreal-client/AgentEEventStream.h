@@ -0,0 +1,137 @@
+/**
+ * AgentE Unreal Engine Client — Event Stream
+ *
+ * Where UAgentEClient::RecordEvent puts events until the flusher sends them.
+ * Producers can be any number of threads — game thread, task-graph workers,
+ * audio, ... — with no locks and no hop to the game thread.
+ *
+ * Each producing thread gets its own ring, found through a thread-local
+ * cache, so recording is a copy plus a few release stores — no lock and no
+ * allocation (event IDs are FNames). The registry lock is taken only the
+ * first time a thread records into a given stream. One consumer (the flusher
+ * task) drains all rings, so every ring is single-producer/single-consumer
+ * and the set of rings is the multi-producer queue.
+ *
+ * Memory is bounded: RingCapacity events per producing thread. What happens
+ * when a ring is full is the overflow policy; every lost event is counted.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+#include "AgentEEconomyState.h"
+#include "AgentEEventStream.generated.h"
+
+UENUM(BlueprintType)
+enum class EAgentEEventOverflow : uint8
+{
+    /** Full ring: the new event is dropped */
+    DropNewest,
+
+    /** Full ring: the new event overwrites the oldest unsent one */
+    DropOldest,
+
+    /** Ring 3/4 full: keep 1 in SampleRate events; full ring: drop newest */
+    Sample,
+};
+
+/** Counters since the stream was created — all producers summed */
+USTRUCT(BlueprintType)
+struct FAgentEEventStats
+{
+    GENERATED_BODY()
+
+    /** Accepted into a ring */
+    UPROPERTY(BlueprintReadOnly)
+    int64 Recorded = 0;
+
+    /** Rejected because the ring was full (DropNewest, Sample) */
+    UPROPERTY(BlueprintReadOnly)
+    int64 DroppedFull = 0;
+
+    /** Skipped by the Sample policy */
+    UPROPERTY(BlueprintReadOnly)
+    int64 SampledOut = 0;
+
+    /** Overwritten before the flusher reached them (DropOldest) */
+    UPROPERTY(BlueprintReadOnly)
+    int64 Overwritten = 0;
+
+    /** Handed to the transport */
+    UPROPERTY(BlueprintReadOnly)
+    int64 Drained = 0;
+
+    int64 TotalLost() const { return DroppedFull + SampledOut + Overwritten; }
+};
+
+class FAgentEEventStream
+{
+public:
+    /** RingCapacity is per producing thread, rounded up to a power of two */
+    FAgentEEventStream(int32 RingCapacity, EAgentEEventOverflow InOverflow, int32 InSampleRate);
+
+    /** Any thread. Append one event; false when the policy dropped it. */
+    bool Record(const FAgentEEvent& Event);
+
+    /** Consumer only. Move up to MaxEvents into Out; returns how many */
+    int32 Drain(TArray<FAgentEEvent>& Out, int32 MaxEvents);
+
+    /** True once a ring passed half full since the last call — flush early */
+    bool ConsumeFlushRequest() { return bFlushRequested.exchange(false, std::memory_order_relaxed); }
+
+    /** Any thread. Counters are read without stopping producers, so they are approximate while recording */
+    FAgentEEventStats GetStats() const;
+
+private:
+    struct FSlot
+    {
+        /** Position + 1 once the event is complete, 0 while it is being written */
+        std::atomic<uint64> Seq { ~uint64(0) };
+        FAgentEEvent Event;
+    };
+
+    struct FRing
+    {
+        FRing(uint32 Capacity, uint32 InThreadId);
+
+        TArray<FSlot> Slots;
+        uint32 Mask;
+        uint32 ThreadId;
+
+        /** Producer-owned: position, write counters, sampling phase */
+        alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> Head { 0 };
+        std::atomic<uint64> Recorded { 0 };
+        std::atomic<uint64> DroppedFull { 0 };
+        std::atomic<uint64> SampledOut { 0 };
+        uint32 SamplePhase = 0;
+
+        /** Consumer-owned */
+        alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> Tail { 0 };
+        std::atomic<uint64> Overwritten { 0 };
+    };
+
+    /** Distinguishes streams in the thread-local cache, even at a reused address */
+    const uint64 StreamId;
+    const uint32 RingCapacity;
+    const EAgentEEventOverflow Overflow;
+    const uint32 SampleRate;
+
+    mutable FCriticalSection RegistryLock;
+    TArray<TUniquePtr<FRing>> Rings;
+
+    /** Consumer's round-robin start, so no ring starves when MaxEvents is hit */
+    int32 NextRing = 0;
+    std::atomic<uint64> Drained { 0 };
+
+    std::atomic<bool> bFlushRequested { false };
+
+    FRing& RingForThisThread();
+
+    /** Single-writer counter bump — no locked RMW on the producer path */
+    static void Bump(std::atomic<uint64>& Counter, uint64 By = 1)
+    {
+        Counter.store(Counter.load(std::memory_order_relaxed) + By, std::memory_order_relaxed);
+    }
+};
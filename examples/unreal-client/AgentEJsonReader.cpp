@@ -0,0 +1,421 @@
+/**
+ * AgentE Unreal Engine Client — Pull JSON Reader
+ *
+ * See AgentEJsonReader.h.
+ */
+
+#include "AgentEJsonReader.h"
+
+/** Containers deeper than this are rejected by Skip */
+static constexpr int32 MaxDepth = 32;
+
+void FAgentEJsonReader::SkipWhitespace()
+{
+    while (Pos < Num && (Data[Pos] == ' ' || Data[Pos] == '\t' || Data[Pos] == '\n' || Data[Pos] == '\r'))
+    {
+        ++Pos;
+    }
+}
+
+bool FAgentEJsonReader::Expect(uint8 C)
+{
+    SkipWhitespace();
+    if (Pos >= Num || Data[Pos] != C)
+    {
+        return Fail();
+    }
+    ++Pos;
+    return true;
+}
+
+bool FAgentEJsonReader::Literal(const ANSICHAR* Word, int32 Len)
+{
+    if (Pos + Len > Num || FMemory::Memcmp(Data + Pos, Word, Len) != 0)
+    {
+        return Fail();
+    }
+    Pos += Len;
+    return true;
+}
+
+EAgentEJsonType FAgentEJsonReader::PeekType()
+{
+    if (bError)
+    {
+        return EAgentEJsonType::Invalid;
+    }
+    SkipWhitespace();
+    if (Pos >= Num)
+    {
+        return EAgentEJsonType::Invalid;
+    }
+    switch (Data[Pos])
+    {
+    case '{': return EAgentEJsonType::Object;
+    case '[': return EAgentEJsonType::Array;
+    case '"': return EAgentEJsonType::String;
+    case 't':
+    case 'f': return EAgentEJsonType::Bool;
+    case 'n': return EAgentEJsonType::Null;
+    default:
+        return (Data[Pos] == '-' || (Data[Pos] >= '0' && Data[Pos] <= '9'))
+            ? EAgentEJsonType::Number
+            : EAgentEJsonType::Invalid;
+    }
+}
+
+bool FAgentEJsonReader::BeginObject()
+{
+    if (bError || !Expect('{'))
+    {
+        return false;
+    }
+    bFirst = true;
+    return true;
+}
+
+bool FAgentEJsonReader::BeginArray()
+{
+    if (bError || !Expect('['))
+    {
+        return false;
+    }
+    bFirst = true;
+    return true;
+}
+
+bool FAgentEJsonReader::EndOrComma(uint8 Close)
+{
+    SkipWhitespace();
+    if (Pos >= Num)
+    {
+        return Fail();
+    }
+    if (Data[Pos] == Close)
+    {
+        ++Pos;
+        bFirst = false;
+        return false;
+    }
+    if (!bFirst)
+    {
+        if (Data[Pos] != ',')
+        {
+            return Fail();
+        }
+        ++Pos;
+    }
+    bFirst = false;
+    return true;
+}
+
+bool FAgentEJsonReader::NextKey(FUtf8StringView& OutKey)
+{
+    if (bError || !EndOrComma('}'))
+    {
+        return false;
+    }
+    return ReadStringView(OutKey) && Expect(':');
+}
+
+bool FAgentEJsonReader::NextElement()
+{
+    return !bError && EndOrComma(']');
+}
+
+bool FAgentEJsonReader::ReadStringView(FUtf8StringView& Out)
+{
+    if (bError || !Expect('"'))
+    {
+        return false;
+    }
+
+    const int32 Start = Pos;
+    bool bEscaped = false;
+    while (Pos < Num && Data[Pos] != '"')
+    {
+        if (Data[Pos] == '\\')
+        {
+            bEscaped = true;
+            ++Pos;
+        }
+        ++Pos;
+    }
+    if (Pos >= Num)
+    {
+        return Fail();
+    }
+    const int32 End = Pos++;
+
+    if (!bEscaped)
+    {
+        Out = FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Data + Start), End - Start);
+        return true;
+    }
+    return DecodeEscaped(Start, End, Out);
+}
+
+static int32 HexDigit(uint8 C)
+{
+    if (C >= '0' && C <= '9') return C - '0';
+    if (C >= 'a' && C <= 'f') return C - 'a' + 10;
+    if (C >= 'A' && C <= 'F') return C - 'A' + 10;
+    return -1;
+}
+
+bool FAgentEJsonReader::DecodeEscaped(int32 Start, int32 End, FUtf8StringView& Out)
+{
+    Scratch.Reset();
+
+    auto ReadHex4 = [this, End](int32 At, uint32& Unit) -> bool
+    {
+        if (At + 4 > End)
+        {
+            return false;
+        }
+        Unit = 0;
+        for (int32 I = 0; I < 4; ++I)
+        {
+            const int32 D = HexDigit(Data[At + I]);
+            if (D < 0)
+            {
+                return false;
+            }
+            Unit = (Unit << 4) | uint32(D);
+        }
+        return true;
+    };
+
+    for (int32 I = Start; I < End; ++I)
+    {
+        const uint8 C = Data[I];
+        if (C != '\\')
+        {
+            Scratch.Add(UTF8CHAR(C));
+            continue;
+        }
+
+        const uint8 E = Data[++I];
+        switch (E)
+        {
+        case '"':  Scratch.Add(UTF8CHAR('"')); break;
+        case '\\': Scratch.Add(UTF8CHAR('\\')); break;
+        case '/':  Scratch.Add(UTF8CHAR('/')); break;
+        case 'b':  Scratch.Add(UTF8CHAR('\b')); break;
+        case 'f':  Scratch.Add(UTF8CHAR('\f')); break;
+        case 'n':  Scratch.Add(UTF8CHAR('\n')); break;
+        case 'r':  Scratch.Add(UTF8CHAR('\r')); break;
+        case 't':  Scratch.Add(UTF8CHAR('\t')); break;
+        case 'u':
+        {
+            uint32 Code = 0;
+            if (!ReadHex4(I + 1, Code))
+            {
+                return Fail();
+            }
+            I += 4;
+
+            // Surrogate pair
+            if (Code >= 0xD800 && Code <= 0xDBFF)
+            {
+                uint32 Low = 0;
+                if (I + 2 < End && Data[I + 1] == '\\' && Data[I + 2] == 'u'
+                    && ReadHex4(I + 3, Low) && Low >= 0xDC00 && Low <= 0xDFFF)
+                {
+                    Code = 0x10000 + ((Code - 0xD800) << 10) + (Low - 0xDC00);
+                    I += 6;
+                }
+                else
+                {
+                    Code = 0xFFFD;
+                }
+            }
+            else if (Code >= 0xDC00 && Code <= 0xDFFF)
+            {
+                Code = 0xFFFD;
+            }
+
+            if (Code < 0x80)
+            {
+                Scratch.Add(UTF8CHAR(Code));
+            }
+            else if (Code < 0x800)
+            {
+                Scratch.Add(UTF8CHAR(0xC0 | (Code >> 6)));
+                Scratch.Add(UTF8CHAR(0x80 | (Code & 0x3F)));
+            }
+            else if (Code < 0x10000)
+            {
+                Scratch.Add(UTF8CHAR(0xE0 | (Code >> 12)));
+                Scratch.Add(UTF8CHAR(0x80 | ((Code >> 6) & 0x3F)));
+                Scratch.Add(UTF8CHAR(0x80 | (Code & 0x3F)));
+            }
+            else
+            {
+                Scratch.Add(UTF8CHAR(0xF0 | (Code >> 18)));
+                Scratch.Add(UTF8CHAR(0x80 | ((Code >> 12) & 0x3F)));
+                Scratch.Add(UTF8CHAR(0x80 | ((Code >> 6) & 0x3F)));
+                Scratch.Add(UTF8CHAR(0x80 | (Code & 0x3F)));
+            }
+            break;
+        }
+        default:
+            return Fail();
+        }
+    }
+
+    Out = FUtf8StringView(Scratch.GetData(), Scratch.Num());
+    return true;
+}
+
+bool FAgentEJsonReader::ReadString(FString& Out)
+{
+    FUtf8StringView View;
+    if (!ReadStringView(View))
+    {
+        return false;
+    }
+    Out = FString(View);
+    return true;
+}
+
+bool FAgentEJsonReader::ReadNumber(double& Out)
+{
+    if (PeekType() != EAgentEJsonType::Number)
+    {
+        return Fail();
+    }
+
+    const int32 Start = Pos;
+    while (Pos < Num)
+    {
+        const uint8 C = Data[Pos];
+        if ((C >= '0' && C <= '9') || C == '-' || C == '+' || C == '.' || C == 'e' || C == 'E')
+        {
+            ++Pos;
+            continue;
+        }
+        break;
+    }
+
+    // Atod needs a terminator; numbers in a tick reply are short
+    ANSICHAR Buffer[64];
+    const int32 Len = Pos - Start;
+    if (Len >= UE_ARRAY_COUNT(Buffer))
+    {
+        return Fail();
+    }
+    FMemory::Memcpy(Buffer, Data + Start, Len);
+    Buffer[Len] = '\0';
+    Out = FCStringAnsi::Atod(Buffer);
+    return true;
+}
+
+bool FAgentEJsonReader::ReadBool(bool& Out)
+{
+    const EAgentEJsonType Type = PeekType();
+    if (Type != EAgentEJsonType::Bool)
+    {
+        return Fail();
+    }
+    Out = Data[Pos] == 't';
+    return Out ? Literal("true", 4) : Literal("false", 5);
+}
+
+bool FAgentEJsonReader::ReadNull()
+{
+    if (PeekType() != EAgentEJsonType::Null)
+    {
+        return Fail();
+    }
+    return Literal("null", 4);
+}
+
+bool FAgentEJsonReader::Skip()
+{
+    // Iterative with a fixed stack of open containers, so a hostile reply
+    // cannot overflow the call stack
+    uint8 Open[MaxDepth];
+    int32 Depth = 0;
+    do
+    {
+        switch (PeekType())
+        {
+        case EAgentEJsonType::Object:
+        case EAgentEJsonType::Array:
+            if (Depth == MaxDepth)
+            {
+                return Fail();
+            }
+            Open[Depth++] = Data[Pos] == '{' ? '}' : ']';
+            ++Pos;
+            bFirst = true;
+            break;
+        case EAgentEJsonType::String:
+        {
+            FUtf8StringView Ignored;
+            if (!ReadStringView(Ignored)) return false;
+            break;
+        }
+        case EAgentEJsonType::Number:
+        {
+            double Ignored;
+            if (!ReadNumber(Ignored)) return false;
+            break;
+        }
+        case EAgentEJsonType::Bool:
+        {
+            bool Ignored;
+            if (!ReadBool(Ignored)) return false;
+            break;
+        }
+        case EAgentEJsonType::Null:
+            if (!ReadNull()) return false;
+            break;
+        default:
+            return Fail();
+        }
+
+        // Close finished containers, then step to the next value of the innermost open one
+        while (Depth > 0)
+        {
+            const uint8 Close = Open[Depth - 1];
+            if (Close == '}')
+            {
+                FUtf8StringView Key;
+                if (NextKey(Key))
+                {
+                    break;
+                }
+            }
+            else if (NextElement())
+            {
+                break;
+            }
+            if (bError)
+            {
+                return false;
+            }
+            --Depth;
+        }
+    }
+    while (Depth > 0);
+
+    return true;
+}
+
+bool FAgentEJsonReader::ReadRaw(TConstArrayView<uint8>& Out)
+{
+    if (bError)
+    {
+        return false;
+    }
+    SkipWhitespace();
+    const int32 Start = Pos;
+    if (!Skip())
+    {
+        return false;
+    }
+    Out = TConstArrayView<uint8>(Data + Start, Pos - Start);
+    return true;
+}
@@ -0,0 +1,92 @@
+/**
+ * AgentE Unreal Engine Client — Pull JSON Reader
+ *
+ * Reads JSON straight from the UTF-8 reply bytes, one value at a time, so a
+ * tick reply is parsed without a DOM, without FJsonObject/FJsonValue and
+ * without an FString per key. Strings come back as views into the input;
+ * only strings containing escapes are decoded, into a scratch buffer that is
+ * reused for the life of the reader.
+ *
+ * Same method names as FAgentEMsgPackReader, so parsers can be written once
+ * for both wire formats:
+ *
+ *   R.BeginObject();
+ *   while (R.NextKey(Key)) { if (Key is "health") R.ReadNumber(H); else R.Skip(); }
+ *
+ * Errors are sticky: after the first one every call returns false.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EAgentEJsonType : uint8
+{
+    Object,
+    Array,
+    String,
+    Number,
+    Bool,
+    Null,
+    Invalid,
+};
+
+class FAgentEJsonReader
+{
+public:
+    FAgentEJsonReader(const uint8* InData, int32 InNum) : Data(InData), Num(InNum) {}
+
+    /** Type of the next value (skips whitespace; does not consume) */
+    EAgentEJsonType PeekType();
+    bool HasError() const { return bError; }
+
+    bool BeginObject();
+
+    /** Next key of the current object; false (and '}' consumed) at its end */
+    bool NextKey(FUtf8StringView& OutKey);
+
+    bool BeginArray();
+
+    /** True if another element follows; false (and ']' consumed) at the end */
+    bool NextElement();
+
+    /** View valid until the next read */
+    bool ReadStringView(FUtf8StringView& Out);
+    bool ReadString(FString& Out);
+    bool ReadNumber(double& Out);
+    bool ReadBool(bool& Out);
+    bool ReadNull();
+
+    /** Skip one value, including nested containers */
+    bool Skip();
+
+    /** Skip one value and return its bytes (a view into the input) */
+    bool ReadRaw(TConstArrayView<uint8>& Out);
+
+private:
+    const uint8* Data;
+    int32 Num;
+    int32 Pos = 0;
+    bool bError = false;
+
+    /** First key/element of the container just opened — no comma expected */
+    bool bFirst = false;
+
+    /** Decoded escaped strings; reused, so no allocation after warm-up */
+    TArray<UTF8CHAR> Scratch;
+
+    bool Fail() { bError = true; return false; }
+    void SkipWhitespace();
+    bool Expect(uint8 C);
+    bool Literal(const ANSICHAR* Word, int32 Len);
+    bool EndOrComma(uint8 Close);
+    bool DecodeEscaped(int32 Start, int32 End, FUtf8StringView& Out);
+};
+
+/** True when a UTF-8 key equals an ASCII literal */
+inline bool AgentEKeyIs(FUtf8StringView Key, const ANSICHAR* Literal)
+{
+    const int32 Len = FCStringAnsi::Strlen(Literal);
+    return Key.Len() == Len
+        && FCStringAnsi::Strncmp(reinterpret_cast<const ANSICHAR*>(Key.GetData()), Literal, Len) == 0;
+}
@@ -0,0 +1,100 @@
+/**
+ * AgentE Unreal Engine Client — Key Table
+ *
+ * See AgentEKeyTable.h.
+ */
+
+#include "AgentEKeyTable.h"
+#include "Hash/CityHash.h"
+
+uint32 FAgentEKeyTable::HashOf(FUtf8StringView Key)
+{
+    return CityHash32(reinterpret_cast<const char*>(Key.GetData()), uint32(Key.Len()));
+}
+
+int32 FAgentEKeyTable::FindLocked(FUtf8StringView Key, uint32 Hash) const
+{
+    const int32* Head = Buckets.Find(Hash);
+    for (int32 Index = Head ? *Head : INDEX_NONE; Index != INDEX_NONE; Index = Entries[Index]->NextInBucket)
+    {
+        const FEntry& Entry = *Entries[Index];
+        if (Entry.Utf8.Num() == Key.Len()
+            && FMemory::Memcmp(Entry.Utf8.GetData(), Key.GetData(), Key.Len()) == 0)
+        {
+            return Index;
+        }
+    }
+    return INDEX_NONE;
+}
+
+int32 FAgentEKeyTable::Find(FUtf8StringView Key) const
+{
+    const uint32 Hash = HashOf(Key);
+    FReadScopeLock ReadLock(Lock);
+    return FindLocked(Key, Hash);
+}
+
+int32 FAgentEKeyTable::FindOrAdd(FUtf8StringView Key)
+{
+    const uint32 Hash = HashOf(Key);
+    {
+        FReadScopeLock ReadLock(Lock);
+        const int32 Found = FindLocked(Key, Hash);
+        if (Found != INDEX_NONE)
+        {
+            return Found;
+        }
+    }
+
+    // Build the entry outside the write lock; another thread may win the race
+    TUniquePtr<FEntry> Entry = MakeUnique<FEntry>();
+    Entry->Utf8.Append(Key.GetData(), Key.Len());
+    Entry->String = FString(Key);
+    Entry->Name = FName(*Entry->String);
+
+    FWriteScopeLock WriteLock(Lock);
+    const int32 Found = FindLocked(Key, Hash);
+    if (Found != INDEX_NONE)
+    {
+        return Found;
+    }
+    int32& Head = Buckets.FindOrAdd(Hash, INDEX_NONE);
+    Entry->NextInBucket = Head;
+    Head = Entries.Add(MoveTemp(Entry));
+    return Head;
+}
+
+int32 FAgentEKeyTable::FindOrAdd(const FString& Key)
+{
+    const FTCHARToUTF8 Utf8(*Key);
+    return FindOrAdd(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Utf8.Get()), Utf8.Length()));
+}
+
+const FString& FAgentEKeyTable::GetString(int32 Handle) const
+{
+    static const FString Empty;
+    if (Handle == INDEX_NONE)
+    {
+        return Empty;
+    }
+    FReadScopeLock ReadLock(Lock);
+    check(Entries.IsValidIndex(Handle));
+    return Entries[Handle]->String;
+}
+
+FName FAgentEKeyTable::GetName(int32 Handle) const
+{
+    if (Handle == INDEX_NONE)
+    {
+        return NAME_None;
+    }
+    FReadScopeLock ReadLock(Lock);
+    check(Entries.IsValidIndex(Handle));
+    return Entries[Handle]->Name;
+}
+
+int32 FAgentEKeyTable::Num() const
+{
+    FReadScopeLock ReadLock(Lock);
+    return Entries.Num();
+}
@@ -0,0 +1,58 @@
+/**
+ * AgentE Unreal Engine Client — Key Table
+ *
+ * Interns the strings tick replies repeat on every tick — parameter keys,
+ * principle ids and names — and hands out stable int32 handles for them.
+ * Reply parsers look keys up straight from the UTF-8 bytes on the wire
+ * (hash plus one compare), so a known key costs no FString, no FName and no
+ * allocation. A key seen for the first time is added once; registering
+ * parameters up front (UAgentEClient::RegisterParameter) moves even that
+ * out of the reply path.
+ *
+ * Any thread: lookups take a shared lock, first sightings an exclusive one.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+
+class FAgentEKeyTable
+{
+public:
+    /** Handle for Key, INDEX_NONE if it was never added */
+    int32 Find(FUtf8StringView Key) const;
+
+    /** Handle for Key, adding it on first sight */
+    int32 FindOrAdd(FUtf8StringView Key);
+    int32 FindOrAdd(const FString& Key);
+    int32 FindOrAdd(FName Key) { return FindOrAdd(Key.ToString()); }
+
+    /** Reference stays valid for the table's lifetime; INDEX_NONE gives an empty string */
+    const FString& GetString(int32 Handle) const;
+    FName GetName(int32 Handle) const;
+
+    int32 Num() const;
+
+private:
+    struct FEntry
+    {
+        TArray<UTF8CHAR> Utf8;
+        FString String;
+        FName Name;
+
+        /** Next entry in the same hash bucket */
+        int32 NextInBucket = INDEX_NONE;
+    };
+
+    mutable FRWLock Lock;
+
+    /** Entries never move, so GetString references outlive the lock */
+    TArray<TUniquePtr<FEntry>> Entries;
+
+    /** Hash → first entry of its bucket */
+    TMap<uint32, int32> Buckets;
+
+    static uint32 HashOf(FUtf8StringView Key);
+    int32 FindLocked(FUtf8StringView Key, uint32 Hash) const;
+};
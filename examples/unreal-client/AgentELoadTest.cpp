@@ -0,0 +1,719 @@
+/**
+ * AgentE Unreal Engine Client — Load Test
+ *
+ * See AgentELoadTest.h.
+ */
+
+#include "AgentELoadTest.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "AgentEClient.h"
+
+// ─── Latency Histogram ──────────────────────────────────────────────────────
+
+static constexpr int32 HistogramSubBits = 5;
+static constexpr int32 HistogramSubBuckets = 1 << HistogramSubBits;
+
+/** Highest power of two of microseconds kept apart (about 25 days); slower samples share the top bins */
+static constexpr int32 HistogramMaxExponent = 40;
+static constexpr int32 HistogramBins = (HistogramMaxExponent - HistogramSubBits + 2) * HistogramSubBuckets;
+
+static int32 HistogramBin(uint64 Micros)
+{
+    Micros = FMath::Min(Micros, (uint64(1) << (HistogramMaxExponent + 1)) - 1);
+    if (Micros < uint64(HistogramSubBuckets))
+    {
+        return int32(Micros);
+    }
+    const int32 Exponent = int32(FMath::FloorLog2_64(Micros));
+    const int32 Sub = int32(Micros >> (Exponent - HistogramSubBits)) & (HistogramSubBuckets - 1);
+    return (Exponent - HistogramSubBits + 1) * HistogramSubBuckets + Sub;
+}
+
+/** Midpoint of a bin, in microseconds */
+static double HistogramBinMicros(int32 Bin)
+{
+    if (Bin < HistogramSubBuckets)
+    {
+        return double(Bin);
+    }
+    const int32 Exponent = Bin / HistogramSubBuckets + HistogramSubBits - 1;
+    const uint64 Width = uint64(1) << (Exponent - HistogramSubBits);
+    const uint64 Lower = uint64(HistogramSubBuckets + Bin % HistogramSubBuckets) * Width;
+    return double(Lower) + double(Width - 1) / 2.0;
+}
+
+FAgentELatencyHistogram::FAgentELatencyHistogram()
+{
+    Bins.SetNumZeroed(HistogramBins);
+}
+
+void FAgentELatencyHistogram::Add(double Ms)
+{
+    Ms = FMath::Max(Ms, 0.0);
+    ++Bins[HistogramBin(uint64(Ms * 1000.0))];
+    ++Count;
+    TotalMs += Ms;
+    Max = FMath::Max(Max, Ms);
+}
+
+void FAgentELatencyHistogram::Reset()
+{
+    FMemory::Memzero(Bins.GetData(), Bins.Num() * sizeof(int64));
+    Count = 0;
+    TotalMs = 0.0;
+    Max = 0.0;
+}
+
+double FAgentELatencyHistogram::Percentile(double P) const
+{
+    if (Count == 0)
+    {
+        return 0.0;
+    }
+    const int64 Rank = FMath::Clamp(int64(FMath::CeilToDouble(P * double(Count))), int64(1), Count);
+    int64 Seen = 0;
+    for (int32 Bin = 0; Bin < Bins.Num(); ++Bin)
+    {
+        Seen += Bins[Bin];
+        if (Seen >= Rank)
+        {
+            return FMath::Min(HistogramBinMicros(Bin) / 1000.0, Max);
+        }
+    }
+    return Max;
+}
+
+static FAgentELatencySummary Summarize(const FAgentELatencyHistogram& H)
+{
+    FAgentELatencySummary Out;
+    Out.Count = H.Num();
+    Out.MeanMs = H.MeanMs();
+    Out.P50Ms = H.Percentile(0.5);
+    Out.P99Ms = H.Percentile(0.99);
+    Out.P999Ms = H.Percentile(0.999);
+    Out.MaxMs = H.MaxMs();
+    return Out;
+}
+
+// ─── Virtual Clients ────────────────────────────────────────────────────────
+
+namespace
+{
+    struct FAgentEVirtualClient
+    {
+        UAgentEClient* Client = nullptr;
+        FRandomStream Rng;
+        double StartTime = 0.0;
+        bool bStarted = false;
+
+        /** Fractions of a change / an event carried to the next frame */
+        double ChurnDebt = 0.0;
+        double EventDebt = 0.0;
+
+        /** Event names, made once: FName creation takes a global lock */
+        TArray<FName> Actors;
+        TArray<FName> Resources;
+        TArray<FName> Currencies;
+    };
+
+    /** Client counters summed over the virtual clients */
+    struct FAgentELoadTotals
+    {
+        int64 TicksSent = 0;
+        int64 BytesSent = 0;
+        int64 BytesReceived = 0;
+        int32 InFlight = 0;
+    };
+
+    /** Every tick reply of every client, on the game thread */
+    struct FAgentELoadCollector
+    {
+        /** After the ramp: replies count towards the summary */
+        bool bSteady = false;
+        int64 Replies = 0;
+
+        /** Outcomes after the ramp; only the counters are used */
+        FAgentELoadTestPoint Totals;
+        FAgentELatencyHistogram RoundTrip;
+        FAgentELatencyHistogram Server;
+        FAgentELatencyHistogram Wait;
+
+        FAgentELoadTestPoint Bucket;
+        FAgentELatencyHistogram BucketRoundTrip;
+        FAgentELatencyHistogram BucketServer;
+
+        void OnReply(const FAgentETickResult& Reply)
+        {
+            ++Replies;
+            int64 FAgentELoadTestPoint::* Outcome = &FAgentELoadTestPoint::Ok;
+            if (Reply.bRateLimited)
+            {
+                Outcome = &FAgentELoadTestPoint::RateLimited;
+            }
+            else if (!Reply.Error.IsEmpty())
+            {
+                Outcome = &FAgentELoadTestPoint::Failed;
+            }
+            else if (!Reply.bHasTick && Reply.Tick < 0)
+            {
+                // 409: no tick ran; a stale reply still says which tick it was
+                Outcome = &FAgentELoadTestPoint::OutOfSync;
+            }
+            ++(Bucket.*Outcome);
+
+            const double RttMs = Reply.RttSeconds * 1000.0;
+            if (Reply.RttSeconds >= 0.0)
+            {
+                BucketRoundTrip.Add(RttMs);
+            }
+            if (Reply.ServerMs >= 0.0)
+            {
+                BucketServer.Add(Reply.ServerMs);
+            }
+
+            if (!bSteady)
+            {
+                return;
+            }
+            ++(Totals.*Outcome);
+            if (Reply.RttSeconds >= 0.0)
+            {
+                RoundTrip.Add(RttMs);
+            }
+            if (Reply.ServerMs >= 0.0)
+            {
+                Server.Add(Reply.ServerMs);
+                if (Reply.RttSeconds >= 0.0)
+                {
+                    Wait.Add(RttMs - Reply.ServerMs);
+                }
+            }
+        }
+
+        /** Close the bucket into Curve and start the next one */
+        void EndBucket(TArray<FAgentELoadTestPoint>& Curve, double Time, int32 Clients, int64 Sent)
+        {
+            Bucket.Time = Time;
+            Bucket.Clients = Clients;
+            Bucket.Sent = Sent;
+            Bucket.P50Ms = BucketRoundTrip.Percentile(0.5);
+            Bucket.P99Ms = BucketRoundTrip.Percentile(0.99);
+            Bucket.ServerP99Ms = BucketServer.Percentile(0.99);
+            Curve.Add(Bucket);
+            Bucket = FAgentELoadTestPoint();
+            BucketRoundTrip.Reset();
+            BucketServer.Reset();
+        }
+    };
+}
+
+static TArray<FString> NumberedNames(const TCHAR* Prefix, int32 Count)
+{
+    TArray<FString> Names;
+    for (int32 I = 0; I < Count; ++I)
+    {
+        Names.Add(FString::Printf(TEXT("%s_%d"), Prefix, I));
+    }
+    return Names;
+}
+
+/** The benchmark's economy shape: a few rich agents, most poor, inventories mostly empty */
+static void FillEconomy(FAgentEEconomyState& State, const FAgentELoadTestSettings& Settings, FRandomStream& Rng)
+{
+    State.SetSchema(NumberedNames(TEXT("role"), Settings.Roles),
+        NumberedNames(TEXT("resource"), Settings.Resources), NumberedNames(TEXT("currency"), Settings.Currencies));
+
+    for (int32 A = 0; A < Settings.Agents; ++A)
+    {
+        const int32 Index = State.AddAgent(FString::Printf(TEXT("agent_%07d"), A), uint16(A % Settings.Roles));
+        for (TArray<double>& Column : State.Balances)
+        {
+            const double U = FMath::Max(Rng.GetFraction(), 1e-6);
+            Column[Index] = FMath::RoundToDouble(100.0 / FMath::Sqrt(U));
+        }
+        for (TArray<double>& Column : State.Inventories)
+        {
+            Column[Index] = Rng.GetFraction() < 0.3 ? double(Rng.RandRange(1, 50)) : 0.0;
+        }
+    }
+    for (TArray<double>& Row : State.MarketPrices)
+    {
+        for (double& Price : Row)
+        {
+            Price = double(Rng.RandRange(5, 80));
+        }
+    }
+}
+
+static UAgentEClient* NewVirtualClient(const FAgentELoadTestSettings& Settings, int32 Index, FAgentEVirtualClient& Out)
+{
+    UAgentEClient* Client = NewObject<UAgentEClient>(GetTransientPackage(), NAME_None, RF_Transient);
+    Client->AddToRoot();
+
+    Client->ServerUrl = Settings.ServerUrl;
+    Client->Encoding = Settings.Encoding;
+    Client->SharedMemoryPort = Settings.SharedMemoryPort;
+    switch (Settings.Transport)
+    {
+    case EAgentELoadTransport::WebSocket:
+        Client->Transport = EAgentETransport::WebSocket;
+        break;
+    case EAgentELoadTransport::SharedMemory:
+        Client->Transport = EAgentETransport::SharedMemory;
+        break;
+    case EAgentELoadTransport::Uplink:
+        Client->Transport = EAgentETransport::Http;
+        Client->Encoding = EAgentEEncoding::Json;
+        Client->bUseSharedUplink = true;
+        break;
+    case EAgentELoadTransport::Http:
+    default:
+        Client->Transport = EAgentETransport::Http;
+        break;
+    }
+    // Every transport runs the same workload: one shard economy per client
+    Client->ShardId = FString::Printf(TEXT("loadtest-%04d"), Index);
+
+    // A fixed interval: the offered load is what the settings say, not what each economy's health asks for
+    Client->bAdaptiveCadence = true;
+    Client->MinSendInterval = Client->TargetSendInterval = Client->MaxSendInterval = float(Settings.SendInterval);
+    Client->MaxInFlight = Settings.MaxInFlight;
+    Client->bUseDeltaSnapshots = Settings.bDeltas;
+    Client->bTrackChanges = true;
+    Client->bCompressTicks = Settings.bCompress;
+    Client->AdjustmentFrameBudgetMs = 0.f;
+
+    Out.Client = Client;
+    Out.Rng.Initialize(int32(Settings.Seed + uint32(Index) * 7919u));
+    FillEconomy(Client->GetEconomyState(), Settings, Out.Rng);
+
+    const FAgentEEconomyState& State = Client->GetEconomyState();
+    for (int32 A = 0; A < FMath::Min(State.NumAgents(), 256); ++A)
+    {
+        Out.Actors.Add(FName(State.AgentIds()[A]));
+    }
+    for (const FString& Resource : State.Resources())
+    {
+        Out.Resources.Add(FName(Resource));
+    }
+    for (const FString& Currency : State.Currencies())
+    {
+        Out.Currencies.Add(FName(Currency));
+    }
+    return Client;
+}
+
+/** One frame of a client's game: churn, events, then the send decision */
+static void DriveClient(FAgentEVirtualClient& V, const FAgentELoadTestSettings& Settings, double DeltaTime)
+{
+    UAgentEClient& Client = *V.Client;
+    const FAgentEEconomyState& State = Client.GetEconomyState();
+    const int32 NumAgents = State.NumAgents();
+
+    V.ChurnDebt += Settings.Churn * double(NumAgents) * DeltaTime;
+    const int32 Changes = int32(V.ChurnDebt);
+    V.ChurnDebt -= double(Changes);
+    for (int32 I = 0; I < Changes && NumAgents > 0; ++I)
+    {
+        const int32 Agent = V.Rng.RandHelper(NumAgents);
+        if (State.Balances.Num() > 0)
+        {
+            Client.AddBalance(Agent, V.Rng.RandHelper(State.Balances.Num()), double(V.Rng.RandRange(-20, 25)));
+        }
+        if (State.Inventories.Num() > 0)
+        {
+            const int32 Resource = V.Rng.RandHelper(State.Inventories.Num());
+            const bool bTake = State.Inventories[Resource][Agent] > 0.0 && V.Rng.GetFraction() < 0.5;
+            Client.AddInventory(Agent, Resource, bTake ? -1.0 : 1.0);
+        }
+    }
+
+    V.EventDebt += Settings.EventsPerSecond * DeltaTime;
+    const int32 Events = int32(V.EventDebt);
+    V.EventDebt -= double(Events);
+    if (Events > 0 && V.Actors.Num() > 1 && V.Resources.Num() > 0 && V.Currencies.Num() > 0)
+    {
+        FAgentEEvent Event;
+        Event.Type = EAgentEEventType::Trade;
+        Event.Timestamp = int64(FPlatformTime::Seconds() * 1000.0);
+        for (int32 I = 0; I < Events; ++I)
+        {
+            Event.Actor = Event.From = V.Actors[V.Rng.RandHelper(V.Actors.Num())];
+            Event.To = V.Actors[V.Rng.RandHelper(V.Actors.Num())];
+            Event.Resource = V.Resources[V.Rng.RandHelper(V.Resources.Num())];
+            Event.Currency = V.Currencies[V.Rng.RandHelper(V.Currencies.Num())];
+            Event.Amount = float(V.Rng.RandRange(1, 5));
+            Event.Price = float(V.Rng.RandRange(5, 80));
+            Client.RecordEvent(Event);
+        }
+    }
+
+    Client.OnGameTick();
+}
+
+static FAgentELoadTotals SumTotals(TConstArrayView<FAgentEVirtualClient> Clients)
+{
+    FAgentELoadTotals Totals;
+    for (const FAgentEVirtualClient& V : Clients)
+    {
+        if (V.bStarted)
+        {
+            const FAgentEClientStats Stats = V.Client->GetClientStats();
+            Totals.TicksSent += Stats.TicksSent;
+            Totals.BytesSent += Stats.BytesSent;
+            Totals.BytesReceived += Stats.BytesReceived;
+            Totals.InFlight += Stats.InFlight;
+        }
+    }
+    return Totals;
+}
+
+/** What the engine loop would do between frames: HTTP, WebSockets and the clients' tickers, then replies posted to the game thread */
+static void PumpEngine(float DeltaTime)
+{
+    FTSTicker::GetCoreTicker().Tick(DeltaTime);
+    FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+}
+
+/** Longest wait for the replies still due once sending stops */
+static constexpr double DrainSeconds = 10.0;
+
+static const TCHAR* TransportName(EAgentELoadTransport Transport)
+{
+    switch (Transport)
+    {
+    case EAgentELoadTransport::WebSocket: return TEXT("WebSocket");
+    case EAgentELoadTransport::SharedMemory: return TEXT("SharedMemory");
+    case EAgentELoadTransport::Uplink: return TEXT("Uplink");
+    case EAgentELoadTransport::Http:
+    default: return TEXT("Http");
+    }
+}
+
+FAgentELoadTestResult AgentERunLoadTest(FAgentELoadTestSettings& Settings)
+{
+    Settings.Clients = FMath::Max(1, Settings.Clients);
+    Settings.SendInterval = FMath::Max(0.01, Settings.SendInterval);
+    Settings.BucketSeconds = FMath::Max(0.1, Settings.BucketSeconds);
+    if (Settings.Transport == EAgentELoadTransport::SharedMemory)
+    {
+        Settings.Encoding = EAgentEEncoding::MessagePack;
+    }
+
+    FAgentELoadTestResult Result;
+    FAgentELoadCollector Collector;
+    const double Ramp = Settings.RampSeconds < 0.0 ? Settings.SendInterval : Settings.RampSeconds;
+
+    TArray<FAgentEVirtualClient> Clients;
+    Clients.SetNum(Settings.Clients);
+    for (int32 I = 0; I < Clients.Num(); ++I)
+    {
+        UAgentEClient* Client = NewVirtualClient(Settings, I, Clients[I]);
+        Client->OnTickReply.AddLambda([&Collector](const FAgentETickResult& Reply) { Collector.OnReply(Reply); });
+    }
+    UE_LOG(LogTemp, Display, TEXT("[AgentE] Load test: %d clients x %d agents over %s (%s), a send every %.2f s"),
+        Settings.Clients, Settings.Agents, TransportName(Settings.Transport),
+        Settings.Encoding == EAgentEEncoding::MessagePack ? TEXT("MessagePack") : TEXT("Json"), Settings.SendInterval);
+
+    const double Begin = FPlatformTime::Seconds();
+    for (int32 I = 0; I < Clients.Num(); ++I)
+    {
+        Clients[I].StartTime = Begin + Ramp * double(I) / double(Clients.Num());
+    }
+    const double SteadyAt = Begin + Ramp;
+    const double StopAt = SteadyAt + Settings.Seconds;
+    const double FrameSeconds = 1.0 / FMath::Max(1.0, Settings.FrameRate);
+
+    FAgentELoadTotals AtSteady;
+    int64 BucketSentBase = 0;
+    double NextBucket = Begin + Settings.BucketSeconds;
+    double NextProgress = Begin + 10.0;
+    double LastFrame = Begin;
+    double SendingEnd = Begin;
+    int32 Active = 0;
+
+    auto EndBucket = [&](double Now) {
+        const int64 Sent = SumTotals(Clients).TicksSent;
+        Collector.EndBucket(Result.Curve, Now - Begin, Active, Sent - BucketSentBase);
+        BucketSentBase = Sent;
+    };
+
+    while (!IsEngineExitRequested())
+    {
+        const double Now = FPlatformTime::Seconds();
+        SendingEnd = Now;
+        if (Now >= StopAt)
+        {
+            break;
+        }
+        const double DeltaTime = Now - LastFrame;
+        LastFrame = Now;
+
+        for (FAgentEVirtualClient& V : Clients)
+        {
+            if (!V.bStarted)
+            {
+                if (Now < V.StartTime)
+                {
+                    continue;
+                }
+                V.Client->StartClient();
+                V.bStarted = true;
+                ++Active;
+            }
+            DriveClient(V, Settings, DeltaTime);
+        }
+        if (!Collector.bSteady && Now >= SteadyAt)
+        {
+            Collector.bSteady = true;
+            AtSteady = SumTotals(Clients);
+        }
+
+        PumpEngine(float(DeltaTime));
+
+        if (Now >= NextBucket)
+        {
+            EndBucket(Now);
+            NextBucket += Settings.BucketSeconds;
+        }
+        if (Now >= NextProgress)
+        {
+            const FAgentELoadTestPoint& Last = Result.Curve.Num() > 0 ? Result.Curve.Last() : FAgentELoadTestPoint();
+            UE_LOG(LogTemp, Display, TEXT("[AgentE] %4.0f s: %d clients, %lld answered, %lld failed, %lld rate limited, p99 %.1f ms (last bucket)"),
+                Now - Begin, Active, Collector.Replies, Collector.Totals.Failed, Collector.Totals.RateLimited, Last.P99Ms);
+            NextProgress += 10.0;
+        }
+
+        const double Spare = FrameSeconds - (FPlatformTime::Seconds() - Now);
+        if (Spare > 0.0)
+        {
+            FPlatformProcess::Sleep(float(Spare));
+        }
+    }
+
+    // Sending stopped; the replies still due are part of the run
+    const FAgentELoadTotals AtStop = SumTotals(Clients);
+    const double DrainUntil = SendingEnd + DrainSeconds;
+    double Now = SendingEnd;
+    while (SumTotals(Clients).InFlight > 0 && Now < DrainUntil && !IsEngineExitRequested())
+    {
+        FPlatformProcess::Sleep(float(FrameSeconds));
+        const double Prev = Now;
+        Now = FPlatformTime::Seconds();
+        PumpEngine(float(Now - Prev));
+    }
+    EndBucket(FPlatformTime::Seconds());
+    const FAgentELoadTotals AtEnd = SumTotals(Clients);
+
+    FAgentEEventStats Events;
+    for (FAgentEVirtualClient& V : Clients)
+    {
+        const FAgentEEventStats ClientEvents = V.Client->GetEventStats();
+        Events.Recorded += ClientEvents.Recorded;
+        Events.DroppedFull += ClientEvents.DroppedFull;
+        Events.SampledOut += ClientEvents.SampledOut;
+        Events.Overwritten += ClientEvents.Overwritten;
+        V.Client->OnTickReply.Clear();
+        if (V.bStarted)
+        {
+            V.Client->StopClient();
+        }
+    }
+    // Let connections close before the clients go
+    PumpEngine(float(FrameSeconds));
+    for (FAgentEVirtualClient& V : Clients)
+    {
+        V.Client->RemoveFromRoot();
+    }
+
+    if (Collector.bSteady)
+    {
+        Result.Seconds = FMath::Max(SendingEnd - SteadyAt, 0.0);
+        Result.TicksSent = AtStop.TicksSent - AtSteady.TicksSent;
+        Result.BytesSent = AtEnd.BytesSent - AtSteady.BytesSent;
+        Result.BytesReceived = AtEnd.BytesReceived - AtSteady.BytesReceived;
+    }
+    Result.OfferedTicksPerSecond = double(Settings.Clients) / Settings.SendInterval;
+    Result.TicksPerSecond = Result.Seconds > 0.0 ? double(Collector.Totals.Ok) / Result.Seconds : 0.0;
+    Result.Ok = Collector.Totals.Ok;
+    Result.Failed = Collector.Totals.Failed;
+    Result.RateLimited = Collector.Totals.RateLimited;
+    Result.OutOfSync = Collector.Totals.OutOfSync;
+    Result.Unanswered = FMath::Max(AtEnd.TicksSent - Collector.Replies, int64(0));
+    Result.EventsRecorded = Events.Recorded;
+    Result.EventsDropped = Events.TotalLost();
+    Result.RoundTrip = Summarize(Collector.RoundTrip);
+    Result.Server = Summarize(Collector.Server);
+    Result.Wait = Summarize(Collector.Wait);
+    Result.bOk = Result.Ok > 0;
+    return Result;
+}
+
+// ─── Results ────────────────────────────────────────────────────────────────
+
+static void WriteSummary(FAgentEJsonWriter& W, const ANSICHAR* Name, const FAgentELatencySummary& S)
+{
+    W.Key(Name);
+    W.BeginObject();
+    W.Key("count"); W.Value(S.Count);
+    W.Key("meanMs"); W.Value(S.MeanMs);
+    W.Key("p50Ms"); W.Value(S.P50Ms);
+    W.Key("p99Ms"); W.Value(S.P99Ms);
+    W.Key("p999Ms"); W.Value(S.P999Ms);
+    W.Key("maxMs"); W.Value(S.MaxMs);
+    W.EndObject();
+}
+
+void AgentEWriteLoadTestJson(FAgentEJsonWriter& W, const FAgentELoadTestSettings& Settings, const FAgentELoadTestResult& R)
+{
+    W.Reset();
+    W.BeginObject();
+    W.Key("version"); W.Value(int64(1));
+    W.Key("platform"); W.Value(FStringView(FPlatformProperties::IniPlatformName()));
+    W.Key("cpu"); W.Value(FStringView(FPlatformMisc::GetCPUBrand().TrimStartAndEnd()));
+
+    W.Key("settings");
+    W.BeginObject();
+    W.Key("server"); W.Value(FStringView(Settings.ServerUrl));
+    W.Key("transport"); W.Value(FStringView(TransportName(Settings.Transport)));
+    W.Key("encoding"); W.Value(Settings.Encoding == EAgentEEncoding::MessagePack ? "MessagePack" : "Json");
+    W.Key("clients"); W.Value(int64(Settings.Clients));
+    W.Key("agents"); W.Value(int64(Settings.Agents));
+    W.Key("churn"); W.Value(Settings.Churn);
+    W.Key("eventsPerSecond"); W.Value(Settings.EventsPerSecond);
+    W.Key("sendInterval"); W.Value(Settings.SendInterval);
+    W.Key("maxInFlight"); W.Value(int64(Settings.MaxInFlight));
+    W.Key("deltas"); W.Value(Settings.bDeltas);
+    W.Key("compress"); W.Value(Settings.bCompress);
+    W.Key("seconds"); W.Value(Settings.Seconds);
+    W.EndObject();
+
+    W.Key("summary");
+    W.BeginObject();
+    W.Key("seconds"); W.Value(R.Seconds);
+    W.Key("offeredTicksPerSecond"); W.Value(R.OfferedTicksPerSecond);
+    W.Key("ticksPerSecond"); W.Value(R.TicksPerSecond);
+    W.Key("ticksSent"); W.Value(R.TicksSent);
+    W.Key("ok"); W.Value(R.Ok);
+    W.Key("failed"); W.Value(R.Failed);
+    W.Key("rateLimited"); W.Value(R.RateLimited);
+    W.Key("outOfSync"); W.Value(R.OutOfSync);
+    W.Key("unanswered"); W.Value(R.Unanswered);
+    W.Key("bytesSent"); W.Value(R.BytesSent);
+    W.Key("bytesReceived"); W.Value(R.BytesReceived);
+    W.Key("eventsRecorded"); W.Value(R.EventsRecorded);
+    W.Key("eventsDropped"); W.Value(R.EventsDropped);
+    WriteSummary(W, "roundTrip", R.RoundTrip);
+    WriteSummary(W, "server", R.Server);
+    WriteSummary(W, "wait", R.Wait);
+    W.EndObject();
+
+    W.Key("curve");
+    W.BeginArray();
+    for (const FAgentELoadTestPoint& P : R.Curve)
+    {
+        W.BeginObject();
+        W.Key("t"); W.Value(P.Time);
+        W.Key("clients"); W.Value(int64(P.Clients));
+        W.Key("sent"); W.Value(P.Sent);
+        W.Key("ok"); W.Value(P.Ok);
+        W.Key("failed"); W.Value(P.Failed);
+        W.Key("rateLimited"); W.Value(P.RateLimited);
+        W.Key("outOfSync"); W.Value(P.OutOfSync);
+        W.Key("p50Ms"); W.Value(P.P50Ms);
+        W.Key("p99Ms"); W.Value(P.P99Ms);
+        W.Key("serverP99Ms"); W.Value(P.ServerP99Ms);
+        W.EndObject();
+    }
+    W.EndArray();
+    W.EndObject();
+}
+
+// ─── Commandlet ─────────────────────────────────────────────────────────────
+
+UAgentELoadTestCommandlet::UAgentELoadTestCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UAgentELoadTestCommandlet::Main(const FString& Params)
+{
+    FAgentELoadTestSettings Settings;
+    FParse::Value(*Params, TEXT("Server="), Settings.ServerUrl);
+
+    FString Transport;
+    if (FParse::Value(*Params, TEXT("Transport="), Transport))
+    {
+        if (Transport == TEXT("Http")) Settings.Transport = EAgentELoadTransport::Http;
+        else if (Transport == TEXT("WebSocket")) Settings.Transport = EAgentELoadTransport::WebSocket;
+        else if (Transport == TEXT("SharedMemory")) Settings.Transport = EAgentELoadTransport::SharedMemory;
+        else if (Transport == TEXT("Uplink")) Settings.Transport = EAgentELoadTransport::Uplink;
+        else
+        {
+            UE_LOG(LogTemp, Error, TEXT("[AgentE] Unknown transport '%s' (Http, WebSocket, SharedMemory, Uplink)"), *Transport);
+            return 1;
+        }
+    }
+    FString Encoding;
+    if (FParse::Value(*Params, TEXT("Encoding="), Encoding))
+    {
+        if (Encoding == TEXT("Json")) Settings.Encoding = EAgentEEncoding::Json;
+        else if (Encoding == TEXT("MessagePack")) Settings.Encoding = EAgentEEncoding::MessagePack;
+        else
+        {
+            UE_LOG(LogTemp, Error, TEXT("[AgentE] Unknown encoding '%s' (Json, MessagePack)"), *Encoding);
+            return 1;
+        }
+    }
+    FParse::Value(*Params, TEXT("SharedMemoryPort="), Settings.SharedMemoryPort);
+    FParse::Value(*Params, TEXT("Clients="), Settings.Clients);
+    FParse::Value(*Params, TEXT("Agents="), Settings.Agents);
+    FParse::Value(*Params, TEXT("Churn="), Settings.Churn);
+    FParse::Value(*Params, TEXT("EventsPerSecond="), Settings.EventsPerSecond);
+    FParse::Value(*Params, TEXT("SendInterval="), Settings.SendInterval);
+    FParse::Value(*Params, TEXT("MaxInFlight="), Settings.MaxInFlight);
+    FParse::Value(*Params, TEXT("Seconds="), Settings.Seconds);
+    FParse::Value(*Params, TEXT("RampSeconds="), Settings.RampSeconds);
+    FParse::Value(*Params, TEXT("BucketSeconds="), Settings.BucketSeconds);
+    Settings.bDeltas = !FParse::Param(*Params, TEXT("NoDeltas"));
+    Settings.bCompress = FParse::Param(*Params, TEXT("Compress"));
+    FString Output = FPaths::ProjectSavedDir() / TEXT("AgentE") / TEXT("LoadTest.json");
+    FParse::Value(*Params, TEXT("Output="), Output);
+
+    // Settings come back as they ran, for the results file
+    const FAgentELoadTestResult Result = AgentERunLoadTest(Settings);
+
+    UE_LOG(LogTemp, Display, TEXT("[AgentE] %.0f s: %.1f of %.1f ticks/s answered; %lld failed, %lld rate limited, %lld out of sync, %lld unanswered"),
+        Result.Seconds, Result.TicksPerSecond, Result.OfferedTicksPerSecond,
+        Result.Failed, Result.RateLimited, Result.OutOfSync, Result.Unanswered);
+    UE_LOG(LogTemp, Display, TEXT("[AgentE] Round trip p50 %.2f  p99 %.2f  p999 %.2f  max %.2f ms"),
+        Result.RoundTrip.P50Ms, Result.RoundTrip.P99Ms, Result.RoundTrip.P999Ms, Result.RoundTrip.MaxMs);
+    UE_LOG(LogTemp, Display, TEXT("[AgentE] Server     p50 %.2f  p99 %.2f  p999 %.2f  max %.2f ms"),
+        Result.Server.P50Ms, Result.Server.P99Ms, Result.Server.P999Ms, Result.Server.MaxMs);
+
+    FAgentEJsonWriter Writer;
+    AgentEWriteLoadTestJson(Writer, Settings, Result);
+    if (!FFileHelper::SaveArrayToFile(Writer.GetBuffer(), *Output))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[AgentE] Can't write %s"), *Output);
+        return 1;
+    }
+    UE_LOG(LogTemp, Display, TEXT("[AgentE] Results written to %s"), *Output);
+
+    if (!Result.bOk)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[AgentE] No tick was answered after the ramp — is the server running at %s?"), *Settings.ServerUrl);
+        return 1;
+    }
+    return 0;
+}
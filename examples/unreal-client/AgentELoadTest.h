@@ -0,0 +1,205 @@
+/**
+ * AgentE Unreal Engine Client — Load Test
+ *
+ * How many games one AgentE server keeps up with before ticks queue up or
+ * get rate-limited. The headless commandlet
+ *
+ *   UnrealEditor-Cmd MyGame.uproject -run=AgentELoadTest
+ *       [-Server=http://localhost:3000] [-Transport=Http|WebSocket|SharedMemory|Uplink]
+ *       [-Encoding=Json|MessagePack] [-Clients=16] [-Agents=1000] [-Churn=0.05]
+ *       [-EventsPerSecond=20] [-SendInterval=1] [-MaxInFlight=1] [-NoDeltas] [-Compress]
+ *       [-Seconds=60] [-RampSeconds=1] [-BucketSeconds=1] [-Output=Path.json]
+ *
+ * starts Clients virtual clients. Each is a real UAgentEClient, started
+ * without a world (StartClient), with an economy of its own: Agents agents
+ * with skewed balances and sparse inventories. Every frame, each client
+ * changes the balance and an inventory of Churn of its agents per second
+ * through the change-tracked hooks, records EventsPerSecond trades and
+ * calls OnGameTick. Sends are due every SendInterval seconds, so the
+ * offered load is Clients / SendInterval ticks per second whatever the
+ * economies' health. Client i starts at i / Clients of RampSeconds: a short
+ * ramp spreads the sends over the interval, and a long one turns the
+ * throughput curve into a capacity curve.
+ *
+ * Transports:
+ *   - Http, WebSocket, SharedMemory: a connection per client.
+ *   - Uplink: every client is a shard of the shared uplink (POST
+ *     /tick/batch, JSON), the way a server process with many zones runs.
+ * Either way client i ticks shard economy `loadtest-<i>` with its own delta
+ * base (and, over HTTP MessagePack, name table), so the transports are
+ * compared on the same server work.
+ *
+ * Reported, for the time after the ramp:
+ *   - round trip p50 / p99 / p999, from OnTickReply;
+ *   - the server's own processing time (`processingMs` in tick replies),
+ *     and the round trip minus it: network, parsing and queueing behind
+ *     other ticks of the same economy;
+ *   - ticks answered per second against the offered rate. Failures, rate
+ *     limits and out-of-sync replies (delta base or name table mismatch)
+ *     are counted separately. Unanswered sends are counted too.
+ * A curve over the whole run adds one point per BucketSeconds: active
+ * clients, sends, each outcome, and that bucket's round trip p50 / p99 and
+ * server p99. Latencies go into log-bucketed histograms (about 3%
+ * resolution), so a soak of hours runs in constant memory.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AgentETransport.h"
+#include "AgentELoadTest.generated.h"
+
+class FAgentEJsonWriter;
+
+/** Latencies in 32 sub-buckets per power of two of microseconds; percentiles answer a bucket's midpoint */
+class FAgentELatencyHistogram
+{
+public:
+    FAgentELatencyHistogram();
+
+    void Add(double Ms);
+    void Reset();
+
+    /** P in [0, 1]; 0 when empty */
+    double Percentile(double P) const;
+
+    int64 Num() const { return Count; }
+    double MeanMs() const { return Count > 0 ? TotalMs / double(Count) : 0.0; }
+    double MaxMs() const { return Max; }
+
+private:
+    TArray<int64> Bins;
+    int64 Count = 0;
+    double TotalMs = 0.0;
+    double Max = 0.0;
+};
+
+enum class EAgentELoadTransport : uint8
+{
+    Http,
+    WebSocket,
+    SharedMemory,
+    Uplink,
+};
+
+struct FAgentELoadTestSettings
+{
+    FString ServerUrl = TEXT("http://localhost:3000");
+    EAgentELoadTransport Transport = EAgentELoadTransport::Http;
+    EAgentEEncoding Encoding = EAgentEEncoding::Json;
+    int32 SharedMemoryPort = 3101;
+
+    int32 Clients = 16;
+    int32 Agents = 1000;
+    int32 Roles = 6;
+    int32 Resources = 8;
+    int32 Currencies = 3;
+
+    /** Share of each economy's agents changed per second */
+    double Churn = 0.05;
+
+    /** Events each client records per second */
+    double EventsPerSecond = 20.0;
+
+    double SendInterval = 1.0;
+    int32 MaxInFlight = 1;
+    bool bDeltas = true;
+    bool bCompress = false;
+
+    /** Sending time after the ramp; replies still due are then awaited a little longer */
+    double Seconds = 60.0;
+
+    /** Time over which the clients start; negative uses SendInterval */
+    double RampSeconds = -1.0;
+    double BucketSeconds = 1.0;
+    double FrameRate = 60.0;
+
+    uint32 Seed = 0xA6E17;
+};
+
+struct FAgentELatencySummary
+{
+    int64 Count = 0;
+    double MeanMs = 0.0;
+    double P50Ms = 0.0;
+    double P99Ms = 0.0;
+    double P999Ms = 0.0;
+    double MaxMs = 0.0;
+};
+
+/** One bucket of the throughput curve */
+struct FAgentELoadTestPoint
+{
+    /** Seconds since the first client started, at the bucket's end */
+    double Time = 0.0;
+    int32 Clients = 0;
+
+    int64 Sent = 0;
+    int64 Ok = 0;
+    int64 Failed = 0;
+    int64 RateLimited = 0;
+    int64 OutOfSync = 0;
+
+    double P50Ms = 0.0;
+    double P99Ms = 0.0;
+    double ServerP99Ms = 0.0;
+};
+
+struct FAgentELoadTestResult
+{
+    /** After the ramp, until sending stopped */
+    double Seconds = 0.0;
+    double OfferedTicksPerSecond = 0.0;
+    double TicksPerSecond = 0.0;
+
+    int64 TicksSent = 0;
+    int64 Ok = 0;
+
+    /** Errors and transport failures, rate limits not included */
+    int64 Failed = 0;
+    int64 RateLimited = 0;
+
+    /** Answered without a tick outcome: the server wants a full snapshot or fresh names */
+    int64 OutOfSync = 0;
+
+    /** Whole run: sends that never got an answer */
+    int64 Unanswered = 0;
+
+    int64 BytesSent = 0;
+    int64 BytesReceived = 0;
+    int64 EventsRecorded = 0;
+    int64 EventsDropped = 0;
+
+    FAgentELatencySummary RoundTrip;
+    FAgentELatencySummary Server;
+
+    /** Round trip minus server time, for replies that carry both */
+    FAgentELatencySummary Wait;
+
+    TArray<FAgentELoadTestPoint> Curve;
+
+    /** At least one tick after the ramp was answered with a tick outcome */
+    bool bOk = false;
+};
+
+/**
+ * Run the load test; game thread, with nothing else ticking the engine.
+ * Settings are left as they ran: clamped, and with MessagePack for the
+ * shared-memory transport.
+ */
+FAgentELoadTestResult AgentERunLoadTest(FAgentELoadTestSettings& Settings);
+
+/** Write `{"version":1,"settings":{...},"summary":{...},"curve":[...]}` into Writer (reset first) */
+void AgentEWriteLoadTestJson(FAgentEJsonWriter& Writer, const FAgentELoadTestSettings& Settings, const FAgentELoadTestResult& Result);
+
+UCLASS()
+class UAgentELoadTestCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UAgentELoadTestCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
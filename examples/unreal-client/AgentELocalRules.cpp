@@ -0,0 +1,243 @@
+/**
+ * AgentE Unreal Engine Client — Local Rules
+ *
+ * See AgentELocalRules.h.
+ */
+
+#include "AgentELocalRules.h"
+#include "AgentEKeyTable.h"
+
+/** suggestedAction.magnitude of both principles */
+static constexpr float RuleMagnitude = 0.15f;
+
+/** P1: demand that counts, and the supply/demand ratio under which a resource is scarce */
+static constexpr double MeaningfulDemand = 5.0;
+static constexpr double ScarceSupplyRatio = 0.5;
+
+// ─── Flows ──────────────────────────────────────────────────────────────────
+
+void FAgentELocalFlows::Add(const FAgentEEvent& Event)
+{
+    switch (Event.Type)
+    {
+    case EAgentEEventType::Mint:
+    case EAgentEEventType::Enter:
+        FaucetByCurrency.FindOrAdd(Event.Currency) += Event.Amount;
+        break;
+    case EAgentEEventType::Burn:
+    case EAgentEEventType::Consume:
+        SinkByCurrency.FindOrAdd(Event.Currency) += Event.Amount;
+        break;
+    case EAgentEEventType::Trade:
+        if (!Event.Resource.IsNone())
+        {
+            // The Observer counts a trade without an amount as one unit
+            DemandByResource.FindOrAdd(Event.Resource) += Event.Amount != 0.f ? Event.Amount : 1.f;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void FAgentELocalFlows::Append(const FAgentELocalFlows& Other)
+{
+    for (const TPair<FName, double>& It : Other.FaucetByCurrency)
+    {
+        FaucetByCurrency.FindOrAdd(It.Key) += It.Value;
+    }
+    for (const TPair<FName, double>& It : Other.SinkByCurrency)
+    {
+        SinkByCurrency.FindOrAdd(It.Key) += It.Value;
+    }
+    for (const TPair<FName, double>& It : Other.DemandByResource)
+    {
+        DemandByResource.FindOrAdd(It.Key) += It.Value;
+    }
+}
+
+void FAgentELocalFlows::Reset()
+{
+    // Keep the maps' storage: the same few names come back every window
+    FaucetByCurrency.Reset();
+    SinkByCurrency.Reset();
+    DemandByResource.Reset();
+}
+
+// ─── Cache ──────────────────────────────────────────────────────────────────
+
+void FAgentELocalRules::Configure(
+    const FAgentELocalRulesSettings& InSettings, FAgentEKeyTable& Keys, const TMap<int32, int32>& Mapping)
+{
+    Settings = InSettings;
+    Settings.HistorySize = FMath::Max(1, Settings.HistorySize);
+    P12 = Keys.FindOrAdd(FString(TEXT("P12")));
+    P1 = Keys.FindOrAdd(FString(TEXT("P1")));
+    Reset();
+    ParameterByPrinciple = Mapping;
+}
+
+void FAgentELocalRules::Reset()
+{
+    ParameterByPrinciple.Reset();
+    ServerValues.Reset();
+    LocalValues.Reset();
+    LocalMovedAt.Reset();
+    History.Reset();
+    Next = 0;
+}
+
+void FAgentELocalRules::Remember(const FAgentECachedAdjustment& Entry)
+{
+    if (History.Num() < Settings.HistorySize)
+    {
+        History.Add(Entry);
+        return;
+    }
+    History[Next] = Entry;
+    Next = (Next + 1) % History.Num();
+}
+
+void FAgentELocalRules::RecordServer(int32 Parameter, float Value, int32 Principle, int64 Tick, double Now)
+{
+    ServerValues.Add(Parameter, Value);
+    if (Principle != INDEX_NONE)
+    {
+        ParameterByPrinciple.Add(Principle, Parameter);
+    }
+
+    FAgentECachedAdjustment Entry;
+    Entry.Parameter = Parameter;
+    Entry.Value = Value;
+    Entry.Principle = Principle;
+    Entry.Tick = Tick;
+    Entry.Time = Now;
+    Remember(Entry);
+}
+
+void FAgentELocalRules::GetHistory(TArray<FAgentECachedAdjustment>& Out) const
+{
+    Out.Reset(History.Num());
+    for (int32 i = 0; i < History.Num(); ++i)
+    {
+        Out.Add(History[(Next + i) % History.Num()]);
+    }
+}
+
+void FAgentELocalRules::TakeRestores(TArray<TPair<int32, float>>& Out)
+{
+    for (const TPair<int32, float>& It : LocalValues)
+    {
+        // A parameter only ever set locally has no server value to return to
+        if (const float* ServerValue = ServerValues.Find(It.Key))
+        {
+            Out.Emplace(It.Key, *ServerValue);
+        }
+    }
+    LocalValues.Reset();
+    LocalMovedAt.Reset();
+}
+
+// ─── Rules ──────────────────────────────────────────────────────────────────
+
+bool FAgentELocalRules::Step(int32 Principle, float Direction, double Now,
+    TFunctionRef<bool(int32, float&)> CurrentValue, TArray<TPair<int32, float>>& Out)
+{
+    const int32* Parameter = ParameterByPrinciple.Find(Principle);
+    if (!Parameter)
+    {
+        return false; // the server never said what it moves for this principle
+    }
+    const double* MovedAt = LocalMovedAt.Find(*Parameter);
+    if (MovedAt && Now - *MovedAt < Settings.CooldownSeconds)
+    {
+        return false;
+    }
+
+    float Current = 0.f;
+    if (const float* Local = LocalValues.Find(*Parameter))
+    {
+        Current = *Local;
+    }
+    else if (const float* Server = ServerValues.Find(*Parameter))
+    {
+        Current = *Server;
+    }
+    else if (!CurrentValue(*Parameter, Current))
+    {
+        return false;
+    }
+
+    const float Value = Current * (1.f + Direction * FMath::Min(RuleMagnitude, Settings.MaxAdjustmentPercent));
+    LocalValues.Add(*Parameter, Value);
+    LocalMovedAt.Add(*Parameter, Now);
+    Out.Emplace(*Parameter, Value);
+
+    FAgentECachedAdjustment Entry;
+    Entry.Parameter = *Parameter;
+    Entry.Value = Value;
+    Entry.Principle = Principle;
+    Entry.Time = Now;
+    Entry.bLocal = true;
+    Remember(Entry);
+    return true;
+}
+
+int32 FAgentELocalRules::Evaluate(
+    const FAgentEEconomyState& State, const FAgentELocalFlows& Flows, double Now,
+    TFunctionRef<bool(int32 Parameter, float& OutValue)> CurrentValue, TArray<TPair<int32, float>>& Out)
+{
+    int32 Violations = 0;
+
+    // P12: the first currency whose net flow is past the threshold, like the engine
+    const TArray<FString>& Currencies = State.Currencies();
+    for (int32 c = 0; c < Currencies.Num(); ++c)
+    {
+        const FName Name(*Currencies[c]);
+        double NetFlow = Flows.FaucetByCurrency.FindRef(Name) - Flows.SinkByCurrency.FindRef(Name);
+        if (c == 0)
+        {
+            NetFlow += Flows.FaucetByCurrency.FindRef(NAME_None) - Flows.SinkByCurrency.FindRef(NAME_None);
+        }
+        if (FMath::Abs(NetFlow) > Settings.NetFlowWarnThreshold)
+        {
+            ++Violations;
+            // Inflation: raise the primary sink's cost; deflation: lower it
+            Step(P12, NetFlow > 0.0 ? 1.f : -1.f, Now, CurrentValue, Out);
+            break;
+        }
+    }
+
+    // P1: any resource in demand but short of supply
+    if (!Flows.DemandByResource.IsEmpty())
+    {
+        const bool bTotals = State.IsTrackingChanges();
+        for (const TPair<FName, double>& It : Flows.DemandByResource)
+        {
+            const int32 Resource = State.FindResource(It.Key);
+            if (It.Value <= MeaningfulDemand || Resource == INDEX_NONE)
+            {
+                continue;
+            }
+            double Supply = 0.0;
+            if (bTotals)
+            {
+                Supply = State.GetTotals().SupplyByResource[Resource];
+            }
+            else
+            {
+                for (const double Quantity : State.Inventories[Resource])
+                {
+                    Supply += Quantity;
+                }
+            }
+            if (Supply / FMath::Max(1.0, It.Value) < ScarceSupplyRatio)
+            {
+                ++Violations;
+                Step(P1, -1.f, Now, CurrentValue, Out);
+                break;
+            }
+        }
+    }
+    return Violations;
+}
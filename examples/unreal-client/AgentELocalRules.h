@@ -0,0 +1,137 @@
+/**
+ * AgentE Unreal Engine Client — Local Rules
+ *
+ * Keeps the economy steered while the server is unreachable or its replies
+ * are overdue, instead of holding the last parameters until it recovers.
+ *
+ * The client remembers recent server adjustments together with the
+ * principle whose decision made each one (the `principle` field of a tick
+ * reply's adjustments), which teaches it which parameter the server moves
+ * for which principle. While the server is degraded, a small subset of the
+ * engine's principles is checked here, with the engine's definitions and
+ * default thresholds:
+ *
+ *   - P12 One Primary Faucet: a currency's net flow (mint + enter minus
+ *     burn + consume) beyond netFlowWarnThreshold raises (inflation) or
+ *     lowers (deflation) cost
+ *   - P1 Production Must Match Consumption: a resource whose trade demand
+ *     is over 5 but whose supply is under half of it lowers cost
+ *
+ * A violation moves the parameter the server last adjusted for that
+ * principle (or the one configured for it) by one maxAdjustmentPercent
+ * step in the principle's direction, at most once per cooldown. Flows are
+ * the events since the previous evaluation; supplies come from the state's
+ * running totals when it tracks changes, otherwise from its columns. An
+ * evaluation touches only the per-currency and per-resource numbers (plus
+ * one pass over the inventory columns of an untracked state).
+ *
+ * The server stays authoritative: its first tick reply after a local
+ * episode restores every locally moved parameter to the server's value,
+ * then its own adjustments apply as usual.
+ *
+ * Game thread only, except FAgentELocalFlows, which its owner guards.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AgentEEconomyState.h"
+
+class FAgentEKeyTable;
+
+/** Event volumes since the last evaluation — what the Observer reads from recentEvents */
+struct FAgentELocalFlows
+{
+    /** By currency name; NAME_None stands for the state's first currency, as on the server */
+    TMap<FName, double> FaucetByCurrency;
+    TMap<FName, double> SinkByCurrency;
+
+    /** Traded amounts by resource name */
+    TMap<FName, double> DemandByResource;
+
+    void Add(const FAgentEEvent& Event);
+    void Append(const FAgentELocalFlows& Other);
+    void Reset();
+};
+
+struct FAgentELocalRulesSettings
+{
+    /** The engine's netFlowWarnThreshold */
+    double NetFlowWarnThreshold = 10.0;
+
+    /** The engine's maxAdjustmentPercent: the size of one local step */
+    float MaxAdjustmentPercent = 0.15f;
+
+    /** Seconds between two local moves of the same parameter */
+    float CooldownSeconds = 10.f;
+
+    /** Adjustments remembered, server and local */
+    int32 HistorySize = 64;
+};
+
+/** One remembered adjustment. Parameter and Principle are FAgentEKeyTable handles. */
+struct FAgentECachedAdjustment
+{
+    int32 Parameter = INDEX_NONE;
+    float Value = 0.f;
+    int32 Principle = INDEX_NONE;
+    int64 Tick = -1;
+    double Time = 0.0;
+    bool bLocal = false;
+};
+
+class FAgentELocalRules
+{
+public:
+    /** Mapping: principle → parameter handles to use before the server has adjusted either */
+    void Configure(const FAgentELocalRulesSettings& InSettings, FAgentEKeyTable& Keys, const TMap<int32, int32>& Mapping);
+    void Reset();
+
+    /** A server adjustment; Principle is INDEX_NONE when the reply didn't say */
+    void RecordServer(int32 Parameter, float Value, int32 Principle, int64 Tick, double Now);
+
+    /**
+     * Check the rules on State and Flows; append a (parameter, value) pair for
+     * each violation that has a parameter and is out of cooldown. CurrentValue
+     * reads a parameter's live value when neither side has set it yet.
+     * Returns the number of violations found.
+     */
+    int32 Evaluate(
+        const FAgentEEconomyState& State, const FAgentELocalFlows& Flows, double Now,
+        TFunctionRef<bool(int32 Parameter, float& OutValue)> CurrentValue, TArray<TPair<int32, float>>& Out);
+
+    /** Parameters moved locally, with the server values to put back; forgets the local moves */
+    void TakeRestores(TArray<TPair<int32, float>>& Out);
+
+    bool HasLocalChanges() const { return !LocalValues.IsEmpty(); }
+
+    /** Remembered adjustments, oldest first */
+    void GetHistory(TArray<FAgentECachedAdjustment>& Out) const;
+
+private:
+    FAgentELocalRulesSettings Settings;
+
+    /** Key handles of the principles checked here */
+    int32 P12 = INDEX_NONE;
+    int32 P1 = INDEX_NONE;
+
+    /** Principle → parameter, learned from server adjustments or configured */
+    TMap<int32, int32> ParameterByPrinciple;
+
+    /** Last value the server gave each parameter */
+    TMap<int32, float> ServerValues;
+
+    /** Values set locally since the server last answered, and when */
+    TMap<int32, float> LocalValues;
+    TMap<int32, double> LocalMovedAt;
+
+    /** Ring of HistorySize entries; Next is the oldest once it is full */
+    TArray<FAgentECachedAdjustment> History;
+    int32 Next = 0;
+
+    void Remember(const FAgentECachedAdjustment& Entry);
+
+    /** Move Principle's parameter one step in Direction (+1 / -1); false when it can't */
+    bool Step(int32 Principle, float Direction, double Now,
+        TFunctionRef<bool(int32, float&)> CurrentValue, TArray<TPair<int32, float>>& Out);
+};
@@ -0,0 +1,333 @@
+/**
+ * AgentE Unreal Engine Client — MessagePack
+ *
+ * See AgentEMsgPack.h.
+ */
+
+#include "AgentEMsgPack.h"
+
+// ─── Writer ─────────────────────────────────────────────────────────────────
+
+void FAgentEMsgPackWriter::BigEndian(uint64 Value, int32 Bytes)
+{
+    for (int32 Shift = (Bytes - 1) * 8; Shift >= 0; Shift -= 8)
+    {
+        Buffer.Add(uint8(Value >> Shift));
+    }
+}
+
+void FAgentEMsgPackWriter::Header(uint8 FixBase, uint32 FixMax, uint8 Code8, uint8 Code16, uint8 Code32, uint32 Len)
+{
+    if (FixBase != 0 && Len <= FixMax)
+    {
+        Buffer.Add(uint8(FixBase | Len));
+    }
+    else if (Code8 != 0 && Len <= 0xff)
+    {
+        Buffer.Add(Code8);
+        Buffer.Add(uint8(Len));
+    }
+    else if (Len <= 0xffff)
+    {
+        Buffer.Add(Code16);
+        BigEndian(Len, 2);
+    }
+    else
+    {
+        Buffer.Add(Code32);
+        BigEndian(Len, 4);
+    }
+}
+
+void FAgentEMsgPackWriter::BeginMap(uint32 Count)
+{
+    Header(0x80, 15, 0, 0xde, 0xdf, Count);
+}
+
+void FAgentEMsgPackWriter::BeginArray(uint32 Count)
+{
+    Header(0x90, 15, 0, 0xdc, 0xdd, Count);
+}
+
+void FAgentEMsgPackWriter::Str(const ANSICHAR* Literal)
+{
+    const int32 Len = FCStringAnsi::Strlen(Literal);
+    Header(0xa0, 31, 0xd9, 0xda, 0xdb, Len);
+    Buffer.Append(reinterpret_cast<const uint8*>(Literal), Len);
+}
+
+void FAgentEMsgPackWriter::Str(FStringView Str)
+{
+    const FTCHARToUTF8 Utf8(Str.GetData(), Str.Len());
+    Header(0xa0, 31, 0xd9, 0xda, 0xdb, Utf8.Length());
+    Buffer.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+}
+
+void FAgentEMsgPackWriter::Int(int64 Number)
+{
+    if (Number >= 0)
+    {
+        if (Number <= 0x7f)           { Buffer.Add(uint8(Number)); }
+        else if (Number <= 0xff)      { Buffer.Add(0xcc); BigEndian(Number, 1); }
+        else if (Number <= 0xffff)    { Buffer.Add(0xcd); BigEndian(Number, 2); }
+        else if (Number <= 0xffffffffll) { Buffer.Add(0xce); BigEndian(Number, 4); }
+        else                          { Buffer.Add(0xcf); BigEndian(Number, 8); }
+        return;
+    }
+    if (Number >= -32)                { Buffer.Add(uint8(0xe0 | (Number + 32))); }
+    else if (Number >= -0x80)         { Buffer.Add(0xd0); BigEndian(uint64(Number), 1); }
+    else if (Number >= -0x8000)       { Buffer.Add(0xd1); BigEndian(uint64(Number), 2); }
+    else if (Number >= -0x80000000ll) { Buffer.Add(0xd2); BigEndian(uint64(Number), 4); }
+    else                              { Buffer.Add(0xd3); BigEndian(uint64(Number), 8); }
+}
+
+void FAgentEMsgPackWriter::Double(double Number)
+{
+    uint64 Bits;
+    FMemory::Memcpy(&Bits, &Number, sizeof(Bits));
+    Buffer.Add(0xcb);
+    BigEndian(Bits, 8);
+}
+
+void FAgentEMsgPackWriter::Bool(bool bValue)
+{
+    Buffer.Add(bValue ? 0xc3 : 0xc2);
+}
+
+void FAgentEMsgPackWriter::Nil()
+{
+    Buffer.Add(0xc0);
+}
+
+uint8* FAgentEMsgPackWriter::BeginBin(int32 Bytes)
+{
+    Header(0, 0, 0xc4, 0xc5, 0xc6, Bytes);
+    const int32 Offset = Buffer.AddUninitialized(Bytes);
+    return Buffer.GetData() + Offset;
+}
+
+void FAgentEMsgPackWriter::Bin(const void* Src, int32 Bytes)
+{
+    if (Bytes > 0)
+    {
+        FMemory::Memcpy(BeginBin(Bytes), Src, Bytes);
+    }
+    else
+    {
+        BeginBin(0);
+    }
+}
+
+// ─── Reader ─────────────────────────────────────────────────────────────────
+
+bool FAgentEMsgPackReader::Need(int32 Bytes)
+{
+    if (bError || Bytes < 0 || Pos + Bytes > Num)
+    {
+        return Fail();
+    }
+    return true;
+}
+
+uint64 FAgentEMsgPackReader::BigEndian(int32 Bytes)
+{
+    uint64 Value = 0;
+    for (int32 i = 0; i < Bytes; ++i)
+    {
+        Value = (Value << 8) | Data[Pos++];
+    }
+    return Value;
+}
+
+EAgentEMsgPackType FAgentEMsgPackReader::PeekType() const
+{
+    if (bError || Pos >= Num)
+    {
+        return EAgentEMsgPackType::Invalid;
+    }
+    const uint8 B = Data[Pos];
+    if (B <= 0x7f || B >= 0xe0)  return EAgentEMsgPackType::Int;
+    if ((B & 0xe0) == 0xa0)      return EAgentEMsgPackType::Str;
+    if ((B & 0xf0) == 0x90)      return EAgentEMsgPackType::Array;
+    if ((B & 0xf0) == 0x80)      return EAgentEMsgPackType::Map;
+    switch (B)
+    {
+    case 0xc0: return EAgentEMsgPackType::Nil;
+    case 0xc2: case 0xc3: return EAgentEMsgPackType::Bool;
+    case 0xc4: case 0xc5: case 0xc6: return EAgentEMsgPackType::Bin;
+    case 0xca: case 0xcb: return EAgentEMsgPackType::Float;
+    case 0xcc: case 0xcd: case 0xce: case 0xcf:
+    case 0xd0: case 0xd1: case 0xd2: case 0xd3: return EAgentEMsgPackType::Int;
+    case 0xd9: case 0xda: case 0xdb: return EAgentEMsgPackType::Str;
+    case 0xdc: case 0xdd: return EAgentEMsgPackType::Array;
+    case 0xde: case 0xdf: return EAgentEMsgPackType::Map;
+    default: return EAgentEMsgPackType::Invalid;
+    }
+}
+
+/** Length for a header whose code byte was just consumed; fix forms carry it in the code */
+bool FAgentEMsgPackReader::ReadLength(uint8 Code, uint32& OutLen)
+{
+    int32 Bytes = 0;
+    switch (Code)
+    {
+    case 0xc4: case 0xd9: Bytes = 1; break;
+    case 0xc5: case 0xda: case 0xdc: case 0xde: Bytes = 2; break;
+    case 0xc6: case 0xdb: case 0xdd: case 0xdf: Bytes = 4; break;
+    default:
+        if ((Code & 0xe0) == 0xa0) { OutLen = Code & 0x1f; return true; }
+        if ((Code & 0xf0) == 0x90 || (Code & 0xf0) == 0x80) { OutLen = Code & 0x0f; return true; }
+        return Fail();
+    }
+    if (!Need(Bytes))
+    {
+        return false;
+    }
+    OutLen = uint32(BigEndian(Bytes));
+    return true;
+}
+
+bool FAgentEMsgPackReader::ReadMapHeader(uint32& OutCount)
+{
+    if (PeekType() != EAgentEMsgPackType::Map)
+    {
+        return Fail();
+    }
+    return ReadLength(Data[Pos++], OutCount);
+}
+
+bool FAgentEMsgPackReader::ReadArrayHeader(uint32& OutCount)
+{
+    if (PeekType() != EAgentEMsgPackType::Array)
+    {
+        return Fail();
+    }
+    return ReadLength(Data[Pos++], OutCount);
+}
+
+bool FAgentEMsgPackReader::ReadStringView(FUtf8StringView& Out)
+{
+    uint32 Len = 0;
+    if (PeekType() != EAgentEMsgPackType::Str || !ReadLength(Data[Pos++], Len) || !Need(int32(Len)))
+    {
+        return Fail();
+    }
+    Out = FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Data + Pos), int32(Len));
+    Pos += int32(Len);
+    return true;
+}
+
+bool FAgentEMsgPackReader::ReadString(FString& Out)
+{
+    FUtf8StringView View;
+    if (!ReadStringView(View))
+    {
+        return false;
+    }
+    Out = FString(View);
+    return true;
+}
+
+bool FAgentEMsgPackReader::ReadNumber(double& Out)
+{
+    if (bError || Pos >= Num)
+    {
+        return Fail();
+    }
+    const uint8 B = Data[Pos];
+    if (B <= 0x7f) { ++Pos; Out = B; return true; }
+    if (B >= 0xe0) { ++Pos; Out = int32(B) - 0x100; return true; }
+
+    int32 Bytes = 0;
+    switch (B)
+    {
+    case 0xcc: case 0xd0: Bytes = 1; break;
+    case 0xcd: case 0xd1: Bytes = 2; break;
+    case 0xce: case 0xd2: case 0xca: Bytes = 4; break;
+    case 0xcf: case 0xd3: case 0xcb: Bytes = 8; break;
+    default: return Fail();
+    }
+    ++Pos;
+    if (!Need(Bytes))
+    {
+        return false;
+    }
+    const uint64 Raw = BigEndian(Bytes);
+    switch (B)
+    {
+    case 0xca: { uint32 Bits = uint32(Raw); float F; FMemory::Memcpy(&F, &Bits, 4); Out = F; break; }
+    case 0xcb: { double D; FMemory::Memcpy(&D, &Raw, 8); Out = D; break; }
+    case 0xd0: Out = int8(Raw); break;
+    case 0xd1: Out = int16(Raw); break;
+    case 0xd2: Out = int32(Raw); break;
+    case 0xd3: Out = double(int64(Raw)); break;
+    default:   Out = double(Raw); break;
+    }
+    return true;
+}
+
+bool FAgentEMsgPackReader::ReadBool(bool& Out)
+{
+    if (PeekType() != EAgentEMsgPackType::Bool)
+    {
+        return Fail();
+    }
+    Out = Data[Pos++] == 0xc3;
+    return true;
+}
+
+bool FAgentEMsgPackReader::ReadNil()
+{
+    if (PeekType() != EAgentEMsgPackType::Nil)
+    {
+        return Fail();
+    }
+    ++Pos;
+    return true;
+}
+
+bool FAgentEMsgPackReader::Skip()
+{
+    // Iterative: a count of values still to skip, so nesting depth costs nothing
+    uint64 Pending = 1;
+    while (Pending > 0)
+    {
+        --Pending;
+        const EAgentEMsgPackType Type = PeekType();
+        switch (Type)
+        {
+        case EAgentEMsgPackType::Nil:
+        case EAgentEMsgPackType::Bool:
+            ++Pos;
+            break;
+        case EAgentEMsgPackType::Int:
+        case EAgentEMsgPackType::Float:
+        {
+            double Ignored;
+            if (!ReadNumber(Ignored)) return false;
+            break;
+        }
+        case EAgentEMsgPackType::Str:
+        case EAgentEMsgPackType::Bin:
+        {
+            uint32 Len = 0;
+            if (!ReadLength(Data[Pos++], Len) || !Need(int32(Len))) return false;
+            Pos += int32(Len);
+            break;
+        }
+        case EAgentEMsgPackType::Array:
+        case EAgentEMsgPackType::Map:
+        {
+            uint32 Count = 0;
+            if (!ReadLength(Data[Pos++], Count)) return false;
+            Pending += Type == EAgentEMsgPackType::Map ? uint64(Count) * 2 : uint64(Count);
+            // Every value takes at least a byte — reject impossible counts early
+            if (Pending > uint64(Num - Pos)) return Fail();
+            break;
+        }
+        default:
+            return Fail();
+        }
+    }
+    return true;
+}
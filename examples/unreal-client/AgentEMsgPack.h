@@ -0,0 +1,101 @@
+/**
+ * AgentE Unreal Engine Client — MessagePack
+ *
+ * The subset of MessagePack the binary wire format uses (nil, bool, int,
+ * float64, str, bin, array, map). Like FAgentEJsonWriter, the writer appends
+ * straight into a reusable byte buffer; the reader is a pull parser over a
+ * borrowed byte range, so replies are decoded without building a DOM.
+ *
+ * Container headers carry their element count, so callers must know how
+ * many entries a map or array has before writing it.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAgentEMsgPackWriter
+{
+public:
+    /** Clear the buffer, keeping its allocation */
+    void Reset() { Buffer.Reset(); }
+
+    const TArray<uint8>& GetBuffer() const { return Buffer; }
+    int32 Num() const { return Buffer.Num(); }
+
+    void BeginMap(uint32 Count);
+    void BeginArray(uint32 Count);
+
+    /** String from a literal — ASCII only */
+    void Str(const ANSICHAR* Literal);
+    void Str(FStringView Str);
+    void Int(int64 Number);
+    void Double(double Number);
+    void Bool(bool bValue);
+    void Nil();
+
+    /** Binary blob of Bytes bytes */
+    void Bin(const void* Data, int32 Bytes);
+
+    /** Reserve a bin header for Bytes bytes and return where to write them */
+    uint8* BeginBin(int32 Bytes);
+
+private:
+    TArray<uint8> Buffer;
+
+    void Header(uint8 FixBase, uint32 FixMax, uint8 Code8, uint8 Code16, uint8 Code32, uint32 Len);
+    void BigEndian(uint64 Value, int32 Bytes);
+};
+
+enum class EAgentEMsgPackType : uint8
+{
+    Nil,
+    Bool,
+    Int,
+    Float,
+    Str,
+    Bin,
+    Array,
+    Map,
+    Invalid,
+};
+
+/**
+ * Pull parser. Every Read* returns false on a type mismatch or truncated
+ * input; after that the reader is in an error state and keeps failing.
+ */
+class FAgentEMsgPackReader
+{
+public:
+    FAgentEMsgPackReader(const uint8* InData, int32 InNum) : Data(InData), Num(InNum) {}
+
+    EAgentEMsgPackType PeekType() const;
+    bool HasError() const { return bError; }
+    bool AtEnd() const { return Pos >= Num; }
+
+    bool ReadMapHeader(uint32& OutCount);
+    bool ReadArrayHeader(uint32& OutCount);
+    bool ReadString(FString& Out);
+
+    /** Zero-copy view of a str payload (UTF-8, not terminated) */
+    bool ReadStringView(FUtf8StringView& Out);
+
+    /** Any int or float, widened to double */
+    bool ReadNumber(double& Out);
+    bool ReadBool(bool& Out);
+    bool ReadNil();
+
+    /** Skip one value, including nested containers */
+    bool Skip();
+
+private:
+    const uint8* Data;
+    int32 Num;
+    int32 Pos = 0;
+    bool bError = false;
+
+    bool Need(int32 Bytes);
+    uint64 BigEndian(int32 Bytes);
+    bool Fail() { bError = true; return false; }
+    bool ReadLength(uint8 Code, uint32& OutLen);
+};
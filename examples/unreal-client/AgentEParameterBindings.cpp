@@ -0,0 +1,193 @@
+/**
+ * AgentE Unreal Engine Client — Parameter Bindings
+ *
+ * See AgentEParameterBindings.h.
+ */
+
+#include "AgentEParameterBindings.h"
+#include "UObject/UnrealType.h"
+
+FAgentEParameterBindings::FBinding& FAgentEParameterBindings::Add(
+    int32 Parameter, const UObject* Owner, FAgentEBindingId& OutId)
+{
+    check(Parameter != INDEX_NONE);
+    if (!ByParameter.IsValidIndex(Parameter))
+    {
+        ByParameter.SetNum(Parameter + 1);
+    }
+
+    FBinding& Binding = ByParameter[Parameter].AddDefaulted_GetRef();
+    Binding.Serial = NextSerial++;
+    Binding.Owner = Owner;
+    Binding.bOwned = Owner != nullptr;
+
+    OutId.Parameter = Parameter;
+    OutId.Serial = Binding.Serial;
+    return Binding;
+}
+
+FAgentEBindingId FAgentEParameterBindings::BindFloat(int32 Parameter, float* Target, const UObject* Owner)
+{
+    FAgentEBindingId Id;
+    if (Target)
+    {
+        Add(Parameter, Owner, Id).Target = Target;
+    }
+    return Id;
+}
+
+FAgentEBindingId FAgentEParameterBindings::BindSetter(int32 Parameter, FSetter Setter, const UObject* Owner)
+{
+    FAgentEBindingId Id;
+    if (Setter)
+    {
+        Add(Parameter, Owner, Id).Setter = MoveTemp(Setter);
+    }
+    return Id;
+}
+
+FAgentEBindingId FAgentEParameterBindings::BindProperty(int32 Parameter, UObject* Target, const FString& PropertyPath)
+{
+    FAgentEBindingId Id;
+    if (!Target)
+    {
+        return Id;
+    }
+
+    TArray<FString> Segments;
+    PropertyPath.ParseIntoArray(Segments, TEXT("."));
+
+    TArray<const FProperty*, TInlineAllocator<4>> Chain;
+    const UStruct* Struct = Target->GetClass();
+    for (int32 I = 0; I < Segments.Num(); ++I)
+    {
+        const FProperty* Property = Struct ? FindFProperty<FProperty>(Struct, *Segments[I]) : nullptr;
+        const bool bLeaf = I == Segments.Num() - 1;
+        const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+
+        if (!Property || (bLeaf && !CastField<FNumericProperty>(Property)) || (!bLeaf && !StructProperty))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[AgentE] Cannot bind %s.%s: not a numeric property path"),
+                *Target->GetClass()->GetName(), *PropertyPath);
+            return Id;
+        }
+        Chain.Add(Property);
+        Struct = StructProperty ? StructProperty->Struct : nullptr;
+    }
+    if (Chain.IsEmpty())
+    {
+        return Id;
+    }
+
+    Add(Parameter, Target, Id).PropertyChain = MoveTemp(Chain);
+    return Id;
+}
+
+void FAgentEParameterBindings::Unbind(FAgentEBindingId Id)
+{
+    if (ByParameter.IsValidIndex(Id.Parameter))
+    {
+        ByParameter[Id.Parameter].RemoveAll([&Id](const FBinding& Binding) { return Binding.Serial == Id.Serial; });
+    }
+}
+
+void FAgentEParameterBindings::UnbindAll(const UObject* Owner)
+{
+    for (TArray<FBinding, TInlineAllocator<1>>& Bindings : ByParameter)
+    {
+        Bindings.RemoveAll([Owner](const FBinding& Binding) { return Binding.bOwned && Binding.Owner == Owner; });
+    }
+}
+
+bool FAgentEParameterBindings::Apply(const FBinding& Binding, float Value)
+{
+    const UObject* Owner = Binding.Owner.Get();
+    if (Binding.bOwned && !Owner)
+    {
+        return false;
+    }
+
+    if (Binding.Target)
+    {
+        *Binding.Target = Value;
+    }
+    else if (Binding.Setter)
+    {
+        Binding.Setter(Value);
+    }
+    else
+    {
+        // Walk the resolved chain: object → nested structs → numeric leaf
+        void* Container = const_cast<UObject*>(Owner);
+        for (const FProperty* Property : Binding.PropertyChain)
+        {
+            Container = Property->ContainerPtrToValuePtr<void>(Container);
+        }
+        const FNumericProperty* Leaf = CastFieldChecked<FNumericProperty>(Binding.PropertyChain.Last());
+        if (Leaf->IsFloatingPoint())
+        {
+            Leaf->SetFloatingPointPropertyValue(Container, double(Value));
+        }
+        else
+        {
+            Leaf->SetIntPropertyValue(Container, FMath::RoundToInt64(double(Value)));
+        }
+    }
+    return true;
+}
+
+bool FAgentEParameterBindings::TryGetValue(int32 Parameter, float& OutValue) const
+{
+    if (!HasBindings(Parameter))
+    {
+        return false;
+    }
+
+    for (const FBinding& Binding : ByParameter[Parameter])
+    {
+        const UObject* Owner = Binding.Owner.Get();
+        if (Binding.bOwned && !Owner)
+        {
+            continue;
+        }
+        if (Binding.Target)
+        {
+            OutValue = *Binding.Target;
+            return true;
+        }
+        if (!Binding.PropertyChain.IsEmpty())
+        {
+            const void* Container = Owner;
+            for (const FProperty* Property : Binding.PropertyChain)
+            {
+                Container = Property->ContainerPtrToValuePtr<void>(Container);
+            }
+            const FNumericProperty* Leaf = CastFieldChecked<FNumericProperty>(Binding.PropertyChain.Last());
+            OutValue = Leaf->IsFloatingPoint()
+                ? float(Leaf->GetFloatingPointPropertyValue(Container))
+                : float(Leaf->GetSignedIntPropertyValue(Container));
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FAgentEParameterBindings::Dispatch(int32 Parameter, float Value)
+{
+    if (!HasBindings(Parameter))
+    {
+        return false;
+    }
+
+    TArray<FBinding, TInlineAllocator<1>>& Bindings = ByParameter[Parameter];
+    bool bStale = false;
+    for (const FBinding& Binding : Bindings)
+    {
+        bStale |= !Apply(Binding, Value);
+    }
+    if (bStale)
+    {
+        Bindings.RemoveAll([](const FBinding& Binding) { return Binding.bOwned && !Binding.Owner.IsValid(); });
+    }
+    return !Bindings.IsEmpty();
+}
@@ -0,0 +1,83 @@
+/**
+ * AgentE Unreal Engine Client — Parameter Bindings
+ *
+ * Binds a parameter key once to whatever it should change — a float, a
+ * setter, or a numeric UPROPERTY reached by a path such as
+ * "Economy.TradeTax" — so adjustments are applied without string compares.
+ * Bindings are indexed by FAgentEKeyTable handle, the same handle the reply
+ * parser resolves keys to, so dispatching an adjustment is an array index
+ * followed by calls to that key's bindings only.
+ *
+ * Game thread only. Setters must not bind or unbind while being dispatched.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+/** Returned by a bind, for unbinding later */
+struct FAgentEBindingId
+{
+    int32 Parameter = INDEX_NONE;
+    uint32 Serial = 0;
+
+    bool IsValid() const { return Parameter != INDEX_NONE; }
+};
+
+class FAgentEParameterBindings
+{
+public:
+    using FSetter = TFunction<void(float)>;
+
+    /**
+     * Owner, when given, scopes the binding: it is dropped once Owner is
+     * destroyed, which makes raw Target pointers into Owner safe.
+     */
+    FAgentEBindingId BindFloat(int32 Parameter, float* Target, const UObject* Owner = nullptr);
+    FAgentEBindingId BindSetter(int32 Parameter, FSetter Setter, const UObject* Owner = nullptr);
+
+    /**
+     * PropertyPath names a numeric property of Target's class, through
+     * struct members if dotted. Resolved once here; false (and a log) if it
+     * does not resolve.
+     */
+    FAgentEBindingId BindProperty(int32 Parameter, UObject* Target, const FString& PropertyPath);
+
+    void Unbind(FAgentEBindingId Id);
+    void UnbindAll(const UObject* Owner);
+
+    /** Apply Value to every binding of Parameter; false when it has none */
+    bool Dispatch(int32 Parameter, float Value);
+
+    /** Current value of Parameter's first readable binding (float or property); false if none */
+    bool TryGetValue(int32 Parameter, float& OutValue) const;
+
+    bool HasBindings(int32 Parameter) const
+    {
+        return ByParameter.IsValidIndex(Parameter) && !ByParameter[Parameter].IsEmpty();
+    }
+
+private:
+    struct FBinding
+    {
+        uint32 Serial = 0;
+        TWeakObjectPtr<const UObject> Owner;
+        bool bOwned = false;
+
+        float* Target = nullptr;
+        FSetter Setter;
+
+        /** Property path from Owner's object to a numeric leaf */
+        TArray<const FProperty*, TInlineAllocator<4>> PropertyChain;
+    };
+
+    /** Indexed by key handle; most keys have one binding */
+    TArray<TArray<FBinding, TInlineAllocator<1>>> ByParameter;
+    uint32 NextSerial = 1;
+
+    FBinding& Add(int32 Parameter, const UObject* Owner, FAgentEBindingId& OutId);
+
+    /** False when the binding's owner is gone */
+    static bool Apply(const FBinding& Binding, float Value);
+};
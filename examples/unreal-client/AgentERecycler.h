@@ -0,0 +1,63 @@
+/**
+ * AgentE Unreal Engine Client — Recycler
+ *
+ * A small pool of shared objects for data that lives one tick or a little
+ * longer: snapshots, samples, aggregates. Acquire() hands back an entry that
+ * nothing else references any more (its shared reference count is back to
+ * one), so once the pipeline is warm a tick reuses the previous ticks'
+ * objects and their array capacity instead of allocating new ones.
+ *
+ * Not a stack arena on purpose: a snapshot outlives its tick as the delta
+ * base (LastSent) and in the name caches, and a reply can land after the
+ * next tick has started, so objects are freed by reference count rather
+ * than reset all at once. When every entry is still in use Acquire makes a
+ * new object and counts it in GetAllocations(); it joins the pool while
+ * there is room.
+ *
+ * Touched by one thread at a time — its owner's. Other threads may hold and
+ * drop references concurrently.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+template <typename T>
+class TAgentERecycler
+{
+public:
+    using FRef = TSharedRef<T, ESPMode::ThreadSafe>;
+
+    explicit TAgentERecycler(int32 InCapacity)
+        : Capacity(FMath::Max(1, InCapacity))
+    {
+        Entries.Reserve(Capacity);
+    }
+
+    /** An object nobody else holds; its previous contents are left for the caller to overwrite */
+    FRef Acquire()
+    {
+        for (const FRef& Entry : Entries)
+        {
+            if (Entry.IsUnique())
+            {
+                return Entry;
+            }
+        }
+        ++Allocations;
+        FRef Made = MakeShared<T, ESPMode::ThreadSafe>();
+        if (Entries.Num() < Capacity)
+        {
+            Entries.Add(Made);
+        }
+        return Made;
+    }
+
+    /** Objects Acquire had to make, the first Capacity included */
+    int64 GetAllocations() const { return Allocations; }
+
+private:
+    int32 Capacity;
+    TArray<FRef> Entries;
+    int64 Allocations = 0;
+};
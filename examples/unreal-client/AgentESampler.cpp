@@ -0,0 +1,203 @@
+/**
+ * AgentE Unreal Engine Client — Agent Sampler
+ *
+ * See AgentESampler.h.
+ */
+
+#include "AgentESampler.h"
+#include "Hash/CityHash.h"
+
+/** Hash thresholds are out of 2^32; this one admits every agent */
+static constexpr uint64 SampleAll = uint64(1) << 32;
+
+static uint32 HashAgentId(const FString& Id, uint32 Seed)
+{
+    // UTF-8 so the same agents are picked on every platform
+    const FTCHARToUTF8 Utf8(*Id, Id.Len());
+    return uint32(CityHash64WithSeed(Utf8.Get(), uint32(Utf8.Length()), Seed) >> 32);
+}
+
+static double ColumnSum(const TArray<double>& Column)
+{
+    double Sum = 0.0;
+    for (const double V : Column)
+    {
+        Sum += V;
+    }
+    return Sum;
+}
+
+FAgentESampler::FStateRef FAgentESampler::Sample(const FStateRef& FullRef, const FAgentESamplingSettings& Settings)
+{
+    const FAgentEEconomyState& Full = *FullRef;
+    const int32 NumAgents = Full.NumAgents();
+    const int32 NumRoles = Full.Roles().Num();
+
+    // ── Exact aggregates over every agent ──
+
+    TSharedRef<FAgentESampleInfo, ESPMode::ThreadSafe> Info = Infos.Acquire();
+    Info->Population = NumAgents;
+    Info->CountByRole.Reset();
+    Info->SupplyByCurrency.Reset();
+    Info->SupplyByResource.Reset();
+    if (Full.IsTrackingChanges())
+    {
+        // Kept up to date by the mutation hooks; no pass over the agents
+        Info->CountByRole.Append(Full.GetTotals().CountByRole);
+        Info->SupplyByCurrency.Append(Full.GetTotals().SupplyByCurrency);
+        Info->SupplyByResource.Append(Full.GetTotals().SupplyByResource);
+    }
+    else
+    {
+        Info->CountByRole.AddZeroed(NumRoles);
+        for (const uint16 Role : Full.AgentRoles)
+        {
+            if (Role < NumRoles)
+            {
+                ++Info->CountByRole[Role];
+            }
+        }
+        for (const TArray<double>& Column : Full.Balances)
+        {
+            Info->SupplyByCurrency.Add(ColumnSum(Column));
+        }
+        for (const TArray<double>& Column : Full.Inventories)
+        {
+            Info->SupplyByResource.Add(ColumnSum(Column));
+        }
+    }
+
+    // ── Per-role rates, as hash thresholds ──
+
+    TArray<uint64, TInlineAllocator<16>> Thresholds;
+    Info->RateByRole.SetNum(NumRoles);
+    for (int32 R = 0; R < NumRoles; ++R)
+    {
+        const int32 Count = Info->CountByRole[R];
+        uint64 Threshold = SampleAll;
+        if (Count > 0)
+        {
+            const double Target = FMath::Max(double(Settings.MinAgentsPerRole),
+                double(Settings.MaxAgents) * double(Count) / double(NumAgents));
+            const double Rate = FMath::Clamp(Target / double(Count), 1.0 / double(Count), 1.0);
+            Threshold = FMath::Max<uint64>(1, uint64(Rate * double(SampleAll)));
+        }
+        Thresholds.Add(Threshold);
+
+        // The rate the server weights by is the one the threshold applies
+        Info->RateByRole[R] = double(Threshold) / double(SampleAll);
+    }
+
+    // ── Hashes: only recomputed when agents were added or removed ──
+
+    if (!HashSource.IsValid() || !Full.SharesAgentIds(*HashSource) || HashSeed != Settings.Seed)
+    {
+        Hashes.Reset(NumAgents);
+        for (const FString& Id : Full.AgentIds())
+        {
+            Hashes.Add(HashAgentId(Id, Settings.Seed));
+        }
+        HashSource = FullRef;
+        HashSeed = Settings.Seed;
+    }
+
+    // ── Membership: keep existing slots, collect joiners ──
+
+    // Recycled, so the columns keep their capacity from earlier samples
+    TSharedRef<FAgentEEconomyState, ESPMode::ThreadSafe> NextRef = States.Acquire();
+    FAgentEEconomyState& Next = *NextRef;
+    if (LastSample.IsValid())
+    {
+        Allocations += Next.CopyFrom(*LastSample) ? 1 : 0;
+    }
+    else
+    {
+        Next = FAgentEEconomyState();
+    }
+    if (!LastSample.IsValid() || LastSourceEpoch != Full.GetSchemaEpoch())
+    {
+        Next.SetSchema(TArray<FString>(Full.Roles()), TArray<FString>(Full.Resources()), TArray<FString>(Full.Currencies()));
+        Next.ResetAgents();
+        SlotSource.Reset();
+    }
+
+    Kept.Init(false, SlotSource.Num());
+    Joiners.Reset();
+    for (int32 A = 0; A < NumAgents; ++A)
+    {
+        const uint16 Role = Full.AgentRoles[A];
+        if (uint64(Hashes[A]) >= (Role < NumRoles ? Thresholds[Role] : SampleAll))
+        {
+            continue;
+        }
+        // Next still holds LastSample's agents, so its index is the slot
+        const int32 Slot = Next.FindAgent(Full.AgentNames()[A]);
+        if (Slot != INDEX_NONE)
+        {
+            SlotSource[Slot] = A;
+            Kept[Slot] = true;
+        }
+        else
+        {
+            Joiners.Add(A);
+        }
+    }
+
+    // Descending, so every swap brings in a slot that is already settled
+    Leavers.Reset();
+    for (int32 Slot = SlotSource.Num() - 1; Slot >= 0; --Slot)
+    {
+        if (!Kept[Slot])
+        {
+            Leavers.Add(Slot);
+        }
+    }
+
+    // An unchanged sample keeps sharing the previous agent table
+    if (!Leavers.IsEmpty() || !Joiners.IsEmpty())
+    {
+        // The first change detaches Next's name table from LastSample's
+        ++Allocations;
+        for (const int32 Slot : Leavers)
+        {
+            Next.RemoveAgent(Slot);
+            SlotSource.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+        }
+        for (const int32 A : Joiners)
+        {
+            Next.AddAgent(Full.AgentIds()[A], Full.AgentRoles[A]);
+            SlotSource.Add(A);
+        }
+    }
+
+    // ── Gather the sampled agents' values ──
+
+    for (int32 Slot = 0; Slot < SlotSource.Num(); ++Slot)
+    {
+        const int32 A = SlotSource[Slot];
+        Next.AgentRoles[Slot] = Full.AgentRoles[A];
+        for (int32 C = 0; C < Full.Balances.Num(); ++C)
+        {
+            Next.Balances[C][Slot] = Full.Balances[C][A];
+        }
+        for (int32 R = 0; R < Full.Inventories.Num(); ++R)
+        {
+            Next.Inventories[R][Slot] = Full.Inventories[R][A];
+        }
+    }
+    Next.MarketPrices.SetNum(Full.MarketPrices.Num(), EAllowShrinking::No);
+    for (int32 C = 0; C < Full.MarketPrices.Num(); ++C)
+    {
+        Next.MarketPrices[C].Reset();
+        Next.MarketPrices[C].Append(Full.MarketPrices[C]);
+    }
+    Next.RecentTransactions.Reset();
+    Next.RecentTransactions.Append(Full.RecentTransactions);
+    Next.Sampling = Info;
+    Next.Aggregates = Full.Aggregates;
+
+    FStateRef Result = NextRef;
+    LastSample = Result;
+    LastSourceEpoch = Full.GetSchemaEpoch();
+    return Result;
+}
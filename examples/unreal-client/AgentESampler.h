@@ -0,0 +1,78 @@
+/**
+ * AgentE Unreal Engine Client — Agent Sampler
+ *
+ * Caps the per-agent part of a tick body for very large economies. Instead
+ * of every agent, a snapshot carries a stratified sample:
+ *
+ *   - Each role r with n_r of the N agents gets a rate
+ *       clamp(max(MinAgentsPerRole, MaxAgents · n_r / N) / n_r, 0, 1)
+ *     so the sample stays near MaxAgents and small roles stay represented.
+ *   - An agent is in the sample when a seeded hash of its ID falls under
+ *     its role's rate. The choice is deterministic, and when a rate moves
+ *     only the agents near the threshold enter or leave.
+ *   - Totals per currency and resource and counts per role are computed
+ *     over all agents and sent exactly, next to the rates (FAgentESampleInfo).
+ *     The server weights each sampled agent by 1 / rate for the rest.
+ *
+ * Sample slots are kept stable across ticks — leavers are swap-removed and
+ * joiners appended, as with FAgentEEconomyState::RemoveAgent — and an
+ * unchanged sample shares its agent table with the previous one, so delta
+ * and binary bodies stay as small as they are without sampling. Samples and
+ * their FAgentESampleInfo are recycled, so a steady sample reuses the
+ * previous ones' columns.
+ *
+ * Touched only by the send tasks.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AgentEEconomyState.h"
+#include "AgentERecycler.h"
+
+struct FAgentESamplingSettings
+{
+    /** Target number of sampled agents across all roles */
+    int32 MaxAgents = 5000;
+
+    /** Fewer agents than this per role only when the role is that small */
+    int32 MinAgentsPerRole = 50;
+
+    /** Changes which agents are picked; keep it fixed within a session */
+    uint32 Seed = 0;
+};
+
+class FAgentESampler
+{
+public:
+    using FStateRef = TSharedRef<const FAgentEEconomyState, ESPMode::ThreadSafe>;
+
+    /** Sampled copy of Full: schema, prices and events as-is, a subset of agents, exact Sampling */
+    FStateRef Sample(const FStateRef& Full, const FAgentESamplingSettings& Settings);
+
+    /** Samples and infos that could not be recycled, plus columns and name tables that had to be allocated */
+    int64 GetAllocations() const { return Allocations + States.GetAllocations() + Infos.GetAllocations(); }
+
+private:
+    /** Previous result, the starting point for the next one (also keeps schema epochs rising) */
+    TSharedPtr<const FAgentEEconomyState, ESPMode::ThreadSafe> LastSample;
+    uint32 LastSourceEpoch = 0;
+
+    /** Source agent index per slot of LastSample */
+    TArray<int32> SlotSource;
+
+    /** Seeded ID hash per source agent, valid while HashSource's agent table is shared */
+    TArray<uint32> Hashes;
+    TSharedPtr<const FAgentEEconomyState, ESPMode::ThreadSafe> HashSource;
+    uint32 HashSeed = 0;
+
+    /** Scratch, reused between ticks */
+    TArray<int32> Joiners;
+    TArray<int32> Leavers;
+    TBitArray<> Kept;
+
+    /** Held by LastSample, the delta base and the name caches, and by sends in flight */
+    TAgentERecycler<FAgentEEconomyState> States { 6 };
+    TAgentERecycler<FAgentESampleInfo> Infos { 8 };
+    int64 Allocations = 0;
+};
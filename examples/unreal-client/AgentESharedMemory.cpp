@@ -0,0 +1,341 @@
+/**
+ * AgentE Unreal Engine Client — Shared-Memory Transport
+ *
+ * See AgentESharedMemory.h.
+ */
+
+#include "AgentESharedMemory.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/ScopeLock.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "IPAddress.h"
+
+// Must match packages/server/src/sharedMemory.ts
+static constexpr uint32 RegionMagic = 0x4D534741; // 'AGSM'
+static constexpr uint32 RegionVersion = 1;
+static constexpr uint32 HeaderBytes = 64;
+static constexpr uint32 FrameTick = 1;
+static constexpr uint32 FrameEvents = 2;
+static constexpr uint32 MinRingBytes = 64 * 1024;
+static constexpr uint32 MaxRingBytes = 256 * 1024 * 1024;
+
+static uint32 FrameBytes(uint32 PayloadBytes)
+{
+    return (8 + PayloadBytes + 7) & ~7u;
+}
+
+static void WriteRing(uint8* Ring, uint32 Capacity, uint32 Pos, const uint8* Data, uint32 Num)
+{
+    const uint32 Offset = Pos & (Capacity - 1);
+    const uint32 First = FMath::Min(Num, Capacity - Offset);
+    FMemory::Memcpy(Ring + Offset, Data, First);
+    FMemory::Memcpy(Ring, Data + First, Num - First);
+}
+
+static void ReadRing(const uint8* Ring, uint32 Capacity, uint32 Pos, uint8* Out, uint32 Num)
+{
+    const uint32 Offset = Pos & (Capacity - 1);
+    const uint32 First = FMath::Min(Num, Capacity - Offset);
+    FMemory::Memcpy(Out, Ring + Offset, First);
+    FMemory::Memcpy(Out + First, Ring, Num - First);
+}
+
+FAgentESharedMemoryTransport::FAgentESharedMemoryTransport(
+    int32 InPort, int32 InRingBytes, float InInitialBackoff, float InMaxBackoff, FAgentEReplyHandler InHandler)
+    : Port(InPort)
+    , RingBytes(FMath::RoundUpToPowerOfTwo(uint32(FMath::Clamp<int64>(InRingBytes, MinRingBytes, MaxRingBytes))))
+    , InitialBackoff(FMath::Max(0.1f, InInitialBackoff))
+    , MaxBackoff(FMath::Max(InInitialBackoff, InMaxBackoff))
+    , Handler(MoveTemp(InHandler))
+{
+}
+
+FAgentESharedMemoryTransport::~FAgentESharedMemoryTransport()
+{
+    Shutdown();
+}
+
+void FAgentESharedMemoryTransport::Connect()
+{
+#if PLATFORM_LINUX
+    static std::atomic<int32> NextRegion{ 0 };
+    RegionName = FString::Printf(TEXT("agente-%u-%d"), FPlatformProcess::GetCurrentProcessId(), NextRegion.fetch_add(1));
+    Region = FPlatformMemory::MapNamedSharedMemoryRegion(RegionName, /*bCreate*/ true,
+        FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write,
+        HeaderBytes + 2 * SIZE_T(RingBytes));
+    if (!Region)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[AgentE] Could not create shared-memory region %s"), *RegionName);
+        return;
+    }
+
+    uint8* Base = static_cast<uint8*>(Region->GetAddress());
+    FMemory::Memzero(Base, HeaderBytes);
+    const uint32 Header[4] = { RegionMagic, RegionVersion, RingBytes, RingBytes };
+    FMemory::Memcpy(Base, Header, sizeof(Header));
+    RequestRing = Base + HeaderBytes;
+    ReplyRing = RequestRing + RingBytes;
+
+    bStopping = false;
+    Thread = FRunnableThread::Create(this, TEXT("AgentE SharedMemory"), 0, TPri_AboveNormal);
+#else
+    UE_LOG(LogTemp, Error, TEXT("[AgentE] The shared-memory transport needs Linux (POSIX shm); use HTTP or WebSocket"));
+#endif
+}
+
+void FAgentESharedMemoryTransport::Shutdown()
+{
+    bStopping = true;
+    if (Thread)
+    {
+        Thread->Kill(/*bShouldWait*/ true);
+        delete Thread;
+        Thread = nullptr;
+    }
+    if (Region)
+    {
+        // The creating process unlinks the region when it unmaps it
+        FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+        Region = nullptr;
+        RequestRing = nullptr;
+        ReplyRing = nullptr;
+    }
+}
+
+// ─── Send Side ──────────────────────────────────────────────────────────────
+
+bool FAgentESharedMemoryTransport::WriteFrame(uint32 Kind, const TArray<uint8>& Payload)
+{
+    const uint32 Need = FrameBytes(uint32(Payload.Num()));
+    const uint32 Used = RequestHead - RequestTail.load(std::memory_order_acquire);
+    if (!bAttached.load() || Need > RingBytes - Used)
+    {
+        return false;
+    }
+
+    const uint32 Header[2] = { uint32(Payload.Num()), Kind };
+    WriteRing(RequestRing, RingBytes, RequestHead, reinterpret_cast<const uint8*>(Header), sizeof(Header));
+    WriteRing(RequestRing, RingBytes, RequestHead + 8, Payload.GetData(), uint32(Payload.Num()));
+    RequestHead += Need;
+    return true;
+}
+
+void FAgentESharedMemoryTransport::RingDoorbell()
+{
+    // The socket write orders the frame bytes before the server's read of them
+    const uint32 Bell[2] = { RequestHead, ReplyTail.load(std::memory_order_relaxed) };
+    int32 Sent = 0;
+    if (Socket)
+    {
+        Socket->Send(reinterpret_cast<const uint8*>(Bell), sizeof(Bell), Sent);
+    }
+}
+
+void FAgentESharedMemoryTransport::SendTick(const TArray<uint8>& Body, bool bGzip)
+{
+    check(!bGzip);
+    bool bWritten = false;
+    {
+        FScopeLock Guard(&SendLock);
+        bWritten = WriteFrame(FrameTick, Body);
+        if (bWritten)
+        {
+            TicksInFlight.fetch_add(1);
+            RingDoorbell();
+        }
+    }
+    if (!bWritten)
+    {
+        // Detached, or the server is a whole ring behind: treated like an HTTP failure
+        Handler(0, {}, true);
+    }
+}
+
+void FAgentESharedMemoryTransport::SendEvents(const TArray<uint8>& Body)
+{
+    FScopeLock Guard(&SendLock);
+    if (!WriteFrame(FrameEvents, Body))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[AgentE] Event batch dropped: shared-memory ring full or detached"));
+        return;
+    }
+    RingDoorbell();
+}
+
+// ─── Doorbell Thread ────────────────────────────────────────────────────────
+
+uint32 FAgentESharedMemoryTransport::Run()
+{
+    float Backoff = InitialBackoff;
+    while (!bStopping)
+    {
+        if (Attach())
+        {
+            Backoff = InitialBackoff;
+            PumpDoorbells();
+            Detach();
+        }
+        if (bStopping)
+        {
+            break;
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("[AgentE] Shared-memory reattach in %.1fs"), Backoff);
+        for (float Waited = 0.f; Waited < Backoff && !bStopping; Waited += 0.1f)
+        {
+            FPlatformProcess::SleepNoStats(0.1f);
+        }
+        Backoff = FMath::Min(MaxBackoff, Backoff * 2.f);
+    }
+    return 0;
+}
+
+bool FAgentESharedMemoryTransport::Attach()
+{
+    ISocketSubsystem* Sockets = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+    FSocket* NewSocket = Sockets->CreateSocket(NAME_Stream, TEXT("AgentE doorbell"), false);
+    if (!NewSocket)
+    {
+        return false;
+    }
+    NewSocket->SetNoDelay(true);
+
+    TSharedRef<FInternetAddr> Addr = Sockets->CreateInternetAddr();
+    Addr->SetLoopbackAddress();
+    Addr->SetPort(Port);
+
+    // Every attachment starts both rings from zero
+    const FTCHARToUTF8 Hello(*FString::Printf(TEXT("AGSM1 %s -\n"), *RegionName));
+    int32 Sent = 0;
+    uint8 Ack[8];
+    int32 Received = 0;
+    bool bOk = NewSocket->Connect(*Addr)
+        && NewSocket->Send(reinterpret_cast<const uint8*>(Hello.Get()), Hello.Length(), Sent);
+    while (bOk && Received < 8)
+    {
+        int32 Read = 0;
+        bOk = NewSocket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromSeconds(5))
+            && NewSocket->Recv(Ack + Received, 8 - Received, Read) && Read > 0;
+        Received += Read;
+    }
+    if (!bOk)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[AgentE] Shared-memory attach to 127.0.0.1:%d failed"), Port);
+        NewSocket->Close();
+        Sockets->DestroySocket(NewSocket);
+        return false;
+    }
+
+    FScopeLock Guard(&SendLock);
+    Socket = NewSocket;
+    RequestHead = 0;
+    RequestTail = 0;
+    ReplyHead = 0;
+    ReplyTail = 0;
+    bAttached = true;
+    UE_LOG(LogTemp, Log, TEXT("[AgentE] Shared-memory transport attached: /dev/shm/%s"), *RegionName);
+    return true;
+}
+
+void FAgentESharedMemoryTransport::Detach()
+{
+    {
+        FScopeLock Guard(&SendLock);
+        bAttached = false;
+        if (Socket)
+        {
+            Socket->Close();
+            ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+            Socket = nullptr;
+        }
+    }
+    // Ticks the server never answered: the client resyncs with a full snapshot
+    for (int32 Lost = TicksInFlight.exchange(0); Lost > 0; --Lost)
+    {
+        Handler(0, {}, true);
+    }
+}
+
+void FAgentESharedMemoryTransport::PumpDoorbells()
+{
+    uint8 Buffer[64];
+    int32 Pending = 0;
+    while (!bStopping)
+    {
+        if (!Socket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromMilliseconds(100)))
+        {
+            continue;
+        }
+        int32 Read = 0;
+        if (!Socket->Recv(Buffer + Pending, sizeof(Buffer) - Pending, Read) || Read <= 0)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[AgentE] Shared-memory doorbell socket closed"));
+            return;
+        }
+        Pending += Read;
+
+        // Doorbells coalesce on the stream; only the newest positions matter
+        const int32 Packets = Pending / 8;
+        if (Packets == 0)
+        {
+            continue;
+        }
+        uint32 Bell[2];
+        FMemory::Memcpy(Bell, Buffer + (Packets - 1) * 8, 8);
+        Pending -= Packets * 8;
+        FMemory::Memmove(Buffer, Buffer + Packets * 8, Pending);
+
+        RequestTail.store(Bell[0], std::memory_order_release);
+        if (Bell[1] != ReplyHead)
+        {
+            ReplyHead = Bell[1];
+            DispatchReplies();
+        }
+    }
+}
+
+void FAgentESharedMemoryTransport::DispatchReplies()
+{
+    uint32 Tail = ReplyTail.load(std::memory_order_relaxed);
+    while (Tail != ReplyHead)
+    {
+        uint32 Header[2];
+        ReadRing(ReplyRing, RingBytes, Tail, reinterpret_cast<uint8*>(Header), sizeof(Header));
+        const uint32 Length = Header[0];
+        if (FrameBytes(Length) > ReplyHead - Tail)
+        {
+            UE_LOG(LogTemp, Error, TEXT("[AgentE] Shared-memory reply overruns the ring"));
+            Tail = ReplyHead;
+            break;
+        }
+
+        // In place unless the body wraps around the end of the ring
+        const uint32 Offset = (Tail + 8) & (RingBytes - 1);
+        TConstArrayView<uint8> Body;
+        if (Offset + Length <= RingBytes)
+        {
+            Body = TConstArrayView<uint8>(ReplyRing + Offset, int32(Length));
+        }
+        else
+        {
+            ReplyScratch.SetNumUninitialized(int32(Length), EAllowShrinking::No);
+            ReadRing(ReplyRing, RingBytes, Tail + 8, ReplyScratch.GetData(), Length);
+            Body = ReplyScratch;
+        }
+
+        int32 InFlight = TicksInFlight.load();
+        while (InFlight > 0 && !TicksInFlight.compare_exchange_weak(InFlight, InFlight - 1))
+        {
+        }
+        Handler(int32(Header[1]), Body, true);
+
+        // Freed only after the handler is done with the in-place body
+        Tail += FrameBytes(Length);
+        ReplyTail.store(Tail, std::memory_order_relaxed);
+    }
+
+    FScopeLock Guard(&SendLock);
+    RingDoorbell();
+}
@@ -0,0 +1,92 @@
+/**
+ * AgentE Unreal Engine Client — Shared-Memory Transport
+ *
+ * For a game server on the same Linux host as the AgentE server: tick
+ * bodies are written straight into a POSIX shared-memory ring
+ * (/dev/shm/agente-<pid>-<n>) that the server reads, and replies come back
+ * through a second ring in the same region. A loopback TCP socket carries
+ * only the handshake and 8-byte doorbells with the ring positions, so a
+ * round trip is two tiny socket writes instead of an HTTP exchange.
+ *
+ * Ticks use the MessagePack format (tick bodies exactly as POST /tick with
+ * application/x-msgpack); replies are read in place from the reply ring
+ * unless they wrap around its end. Region layout and protocol: see
+ * packages/server/src/sharedMemory.ts. The server must run with
+ * `sharedMemoryPort` (AGENTE_SHM_PORT); the client's SharedMemoryPort must
+ * match.
+ *
+ * A dropped doorbell socket fails the ticks in flight (status 0, like an
+ * HTTP failure) and reattaches with backoff; the server starts the rings
+ * from zero on every attachment.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/PlatformMemory.h"
+#include <atomic>
+#include "AgentETransport.h"
+
+class FSocket;
+class FRunnableThread;
+
+class FAgentESharedMemoryTransport : public IAgentETransport, public FRunnable
+{
+public:
+    /** RingBytes: size of each ring, rounded up to a power of two (64 KB – 256 MB) */
+    FAgentESharedMemoryTransport(
+        int32 InPort, int32 InRingBytes, float InInitialBackoff, float InMaxBackoff, FAgentEReplyHandler InHandler);
+    virtual ~FAgentESharedMemoryTransport() override;
+
+    // IAgentETransport
+    virtual void Connect() override;
+    virtual void Shutdown() override;
+    virtual void SendTick(const TArray<uint8>& Body, bool bGzip) override;
+    virtual void SendEvents(const TArray<uint8>& Body) override;
+
+    // FRunnable — the doorbell thread: attaches, reads doorbells, dispatches replies
+    virtual uint32 Run() override;
+    virtual void Stop() override { bStopping = true; }
+
+private:
+    int32 Port;
+    uint32 RingBytes;
+    float InitialBackoff;
+    float MaxBackoff;
+    FAgentEReplyHandler Handler;
+
+    FString RegionName;
+    FPlatformMemory::FSharedMemoryRegion* Region = nullptr;
+    uint8* RequestRing = nullptr;
+    uint8* ReplyRing = nullptr;
+
+    FSocket* Socket = nullptr;
+    FRunnableThread* Thread = nullptr;
+    std::atomic<bool> bStopping{ false };
+    std::atomic<bool> bAttached{ false };
+
+    /** Guards the request ring's head and socket writes (send tasks and the doorbell thread) */
+    FCriticalSection SendLock;
+    uint32 RequestHead = 0;
+    std::atomic<uint32> RequestTail{ 0 };
+
+    /** Doorbell thread only, except ReplyTail, which doorbells read under SendLock */
+    std::atomic<uint32> ReplyTail{ 0 };
+    uint32 ReplyHead = 0;
+    TArray<uint8> ReplyScratch;
+
+    /** Ticks written but not answered — failed with status 0 if the attachment drops */
+    std::atomic<int32> TicksInFlight{ 0 };
+
+    bool Attach();
+    void Detach();
+    void PumpDoorbells();
+    void DispatchReplies();
+
+    /** SendLock held. Write one frame; false if the request ring is full or detached */
+    bool WriteFrame(uint32 Kind, const TArray<uint8>& Payload);
+
+    /** SendLock held */
+    void RingDoorbell();
+};
@@ -0,0 +1,253 @@
+/**
+ * AgentE Unreal Engine Client — Offline Spool
+ *
+ * See AgentESpool.h.
+ */
+
+#include "AgentESpool.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "Spool headers are memcpy'd and must be little-endian");
+
+static constexpr uint32 SpoolMagic = 0x50534741; // "AGSP"
+static constexpr uint32 SpoolVersion = 1;
+
+struct FAgentESpoolFileHeader
+{
+    uint32 Magic = SpoolMagic;
+    uint32 Version = SpoolVersion;
+    uint32 Format = 0;
+    uint32 Reserved = 0;
+    int64 Capacity = 0;
+    int64 Head = 0;
+    int64 Tail = 0;
+    int64 Count = 0;
+    int64 LastSeq = 0;
+};
+static_assert(sizeof(FAgentESpoolFileHeader) == 56, "Spool file header layout");
+
+struct FAgentESpoolRecordHeader
+{
+    uint32 Len = 0;
+    uint8 Kind = 0;
+    uint8 Reserved[3] = {};
+    int64 Seq = 0;
+};
+static_assert(sizeof(FAgentESpoolRecordHeader) == 16, "Spool record header layout");
+
+static constexpr int64 FileHeaderSize = sizeof(FAgentESpoolFileHeader);
+static constexpr int64 RecordHeaderSize = sizeof(FAgentESpoolRecordHeader);
+
+FAgentESpool::~FAgentESpool()
+{
+    Close();
+}
+
+bool FAgentESpool::Open(const FString& Path, int64 InCapacity, uint32 InFormat)
+{
+    Close();
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Path));
+
+    // Append mode keeps an existing spool; every access seeks anyway
+    Handle.Reset(PlatformFile.OpenWrite(*Path, /*bAppend*/ true, /*bAllowRead*/ true));
+    if (!Handle.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[AgentE] Can't open spool file %s"), *Path);
+        return false;
+    }
+    Capacity = FMath::Max<int64>(InCapacity, RecordHeaderSize);
+    Format = InFormat;
+    Dropped = 0;
+
+    FAgentESpoolFileHeader Header;
+    const bool bRead = Handle->Size() >= FileHeaderSize && Handle->Seek(0)
+        && Handle->Read(reinterpret_cast<uint8*>(&Header), FileHeaderSize);
+    const bool bValid = bRead && Header.Magic == SpoolMagic && Header.Version == SpoolVersion
+        && Header.Head >= 0 && Header.Head <= Header.Tail && Header.Tail - Header.Head <= Header.Capacity
+        && Header.Count >= 0;
+    if (bValid && Header.Format == Format && Header.Capacity == Capacity)
+    {
+        Head = Header.Head;
+        Tail = Header.Tail;
+        Count = Header.Count;
+        LastSeq = Header.LastSeq;
+        if (Count > 0)
+        {
+            UE_LOG(LogTemp, Log, TEXT("[AgentE] Spool %s holds %lld records from an earlier session"), *Path, Count);
+        }
+        return true;
+    }
+
+    if (bValid && Header.Count > 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[AgentE] Discarding %lld spooled records written with another format or size"),
+            Header.Count);
+    }
+    // Seqs keep rising even when the records go
+    LastSeq = bValid ? Header.LastSeq : 0;
+    Clear();
+    Handle->Truncate(FileHeaderSize);
+    return true;
+}
+
+void FAgentESpool::Close()
+{
+    if (Handle.IsValid())
+    {
+        Handle->Flush();
+        Handle.Reset();
+    }
+    Head = Tail = Count = 0;
+}
+
+void FAgentESpool::Clear()
+{
+    Head = Tail = Count = 0;
+    WriteHeader();
+}
+
+void FAgentESpool::WriteHeader()
+{
+    FAgentESpoolFileHeader Header;
+    Header.Format = Format;
+    Header.Capacity = Capacity;
+    Header.Head = Head;
+    Header.Tail = Tail;
+    Header.Count = Count;
+    Header.LastSeq = LastSeq;
+    if (Handle->Seek(0))
+    {
+        Handle->Write(reinterpret_cast<const uint8*>(&Header), FileHeaderSize);
+    }
+    Handle->Flush();
+}
+
+// ─── Ring I/O ───────────────────────────────────────────────────────────────
+
+bool FAgentESpool::ReadRing(int64 Offset, void* Data, int64 Len)
+{
+    uint8* Out = static_cast<uint8*>(Data);
+    const int64 Pos = Offset % Capacity;
+    const int64 First = FMath::Min(Len, Capacity - Pos);
+    if (!Handle->Seek(FileHeaderSize + Pos) || !Handle->Read(Out, First))
+    {
+        return false;
+    }
+    return First == Len || (Handle->Seek(FileHeaderSize) && Handle->Read(Out + First, Len - First));
+}
+
+bool FAgentESpool::WriteRing(int64 Offset, const void* Data, int64 Len)
+{
+    const uint8* In = static_cast<const uint8*>(Data);
+    const int64 Pos = Offset % Capacity;
+    const int64 First = FMath::Min(Len, Capacity - Pos);
+    if (!Handle->Seek(FileHeaderSize + Pos) || !Handle->Write(In, First))
+    {
+        return false;
+    }
+    return First == Len || (Handle->Seek(FileHeaderSize) && Handle->Write(In + First, Len - First));
+}
+
+bool FAgentESpool::ReadRecordSize(int64 Offset, int64& OutSize)
+{
+    FAgentESpoolRecordHeader Record;
+    if (!ReadRing(Offset, &Record, RecordHeaderSize))
+    {
+        return false;
+    }
+    OutSize = RecordHeaderSize + int64(Record.Len);
+    return OutSize <= Tail - Offset;
+}
+
+// ─── Records ────────────────────────────────────────────────────────────────
+
+bool FAgentESpool::Push(EAgentESpoolRecord Kind, int64 Seq, TConstArrayView<uint8> Body)
+{
+    if (!IsOpen())
+    {
+        return false;
+    }
+    const int64 Size = RecordHeaderSize + Body.Num();
+    if (Size > Capacity)
+    {
+        ++Dropped;
+        return false;
+    }
+
+    // Oldest out first; a record that can't be read means the ring is corrupt
+    while (Capacity - (Tail - Head) < Size)
+    {
+        int64 OldSize = 0;
+        if (!ReadRecordSize(Head, OldSize))
+        {
+            Dropped += Count;
+            Head = Tail;
+            Count = 0;
+            break;
+        }
+        Head += OldSize;
+        --Count;
+        ++Dropped;
+    }
+
+    FAgentESpoolRecordHeader Record;
+    Record.Len = uint32(Body.Num());
+    Record.Kind = uint8(Kind);
+    Record.Seq = Seq;
+    if (!WriteRing(Tail, &Record, RecordHeaderSize) || !WriteRing(Tail + RecordHeaderSize, Body.GetData(), Body.Num()))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[AgentE] Spool write failed"));
+        return false;
+    }
+    Tail += Size;
+    ++Count;
+    LastSeq = FMath::Max(LastSeq, Seq);
+    WriteHeader();
+    return true;
+}
+
+bool FAgentESpool::Peek(EAgentESpoolRecord& OutKind, int64& OutSeq, TArray<uint8>& OutBody)
+{
+    if (!IsOpen() || Count == 0)
+    {
+        return false;
+    }
+    FAgentESpoolRecordHeader Record;
+    if (!ReadRing(Head, &Record, RecordHeaderSize)
+        || RecordHeaderSize + int64(Record.Len) > Tail - Head
+        || Record.Kind > uint8(EAgentESpoolRecord::Events))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[AgentE] Spool is corrupt, dropping %lld records"), Count);
+        Dropped += Count;
+        Clear();
+        return false;
+    }
+    OutBody.SetNumUninitialized(Record.Len, EAllowShrinking::No);
+    if (!ReadRing(Head + RecordHeaderSize, OutBody.GetData(), Record.Len))
+    {
+        return false;
+    }
+    OutKind = EAgentESpoolRecord(Record.Kind);
+    OutSeq = Record.Seq;
+    return true;
+}
+
+void FAgentESpool::Pop()
+{
+    int64 Size = 0;
+    if (!IsOpen() || Count == 0 || !ReadRecordSize(Head, Size))
+    {
+        return;
+    }
+    Head += Size;
+    --Count;
+    if (Count == 0)
+    {
+        // Start over from the front so the next outage writes contiguously
+        Head = Tail = 0;
+    }
+    WriteHeader();
+}
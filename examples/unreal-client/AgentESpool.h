@@ -0,0 +1,86 @@
+/**
+ * AgentE Unreal Engine Client — Offline Spool
+ *
+ * Where tick and event bodies go while the server is unreachable, so a
+ * restart or deploy doesn't leave a hole in the server's metric history.
+ * Once the server answers again they are replayed oldest first.
+ *
+ * The spool is one file: a small header, then a byte ring of fixed
+ * capacity. Each record is its kind, seq and body; a record may wrap
+ * around the end of the ring. A full ring drops its oldest records to make
+ * room, so disk usage never exceeds the header plus the capacity. The
+ * header is rewritten after every change, so a spool left over from an
+ * earlier session is picked up and replayed.
+ *
+ * Records are written and read in place with positioned file I/O. The
+ * platform's mapped-file API maps read-only, which rules out mmap for a
+ * ring that is written.
+ *
+ * Touched only by the send tasks, like the rest of FAgentESendContext.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IFileHandle;
+
+enum class EAgentESpoolRecord : uint8
+{
+    Tick,
+    Events,
+};
+
+class FAgentESpool
+{
+public:
+    ~FAgentESpool();
+
+    /**
+     * Open (or create) the spool file. Capacity is the ring size in bytes.
+     * Format identifies the wire format the bodies are in; a spool written
+     * with another format or capacity is discarded. False if the file can't
+     * be opened.
+     */
+    bool Open(const FString& Path, int64 Capacity, uint32 Format);
+    void Close();
+
+    bool IsOpen() const { return Handle.IsValid(); }
+    bool IsEmpty() const { return Count == 0; }
+    int32 Num() const { return int32(Count); }
+
+    /** Highest seq ever pushed — a new session must continue above it */
+    int64 GetLastSeq() const { return LastSeq; }
+
+    /** Records dropped to make room (or too large to ever fit) since Open */
+    int64 GetDropped() const { return Dropped; }
+
+    /** Append one record, dropping the oldest ones while it doesn't fit */
+    bool Push(EAgentESpoolRecord Kind, int64 Seq, TConstArrayView<uint8> Body);
+
+    /** Read the oldest record without removing it */
+    bool Peek(EAgentESpoolRecord& OutKind, int64& OutSeq, TArray<uint8>& OutBody);
+
+    /** Remove the oldest record */
+    void Pop();
+
+private:
+    TUniquePtr<IFileHandle> Handle;
+    int64 Capacity = 0;
+    uint32 Format = 0;
+
+    /** Logical byte offsets into the ring (position = offset % Capacity); Tail − Head bytes are used */
+    int64 Head = 0;
+    int64 Tail = 0;
+    int64 Count = 0;
+    int64 LastSeq = 0;
+    int64 Dropped = 0;
+
+    bool ReadRing(int64 Offset, void* Data, int64 Len);
+    bool WriteRing(int64 Offset, const void* Data, int64 Len);
+    bool ReadRecordSize(int64 Offset, int64& OutSize);
+    void WriteHeader();
+
+    /** Forget every record (corrupt ring, or a spool from another format) */
+    void Clear();
+};
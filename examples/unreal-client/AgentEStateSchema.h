@@ -0,0 +1,339 @@
+/**
+ * AgentE Unreal Engine Client — Compile-Time State Schema
+ *
+ * For economies whose currencies, resources and roles are fixed when the
+ * game is built. Declare each list as a type with a `Names` array,
+ *
+ *   struct FMyCurrencies { static constexpr const ANSICHAR* Names[] = { "gold", "gems" }; };
+ *   struct FMyResources  { static constexpr const ANSICHAR* Names[] = { "ore", "wood", "weapons" }; };
+ *   struct FMyRoles      { static constexpr const ANSICHAR* Names[] = { "Fighter", "Crafter" }; };
+ *   using FMySchema = TAgentEStateSchema<FMyCurrencies, FMyResources, FMyRoles>;
+ *
+ * and TAgentEStateSchema provides, at compile time:
+ *   - the column counts and a constexpr index per name
+ *     (`constexpr int32 Gold = FMySchema::Currency("gold");`), so game code
+ *     addresses columns without FindCurrency;
+ *   - every key and role value of the per-agent maps pre-encoded as JSON
+ *     (`{"gold":`, `,"gems":`, `"Fighter"`), so the full-snapshot writer
+ *     copies fixed fragments instead of escaping each name once per agent.
+ *     Each agent's column loop has a constant trip count, which the compiler
+ *     unrolls.
+ *
+ * AgentEWriteSchemaTickBody writes the same bytes as AgentEWriteTickBody.
+ * If the state's names don't match the schema (for example, SetSchema was
+ * called with other names), it falls back to AgentEWriteTickBody instead.
+ * UAgentEClient::UseStateSchema<FMySchema>() applies the names and switches
+ * the send task to it. Deltas and MessagePack bodies don't change: deltas
+ * already visit only what changed, and binary columns are already raw
+ * copies.
+ *
+ * Names must be printable ASCII without `"` or `\`, so that each name is its
+ * own JSON encoding; the static_asserts below enforce it. Lists must be
+ * non-empty and free of duplicates.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AgentEEconomyState.h"
+#include "AgentEStateWriter.h"
+
+namespace AgentESchema
+{
+    template <typename T, int32 N>
+    constexpr int32 CountOf(const T (&)[N]) { return N; }
+
+    constexpr int32 Length(const ANSICHAR* Str)
+    {
+        int32 Len = 0;
+        while (Str[Len])
+        {
+            ++Len;
+        }
+        return Len;
+    }
+
+    constexpr bool Equal(const ANSICHAR* A, const ANSICHAR* B)
+    {
+        int32 I = 0;
+        while (A[I] && A[I] == B[I])
+        {
+            ++I;
+        }
+        return A[I] == B[I];
+    }
+
+    template <typename ListT>
+    constexpr int32 IndexOf(const ANSICHAR* Name)
+    {
+        for (int32 I = 0; I < CountOf(ListT::Names); ++I)
+        {
+            if (Equal(ListT::Names[I], Name))
+            {
+                return I;
+            }
+        }
+        return INDEX_NONE;
+    }
+
+    /** Non-empty, printable ASCII, nothing JSON would escape, no duplicates */
+    template <typename ListT>
+    constexpr bool IsValidList()
+    {
+        for (int32 I = 0; I < CountOf(ListT::Names); ++I)
+        {
+            const ANSICHAR* Name = ListT::Names[I];
+            if (!Name[0] || IndexOf<ListT>(Name) != I)
+            {
+                return false;
+            }
+            for (int32 C = 0; Name[C]; ++C)
+            {
+                if (Name[C] < 0x20 || Name[C] > 0x7e || Name[C] == '"' || Name[C] == '\\')
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /** Exact match, as the JSON key compares — FName lookups would ignore case */
+    inline bool SameName(const FString& Actual, const ANSICHAR* Expected)
+    {
+        const int32 Len = Length(Expected);
+        if (Actual.Len() != Len)
+        {
+            return false;
+        }
+        for (int32 I = 0; I < Len; ++I)
+        {
+            if (Actual[I] != TCHAR(Expected[I]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename ListT>
+    bool Matches(const TArray<FString>& Actual)
+    {
+        if (Actual.Num() != CountOf(ListT::Names))
+        {
+            return false;
+        }
+        for (int32 I = 0; I < Actual.Num(); ++I)
+        {
+            if (!SameName(Actual[I], ListT::Names[I]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename ListT>
+    TArray<FString> ToStrings()
+    {
+        TArray<FString> Out;
+        for (const ANSICHAR* Name : ListT::Names)
+        {
+            Out.Add(FString(Name));
+        }
+        return Out;
+    }
+
+    /** Bytes of all of ListT's names with Extra bytes (quotes, prefix, suffix) each */
+    template <typename ListT>
+    constexpr int32 FragmentBytes(int32 Extra)
+    {
+        int32 Bytes = 0;
+        for (const ANSICHAR* Name : ListT::Names)
+        {
+            Bytes += Length(Name) + Extra;
+        }
+        return Bytes;
+    }
+
+    /**
+     * Every name of ListT encoded as PrefixT "name" SuffixT, back to back in
+     * one constexpr array; a '\0' prefix or suffix is left out.
+     */
+    template <typename ListT, ANSICHAR PrefixT, ANSICHAR SuffixT>
+    struct TFragments
+    {
+        static constexpr int32 Num = CountOf(ListT::Names);
+
+        ANSICHAR Bytes[FragmentBytes<ListT>(2 + (PrefixT ? 1 : 0) + (SuffixT ? 1 : 0))] = {};
+        int32 Offsets[Num + 1] = {};
+
+        constexpr TFragments()
+        {
+            int32 At = 0;
+            for (int32 I = 0; I < Num; ++I)
+            {
+                Offsets[I] = At;
+                if (PrefixT)
+                {
+                    Bytes[At++] = PrefixT;
+                }
+                Bytes[At++] = '"';
+                for (const ANSICHAR* C = ListT::Names[I]; *C; ++C)
+                {
+                    Bytes[At++] = *C;
+                }
+                Bytes[At++] = '"';
+                if (SuffixT)
+                {
+                    Bytes[At++] = SuffixT;
+                }
+            }
+            Offsets[Num] = At;
+        }
+
+        const ANSICHAR* Get(int32 Index) const { return Bytes + Offsets[Index]; }
+        int32 Len(int32 Index) const { return Offsets[Index + 1] - Offsets[Index]; }
+    };
+}
+
+template <typename CurrenciesT, typename ResourcesT, typename RolesT>
+struct TAgentEStateSchema
+{
+    static_assert(AgentESchema::IsValidList<CurrenciesT>(), "Currency names must be unique, non-empty, plain ASCII without quotes or backslashes");
+    static_assert(AgentESchema::IsValidList<ResourcesT>(), "Resource names must be unique, non-empty, plain ASCII without quotes or backslashes");
+    static_assert(AgentESchema::IsValidList<RolesT>(), "Role names must be unique, non-empty, plain ASCII without quotes or backslashes");
+
+    static constexpr int32 NumCurrencies = AgentESchema::CountOf(CurrenciesT::Names);
+    static constexpr int32 NumResources = AgentESchema::CountOf(ResourcesT::Names);
+    static constexpr int32 NumRoles = AgentESchema::CountOf(RolesT::Names);
+
+    /** Column / role index of a name; INDEX_NONE when the schema has no such name */
+    static constexpr int32 Currency(const ANSICHAR* Name) { return AgentESchema::IndexOf<CurrenciesT>(Name); }
+    static constexpr int32 Resource(const ANSICHAR* Name) { return AgentESchema::IndexOf<ResourcesT>(Name); }
+    static constexpr int32 Role(const ANSICHAR* Name) { return AgentESchema::IndexOf<RolesT>(Name); }
+
+    /** `,"name":` per currency / resource (the comma is skipped for the first key), `"name"` per role */
+    static constexpr AgentESchema::TFragments<CurrenciesT, ',', ':'> CurrencyKeys{};
+    static constexpr AgentESchema::TFragments<ResourcesT, ',', ':'> ResourceKeys{};
+    static constexpr AgentESchema::TFragments<RolesT, '\0', '\0'> RoleValues{};
+
+    /** SetSchema with these names; existing agents are kept */
+    static void Apply(FAgentEEconomyState& State)
+    {
+        State.SetSchema(AgentESchema::ToStrings<RolesT>(), AgentESchema::ToStrings<ResourcesT>(),
+            AgentESchema::ToStrings<CurrenciesT>());
+    }
+
+    /** Whether State has exactly these names, in this order */
+    static bool Matches(const FAgentEEconomyState& State)
+    {
+        return State.Balances.Num() == NumCurrencies && State.Inventories.Num() == NumResources
+            && State.AgentRoles.Num() == State.NumAgents()
+            && AgentESchema::Matches<CurrenciesT>(State.Currencies())
+            && AgentESchema::Matches<ResourcesT>(State.Resources())
+            && AgentESchema::Matches<RolesT>(State.Roles());
+    }
+};
+
+/**
+ * AgentEWriteTickBody, specialized for SchemaT; same signature and output.
+ * Falls back to the generic writer when State doesn't match SchemaT.
+ */
+template <typename SchemaT>
+void AgentEWriteSchemaTickBody(
+    FAgentEJsonWriter& W, const FAgentEEconomyState& S, int32 Tick, int64 Seq,
+    const ANSICHAR* MessageType = nullptr, const FAgentEJsonNames* Names = nullptr)
+{
+    if (!SchemaT::Matches(S))
+    {
+        AgentEWriteTickBody(W, S, Tick, Seq, MessageType, Names);
+        return;
+    }
+
+    const int32 NumAgents = S.NumAgents();
+    const FAgentEJsonNames* Encoded = Names && Names->IsBoundTo(S) ? Names : nullptr;
+    auto AgentKey = [&](int32 A) {
+        if (Encoded)
+        {
+            W.EncodedKey(Encoded->Agent(A));
+        }
+        else
+        {
+            W.Key(FStringView(S.AgentIds()[A]));
+        }
+    };
+
+    const double* Balances[SchemaT::NumCurrencies];
+    for (int32 C = 0; C < SchemaT::NumCurrencies; ++C)
+    {
+        Balances[C] = S.Balances[C].GetData();
+    }
+    const double* Inventories[SchemaT::NumResources];
+    for (int32 R = 0; R < SchemaT::NumResources; ++R)
+    {
+        Inventories[R] = S.Inventories[R].GetData();
+    }
+
+    AgentEBeginTickBody(W, S, Tick, MessageType);
+
+    // agent → { currency → balance }: every agent has every currency
+    W.Key("agentBalances");
+    W.BeginObject();
+    for (int32 A = 0; A < NumAgents; ++A)
+    {
+        AgentKey(A);
+        W.Fragment("{", 1);
+        W.Fragment(SchemaT::CurrencyKeys.Get(0) + 1, SchemaT::CurrencyKeys.Len(0) - 1);
+        W.Value(Balances[0][A]);
+        for (int32 C = 1; C < SchemaT::NumCurrencies; ++C)
+        {
+            W.Fragment(SchemaT::CurrencyKeys.Get(C), SchemaT::CurrencyKeys.Len(C));
+            W.Value(Balances[C][A]);
+        }
+        W.EndObject();
+    }
+    W.EndObject();
+
+    // agent → role; an out-of-range role is "" as in the generic writer
+    W.Key("agentRoles");
+    W.BeginObject();
+    for (int32 A = 0; A < NumAgents; ++A)
+    {
+        AgentKey(A);
+        const uint16 Role = S.AgentRoles[A];
+        if (Role < SchemaT::NumRoles)
+        {
+            W.Raw(SchemaT::RoleValues.Get(Role), SchemaT::RoleValues.Len(Role));
+        }
+        else
+        {
+            W.Raw("\"\"", 2);
+        }
+    }
+    W.EndObject();
+
+    // agent → { resource → quantity }, zero quantities omitted
+    W.Key("agentInventories");
+    W.BeginObject();
+    for (int32 A = 0; A < NumAgents; ++A)
+    {
+        AgentKey(A);
+        W.Fragment("{", 1);
+        int32 Skip = 1; // no comma before the first key written
+        for (int32 R = 0; R < SchemaT::NumResources; ++R)
+        {
+            const double Qty = Inventories[R][A];
+            if (Qty != 0.0)
+            {
+                W.Fragment(SchemaT::ResourceKeys.Get(R) + Skip, SchemaT::ResourceKeys.Len(R) - Skip);
+                W.Value(Qty);
+                Skip = 0;
+            }
+        }
+        W.EndObject();
+    }
+    W.EndObject();
+
+    AgentEEndTickBody(W, S, Seq);
+}
@@ -0,0 +1,984 @@
+/**
+ * AgentE Unreal Engine Client — Streaming State Writer
+ *
+ * See AgentEStateWriter.h.
+ */
+
+#include "AgentEStateWriter.h"
+#include "AgentEEconomyState.h"
+#include "AgentEMsgPack.h"
+#include "UObject/NameTypes.h"
+
+// ─── Primitives ─────────────────────────────────────────────────────────────
+
+void FAgentEJsonWriter::Reset()
+{
+    Buffer.Reset();
+    bNeedComma = false;
+}
+
+void FAgentEJsonWriter::Separator()
+{
+    if (bNeedComma)
+    {
+        Buffer.Add(',');
+    }
+}
+
+void FAgentEJsonWriter::WriteLiteral(const ANSICHAR* Str, int32 Len)
+{
+    Buffer.Append(reinterpret_cast<const uint8*>(Str), Len);
+}
+
+void FAgentEJsonWriter::Raw(const ANSICHAR* Json, int32 Len)
+{
+    Separator();
+    WriteLiteral(Json, Len);
+    bNeedComma = true;
+}
+
+void FAgentEJsonWriter::EncodedKey(TConstArrayView<uint8> Encoded)
+{
+    Separator();
+    Buffer.Append(Encoded.GetData(), Encoded.Num());
+    Buffer.Add(':');
+    bNeedComma = false;
+}
+
+void FAgentEJsonWriter::Fragment(const ANSICHAR* Json, int32 Len)
+{
+    WriteLiteral(Json, Len);
+    bNeedComma = false;
+}
+
+void FAgentEJsonWriter::BeginObject()
+{
+    Separator();
+    Buffer.Add('{');
+    bNeedComma = false;
+}
+
+void FAgentEJsonWriter::EndObject()
+{
+    Buffer.Add('}');
+    bNeedComma = true;
+}
+
+void FAgentEJsonWriter::BeginArray()
+{
+    Separator();
+    Buffer.Add('[');
+    bNeedComma = false;
+}
+
+void FAgentEJsonWriter::EndArray()
+{
+    Buffer.Add(']');
+    bNeedComma = true;
+}
+
+void FAgentEJsonWriter::Key(const ANSICHAR* Literal)
+{
+    Separator();
+    Buffer.Add('"');
+    WriteLiteral(Literal, FCStringAnsi::Strlen(Literal));
+    Buffer.Add('"');
+    Buffer.Add(':');
+    bNeedComma = false;
+}
+
+void FAgentEJsonWriter::Key(FStringView Name)
+{
+    Separator();
+    WriteEscaped(Name.GetData(), Name.Len());
+    Buffer.Add(':');
+    bNeedComma = false;
+}
+
+void FAgentEJsonWriter::Key(FName Name)
+{
+    FNameBuilder Builder(Name);
+    Key(Builder.ToView());
+}
+
+void FAgentEJsonWriter::Value(FStringView Str)
+{
+    Separator();
+    WriteEscaped(Str.GetData(), Str.Len());
+    bNeedComma = true;
+}
+
+void FAgentEJsonWriter::Value(FName Name)
+{
+    FNameBuilder Builder(Name);
+    Value(Builder.ToView());
+}
+
+void FAgentEJsonWriter::Value(const ANSICHAR* Literal)
+{
+    Separator();
+    Buffer.Add('"');
+    WriteLiteral(Literal, FCStringAnsi::Strlen(Literal));
+    Buffer.Add('"');
+    bNeedComma = true;
+}
+
+void FAgentEJsonWriter::Value(int64 Number)
+{
+    Separator();
+    WriteInt(Number);
+    bNeedComma = true;
+}
+
+void FAgentEJsonWriter::Value(double Number)
+{
+    Separator();
+    if (!FMath::IsFinite(Number))
+    {
+        // Not representable in JSON — let the server's validator report the path
+        WriteLiteral("null", 4);
+    }
+    else if (Number == FMath::FloorToDouble(Number) && FMath::Abs(Number) < 9.0e15)
+    {
+        // Balances and quantities are usually whole — skip printf
+        WriteInt(static_cast<int64>(Number));
+    }
+    else
+    {
+        // Shortest of 15-17 significant digits that reads back as the same
+        // double; most prices stop at 15, and 17 always round-trips
+        ANSICHAR Tmp[32];
+        int32 Len = 0;
+        for (const ANSICHAR* Format : { "%.15g", "%.16g", "%.17g" })
+        {
+            Len = FCStringAnsi::Snprintf(Tmp, UE_ARRAY_COUNT(Tmp), Format, Number);
+            if (FCStringAnsi::Atod(Tmp) == Number)
+            {
+                break;
+            }
+        }
+        WriteLiteral(Tmp, FMath::Clamp(Len, 0, int32(UE_ARRAY_COUNT(Tmp)) - 1));
+    }
+    bNeedComma = true;
+}
+
+void FAgentEJsonWriter::Value(bool bValue)
+{
+    Separator();
+    if (bValue) WriteLiteral("true", 4);
+    else WriteLiteral("false", 5);
+    bNeedComma = true;
+}
+
+void FAgentEJsonWriter::Null()
+{
+    Separator();
+    WriteLiteral("null", 4);
+    bNeedComma = true;
+}
+
+void FAgentEJsonWriter::WriteInt(int64 Number)
+{
+    ANSICHAR Tmp[24];
+    int32 Pos = UE_ARRAY_COUNT(Tmp);
+    uint64 Magnitude = Number < 0 ? 0ull - static_cast<uint64>(Number) : static_cast<uint64>(Number);
+    do
+    {
+        Tmp[--Pos] = static_cast<ANSICHAR>('0' + Magnitude % 10);
+        Magnitude /= 10;
+    } while (Magnitude != 0);
+    if (Number < 0)
+    {
+        Tmp[--Pos] = '-';
+    }
+    WriteLiteral(Tmp + Pos, UE_ARRAY_COUNT(Tmp) - Pos);
+}
+
+void FAgentEJsonWriter::WriteEscaped(const TCHAR* Str, int32 Len)
+{
+    static const ANSICHAR Hex[] = "0123456789abcdef";
+
+    Buffer.Add('"');
+    for (int32 i = 0; i < Len; ++i)
+    {
+        uint32 C = static_cast<uint32>(Str[i]);
+
+        if (C < 0x80)
+        {
+            if (C == '"' || C == '\\')
+            {
+                Buffer.Add('\\');
+                Buffer.Add(static_cast<uint8>(C));
+            }
+            else if (C < 0x20)
+            {
+                const uint8 Esc[6] = { '\\', 'u', '0', '0', uint8(Hex[C >> 4]), uint8(Hex[C & 0xF]) };
+                Buffer.Append(Esc, 6);
+            }
+            else
+            {
+                Buffer.Add(static_cast<uint8>(C));
+            }
+            continue;
+        }
+
+        // UTF-16 surrogate pair (TCHAR is 16-bit on Windows)
+        if (C >= 0xD800 && C <= 0xDBFF && i + 1 < Len)
+        {
+            const uint32 Low = static_cast<uint32>(Str[i + 1]);
+            if (Low >= 0xDC00 && Low <= 0xDFFF)
+            {
+                C = 0x10000 + ((C - 0xD800) << 10) + (Low - 0xDC00);
+                ++i;
+            }
+        }
+        if (C >= 0xD800 && C <= 0xDFFF)
+        {
+            C = 0xFFFD; // lone surrogate
+        }
+
+        if (C < 0x800)
+        {
+            const uint8 Bytes[2] = { uint8(0xC0 | (C >> 6)), uint8(0x80 | (C & 0x3F)) };
+            Buffer.Append(Bytes, 2);
+        }
+        else if (C < 0x10000)
+        {
+            const uint8 Bytes[3] = {
+                uint8(0xE0 | (C >> 12)), uint8(0x80 | ((C >> 6) & 0x3F)), uint8(0x80 | (C & 0x3F)) };
+            Buffer.Append(Bytes, 3);
+        }
+        else
+        {
+            const uint8 Bytes[4] = {
+                uint8(0xF0 | (C >> 18)), uint8(0x80 | ((C >> 12) & 0x3F)),
+                uint8(0x80 | ((C >> 6) & 0x3F)), uint8(0x80 | (C & 0x3F)) };
+            Buffer.Append(Bytes, 4);
+        }
+    }
+    Buffer.Add('"');
+}
+
+// ─── Encoded agent IDs ──────────────────────────────────────────────────────
+
+/** Past this many bytes (agent churn), start encoding afresh */
+static constexpr int32 MaxJsonNameBytes = 16 << 20;
+
+void FAgentEJsonNames::Reset()
+{
+    Bytes.Reset();
+    Spans.Reset();
+    AgentSpans.Reset();
+    Source.Reset();
+}
+
+void FAgentEJsonNames::Bind(const TSharedRef<const FAgentEEconomyState, ESPMode::ThreadSafe>& State)
+{
+    const FAgentEEconomyState& S = *State;
+
+    // No adds/removes since the last body ⇒ same spans
+    if (Source.IsValid() && S.SharesAgentIds(*Source))
+    {
+        Source = State;
+        return;
+    }
+
+    if (Bytes.Num() > MaxJsonNameBytes)
+    {
+        Bytes.Reset();
+        Spans.Reset();
+    }
+
+    const int32 NumAgents = S.NumAgents();
+    AgentSpans.Reset(NumAgents);
+    for (int32 A = 0; A < NumAgents; ++A)
+    {
+        const FName Id = S.AgentNames()[A];
+        if (const FSpan* Found = Spans.Find(Id))
+        {
+            AgentSpans.Add(*Found);
+            continue;
+        }
+        Scratch.Reset();
+        Scratch.Value(FStringView(S.AgentIds()[A]));
+        FSpan Span;
+        Span.Offset = Bytes.Num();
+        Span.Len = Scratch.Num();
+        Bytes.Append(Scratch.GetBuffer());
+        Spans.Add(Id, Span);
+        AgentSpans.Add(Span);
+    }
+    Source = State;
+}
+
+// ─── EconomyState ───────────────────────────────────────────────────────────
+
+static void WriteNameArray(FAgentEJsonWriter& W, const TArray<FString>& Names)
+{
+    W.BeginArray();
+    for (const FString& Name : Names)
+    {
+        W.Value(FStringView(Name));
+    }
+    W.EndArray();
+}
+
+static void WriteEvent(FAgentEJsonWriter& W, const FAgentEEvent& E)
+{
+    W.BeginObject();
+    W.Key("type");      W.Value(AgentEEventTypeName(E.Type));
+    W.Key("timestamp"); W.Value(E.Timestamp);
+    W.Key("actor");     W.Value(E.Actor);
+    if (!E.Role.IsNone())     { W.Key("role");     W.Value(E.Role); }
+    if (!E.Resource.IsNone()) { W.Key("resource"); W.Value(E.Resource); }
+    if (!E.Currency.IsNone()) { W.Key("currency"); W.Value(E.Currency); }
+    if (E.Amount != 0.f)      { W.Key("amount");   W.Value(double(E.Amount)); }
+    if (E.Price != 0.f)       { W.Key("price");    W.Value(double(E.Price)); }
+    if (!E.From.IsNone())     { W.Key("from");     W.Value(E.From); }
+    if (!E.To.IsNone())       { W.Key("to");       W.Value(E.To); }
+    W.EndObject();
+}
+
+// currency → { resource → price }
+static void WriteMarketPrices(FAgentEJsonWriter& W, const FAgentEEconomyState& S)
+{
+    W.Key("marketPrices");
+    W.BeginObject();
+    for (int32 C = 0; C < S.MarketPrices.Num(); ++C)
+    {
+        W.Key(FStringView(S.Currencies()[C]));
+        W.BeginObject();
+        for (int32 R = 0; R < S.MarketPrices[C].Num(); ++R)
+        {
+            W.Key(FStringView(S.Resources()[R]));
+            W.Value(S.MarketPrices[C][R]);
+        }
+        W.EndObject();
+    }
+    W.EndObject();
+}
+
+static void WriteTransactions(FAgentEJsonWriter& W, const FAgentEEconomyState& S)
+{
+    W.Key("recentTransactions");
+    W.BeginArray();
+    for (const FAgentEEvent& Event : S.RecentTransactions)
+    {
+        WriteEvent(W, Event);
+    }
+    W.EndArray();
+}
+
+static void WritePerCurrency(FAgentEJsonWriter& W, const ANSICHAR* Key, const FAgentEEconomyState& S, const TArray<double>& Values)
+{
+    W.Key(Key);
+    W.BeginObject();
+    for (int32 C = 0; C < Values.Num(); ++C)
+    {
+        W.Key(FStringView(S.Currencies()[C]));
+        W.Value(Values[C]);
+    }
+    W.EndObject();
+}
+
+/** Exact aggregates of a sampled snapshot — nothing for a full one */
+static void WriteSampling(FAgentEJsonWriter& W, const FAgentEEconomyState& S)
+{
+    if (!S.Sampling.IsValid())
+    {
+        return;
+    }
+    const FAgentESampleInfo& Info = *S.Sampling;
+
+    W.Key("sampling");
+    W.BeginObject();
+    W.Key("population"); W.Value(int64(Info.Population));
+
+    W.Key("rateByRole");
+    W.BeginObject();
+    for (int32 R = 0; R < Info.RateByRole.Num(); ++R)
+    {
+        W.Key(FStringView(S.Roles()[R]));
+        W.Value(Info.RateByRole[R]);
+    }
+    W.EndObject();
+
+    W.Key("populationByRole");
+    W.BeginObject();
+    for (int32 R = 0; R < Info.CountByRole.Num(); ++R)
+    {
+        W.Key(FStringView(S.Roles()[R]));
+        W.Value(int64(Info.CountByRole[R]));
+    }
+    W.EndObject();
+
+    WritePerCurrency(W, "supplyByCurrency", S, Info.SupplyByCurrency);
+
+    W.Key("supplyByResource");
+    W.BeginObject();
+    for (int32 R = 0; R < Info.SupplyByResource.Num(); ++R)
+    {
+        W.Key(FStringView(S.Resources()[R]));
+        W.Value(Info.SupplyByResource[R]);
+    }
+    W.EndObject();
+
+    W.EndObject();
+}
+
+/** Client-computed metrics of a pre-aggregated snapshot — nothing otherwise */
+static void WriteAggregates(FAgentEJsonWriter& W, const FAgentEEconomyState& S)
+{
+    if (!S.Aggregates.IsValid())
+    {
+        return;
+    }
+    const FAgentEAggregates& Agg = *S.Aggregates;
+
+    W.Key("aggregates");
+    W.BeginObject();
+    W.Key("population"); W.Value(int64(Agg.Population));
+
+    W.Key("populationByRole");
+    W.BeginObject();
+    for (int32 R = 0; R < Agg.CountByRole.Num(); ++R)
+    {
+        W.Key(FStringView(S.Roles()[R]));
+        W.Value(int64(Agg.CountByRole[R]));
+    }
+    W.EndObject();
+
+    WritePerCurrency(W, "supplyByCurrency", S, Agg.SupplyByCurrency);
+    WritePerCurrency(W, "giniByCurrency", S, Agg.GiniByCurrency);
+    WritePerCurrency(W, "medianBalanceByCurrency", S, Agg.MedianByCurrency);
+    WritePerCurrency(W, "top10PctShareByCurrency", S, Agg.Top10ShareByCurrency);
+
+    W.Key("supplyByResource");
+    W.BeginObject();
+    for (int32 R = 0; R < Agg.SupplyByResource.Num(); ++R)
+    {
+        W.Key(FStringView(S.Resources()[R]));
+        W.Value(Agg.SupplyByResource[R]);
+    }
+    W.EndObject();
+
+    W.EndObject();
+}
+
+static FStringView RoleName(const FAgentEEconomyState& S, int32 Agent)
+{
+    const uint16 Role = S.AgentRoles[Agent];
+    return S.Roles().IsValidIndex(Role) ? FStringView(S.Roles()[Role]) : FStringView();
+}
+
+static void AgentKey(FAgentEJsonWriter& W, const FAgentEEconomyState& S, int32 Agent, const FAgentEJsonNames* Encoded)
+{
+    if (Encoded)
+    {
+        W.EncodedKey(Encoded->Agent(Agent));
+    }
+    else
+    {
+        W.Key(FStringView(S.AgentIds()[Agent]));
+    }
+}
+
+static void BeginMessage(FAgentEJsonWriter& W, const ANSICHAR* MessageType)
+{
+    W.Reset();
+    W.BeginObject();
+    if (MessageType)
+    {
+        W.Key("type");
+        W.Value(MessageType);
+    }
+}
+
+void AgentEBeginTickBody(FAgentEJsonWriter& W, const FAgentEEconomyState& S, int32 Tick, const ANSICHAR* MessageType)
+{
+    BeginMessage(W, MessageType);
+    W.Key("state");
+    W.BeginObject();
+
+    W.Key("tick");       W.Value(int64(Tick));
+    W.Key("roles");      WriteNameArray(W, S.Roles());
+    W.Key("resources");  WriteNameArray(W, S.Resources());
+    W.Key("currencies"); WriteNameArray(W, S.Currencies());
+}
+
+void AgentEEndTickBody(FAgentEJsonWriter& W, const FAgentEEconomyState& S, int64 Seq)
+{
+    WriteMarketPrices(W, S);
+    WriteTransactions(W, S);
+    WriteSampling(W, S);
+    WriteAggregates(W, S);
+
+    W.EndObject(); // state
+    W.Key("seq"); W.Value(Seq);
+    W.EndObject();
+}
+
+void AgentEWriteTickBody(
+    FAgentEJsonWriter& W, const FAgentEEconomyState& S, int32 Tick, int64 Seq, const ANSICHAR* MessageType,
+    const FAgentEJsonNames* Names)
+{
+    const int32 NumAgents = S.NumAgents();
+    const FAgentEJsonNames* Encoded = Names && Names->IsBoundTo(S) ? Names : nullptr;
+
+    AgentEBeginTickBody(W, S, Tick, MessageType);
+
+    // agent → { currency → balance }
+    W.Key("agentBalances");
+    W.BeginObject();
+    for (int32 A = 0; A < NumAgents; ++A)
+    {
+        AgentKey(W, S, A, Encoded);
+        W.BeginObject();
+        for (int32 C = 0; C < S.Balances.Num(); ++C)
+        {
+            W.Key(FStringView(S.Currencies()[C]));
+            W.Value(S.Balances[C][A]);
+        }
+        W.EndObject();
+    }
+    W.EndObject();
+
+    // agent → role
+    W.Key("agentRoles");
+    W.BeginObject();
+    for (int32 A = 0; A < NumAgents; ++A)
+    {
+        AgentKey(W, S, A, Encoded);
+        W.Value(RoleName(S, A));
+    }
+    W.EndObject();
+
+    // agent → { resource → quantity }, zero quantities omitted
+    W.Key("agentInventories");
+    W.BeginObject();
+    for (int32 A = 0; A < NumAgents; ++A)
+    {
+        AgentKey(W, S, A, Encoded);
+        W.BeginObject();
+        for (int32 R = 0; R < S.Inventories.Num(); ++R)
+        {
+            const double Qty = S.Inventories[R][A];
+            if (Qty != 0.0)
+            {
+                W.Key(FStringView(S.Resources()[R]));
+                W.Value(Qty);
+            }
+        }
+        W.EndObject();
+    }
+    W.EndObject();
+
+    AgentEEndTickBody(W, S, Seq);
+}
+
+// ─── Delta ──────────────────────────────────────────────────────────────────
+
+bool AgentEWriteDeltaBody(
+    FAgentEJsonWriter& W, const FAgentEEconomyState& P, const FAgentEEconomyState& S,
+    int32 Tick, int64 Seq, int64 BaseSeq, const ANSICHAR* MessageType, const FAgentEJsonNames* Names)
+{
+    // Sampled / pre-aggregated snapshots and plain ones don't diff against each other
+    if (P.GetSchemaEpoch() != S.GetSchemaEpoch() || P.Sampling.IsValid() != S.Sampling.IsValid()
+        || P.Aggregates.IsValid() != S.Aggregates.IsValid())
+    {
+        return false;
+    }
+
+    const int32 NumPrev = P.NumAgents();
+    const int32 NumCur = S.NumAgents();
+    const bool bSameIds = S.SharesAgentIds(P);
+    const FAgentEJsonNames* Encoded = Names && Names->IsBoundTo(S) ? Names : nullptr;
+
+    // Same agent at the same index in both states? Shared table ⇒ yes for all.
+    auto IsSameAgent = [&](int32 A) {
+        return A < NumPrev && (bSameIds || P.AgentNames()[A] == S.AgentNames()[A]);
+    };
+
+    // A change-tracked state that directly follows P says which agents can differ;
+    // otherwise every agent is compared
+    const bool bTracked = S.IsTrackingChanges() && P.IsTrackingChanges()
+        && S.GetChangeSerial() == P.GetChangeSerial() + 1;
+    auto ForEachCandidate = [&](auto&& Fn) {
+        if (bTracked)
+        {
+            for (TConstSetBitIterator<> It(S.GetChanges().Agents); It; ++It)
+            {
+                Fn(It.GetIndex());
+            }
+        }
+        else
+        {
+            for (int32 A = 0; A < NumCur; ++A)
+            {
+                Fn(A);
+            }
+        }
+    };
+
+    BeginMessage(W, MessageType);
+    W.Key("delta");
+    W.BeginObject();
+
+    W.Key("tick"); W.Value(int64(Tick));
+
+    // Removed first: trailing slots beyond NumCur, and slots now holding someone else
+    W.Key("removedAgents");
+    W.BeginArray();
+    if (!bSameIds)
+    {
+        // Tracked: only marked slots can hold someone else now
+        ForEachCandidate([&](int32 A) {
+            if (A < NumPrev && P.AgentNames()[A] != S.AgentNames()[A])
+            {
+                W.Value(FStringView(P.AgentIds()[A]));
+            }
+        });
+        for (int32 A = NumCur; A < NumPrev; ++A)
+        {
+            W.Value(FStringView(P.AgentIds()[A]));
+        }
+    }
+    W.EndArray();
+
+    W.Key("agentBalances");
+    W.BeginObject();
+    ForEachCandidate([&](int32 A) {
+        const bool bExisting = IsSameAgent(A);
+        bool bOpen = false;
+        for (int32 C = 0; C < S.Balances.Num(); ++C)
+        {
+            const double V = S.Balances[C][A];
+            if (bExisting && P.Balances[C][A] == V)
+            {
+                continue;
+            }
+            if (!bOpen)
+            {
+                AgentKey(W, S, A, Encoded);
+                W.BeginObject();
+                bOpen = true;
+            }
+            W.Key(FStringView(S.Currencies()[C]));
+            W.Value(V);
+        }
+        if (bOpen)
+        {
+            W.EndObject();
+        }
+    });
+    W.EndObject();
+
+    W.Key("agentRoles");
+    W.BeginObject();
+    ForEachCandidate([&](int32 A) {
+        if (!IsSameAgent(A) || P.AgentRoles[A] != S.AgentRoles[A])
+        {
+            AgentKey(W, S, A, Encoded);
+            W.Value(RoleName(S, A));
+        }
+    });
+    W.EndObject();
+
+    // Existing agents: changed fields, null when a quantity drops to zero.
+    // Added agents: non-zero fields, or an empty record so the agent exists.
+    W.Key("agentInventories");
+    W.BeginObject();
+    ForEachCandidate([&](int32 A) {
+        const bool bExisting = IsSameAgent(A);
+        bool bOpen = false;
+        for (int32 R = 0; R < S.Inventories.Num(); ++R)
+        {
+            const double Qty = S.Inventories[R][A];
+            if (bExisting ? P.Inventories[R][A] == Qty : Qty == 0.0)
+            {
+                continue;
+            }
+            if (!bOpen)
+            {
+                AgentKey(W, S, A, Encoded);
+                W.BeginObject();
+                bOpen = true;
+            }
+            W.Key(FStringView(S.Resources()[R]));
+            if (Qty == 0.0) W.Null();
+            else W.Value(Qty);
+        }
+        if (!bOpen && !bExisting)
+        {
+            AgentKey(W, S, A, Encoded);
+            W.BeginObject();
+            bOpen = true;
+        }
+        if (bOpen)
+        {
+            W.EndObject();
+        }
+    });
+    W.EndObject();
+
+    WriteMarketPrices(W, S);
+    WriteTransactions(W, S);
+    WriteSampling(W, S);
+    WriteAggregates(W, S);
+
+    W.EndObject(); // delta
+    W.Key("seq");     W.Value(Seq);
+    W.Key("baseSeq"); W.Value(BaseSeq);
+    W.EndObject();
+    return true;
+}
+
+// ─── Events ─────────────────────────────────────────────────────────────────
+
+void AgentEWriteEventsBody(FAgentEJsonWriter& W, TConstArrayView<FAgentEEvent> Events, const ANSICHAR* MessageType)
+{
+    BeginMessage(W, MessageType);
+    W.Key("events");
+    W.BeginArray();
+    for (const FAgentEEvent& Event : Events)
+    {
+        WriteEvent(W, Event);
+    }
+    W.EndArray();
+    W.EndObject();
+}
+
+TArray<uint8> AgentEShardPrefix(const FString& ShardId)
+{
+    const FTCHARToUTF8 Utf8(*FString::Printf(TEXT("{\"shard\":\"%s\","), *ShardId));
+    TArray<uint8> Prefix;
+    Prefix.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+    return Prefix;
+}
+
+void AgentESpliceShard(TArray<uint8>& Out, const TArray<uint8>& Prefix, const TArray<uint8>& Body)
+{
+    Out.Append(Prefix);
+    if (Body.Num() >= 2 && Body[1] == '}')
+    {
+        Out.Pop(EAllowShrinking::No); // `{}` — no field to separate from
+    }
+    Out.Append(Body.GetData() + 1, Body.Num() - 1);
+}
+
+// ─── Binary ─────────────────────────────────────────────────────────────────
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "Binary tick columns are memcpy'd and must be little-endian");
+
+/** Past this many names (agent churn), start a fresh dictionary */
+static constexpr int32 MaxWireNames = 1 << 18;
+
+void FAgentEWireNames::Reset()
+{
+    ++Epoch;
+    Names.Reset();
+    SentCount = 0;
+    AgentWireIds.Reset();
+    AgentSource.Reset();
+    Ids.Reset();
+    NameIds.Reset();
+}
+
+int32 FAgentEWireNames::Intern(const FString& Name)
+{
+    if (const int32* Found = Ids.Find(Name))
+    {
+        return *Found;
+    }
+    const int32 Id = Names.Add(Name);
+    Ids.Add(Name, Id);
+    return Id;
+}
+
+int32 FAgentEWireNames::Intern(FName Name)
+{
+    if (const int32* Found = NameIds.Find(Name))
+    {
+        return *Found;
+    }
+    const int32 Id = Intern(Name.ToString());
+    NameIds.Add(Name, Id);
+    return Id;
+}
+
+/** One bin of exactly Count values; a short column is zero-padded */
+template <typename T>
+static void WriteColumn(FAgentEMsgPackWriter& W, const TArray<T>* Column, int32 Count)
+{
+    uint8* Out = W.BeginBin(Count * int32(sizeof(T)));
+    const int32 Have = Column ? FMath::Min(Column->Num(), Count) : 0;
+    if (Have > 0)
+    {
+        FMemory::Memcpy(Out, Column->GetData(), Have * sizeof(T));
+    }
+    if (Have < Count)
+    {
+        FMemory::Memzero(Out + Have * sizeof(T), (Count - Have) * sizeof(T));
+    }
+}
+
+/** Integer counts as an f64 column, like every other numeric blob */
+static void WriteCountColumn(FAgentEMsgPackWriter& W, const TArray<int32>& Counts, int32 Count)
+{
+    uint8* Out = W.BeginBin(Count * int32(sizeof(double)));
+    for (int32 I = 0; I < Count; ++I)
+    {
+        const double Value = Counts.IsValidIndex(I) ? double(Counts[I]) : 0.0;
+        FMemory::Memcpy(Out + I * sizeof(double), &Value, sizeof(double));
+    }
+}
+
+static void WriteColumns(FAgentEMsgPackWriter& W, const TArray<TArray<double>>& Columns, int32 NumColumns, int32 Count)
+{
+    W.BeginArray(NumColumns);
+    for (int32 I = 0; I < NumColumns; ++I)
+    {
+        WriteColumn(W, Columns.IsValidIndex(I) ? &Columns[I] : nullptr, Count);
+    }
+}
+
+static void WriteBinaryEvent(FAgentEMsgPackWriter& W, FAgentEWireNames& Names, const FAgentEEvent& E)
+{
+    const uint32 Fields = 3
+        + !E.Role.IsNone() + !E.Resource.IsNone() + !E.Currency.IsNone()
+        + (E.Amount != 0.f) + (E.Price != 0.f) + !E.From.IsNone() + !E.To.IsNone();
+
+    W.BeginMap(Fields);
+    W.Str("y");  W.Str(AgentEEventTypeName(E.Type));
+    W.Str("ts"); W.Int(E.Timestamp);
+    W.Str("a");  W.Int(Names.Intern(E.Actor));
+    if (!E.Role.IsNone())     { W.Str("r");   W.Int(Names.Intern(E.Role)); }
+    if (!E.Resource.IsNone()) { W.Str("res"); W.Int(Names.Intern(E.Resource)); }
+    if (!E.Currency.IsNone()) { W.Str("c");   W.Int(Names.Intern(E.Currency)); }
+    if (E.Amount != 0.f)      { W.Str("amt"); W.Double(E.Amount); }
+    if (E.Price != 0.f)       { W.Str("p");   W.Double(E.Price); }
+    if (!E.From.IsNone())     { W.Str("f");   W.Int(Names.Intern(E.From)); }
+    if (!E.To.IsNone())       { W.Str("to");  W.Int(Names.Intern(E.To)); }
+}
+
+void AgentEWriteBinaryTickBody(
+    FAgentEMsgPackWriter& W, FAgentEWireNames& Names,
+    const TSharedRef<const FAgentEEconomyState, ESPMode::ThreadSafe>& State, int32 Tick, int64 Seq,
+    FStringView Shard)
+{
+    const FAgentEEconomyState& S = *State;
+    const int32 NumAgents = S.NumAgents();
+    const int32 NumResources = S.Resources().Num();
+    const int32 NumCurrencies = S.Currencies().Num();
+
+    if (Names.Names.Num() > MaxWireNames)
+    {
+        Names.Reset();
+    }
+
+    // Intern everything up front: the dict section precedes the ids that use it
+    TArray<int32> Roles, Resources, Currencies;
+    for (const FString& Name : S.Roles())      { Roles.Add(Names.Intern(Name)); }
+    for (const FString& Name : S.Resources())  { Resources.Add(Names.Intern(Name)); }
+    for (const FString& Name : S.Currencies()) { Currencies.Add(Names.Intern(Name)); }
+
+    // No adds/removes since the last body ⇒ same agent ids, no hashing
+    if (!Names.AgentSource.IsValid() || !S.SharesAgentIds(*Names.AgentSource))
+    {
+        Names.AgentWireIds.Reset(NumAgents);
+        for (const FName Id : S.AgentNames())
+        {
+            Names.AgentWireIds.Add(Names.Intern(Id));
+        }
+    }
+    Names.AgentSource = State;
+
+    for (const FAgentEEvent& Event : S.RecentTransactions)
+    {
+        Names.Intern(Event.Actor);
+        if (!Event.Role.IsNone())     { Names.Intern(Event.Role); }
+        if (!Event.Resource.IsNone()) { Names.Intern(Event.Resource); }
+        if (!Event.Currency.IsNone()) { Names.Intern(Event.Currency); }
+        if (!Event.From.IsNone())     { Names.Intern(Event.From); }
+        if (!Event.To.IsNone())       { Names.Intern(Event.To); }
+    }
+
+    // The first body of a session always carries a dict (base 0 resets the server's table)
+    const bool bDict = Names.SentCount == 0 || Names.SentCount < Names.Names.Num();
+    const bool bEvents = S.RecentTransactions.Num() > 0;
+    const bool bSampled = S.Sampling.IsValid();
+    const bool bAggregated = S.Aggregates.IsValid();
+    const bool bShard = !Shard.IsEmpty();
+
+    W.Reset();
+    W.BeginMap(10 + bDict + bEvents + bSampled + bAggregated + bShard);
+
+    if (bDict)
+    {
+        W.Str("dict");
+        W.BeginMap(3);
+        W.Str("e"); W.Int(Names.Epoch);
+        W.Str("b"); W.Int(Names.SentCount);
+        W.Str("n");
+        W.BeginArray(Names.Names.Num() - Names.SentCount);
+        for (int32 I = Names.SentCount; I < Names.Names.Num(); ++I)
+        {
+            W.Str(FStringView(Names.Names[I]));
+        }
+        Names.SentCount = Names.Names.Num();
+    }
+
+    if (bShard)
+    {
+        W.Str("shard"); W.Str(Shard);
+    }
+    W.Str("seq");  W.Int(Seq);
+    W.Str("tick"); W.Int(Tick);
+
+    W.Str("roles");      W.BeginArray(Roles.Num());      for (int32 Id : Roles)      { W.Int(Id); }
+    W.Str("resources");  W.BeginArray(Resources.Num());  for (int32 Id : Resources)  { W.Int(Id); }
+    W.Str("currencies"); W.BeginArray(Currencies.Num()); for (int32 Id : Currencies) { W.Int(Id); }
+    W.Str("agents");     W.BeginArray(NumAgents);        for (int32 Id : Names.AgentWireIds) { W.Int(Id); }
+
+    W.Str("agentRoles");  WriteColumn(W, &S.AgentRoles, NumAgents);
+    W.Str("balances");    WriteColumns(W, S.Balances, NumCurrencies, NumAgents);
+    W.Str("inventories"); WriteColumns(W, S.Inventories, NumResources, NumAgents);
+    W.Str("prices");      WriteColumns(W, S.MarketPrices, NumCurrencies, NumResources);
+
+    if (bEvents)
+    {
+        W.Str("events");
+        W.BeginArray(S.RecentTransactions.Num());
+        for (const FAgentEEvent& Event : S.RecentTransactions)
+        {
+            WriteBinaryEvent(W, Names, Event);
+        }
+    }
+
+    if (bSampled)
+    {
+        const FAgentESampleInfo& Info = *S.Sampling;
+        W.Str("sampling");
+        W.BeginMap(5);
+        W.Str("n");      W.Int(Info.Population);
+        W.Str("rate");   WriteColumn(W, &Info.RateByRole, Roles.Num());
+        W.Str("count");
+        WriteCountColumn(W, Info.CountByRole, Roles.Num());
+        W.Str("supply"); WriteColumn(W, &Info.SupplyByCurrency, NumCurrencies);
+        W.Str("stock");  WriteColumn(W, &Info.SupplyByResource, NumResources);
+    }
+
+    if (bAggregated)
+    {
+        const FAgentEAggregates& Agg = *S.Aggregates;
+        W.Str("aggregates");
+        W.BeginMap(7);
+        W.Str("n");      W.Int(Agg.Population);
+        W.Str("count");  WriteCountColumn(W, Agg.CountByRole, Roles.Num());
+        W.Str("supply"); WriteColumn(W, &Agg.SupplyByCurrency, NumCurrencies);
+        W.Str("gini");   WriteColumn(W, &Agg.GiniByCurrency, NumCurrencies);
+        W.Str("median"); WriteColumn(W, &Agg.MedianByCurrency, NumCurrencies);
+        W.Str("top10");  WriteColumn(W, &Agg.Top10ShareByCurrency, NumCurrencies);
+        W.Str("stock");  WriteColumn(W, &Agg.SupplyByResource, NumResources);
+    }
+}
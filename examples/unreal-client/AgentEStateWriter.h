@@ -0,0 +1,223 @@
+/**
+ * AgentE Unreal Engine Client — Streaming State Writer
+ *
+ * Append-only JSON writer that emits UTF-8 straight into a reusable byte
+ * buffer. Reset() clears the buffer but keeps its allocation, so once the
+ * buffer has grown to the size of a typical tick body, sending a snapshot
+ * no longer touches the heap.
+ *
+ * No DOM, no FJsonObject, no FString temporaries: keys and values are
+ * encoded as they are written.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAgentEEconomyState;
+struct FAgentEEvent;
+class FAgentEMsgPackWriter;
+
+class FAgentEJsonWriter
+{
+public:
+    /** Clear the buffer, keeping its allocation */
+    void Reset();
+
+    /** Pre-size the buffer (e.g. to the size of the last body) */
+    void Reserve(int32 Bytes) { Buffer.Reserve(Bytes); }
+
+    const TArray<uint8>& GetBuffer() const { return Buffer; }
+    int32 Num() const { return Buffer.Num(); }
+
+    void BeginObject();
+    void EndObject();
+    void BeginArray();
+    void EndArray();
+
+    /** Object key from a string literal — must not need escaping */
+    void Key(const ANSICHAR* Literal);
+    void Key(FStringView Name);
+    void Key(FName Name);
+
+    void Value(FStringView Str);
+    void Value(FName Name);
+    void Value(const ANSICHAR* Literal);
+    void Value(double Number);
+    void Value(int64 Number);
+    void Value(bool bValue);
+    void Null();
+
+    /** Append pre-encoded JSON verbatim (caller guarantees validity) */
+    void Raw(const ANSICHAR* Json, int32 Len);
+
+    /** Object key already encoded as a JSON string, quotes included */
+    void EncodedKey(TConstArrayView<uint8> Encoded);
+
+    /**
+     * Append pre-encoded JSON that ends where a value starts (`{"gold":`,
+     * `,"ore":`), verbatim: no separator before it, the value follows it
+     */
+    void Fragment(const ANSICHAR* Json, int32 Len);
+
+private:
+    TArray<uint8> Buffer;
+
+    /** True when the next key/value must be preceded by a comma */
+    bool bNeedComma = false;
+
+    void Separator();
+    void WriteLiteral(const ANSICHAR* Str, int32 Len);
+    void WriteInt(int64 Number);
+    void WriteEscaped(const TCHAR* Str, int32 Len);
+};
+
+/**
+ * Agent IDs encoded once per session as JSON strings (quoted, escaped,
+ * UTF-8), so tick bodies copy each ID's bytes instead of escaping it three
+ * times per body. IDs are keyed by FName; an agent that leaves and rejoins
+ * reuses its encoding.
+ *
+ * Touched only by the send tasks, like the rest of FAgentESendContext.
+ */
+class FAgentEJsonNames
+{
+public:
+    /** Point at State's agents, encoding any ID not seen before */
+    void Bind(const TSharedRef<const FAgentEEconomyState, ESPMode::ThreadSafe>& State);
+
+    bool IsBoundTo(const FAgentEEconomyState& State) const { return Source.Get() == &State; }
+
+    /** Encoded ID of the bound state's agent at AgentIndex */
+    TConstArrayView<uint8> Agent(int32 AgentIndex) const
+    {
+        const FSpan& Span = AgentSpans[AgentIndex];
+        return TConstArrayView<uint8>(Bytes.GetData() + Span.Offset, Span.Len);
+    }
+
+    /** Forget every encoding */
+    void Reset();
+
+private:
+    struct FSpan
+    {
+        int32 Offset = 0;
+        int32 Len = 0;
+    };
+
+    /** Every encoding back to back */
+    TArray<uint8> Bytes;
+    TMap<FName, FSpan> Spans;
+
+    /** Spans of Source's agents, index for index — reused while its agent table is shared */
+    TArray<FSpan> AgentSpans;
+    TSharedPtr<const FAgentEEconomyState, ESPMode::ThreadSafe> Source;
+
+    FAgentEJsonWriter Scratch;
+};
+
+/**
+ * Write `{"state":{...},"seq":N}` for the given economy into Writer.
+ * The writer is reset first. RecentTransactions are written as-is.
+ * MessageType, when set, is written first as `"type"` (WebSocket messages).
+ * A sampled state also gets its `sampling` block (exact aggregates), and a
+ * pre-aggregated one its `aggregates` block.
+ * Agent IDs are copied from Names when it is bound to State.
+ */
+void AgentEWriteTickBody(
+    FAgentEJsonWriter& Writer, const FAgentEEconomyState& State, int32 Tick, int64 Seq,
+    const ANSICHAR* MessageType = nullptr, const FAgentEJsonNames* Names = nullptr);
+
+/** AgentEWriteTickBody or a writer with the same output (AgentEWriteSchemaTickBody) */
+using FAgentETickBodyWriter = void (*)(
+    FAgentEJsonWriter&, const FAgentEEconomyState&, int32, int64, const ANSICHAR*, const FAgentEJsonNames*);
+
+/**
+ * The parts of AgentEWriteTickBody around its three per-agent maps, for
+ * writers specialized by schema (AgentEStateSchema.h). Begin resets Writer
+ * and writes up to the "currencies" array; End writes prices, events,
+ * sampling, aggregates and seq.
+ */
+void AgentEBeginTickBody(FAgentEJsonWriter& Writer, const FAgentEEconomyState& State, int32 Tick, const ANSICHAR* MessageType);
+void AgentEEndTickBody(FAgentEJsonWriter& Writer, const FAgentEEconomyState& State, int64 Seq);
+
+/**
+ * Write `{"delta":{...},"seq":N,"baseSeq":M}` — only what changed between
+ * Base and State: changed fields of existing agents, all fields of added
+ * agents, IDs of removed agents, plus prices and events. When State is
+ * change-tracked and captured right after Base, only the agents in its change
+ * set are looked at, so the cost follows what changed, not the population.
+ *
+ * Returns false (writer contents undefined) when the two states are from
+ * different schema epochs, or only one is sampled or pre-aggregated; send a
+ * full body instead.
+ */
+bool AgentEWriteDeltaBody(
+    FAgentEJsonWriter& Writer, const FAgentEEconomyState& Base, const FAgentEEconomyState& State,
+    int32 Tick, int64 Seq, int64 BaseSeq, const ANSICHAR* MessageType = nullptr,
+    const FAgentEJsonNames* Names = nullptr);
+
+/**
+ * Write `{"events":[...]}` — a batch for POST /events, or the WebSocket
+ * `events` message when MessageType is set. The writer is reset first.
+ */
+void AgentEWriteEventsBody(
+    FAgentEJsonWriter& Writer, TConstArrayView<FAgentEEvent> Events, const ANSICHAR* MessageType = nullptr);
+
+/** `{"shard":"<ShardId>",` — what AgentESpliceShard puts in place of a body's opening brace */
+TArray<uint8> AgentEShardPrefix(const FString& ShardId);
+
+/**
+ * Append Body (any JSON body above) to Out with Prefix in place of its
+ * opening brace, so the server runs it against that shard's economy.
+ */
+void AgentESpliceShard(TArray<uint8>& Out, const TArray<uint8>& Prefix, const TArray<uint8>& Body);
+
+/**
+ * Client half of the binary format's name dictionary (NameDictionary in the
+ * server's binary.ts). Every name gets an id the first time it is written;
+ * the body carries only names the server has not seen yet.
+ *
+ * Touched only by the send tasks, like the rest of FAgentESendContext.
+ */
+struct FAgentEWireNames
+{
+    /** Changes on every Reset so the server can tell sessions apart */
+    uint32 Epoch = 0;
+
+    /** All names by id */
+    TArray<FString> Names;
+
+    /** Names[0 .. SentCount) are known to the server */
+    int32 SentCount = 0;
+
+    /** Agent ids of AgentSource — reused while the agent table is shared */
+    TArray<int32> AgentWireIds;
+    TSharedPtr<const FAgentEEconomyState, ESPMode::ThreadSafe> AgentSource;
+
+    /** Forget everything; the next body re-sends the table from base 0 */
+    void Reset();
+
+    int32 Intern(const FString& Name);
+    int32 Intern(FName Name);
+
+private:
+    TMap<FString, int32> Ids;
+
+    /** Event fields are FNames — looked up without building an FString */
+    TMap<FName, int32> NameIds;
+};
+
+/**
+ * Write one MessagePack tick (format in the server's binary.ts) for State.
+ * Balances, inventories, prices and roles go out as raw little-endian
+ * column blobs straight from the typed arrays. Always a full snapshot.
+ * A non-empty Shard is written as `shard`, for that shard's economy.
+ *
+ * State is retained in Names so the next body can reuse agent ids while the
+ * agent table is unchanged.
+ */
+void AgentEWriteBinaryTickBody(
+    FAgentEMsgPackWriter& Writer, FAgentEWireNames& Names,
+    const TSharedRef<const FAgentEEconomyState, ESPMode::ThreadSafe>& State, int32 Tick, int64 Seq,
+    FStringView Shard = {});
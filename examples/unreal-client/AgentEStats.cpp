@@ -0,0 +1,179 @@
+/**
+ * AgentE Unreal Engine Client — Instrumentation
+ *
+ * See AgentEStats.h.
+ */
+
+#include "AgentEStats.h"
+
+DEFINE_STAT(STAT_AgentE_Capture);
+DEFINE_STAT(STAT_AgentE_Serialize);
+DEFINE_STAT(STAT_AgentE_Compress);
+DEFINE_STAT(STAT_AgentE_Parse);
+DEFINE_STAT(STAT_AgentE_Dispatch);
+DEFINE_STAT(STAT_AgentE_LocalRules);
+
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Round trip (ms)"), STAT_AgentE_RoundTripMs, STATGROUP_AgentE);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Bulk wait (ms)"), STAT_AgentE_BulkWaitMs, STATGROUP_AgentE);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Control round trip (ms)"), STAT_AgentE_ControlRoundTripMs, STATGROUP_AgentE);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Server processing (ms)"), STAT_AgentE_ServerProcessingMs, STATGROUP_AgentE);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ticks sent"), STAT_AgentE_TicksSent, STATGROUP_AgentE);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bytes sent"), STAT_AgentE_BytesSent, STATGROUP_AgentE);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bytes received"), STAT_AgentE_BytesReceived, STATGROUP_AgentE);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("In flight"), STAT_AgentE_InFlight, STATGROUP_AgentE);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Ticks failed"), STAT_AgentE_TicksFailed, STATGROUP_AgentE);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Rate limited"), STAT_AgentE_RateLimited, STATGROUP_AgentE);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Events dropped"), STAT_AgentE_EventsDropped, STATGROUP_AgentE);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Transient allocations"), STAT_AgentE_TransientAllocations, STATGROUP_AgentE);
+
+TRACE_DECLARE_FLOAT_COUNTER(AgentE_RoundTripMs, TEXT("AgentE/RoundTripMs"));
+TRACE_DECLARE_FLOAT_COUNTER(AgentE_BulkWaitMs, TEXT("AgentE/BulkWaitMs"));
+TRACE_DECLARE_FLOAT_COUNTER(AgentE_ControlRoundTripMs, TEXT("AgentE/ControlRoundTripMs"));
+TRACE_DECLARE_FLOAT_COUNTER(AgentE_ServerProcessingMs, TEXT("AgentE/ServerProcessingMs"));
+TRACE_DECLARE_INT_COUNTER(AgentE_BytesSent, TEXT("AgentE/BytesSent"));
+TRACE_DECLARE_INT_COUNTER(AgentE_BytesReceived, TEXT("AgentE/BytesReceived"));
+TRACE_DECLARE_INT_COUNTER(AgentE_InFlight, TEXT("AgentE/InFlight"));
+TRACE_DECLARE_INT_COUNTER(AgentE_TicksFailed, TEXT("AgentE/TicksFailed"));
+TRACE_DECLARE_INT_COUNTER(AgentE_RateLimited, TEXT("AgentE/RateLimited"));
+TRACE_DECLARE_INT_COUNTER(AgentE_EventsDropped, TEXT("AgentE/EventsDropped"));
+TRACE_DECLARE_INT_COUNTER(AgentE_TransientAllocations, TEXT("AgentE/TransientAllocations"));
+
+static void RaiseTo(std::atomic<int64>& Value, int64 To)
+{
+    int64 Prev = Value.load(std::memory_order_relaxed);
+    while (Prev < To && !Value.compare_exchange_weak(Prev, To, std::memory_order_relaxed))
+    {
+    }
+}
+
+void FAgentEStatsRecorder::AddStage(EAgentEStage Stage, double Seconds)
+{
+    FStage& S = Stages[int32(Stage)];
+    const int64 Micros = int64(Seconds * 1e6);
+    S.Count.fetch_add(1, std::memory_order_relaxed);
+    S.TotalMicros.fetch_add(Micros, std::memory_order_relaxed);
+    S.LastMicros.store(Micros, std::memory_order_relaxed);
+    RaiseTo(S.MaxMicros, Micros);
+
+    // Not scopes on any thread, so they get value stats instead of cycle stats
+    switch (Stage)
+    {
+    case EAgentEStage::RoundTrip:
+        SET_FLOAT_STAT(STAT_AgentE_RoundTripMs, float(Seconds * 1000.0));
+        TRACE_COUNTER_SET(AgentE_RoundTripMs, Seconds * 1000.0);
+        break;
+    case EAgentEStage::BulkWait:
+        SET_FLOAT_STAT(STAT_AgentE_BulkWaitMs, float(Seconds * 1000.0));
+        TRACE_COUNTER_SET(AgentE_BulkWaitMs, Seconds * 1000.0);
+        break;
+    case EAgentEStage::ControlRoundTrip:
+        SET_FLOAT_STAT(STAT_AgentE_ControlRoundTripMs, float(Seconds * 1000.0));
+        TRACE_COUNTER_SET(AgentE_ControlRoundTripMs, Seconds * 1000.0);
+        break;
+    case EAgentEStage::ServerProcessing:
+        SET_FLOAT_STAT(STAT_AgentE_ServerProcessingMs, float(Seconds * 1000.0));
+        TRACE_COUNTER_SET(AgentE_ServerProcessingMs, Seconds * 1000.0);
+        break;
+    default:
+        break;
+    }
+}
+
+void FAgentEStatsRecorder::AddTickSent(int64 Bytes)
+{
+    TicksSent.fetch_add(1, std::memory_order_relaxed);
+    BytesSent.fetch_add(Bytes, std::memory_order_relaxed);
+    INC_DWORD_STAT(STAT_AgentE_TicksSent);
+    INC_DWORD_STAT_BY(STAT_AgentE_BytesSent, uint32(Bytes));
+    TRACE_COUNTER_ADD(AgentE_BytesSent, Bytes);
+}
+
+void FAgentEStatsRecorder::AddEventsSent(int64 Bytes)
+{
+    BytesSent.fetch_add(Bytes, std::memory_order_relaxed);
+    INC_DWORD_STAT_BY(STAT_AgentE_BytesSent, uint32(Bytes));
+    TRACE_COUNTER_ADD(AgentE_BytesSent, Bytes);
+}
+
+void FAgentEStatsRecorder::AddReply(int64 Bytes, bool bFailed, bool bRateLimited)
+{
+    BytesReceived.fetch_add(Bytes, std::memory_order_relaxed);
+    INC_DWORD_STAT_BY(STAT_AgentE_BytesReceived, uint32(Bytes));
+    TRACE_COUNTER_ADD(AgentE_BytesReceived, Bytes);
+    if (bFailed)
+    {
+        const int64 Failed = TicksFailed.fetch_add(1, std::memory_order_relaxed) + 1;
+        SET_DWORD_STAT(STAT_AgentE_TicksFailed, uint32(Failed));
+        TRACE_COUNTER_SET(AgentE_TicksFailed, Failed);
+    }
+    if (bRateLimited)
+    {
+        const int64 Limited = RateLimited.fetch_add(1, std::memory_order_relaxed) + 1;
+        SET_DWORD_STAT(STAT_AgentE_RateLimited, uint32(Limited));
+        TRACE_COUNTER_SET(AgentE_RateLimited, Limited);
+    }
+}
+
+void FAgentEStatsRecorder::SetInFlight(int32 InFlight)
+{
+    SET_DWORD_STAT(STAT_AgentE_InFlight, uint32(InFlight));
+    TRACE_COUNTER_SET(AgentE_InFlight, InFlight);
+}
+
+void FAgentEStatsRecorder::SetEventsDropped(int64 Dropped)
+{
+    SET_DWORD_STAT(STAT_AgentE_EventsDropped, uint32(Dropped));
+    TRACE_COUNTER_SET(AgentE_EventsDropped, Dropped);
+}
+
+void FAgentEStatsRecorder::AddTransientAllocations(int64 Count)
+{
+    if (Count <= 0)
+    {
+        return;
+    }
+    const int64 Total = TransientAllocations.fetch_add(Count, std::memory_order_relaxed) + Count;
+    SET_DWORD_STAT(STAT_AgentE_TransientAllocations, uint32(Total));
+    TRACE_COUNTER_SET(AgentE_TransientAllocations, Total);
+}
+
+FAgentEClientStats FAgentEStatsRecorder::Snapshot() const
+{
+    FAgentEClientStats Out;
+    FAgentEStageTiming* Timings[] = { &Out.Capture, &Out.Serialize, &Out.Compress, &Out.RoundTrip, &Out.Parse, &Out.Dispatch,
+        &Out.BulkWait, &Out.ControlRoundTrip, &Out.LocalRules, &Out.ServerProcessing };
+    static_assert(UE_ARRAY_COUNT(Timings) == int32(EAgentEStage::Num), "One timing per stage");
+    for (int32 i = 0; i < int32(EAgentEStage::Num); ++i)
+    {
+        const FStage& S = Stages[i];
+        FAgentEStageTiming& T = *Timings[i];
+        T.Count = S.Count.load(std::memory_order_relaxed);
+        T.LastMs = float(S.LastMicros.load(std::memory_order_relaxed)) / 1000.f;
+        T.MaxMs = float(S.MaxMicros.load(std::memory_order_relaxed)) / 1000.f;
+        T.AverageMs = T.Count > 0 ? float(double(S.TotalMicros.load(std::memory_order_relaxed)) / double(T.Count) / 1000.0) : 0.f;
+    }
+    Out.TicksSent = TicksSent.load(std::memory_order_relaxed);
+    Out.TicksFailed = TicksFailed.load(std::memory_order_relaxed);
+    Out.RateLimited = RateLimited.load(std::memory_order_relaxed);
+    Out.BytesSent = BytesSent.load(std::memory_order_relaxed);
+    Out.BytesReceived = BytesReceived.load(std::memory_order_relaxed);
+    Out.TransientAllocations = TransientAllocations.load(std::memory_order_relaxed);
+    return Out;
+}
+
+void FAgentEStatsRecorder::Reset()
+{
+    for (FStage& S : Stages)
+    {
+        S.Count = 0;
+        S.TotalMicros = 0;
+        S.LastMicros = 0;
+        S.MaxMicros = 0;
+    }
+    TicksSent = 0;
+    TicksFailed = 0;
+    RateLimited = 0;
+    BytesSent = 0;
+    BytesReceived = 0;
+    TransientAllocations = 0;
+}
@@ -0,0 +1,226 @@
+/**
+ * AgentE Unreal Engine Client — Instrumentation
+ *
+ * Where a tick's time and bytes go, surfaced three ways:
+ *   - `stat AgentE`: a cycle stat per stage and per-frame byte counters
+ *   - Unreal Insights: a CPU scope per stage and AgentE/* counters
+ *   - Blueprint: UAgentEClient::GetClientStats(), an FAgentEClientStats
+ *
+ * The stages are snapshot capture (game thread), serialize and compress
+ * (send task), network round trip, reply parse (reply thread) and dispatch
+ * (game thread). Two more time the WebSocket's lanes (see
+ * AgentETransport.h): how long bulk messages queue before reaching the
+ * socket, and the round trip of control messages (health, approve,
+ * reject), which is what a large upload would otherwise hold up. One more
+ * times the local rules (see AgentELocalRules.h) while they stand in for
+ * the server, and one records the server's own processing time per tick,
+ * as its replies report it (`processingMs`), so a slow round trip can be
+ * told apart from a busy server. FAgentEStatsRecorder lives in the send context and is all
+ * relaxed atomics, so every one of those threads records without a lock.
+ * The stat and trace macros compile out with STATS / CPUPROFILERTRACE off;
+ * the recorder itself is a few atomic adds per stage.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include <atomic>
+#include "AgentEStats.generated.h"
+
+DECLARE_STATS_GROUP(TEXT("AgentE"), STATGROUP_AgentE, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Snapshot capture"), STAT_AgentE_Capture, STATGROUP_AgentE, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Serialize"), STAT_AgentE_Serialize, STATGROUP_AgentE, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Compress"), STAT_AgentE_Compress, STATGROUP_AgentE, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Parse reply"), STAT_AgentE_Parse, STATGROUP_AgentE, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Dispatch"), STAT_AgentE_Dispatch, STATGROUP_AgentE, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Local rules"), STAT_AgentE_LocalRules, STATGROUP_AgentE, );
+
+/** The timed stages, in the order a tick goes through them */
+enum class EAgentEStage : uint8
+{
+    Capture,
+    Serialize,
+    Compress,
+    RoundTrip,
+    Parse,
+    Dispatch,
+    BulkWait,
+    ControlRoundTrip,
+    LocalRules,
+    ServerProcessing,
+    Num,
+};
+
+/** One stage's timings since the last reset */
+USTRUCT(BlueprintType)
+struct FAgentEStageTiming
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly)
+    int64 Count = 0;
+
+    UPROPERTY(BlueprintReadOnly)
+    float LastMs = 0.f;
+
+    UPROPERTY(BlueprintReadOnly)
+    float AverageMs = 0.f;
+
+    UPROPERTY(BlueprintReadOnly)
+    float MaxMs = 0.f;
+};
+
+/** Client counters and stage timings since BeginPlay or ResetClientStats */
+USTRUCT(BlueprintType)
+struct FAgentEClientStats
+{
+    GENERATED_BODY()
+
+    /** Game thread: the EconomyState copy a send works from */
+    UPROPERTY(BlueprintReadOnly)
+    FAgentEStageTiming Capture;
+
+    /** Send task: pre-aggregation, sampling and the tick body */
+    UPROPERTY(BlueprintReadOnly)
+    FAgentEStageTiming Serialize;
+
+    /** Send task: gzip, for bodies over CompressionThresholdBytes */
+    UPROPERTY(BlueprintReadOnly)
+    FAgentEStageTiming Compress;
+
+    /** Tick sent to its reply received */
+    UPROPERTY(BlueprintReadOnly)
+    FAgentEStageTiming RoundTrip;
+
+    /** Reply thread: the tick reply, JSON or MessagePack */
+    UPROPERTY(BlueprintReadOnly)
+    FAgentEStageTiming Parse;
+
+    /** Game thread: applying a reply and draining the adjustment queue */
+    UPROPERTY(BlueprintReadOnly)
+    FAgentEStageTiming Dispatch;
+
+    /** WebSocket bulk lane: a tick or event batch queued behind earlier ones before its first byte went out */
+    UPROPERTY(BlueprintReadOnly)
+    FAgentEStageTiming BulkWait;
+
+    /** Health probe or approve/reject sent to its answer received, either transport */
+    UPROPERTY(BlueprintReadOnly)
+    FAgentEStageTiming ControlRoundTrip;
+
+    /** Game thread: checking the local rules and deciding their adjustments (bUseLocalRules) */
+    UPROPERTY(BlueprintReadOnly)
+    FAgentEStageTiming LocalRules;
+
+    /** Server: the tick itself, as its reply reports it; part of RoundTrip */
+    UPROPERTY(BlueprintReadOnly)
+    FAgentEStageTiming ServerProcessing;
+
+    /** Tick bodies handed to the transport, replays included */
+    UPROPERTY(BlueprintReadOnly)
+    int64 TicksSent = 0;
+
+    /** Tick sends that failed or were rejected, rate limits included */
+    UPROPERTY(BlueprintReadOnly)
+    int64 TicksFailed = 0;
+
+    /** Tick sends the server refused with rate_limited */
+    UPROPERTY(BlueprintReadOnly)
+    int64 RateLimited = 0;
+
+    /** Tick and event bodies as sent (after gzip) */
+    UPROPERTY(BlueprintReadOnly)
+    int64 BytesSent = 0;
+
+    /** Tick reply bodies */
+    UPROPERTY(BlueprintReadOnly)
+    int64 BytesReceived = 0;
+
+    /** Tick sends without a reply right now */
+    UPROPERTY(BlueprintReadOnly)
+    int32 InFlight = 0;
+
+    /** Events lost to full buffers (FAgentEEventStats::TotalLost) */
+    UPROPERTY(BlueprintReadOnly)
+    int64 EventsDropped = 0;
+
+    /** Bodies waiting in the offline spool */
+    UPROPERTY(BlueprintReadOnly)
+    int32 SpoolPending = 0;
+
+    /**
+     * Per-tick buffers that had to be allocated or grown: snapshot, sample
+     * and aggregate pool misses, body buffers outgrowing their capacity.
+     * Stops rising once the send pipeline is warm and the economy's size is
+     * steady.
+     */
+    UPROPERTY(BlueprintReadOnly)
+    int64 TransientAllocations = 0;
+};
+
+class FAgentEStatsRecorder
+{
+public:
+    /** Any thread */
+    void AddStage(EAgentEStage Stage, double Seconds);
+    void AddTickSent(int64 Bytes);
+    void AddEventsSent(int64 Bytes);
+    void AddReply(int64 Bytes, bool bFailed, bool bRateLimited);
+    void SetInFlight(int32 InFlight);
+    void SetEventsDropped(int64 Dropped);
+    void AddTransientAllocations(int64 Count);
+
+    /** Everything the recorder holds; the caller fills InFlight, EventsDropped and SpoolPending */
+    FAgentEClientStats Snapshot() const;
+    void Reset();
+
+private:
+    struct FStage
+    {
+        std::atomic<int64> Count { 0 };
+        std::atomic<int64> TotalMicros { 0 };
+        std::atomic<int64> LastMicros { 0 };
+        std::atomic<int64> MaxMicros { 0 };
+    };
+    FStage Stages[int32(EAgentEStage::Num)];
+
+    std::atomic<int64> TicksSent { 0 };
+    std::atomic<int64> TicksFailed { 0 };
+    std::atomic<int64> RateLimited { 0 };
+    std::atomic<int64> BytesSent { 0 };
+    std::atomic<int64> BytesReceived { 0 };
+    std::atomic<int64> TransientAllocations { 0 };
+};
+
+/** Times one stage into a recorder for as long as it is in scope */
+class FAgentEStageTimer
+{
+public:
+    FAgentEStageTimer(FAgentEStatsRecorder& InRecorder, EAgentEStage InStage)
+        : Recorder(InRecorder), Stage(InStage), Start(FPlatformTime::Cycles64())
+    {
+    }
+    ~FAgentEStageTimer()
+    {
+        Recorder.AddStage(Stage, FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start));
+    }
+
+private:
+    FAgentEStatsRecorder& Recorder;
+    EAgentEStage Stage;
+    uint64 Start;
+};
+
+/**
+ * Time the rest of the enclosing scope as Stage (an EAgentEStage name other
+ * than RoundTrip, BulkWait, ControlRoundTrip and ServerProcessing): recorder, `stat AgentE`
+ * and an Insights scope in one.
+ */
+#define AGENTE_STAGE_SCOPE(Recorder, Stage) \
+    TRACE_CPUPROFILER_EVENT_SCOPE(AgentE_##Stage); \
+    SCOPE_CYCLE_COUNTER(STAT_AgentE_##Stage); \
+    FAgentEStageTimer AgentEStageTimer_##Stage(Recorder, EAgentEStage::Stage)
@@ -0,0 +1,55 @@
+/**
+ * AgentE Unreal Engine Client — Uplink Subsystem
+ *
+ * See AgentESubsystem.h.
+ */
+
+#include "AgentESubsystem.h"
+
+void UAgentESubsystem::Deinitialize()
+{
+    for (const TPair<FString, TSharedRef<FAgentEUplink, ESPMode::ThreadSafe>>& Pair : Uplinks)
+    {
+        Pair.Value->Flush();
+    }
+    Uplinks.Reset();
+    Super::Deinitialize();
+}
+
+TSharedPtr<IAgentETransport, ESPMode::ThreadSafe> UAgentESubsystem::RegisterShard(
+    const FString& ServerUrl, const FString& ShardId, FAgentEReplyHandler Handler,
+    float BatchWindow, int32 CompressAbove)
+{
+    check(IsInGameThread());
+    PruneUplinks();
+
+    TSharedRef<FAgentEUplink, ESPMode::ThreadSafe>* Found = Uplinks.Find(ServerUrl);
+    TSharedRef<FAgentEUplink, ESPMode::ThreadSafe> Uplink = Found
+        ? *Found
+        : Uplinks.Add(ServerUrl, MakeShared<FAgentEUplink, ESPMode::ThreadSafe>(ServerUrl, BatchWindow, CompressAbove));
+
+    if (!Uplink->Register(ShardId, MoveTemp(Handler)))
+    {
+        return nullptr;
+    }
+    UE_LOG(LogTemp, Log, TEXT("[AgentE] Shard %s joined the uplink to %s (%d shards)"),
+        *ShardId, *ServerUrl, Uplink->NumShards());
+    return MakeShared<FAgentEShardTransport, ESPMode::ThreadSafe>(Uplink, ShardId);
+}
+
+int32 UAgentESubsystem::GetShardCount(const FString& ServerUrl) const
+{
+    const TSharedRef<FAgentEUplink, ESPMode::ThreadSafe>* Found = Uplinks.Find(ServerUrl);
+    return Found ? (*Found)->NumShards() : 0;
+}
+
+void UAgentESubsystem::PruneUplinks()
+{
+    for (auto It = Uplinks.CreateIterator(); It; ++It)
+    {
+        if (It.Value()->NumShards() == 0)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
@@ -0,0 +1,42 @@
+/**
+ * AgentE Unreal Engine Client — Uplink Subsystem
+ *
+ * Owns the process's shared uplinks (see AgentEUplink.h), one per server
+ * URL. A UAgentEClient with bUseSharedUplink registers its shard here in
+ * BeginPlay and unregisters in EndPlay; an uplink goes away with its last
+ * shard.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "AgentEUplink.h"
+#include "AgentESubsystem.generated.h"
+
+UCLASS()
+class YOURGAME_API UAgentESubsystem : public UEngineSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    /**
+     * Game thread. A transport sending through ServerUrl's uplink under
+     * ShardId, or null if the ID is invalid or taken. The first shard of a
+     * server picks its uplink's batch window and compression threshold.
+     */
+    TSharedPtr<IAgentETransport, ESPMode::ThreadSafe> RegisterShard(
+        const FString& ServerUrl, const FString& ShardId, FAgentEReplyHandler Handler,
+        float BatchWindow, int32 CompressAbove);
+
+    /** Game thread. Shards registered on ServerUrl's uplink (0 if it has none) */
+    int32 GetShardCount(const FString& ServerUrl) const;
+
+private:
+    TMap<FString, TSharedRef<FAgentEUplink, ESPMode::ThreadSafe>> Uplinks;
+
+    /** Drop uplinks whose shards have all unregistered */
+    void PruneUplinks();
+};
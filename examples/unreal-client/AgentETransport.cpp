@@ -0,0 +1,434 @@
+/**
+ * AgentE Unreal Engine Client — Transports
+ *
+ * See AgentETransport.h.
+ */
+
+#include "AgentETransport.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "WebSocketsModule.h"
+#include "IWebSocket.h"
+#include "Async/Async.h"
+
+// ─── HTTP ───────────────────────────────────────────────────────────────────
+
+static const TCHAR* MsgPackContentType = TEXT("application/x-msgpack");
+static const TCHAR* MsgPackSubprotocol = TEXT("agente.msgpack.v1");
+
+/** Chunk frame header, as the server expects it (see packages/server/src/websocket.ts) */
+static constexpr uint8 ChunkMarker = 0xc1;
+static constexpr uint8 ChunkLast = 1;
+static constexpr uint8 ChunkBinary = 2;
+static constexpr int32 ChunkHeaderBytes = 6;
+
+FAgentEHttpTransport::FAgentEHttpTransport(
+    const FString& ServerUrl, EAgentEEncoding InEncoding, FAgentEReplyHandler InHandler)
+    : TickUrl(ServerUrl + TEXT("/tick"))
+    , EventsUrl(ServerUrl + TEXT("/events"))
+    , Encoding(InEncoding)
+    , Handler(MoveTemp(InHandler))
+{
+}
+
+void FAgentEHttpTransport::SendTick(const TArray<uint8>& Body, bool bGzip)
+{
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request =
+        FHttpModule::Get().CreateRequest();
+
+    Request->SetURL(TickUrl);
+    Request->SetVerb(TEXT("POST"));
+    if (Encoding == EAgentEEncoding::MessagePack)
+    {
+        Request->SetHeader(TEXT("Content-Type"), MsgPackContentType);
+        Request->SetHeader(TEXT("Accept"), MsgPackContentType);
+    }
+    else
+    {
+        Request->SetHeader(TEXT("Content-Type"), TEXT("application/json; charset=utf-8"));
+    }
+    if (bGzip)
+    {
+        Request->SetHeader(TEXT("Content-Encoding"), TEXT("gzip"));
+    }
+    Request->SetContent(Body);
+    Request->SetDelegateThreadPolicy(EHttpRequestDelegateThreadPolicy::CompleteOnHttpThread);
+    Request->OnProcessRequestComplete().BindLambda(
+        [Handler = Handler](FHttpRequestPtr, FHttpResponsePtr Response, bool bSuccess) {
+            if (!bSuccess || !Response.IsValid())
+            {
+                Handler(0, {}, false);
+                return;
+            }
+            Handler(Response->GetResponseCode(), Response->GetContent(),
+                Response->GetContentType().StartsWith(MsgPackContentType));
+        });
+
+    Request->ProcessRequest();
+}
+
+void FAgentEHttpTransport::SendEvents(const TArray<uint8>& Body)
+{
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request =
+        FHttpModule::Get().CreateRequest();
+
+    Request->SetURL(EventsUrl);
+    Request->SetVerb(TEXT("POST"));
+    Request->SetHeader(TEXT("Content-Type"), TEXT("application/json; charset=utf-8"));
+    Request->SetContent(Body);
+    Request->SetDelegateThreadPolicy(EHttpRequestDelegateThreadPolicy::CompleteOnHttpThread);
+    Request->OnProcessRequestComplete().BindLambda(
+        [](FHttpRequestPtr, FHttpResponsePtr Response, bool bSuccess) {
+            if (!bSuccess || !Response.IsValid() || !EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("[AgentE] Event batch failed (%d)"),
+                    Response.IsValid() ? Response->GetResponseCode() : 0);
+            }
+        });
+
+    Request->ProcessRequest();
+}
+
+// ─── WebSocket ──────────────────────────────────────────────────────────────
+
+FAgentEWebSocketTransport::FAgentEWebSocketTransport(
+    const FString& InUrl, EAgentEEncoding InEncoding, float InInitialBackoff, float InMaxBackoff,
+    int32 InBulkChunkBytes, int32 InBulkBytesPerFrame,
+    FAgentEReplyHandler InHandler, FAgentEBulkWaitHandler InBulkWait)
+    : Url(InUrl)
+    , Encoding(InEncoding)
+    , InitialBackoff(FMath::Max(0.1f, InInitialBackoff))
+    , MaxBackoff(FMath::Max(InInitialBackoff, InMaxBackoff))
+    , BulkChunkBytes(FMath::Max(1024, InBulkChunkBytes))
+    , BulkBytesPerFrame(FMath::Max(BulkChunkBytes, InBulkBytesPerFrame))
+    , Handler(MoveTemp(InHandler))
+    , BulkWait(MoveTemp(InBulkWait))
+{
+}
+
+FAgentEWebSocketTransport::~FAgentEWebSocketTransport()
+{
+    Shutdown();
+}
+
+FString FAgentEWebSocketTransport::ToWebSocketUrl(const FString& ServerUrl)
+{
+    if (ServerUrl.StartsWith(TEXT("https://")))
+    {
+        return TEXT("wss://") + ServerUrl.RightChop(8);
+    }
+    if (ServerUrl.StartsWith(TEXT("http://")))
+    {
+        return TEXT("ws://") + ServerUrl.RightChop(7);
+    }
+    return ServerUrl;
+}
+
+void FAgentEWebSocketTransport::Connect()
+{
+    bShuttingDown = false;
+    OpenSocket();
+}
+
+void FAgentEWebSocketTransport::Shutdown()
+{
+    bShuttingDown = true;
+    if (ReconnectHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(ReconnectHandle);
+        ReconnectHandle.Reset();
+    }
+    if (PumpHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(PumpHandle);
+        PumpHandle.Reset();
+    }
+    BulkQueue.Reset();
+    if (Socket.IsValid())
+    {
+        Socket->OnConnected().Clear();
+        Socket->OnConnectionError().Clear();
+        Socket->OnClosed().Clear();
+        Socket->OnRawMessage().Clear();
+        Socket->OnBinaryMessage().Clear();
+        Socket->Close();
+        Socket.Reset();
+    }
+}
+
+void FAgentEWebSocketTransport::OpenSocket()
+{
+    if (!FModuleManager::Get().IsModuleLoaded(TEXT("WebSockets")))
+    {
+        FModuleManager::Get().LoadModule(TEXT("WebSockets"));
+    }
+
+    PartialFrame.Reset();
+    PartialText.Reset();
+    Socket = FWebSocketsModule::Get().CreateWebSocket(
+        Url, Encoding == EAgentEEncoding::MessagePack ? FString(MsgPackSubprotocol) : FString());
+
+    // Callbacks arrive on the game thread; a weak pointer keeps late ones harmless
+    TWeakPtr<FAgentEWebSocketTransport, ESPMode::ThreadSafe> WeakSelf = AsShared();
+
+    Socket->OnConnected().AddLambda([WeakSelf]() {
+        if (auto Self = WeakSelf.Pin())
+        {
+            Self->ReconnectAttempts = 0;
+            UE_LOG(LogTemp, Log, TEXT("[AgentE] WebSocket connected: %s"), *Self->Url);
+            if (!Self->SubscribeBody.IsEmpty())
+            {
+                Self->SendControl(Self->SubscribeBody);
+            }
+        }
+    });
+
+    Socket->OnConnectionError().AddLambda([WeakSelf](const FString& Error) {
+        if (auto Self = WeakSelf.Pin())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[AgentE] WebSocket connection error: %s"), *Error);
+            Self->DropBulk();
+            Self->ScheduleReconnect();
+        }
+    });
+
+    Socket->OnClosed().AddLambda([WeakSelf](int32 StatusCode, const FString& Reason, bool bWasClean) {
+        if (auto Self = WeakSelf.Pin())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[AgentE] WebSocket closed (%d): %s"), StatusCode, *Reason);
+            Self->DropBulk();
+            Self->ScheduleReconnect();
+        }
+    });
+
+    // Raw text frames, so replies are parsed from their UTF-8 bytes (OnMessage would decode to FString)
+    Socket->OnRawMessage().AddLambda([WeakSelf](const void* Data, SIZE_T Size, SIZE_T BytesRemaining) {
+        if (auto Self = WeakSelf.Pin())
+        {
+            if (BytesRemaining == 0 && Self->PartialText.IsEmpty())
+            {
+                Self->Handler(200, TConstArrayView<uint8>(static_cast<const uint8*>(Data), int32(Size)), false);
+                return;
+            }
+            Self->PartialText.Append(static_cast<const uint8*>(Data), int32(Size));
+            if (BytesRemaining == 0)
+            {
+                Self->Handler(200, Self->PartialText, false);
+                Self->PartialText.Reset();
+            }
+        }
+    });
+
+    Socket->OnBinaryMessage().AddLambda([WeakSelf](const void* Data, SIZE_T Size, bool bIsLastFragment) {
+        if (auto Self = WeakSelf.Pin())
+        {
+            Self->PartialFrame.Append(static_cast<const uint8*>(Data), int32(Size));
+            if (bIsLastFragment)
+            {
+                Self->Handler(200, Self->PartialFrame, true);
+                Self->PartialFrame.Reset();
+            }
+        }
+    });
+
+    Socket->Connect();
+}
+
+void FAgentEWebSocketTransport::ScheduleReconnect()
+{
+    if (bShuttingDown || ReconnectHandle.IsValid())
+    {
+        return;
+    }
+
+    // Exponential backoff with ±20% jitter so many clients don't reconnect in lockstep
+    const float Base = FMath::Min(MaxBackoff, InitialBackoff * FMath::Pow(2.f, float(FMath::Min(ReconnectAttempts, 16))));
+    const float Delay = Base * FMath::FRandRange(0.8f, 1.2f);
+    ++ReconnectAttempts;
+
+    UE_LOG(LogTemp, Log, TEXT("[AgentE] WebSocket reconnect in %.1fs (attempt %d)"), Delay, ReconnectAttempts);
+
+    TWeakPtr<FAgentEWebSocketTransport, ESPMode::ThreadSafe> WeakSelf = AsShared();
+    ReconnectHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateLambda([WeakSelf](float) {
+            if (auto Self = WeakSelf.Pin())
+            {
+                Self->ReconnectHandle.Reset();
+                if (!Self->bShuttingDown)
+                {
+                    Self->OpenSocket();
+                }
+            }
+            return false; // one-shot
+        }),
+        Delay);
+}
+
+void FAgentEWebSocketTransport::SendTick(const TArray<uint8>& Body, bool bGzip)
+{
+    check(!bGzip);
+    Send(Body, Encoding == EAgentEEncoding::MessagePack, /*bIsTick*/ true);
+}
+
+void FAgentEWebSocketTransport::SendEvents(const TArray<uint8>& Body)
+{
+    Send(Body, /*bBinary*/ false, /*bIsTick*/ false);
+}
+
+void FAgentEWebSocketTransport::Send(const TArray<uint8>& Body, bool bBinary, bool bIsTick)
+{
+    // IWebSocket is not thread-safe; copy the frame and send from the game thread
+    TArray<uint8> Frame(Body);
+    if (IsInGameThread())
+    {
+        SendOnGameThread(MoveTemp(Frame), bBinary, bIsTick);
+        return;
+    }
+
+    TWeakPtr<FAgentEWebSocketTransport, ESPMode::ThreadSafe> WeakSelf = AsShared();
+    AsyncTask(ENamedThreads::GameThread, [WeakSelf, Frame = MoveTemp(Frame), bBinary, bIsTick]() mutable {
+        if (auto Self = WeakSelf.Pin())
+        {
+            Self->SendOnGameThread(MoveTemp(Frame), bBinary, bIsTick);
+        }
+    });
+}
+
+void FAgentEWebSocketTransport::SendOnGameThread(TArray<uint8> Frame, bool bBinary, bool bIsTick)
+{
+    if (!Socket.IsValid() || !Socket->IsConnected())
+    {
+        if (bIsTick)
+        {
+            // Reported like an HTTP failure: the client resyncs with a full snapshot
+            Handler(0, {}, false);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[AgentE] Event batch dropped: WebSocket not connected"));
+        }
+        return;
+    }
+
+    FBulkMessage& Message = BulkQueue.AddDefaulted_GetRef();
+    Message.Body = MoveTemp(Frame);
+    Message.bBinary = bBinary;
+    Message.bIsTick = bIsTick;
+    Message.QueuedAt = FPlatformTime::Seconds();
+    if (PumpHandle.IsValid())
+    {
+        return; // the pump sends it after the messages ahead of it
+    }
+
+    // An idle lane sends right away; the pump carries on next frame only if the budget ran out
+    if (PumpBulk())
+    {
+        TWeakPtr<FAgentEWebSocketTransport, ESPMode::ThreadSafe> WeakSelf = AsShared();
+        PumpHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateLambda([WeakSelf](float) {
+                TSharedPtr<FAgentEWebSocketTransport, ESPMode::ThreadSafe> Self = WeakSelf.Pin();
+                if (!Self.IsValid())
+                {
+                    return false;
+                }
+                if (!Self->PumpBulk())
+                {
+                    Self->PumpHandle.Reset();
+                    return false;
+                }
+                return true;
+            }));
+    }
+}
+
+bool FAgentEWebSocketTransport::PumpBulk()
+{
+    if (!Socket.IsValid() || !Socket->IsConnected())
+    {
+        DropBulk();
+        return false;
+    }
+
+    int32 Budget = BulkBytesPerFrame;
+    while (Budget > 0 && !BulkQueue.IsEmpty())
+    {
+        FBulkMessage& Message = BulkQueue[0];
+        const int32 Size = Message.Body.Num();
+        if (Message.Offset == 0)
+        {
+            BulkWait(FPlatformTime::Seconds() - Message.QueuedAt);
+            if (Size <= BulkChunkBytes)
+            {
+                Socket->Send(Message.Body.GetData(), Size, Message.bBinary);
+                Budget -= Size;
+                BulkQueue.RemoveAt(0, 1, EAllowShrinking::No);
+                continue;
+            }
+            Message.ChunkId = NextChunkId++;
+        }
+
+        const int32 Piece = FMath::Min(BulkChunkBytes, Size - Message.Offset);
+        const bool bLast = Message.Offset + Piece == Size;
+        const uint8 Flags = (bLast ? ChunkLast : 0) | (Message.bBinary ? ChunkBinary : 0);
+        const uint8 Header[ChunkHeaderBytes] = {
+            ChunkMarker, Flags,
+            uint8(Message.ChunkId), uint8(Message.ChunkId >> 8), uint8(Message.ChunkId >> 16), uint8(Message.ChunkId >> 24),
+        };
+        ChunkScratch.Reset();
+        ChunkScratch.Append(Header, ChunkHeaderBytes);
+        ChunkScratch.Append(Message.Body.GetData() + Message.Offset, Piece);
+        Socket->Send(ChunkScratch.GetData(), ChunkScratch.Num(), /*bIsBinary*/ true);
+
+        Message.Offset += Piece;
+        Budget -= Piece;
+        if (bLast)
+        {
+            BulkQueue.RemoveAt(0, 1, EAllowShrinking::No);
+        }
+    }
+    return !BulkQueue.IsEmpty();
+}
+
+void FAgentEWebSocketTransport::DropBulk()
+{
+    // Handlers may send again, so fail a detached copy of the queue
+    TArray<FBulkMessage> Dropped = MoveTemp(BulkQueue);
+    BulkQueue.Reset();
+    int32 Events = 0;
+    for (const FBulkMessage& Message : Dropped)
+    {
+        if (Message.bIsTick)
+        {
+            Handler(0, {}, false);
+        }
+        else
+        {
+            ++Events;
+        }
+    }
+    if (Events > 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[AgentE] %d event batches dropped: WebSocket closed"), Events);
+    }
+}
+
+bool FAgentEWebSocketTransport::SendControl(const TArray<uint8>& Body)
+{
+    check(IsInGameThread());
+    if (!Socket.IsValid() || !Socket->IsConnected())
+    {
+        return false;
+    }
+    // Between two chunk frames at worst; the server reassembles chunked messages around it
+    Socket->Send(Body.GetData(), Body.Num(), /*bIsBinary*/ false);
+    return true;
+}
+
+bool FAgentEWebSocketTransport::Subscribe(const TArray<uint8>& Body)
+{
+    check(IsInGameThread());
+    SubscribeBody = Body;
+    SendControl(SubscribeBody); // false until connected; OnConnected sends it then
+    return true;
+}
@@ -0,0 +1,204 @@
+/**
+ * AgentE Unreal Engine Client — Transports
+ *
+ * How a serialized tick body reaches the server and how replies come back.
+ * UAgentEClient owns exactly one transport, picked by its Transport setting:
+ *
+ *   - HTTP:      one POST /tick per send (FHttpModule)
+ *   - WebSocket: one persistent IWebSocket connection ("WebSockets" module),
+ *                reconnecting with exponential backoff
+ *   - SharedMemory: rings in a POSIX shared-memory region with a loopback
+ *                doorbell socket, for a server on the same Linux host
+ *                (see AgentESharedMemory.h)
+ *
+ * Both report replies through the same handler, so the client parses HTTP
+ * bodies and WebSocket frames with one code path.
+ *
+ * Encoding picks JSON or MessagePack (see AgentEMsgPack.h): HTTP sends
+ * Content-Type/Accept application/x-msgpack, WebSocket negotiates the
+ * agente.msgpack.v1 subprotocol and sends binary frames.
+ *
+ * HTTP tick bodies may be gzip-compressed by the client (Content-Encoding:
+ * gzip); WebSocket frames are never compressed here.
+ *
+ * The WebSocket shares one connection between bulk traffic (ticks, event
+ * batches) and small control messages (health probes, approve/reject), so it
+ * keeps two lanes. Control messages go to the socket as soon as they are
+ * sent. Bulk frames queue behind each other. Those over BulkChunkBytes are
+ * split into chunk frames (see packages/server/src/websocket.ts), and at
+ * most BulkBytesPerFrame bulk bytes reach the socket per engine frame. So
+ * a control message waits behind one frame's worth of bulk at most, never
+ * behind a whole snapshot. HTTP needs no lanes: every request has its own
+ * connection.
+ *
+ * The WebSocket can also carry a subscription: a control message sent again
+ * on every (re)connect, since the server forgets it with the connection.
+ * Whatever the server pushes in return reaches the reply handler like any
+ * other frame.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "AgentETransport.generated.h"
+
+class IWebSocket;
+
+UENUM(BlueprintType)
+enum class EAgentETransport : uint8
+{
+    Http,
+    WebSocket,
+    SharedMemory,
+};
+
+UENUM(BlueprintType)
+enum class EAgentEEncoding : uint8
+{
+    Json,
+    MessagePack,
+};
+
+/**
+ * Reply handler. StatusCode is the HTTP status, 200 for WebSocket frames,
+ * or 0 when the transport failed before the server answered.
+ * Body is the raw reply — MessagePack when bBinary, UTF-8 JSON otherwise —
+ * and is only valid for the duration of the call.
+ * May be invoked on the HTTP thread (HTTP) or the game thread (WebSocket).
+ */
+using FAgentEReplyHandler = TFunction<void(int32 StatusCode, TConstArrayView<uint8> Body, bool bBinary)>;
+
+/** Called on the game thread when a bulk message starts reaching the socket, with the seconds it queued */
+using FAgentEBulkWaitHandler = TFunction<void(double QueuedSeconds)>;
+
+class IAgentETransport
+{
+public:
+    virtual ~IAgentETransport() = default;
+
+    /** Game thread. Open connections, if the transport has any. */
+    virtual void Connect() {}
+
+    /** Game thread. Close connections and stop reconnecting. */
+    virtual void Shutdown() {}
+
+    /** Any thread. Send one tick body (gzip data when bGzip); the reply goes to the handler. */
+    virtual void SendTick(const TArray<uint8>& Body, bool bGzip) = 0;
+
+    /** Whether SendTick accepts gzip bodies */
+    virtual bool SupportsCompression() const { return false; }
+
+    /** Any thread. Send one JSON events batch; failures are logged, not reported */
+    virtual void SendEvents(const TArray<uint8>& Body) = 0;
+
+    /**
+     * Game thread. Send one small JSON message on the control lane, ahead of
+     * queued bulk frames; its reply goes to the handler. False when the
+     * transport has no control lane or it is down — ask over HTTP instead.
+     */
+    virtual bool SendControl(const TArray<uint8>& Body) { return false; }
+
+    /**
+     * Game thread. Send Body on the control lane now (if connected) and after
+     * every reconnect. False when the transport can't receive pushes.
+     */
+    virtual bool Subscribe(const TArray<uint8>& Body) { return false; }
+
+    /** Whether the wire body must carry a "type" field (WebSocket messages) */
+    virtual const ANSICHAR* GetTickMessageType() const { return nullptr; }
+    virtual const ANSICHAR* GetEventsMessageType() const { return nullptr; }
+};
+
+class FAgentEHttpTransport : public IAgentETransport
+{
+public:
+    FAgentEHttpTransport(const FString& ServerUrl, EAgentEEncoding InEncoding, FAgentEReplyHandler InHandler);
+
+    virtual void SendTick(const TArray<uint8>& Body, bool bGzip) override;
+    virtual void SendEvents(const TArray<uint8>& Body) override;
+    virtual bool SupportsCompression() const override { return true; }
+
+private:
+    FString TickUrl;
+    FString EventsUrl;
+    EAgentEEncoding Encoding;
+    FAgentEReplyHandler Handler;
+};
+
+class FAgentEWebSocketTransport
+    : public IAgentETransport
+    , public TSharedFromThis<FAgentEWebSocketTransport, ESPMode::ThreadSafe>
+{
+public:
+    /** BulkChunkBytes / BulkBytesPerFrame: chunk size and per-frame budget of the bulk lane */
+    FAgentEWebSocketTransport(
+        const FString& InUrl, EAgentEEncoding InEncoding, float InInitialBackoff, float InMaxBackoff,
+        int32 InBulkChunkBytes, int32 InBulkBytesPerFrame,
+        FAgentEReplyHandler InHandler, FAgentEBulkWaitHandler InBulkWait);
+    virtual ~FAgentEWebSocketTransport() override;
+
+    virtual void Connect() override;
+    virtual void Shutdown() override;
+    virtual void SendTick(const TArray<uint8>& Body, bool bGzip) override;
+    virtual void SendEvents(const TArray<uint8>& Body) override;
+    virtual bool SendControl(const TArray<uint8>& Body) override;
+    virtual bool Subscribe(const TArray<uint8>& Body) override;
+    /** Binary frames are always ticks; JSON ones say so */
+    virtual const ANSICHAR* GetTickMessageType() const override
+    {
+        return Encoding == EAgentEEncoding::Json ? "tick" : nullptr;
+    }
+    virtual const ANSICHAR* GetEventsMessageType() const override { return "events"; }
+
+    /** ws:// or wss:// URL for an http:// or https:// server URL */
+    static FString ToWebSocketUrl(const FString& ServerUrl);
+
+private:
+    FString Url;
+    EAgentEEncoding Encoding;
+    float InitialBackoff;
+    float MaxBackoff;
+    int32 BulkChunkBytes;
+    int32 BulkBytesPerFrame;
+    FAgentEReplyHandler Handler;
+    FAgentEBulkWaitHandler BulkWait;
+
+    TSharedPtr<IWebSocket> Socket;
+    FTSTicker::FDelegateHandle ReconnectHandle;
+    int32 ReconnectAttempts = 0;
+    bool bShuttingDown = false;
+
+    /** Sent on every connect; empty when not subscribed */
+    TArray<uint8> SubscribeBody;
+
+    /** Fragments of the frame being received — text frames stay UTF-8 bytes, never an FString */
+    TArray<uint8> PartialFrame;
+    TArray<uint8> PartialText;
+
+    /** Bulk lane, game thread only: whole messages in send order, the first one possibly part-sent */
+    struct FBulkMessage
+    {
+        TArray<uint8> Body;
+        bool bBinary = false;
+        bool bIsTick = false;
+        int32 Offset = 0;
+        uint32 ChunkId = 0;
+        double QueuedAt = 0.0;
+    };
+    TArray<FBulkMessage> BulkQueue;
+    TArray<uint8> ChunkScratch;
+    uint32 NextChunkId = 0;
+    FTSTicker::FDelegateHandle PumpHandle;
+
+    void OpenSocket();
+    void ScheduleReconnect();
+    void Send(const TArray<uint8>& Body, bool bBinary, bool bIsTick);
+    void SendOnGameThread(TArray<uint8> Frame, bool bBinary, bool bIsTick);
+
+    /** Hand up to BulkBytesPerFrame queued bytes to the socket; true while more are queued */
+    bool PumpBulk();
+
+    /** Fail queued ticks (status 0) and drop queued event batches — the connection is gone */
+    void DropBulk();
+};
@@ -0,0 +1,345 @@
+/**
+ * AgentE Unreal Engine Client — Shared Uplink
+ *
+ * See AgentEUplink.h.
+ */
+
+#include "AgentEUplink.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/Compression.h"
+#include "Misc/ScopeLock.h"
+#include "AgentEJsonReader.h"
+#include "AgentEStateWriter.h"
+
+using FAgentEBatchSlice = TPair<FString, TSharedRef<FAgentEReplyHandler, ESPMode::ThreadSafe>>;
+
+static bool IsShardId(const FString& Id)
+{
+    if (Id.IsEmpty() || Id.Len() > 64)
+    {
+        return false;
+    }
+    for (const TCHAR C : Id)
+    {
+        if (!FChar::IsAlnum(C) && C != '_' && C != '.' && C != ':' && C != '-')
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Route a /tick/batch reply's slices to their shards. False, with no
+ * handler called, if the reply isn't a batch reply; a slice the reply
+ * has no result for hears 502.
+ */
+static bool DispatchBatchReply(TConstArrayView<uint8> Reply, TConstArrayView<FAgentEBatchSlice> Slices)
+{
+    struct FResult
+    {
+        int32 Status = 502;
+        TConstArrayView<uint8> Body;
+    };
+    TArray<FResult, TInlineAllocator<16>> Results;
+    Results.SetNum(Slices.Num());
+
+    FAgentEJsonReader R(Reply.GetData(), Reply.Num());
+    FUtf8StringView Key;
+    if (!R.BeginObject())
+    {
+        return false;
+    }
+
+    bool bFound = false;
+    while (R.NextKey(Key))
+    {
+        if (!AgentEKeyIs(Key, "results") || !R.BeginArray())
+        {
+            R.Skip();
+            continue;
+        }
+        bFound = true;
+
+        // One result per slice, in the order sent
+        int32 Index = 0;
+        while (R.NextElement())
+        {
+            FString Shard;
+            double Status = 0.0;
+            TConstArrayView<uint8> Body;
+            if (!R.BeginObject())
+            {
+                return false;
+            }
+            while (R.NextKey(Key))
+            {
+                if (AgentEKeyIs(Key, "shard") && R.PeekType() == EAgentEJsonType::String) R.ReadString(Shard);
+                else if (AgentEKeyIs(Key, "status")) R.ReadNumber(Status);
+                else if (AgentEKeyIs(Key, "body")) R.ReadRaw(Body);
+                else R.Skip();
+            }
+            if (Slices.IsValidIndex(Index) && Shard == Slices[Index].Key)
+            {
+                Results[Index] = { int32(Status), Body };
+            }
+            ++Index;
+        }
+    }
+    if (!bFound || R.HasError())
+    {
+        return false;
+    }
+
+    for (int32 i = 0; i < Slices.Num(); ++i)
+    {
+        (*Slices[i].Value)(Results[i].Status, Results[i].Body, false);
+    }
+    return true;
+}
+
+// ─── Uplink ─────────────────────────────────────────────────────────────────
+
+FAgentEUplink::FAgentEUplink(const FString& ServerUrl, float InBatchWindow, int32 InCompressAbove)
+    : BatchUrl(ServerUrl + TEXT("/tick/batch"))
+    , EventsUrl(ServerUrl + TEXT("/events"))
+    , BatchWindow(FMath::Max(0.f, InBatchWindow))
+    , CompressAbove(InCompressAbove)
+{
+    // FTSTicker removal is thread-safe, so the last reference may go on any thread
+    FlushHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateRaw(this, &FAgentEUplink::TickFlush));
+}
+
+FAgentEUplink::~FAgentEUplink()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(FlushHandle);
+}
+
+bool FAgentEUplink::Register(const FString& ShardId, FAgentEReplyHandler Handler)
+{
+    if (!IsShardId(ShardId))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[AgentE] Invalid shard ID '%s' (1-64 of A-Z a-z 0-9 _ . : -)"), *ShardId);
+        return false;
+    }
+
+    FScopeLock Guard(&Lock);
+    if (Shards.ContainsByPredicate([&](const FShard& S) { return S.Id == ShardId; }))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[AgentE] Shard '%s' is already registered on %s"), *ShardId, *BatchUrl);
+        return false;
+    }
+
+    FShard& Shard = Shards.Add_GetRef(FShard{
+        ShardId, {}, MakeShared<FAgentEReplyHandler, ESPMode::ThreadSafe>(MoveTemp(Handler)) });
+    Shard.Prefix = AgentEShardPrefix(ShardId);
+    return true;
+}
+
+void FAgentEUplink::Unregister(const FString& ShardId)
+{
+    bool bHadPending = false;
+    {
+        FScopeLock Guard(&Lock);
+        const FShard* Shard = Shards.FindByPredicate([&](const FShard& S) { return S.Id == ShardId; });
+        bHadPending = Shard && Shard->bPending;
+    }
+    if (bHadPending)
+    {
+        Flush();
+    }
+
+    FScopeLock Guard(&Lock);
+    Shards.RemoveAll([&](const FShard& S) { return S.Id == ShardId; });
+}
+
+int32 FAgentEUplink::NumShards() const
+{
+    FScopeLock Guard(&Lock);
+    return Shards.Num();
+}
+
+void FAgentEUplink::SendTick(const FString& ShardId, const TArray<uint8>& Body)
+{
+    // A second tick from a shard first sends the batch holding its previous one
+    bool bFlushFirst = false;
+    {
+        FScopeLock Guard(&Lock);
+        const FShard* Shard = Shards.FindByPredicate([&](const FShard& S) { return S.Id == ShardId; });
+        bFlushFirst = Shard && Shard->bPending;
+    }
+    if (bFlushFirst)
+    {
+        Flush();
+    }
+
+    bool bAllPending = false;
+    {
+        FScopeLock Guard(&Lock);
+        FShard* Shard = Shards.FindByPredicate([&](const FShard& S) { return S.Id == ShardId; });
+        if (!Shard)
+        {
+            return; // unregistered while the send task ran
+        }
+        Shard->Pending.Reset();
+        Shard->Pending.Append(Body);
+        if (!Shard->bPending)
+        {
+            Shard->bPending = true;
+            if (NumPending++ == 0)
+            {
+                OldestPendingTime = FPlatformTime::Seconds();
+            }
+        }
+        bAllPending = NumPending == Shards.Num();
+    }
+    if (bAllPending || BatchWindow <= 0.0)
+    {
+        Flush();
+    }
+}
+
+void FAgentEUplink::SendEvents(const FString& ShardId, const TArray<uint8>& Body)
+{
+    TArray<uint8> Tagged;
+    {
+        FScopeLock Guard(&Lock);
+        const FShard* Shard = Shards.FindByPredicate([&](const FShard& S) { return S.Id == ShardId; });
+        if (!Shard)
+        {
+            return;
+        }
+        Tagged.Reserve(Shard->Prefix.Num() + Body.Num());
+        AgentESpliceShard(Tagged, Shard->Prefix, Body);
+    }
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+    Request->SetURL(EventsUrl);
+    Request->SetVerb(TEXT("POST"));
+    Request->SetHeader(TEXT("Content-Type"), TEXT("application/json; charset=utf-8"));
+    Request->SetContent(MoveTemp(Tagged));
+    Request->SetDelegateThreadPolicy(EHttpRequestDelegateThreadPolicy::CompleteOnHttpThread);
+    Request->OnProcessRequestComplete().BindLambda(
+        [ShardId](FHttpRequestPtr, FHttpResponsePtr Response, bool bSuccess) {
+            if (!bSuccess || !Response.IsValid() || !EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("[AgentE] Event batch for shard %s failed (%d)"),
+                    *ShardId, Response.IsValid() ? Response->GetResponseCode() : 0);
+            }
+        });
+    Request->ProcessRequest();
+}
+
+void FAgentEUplink::Flush()
+{
+    TArray<FAgentEBatchSlice> Slices;
+    TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> Request;
+    {
+        FScopeLock Guard(&Lock);
+        if (NumPending == 0)
+        {
+            return;
+        }
+
+        static const char Open[] = "{\"shards\":[";
+        Frame.Reset();
+        Frame.Append(reinterpret_cast<const uint8*>(Open), sizeof(Open) - 1);
+        for (FShard& Shard : Shards)
+        {
+            if (!Shard.bPending)
+            {
+                continue;
+            }
+            if (!Slices.IsEmpty())
+            {
+                Frame.Add(',');
+            }
+            AgentESpliceShard(Frame, Shard.Prefix, Shard.Pending);
+            Slices.Emplace(Shard.Id, Shard.Handler);
+            Shard.bPending = false;
+        }
+        Frame.Append(reinterpret_cast<const uint8*>("]}"), 2);
+        NumPending = 0;
+
+        Request = FHttpModule::Get().CreateRequest();
+        Request->SetURL(BatchUrl);
+        Request->SetVerb(TEXT("POST"));
+        Request->SetHeader(TEXT("Content-Type"), TEXT("application/json; charset=utf-8"));
+
+        bool bGzip = false;
+        if (CompressAbove >= 0 && Frame.Num() >= CompressAbove)
+        {
+            int32 CompressedSize = int32(FCompression::CompressMemoryBound(NAME_Gzip, Frame.Num()));
+            Compressed.SetNumUninitialized(CompressedSize, EAllowShrinking::No);
+            bGzip = FCompression::CompressMemory(NAME_Gzip, Compressed.GetData(), CompressedSize,
+                    Frame.GetData(), Frame.Num(), COMPRESS_BiasSpeed)
+                && CompressedSize < Frame.Num() - Frame.Num() / 10;
+            if (bGzip)
+            {
+                Compressed.SetNum(CompressedSize, EAllowShrinking::No);
+                Request->SetHeader(TEXT("Content-Encoding"), TEXT("gzip"));
+            }
+        }
+        Request->SetContent(bGzip ? Compressed : Frame);
+    }
+
+    Request->SetDelegateThreadPolicy(EHttpRequestDelegateThreadPolicy::CompleteOnHttpThread);
+    Request->OnProcessRequestComplete().BindLambda(
+        [Slices = MoveTemp(Slices)](FHttpRequestPtr, FHttpResponsePtr Response, bool bSuccess) {
+            if (!bSuccess || !Response.IsValid())
+            {
+                for (const FAgentEBatchSlice& Slice : Slices)
+                {
+                    (*Slice.Value)(0, {}, false);
+                }
+                return;
+            }
+            const int32 Status = Response->GetResponseCode();
+            if (Status == 200 && DispatchBatchReply(Response->GetContent(), Slices))
+            {
+                return;
+            }
+            // The whole batch was refused (auth, rate limit, malformed): every shard hears so
+            const int32 Reported = Status == 200 ? 502 : Status;
+            for (const FAgentEBatchSlice& Slice : Slices)
+            {
+                (*Slice.Value)(Reported, Response->GetContent(), false);
+            }
+        });
+    Request->ProcessRequest();
+}
+
+bool FAgentEUplink::TickFlush(float DeltaTime)
+{
+    bool bDue = false;
+    {
+        FScopeLock Guard(&Lock);
+        bDue = NumPending > 0 && FPlatformTime::Seconds() - OldestPendingTime >= BatchWindow;
+    }
+    if (bDue)
+    {
+        Flush();
+    }
+    return true;
+}
+
+// ─── Shard Transport ────────────────────────────────────────────────────────
+
+void FAgentEShardTransport::Shutdown()
+{
+    Uplink->Unregister(ShardId);
+}
+
+void FAgentEShardTransport::SendTick(const TArray<uint8>& Body, bool bGzip)
+{
+    check(!bGzip);
+    Uplink->SendTick(ShardId, Body);
+}
+
+void FAgentEShardTransport::SendEvents(const TArray<uint8>& Body)
+{
+    Uplink->SendEvents(ShardId, Body);
+}
@@ -0,0 +1,109 @@
+/**
+ * AgentE Unreal Engine Client — Shared Uplink
+ *
+ * One connection per server for every AgentE component in the process.
+ * A dedicated server hosting several zones (or a process running several
+ * instances) has one UAgentEClient per economy; with bUseSharedUplink each
+ * one gets an FAgentEShardTransport instead of its own HTTP transport, and
+ * their ticks are coalesced into POST /tick/batch requests:
+ *
+ *   { "shards": [ { "shard": "Zone1", ...tick body... }, ... ] }
+ *   → { "results": [ { "shard": "Zone1", "status": 200, "body": {...} }, ... ] }
+ *
+ * Each shard's serialized body is spliced in whole — the shard field goes
+ * in front of its first key — so nothing is parsed or written twice. A
+ * batch goes out when every registered shard has a tick pending, when the
+ * oldest pending tick has waited BatchWindow seconds, or when a shard sends
+ * again before its previous tick went out. Each result slice is handed to
+ * that shard's reply handler as if it were a lone /tick reply.
+ *
+ * The server keeps one economy per shard ID. Batches are JSON only: the
+ * binary format's name tables are per connection, not per shard.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "AgentETransport.h"
+
+class FAgentEUplink : public TSharedFromThis<FAgentEUplink, ESPMode::ThreadSafe>
+{
+public:
+    /** CompressAbove: gzip batches of at least this many bytes (< 0: never) */
+    FAgentEUplink(const FString& ServerUrl, float InBatchWindow, int32 InCompressAbove);
+    ~FAgentEUplink();
+
+    /** Game thread. Add a shard; false if the ID is already registered */
+    bool Register(const FString& ShardId, FAgentEReplyHandler Handler);
+
+    /** Game thread. Remove a shard; its pending tick is sent first */
+    void Unregister(const FString& ShardId);
+
+    int32 NumShards() const;
+
+    /** Any thread. Queue one JSON tick body for the next batch */
+    void SendTick(const FString& ShardId, const TArray<uint8>& Body);
+
+    /** Any thread. POST one JSON events body to /events, tagged with the shard */
+    void SendEvents(const FString& ShardId, const TArray<uint8>& Body);
+
+    /** Any thread. Send whatever is pending now */
+    void Flush();
+
+private:
+    struct FShard
+    {
+        FString Id;
+
+        /** `{"shard":"<Id>",` — what a spliced body starts with */
+        TArray<uint8> Prefix;
+        TSharedRef<FAgentEReplyHandler, ESPMode::ThreadSafe> Handler;
+        TArray<uint8> Pending;
+        bool bPending = false;
+    };
+
+    FString BatchUrl;
+    FString EventsUrl;
+    double BatchWindow;
+    int32 CompressAbove;
+
+    mutable FCriticalSection Lock;
+    TArray<FShard> Shards;
+    int32 NumPending = 0;
+    double OldestPendingTime = 0.0;
+
+    /** Frame and gzip buffers, reused between batches */
+    TArray<uint8> Frame;
+    TArray<uint8> Compressed;
+
+    FTSTicker::FDelegateHandle FlushHandle;
+
+    bool TickFlush(float DeltaTime);
+};
+
+/**
+ * What a UAgentEClient with bUseSharedUplink sends through: its ticks and
+ * events go to the uplink under its shard ID, replies come back from the
+ * slice of the batch reply that carries it. JSON only; compression is
+ * left to the uplink, which gzips whole batches.
+ */
+class FAgentEShardTransport : public IAgentETransport
+{
+public:
+    FAgentEShardTransport(TSharedRef<FAgentEUplink, ESPMode::ThreadSafe> InUplink, const FString& InShardId)
+        : Uplink(MoveTemp(InUplink))
+        , ShardId(InShardId)
+    {
+    }
+
+    virtual void Shutdown() override;
+    virtual void SendTick(const TArray<uint8>& Body, bool bGzip) override;
+    virtual void SendEvents(const TArray<uint8>& Body) override;
+
+    const FString& GetShardId() const { return ShardId; }
+
+private:
+    TSharedRef<FAgentEUplink, ESPMode::ThreadSafe> Uplink;
+    FString ShardId;
+};
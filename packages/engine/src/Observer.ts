@@ -28,7 +28,15 @@ export class Observer {
 
     const tick = state.tick;
     const roles = Object.values(state.agentRoles);
-    const totalAgents = Object.keys(state.agentBalances).length;
+    const sampling = state.sampling;
+    const aggregates = state.aggregates;
+    const totalAgents = aggregates?.population ?? sampling?.population ?? Object.keys(state.agentBalances).length;
+
+    // Sampled state: each agent record stands for 1 / (its role's rate) agents
+    const weightOf = (agentId: string): number => {
+      const rate = sampling?.rateByRole[state.agentRoles[agentId] ?? ''];
+      return rate !== undefined && rate > 0 ? 1 / rate : 1;
+    };
 
     // ── Event classification (single pass, per-currency) ──
     let productionAmount = 0;
@@ -118,12 +126,26 @@ export class Observer {
     // ── Per-currency supply ──
     const totalSupplyByCurrency: Record<string, number> = {};
     const balancesByCurrency: Record<string, number[]> = {};
-
-    for (const [_agentId, balances] of Object.entries(state.agentBalances)) {
-      for (const [curr, bal] of Object.entries(balances)) {
-        totalSupplyByCurrency[curr] = (totalSupplyByCurrency[curr] ?? 0) + bal;
-        if (!balancesByCurrency[curr]) balancesByCurrency[curr] = [];
-        balancesByCurrency[curr]!.push(bal);
+    const weightedBalancesByCurrency: Record<string, WeightedValue[]> = {};
+
+    if (aggregates) {
+      Object.assign(totalSupplyByCurrency, aggregates.supplyByCurrency);
+    } else if (sampling) {
+      for (const [agentId, balances] of Object.entries(state.agentBalances)) {
+        const weight = weightOf(agentId);
+        for (const [curr, bal] of Object.entries(balances)) {
+          if (!weightedBalancesByCurrency[curr]) weightedBalancesByCurrency[curr] = [];
+          weightedBalancesByCurrency[curr]!.push({ value: bal, weight });
+        }
+      }
+      Object.assign(totalSupplyByCurrency, sampling.supplyByCurrency);
+    } else {
+      for (const [_agentId, balances] of Object.entries(state.agentBalances)) {
+        for (const [curr, bal] of Object.entries(balances)) {
+          totalSupplyByCurrency[curr] = (totalSupplyByCurrency[curr] ?? 0) + bal;
+          if (!balancesByCurrency[curr]) balancesByCurrency[curr] = [];
+          balancesByCurrency[curr]!.push(bal);
+        }
       }
     }
 
@@ -156,20 +178,37 @@ export class Observer {
     const meanMedianDivergenceByCurrency: Record<string, number> = {};
 
     for (const curr of currencies) {
-      const bals = balancesByCurrency[curr] ?? [];
-      const sorted = [...bals].sort((a, b) => a - b);
       const supply = totalSupplyByCurrency[curr] ?? 0;
-      const count = sorted.length;
-
-      const median = computeMedian(sorted);
-      const mean = count > 0 ? supply / count : 0;
-      const top10Idx = Math.floor(count * 0.9);
-      const top10Sum = sorted.slice(top10Idx).reduce((s, b) => s + b, 0);
+      let median: number;
+      let mean: number;
+
+      if (aggregates) {
+        // Computed by the client over every agent
+        median = aggregates.medianBalanceByCurrency[curr] ?? 0;
+        mean = totalAgents > 0 ? supply / totalAgents : 0;
+        giniCoefficientByCurrency[curr] = aggregates.giniByCurrency[curr] ?? 0;
+        top10PctShareByCurrency[curr] = aggregates.top10PctShareByCurrency[curr] ?? 0;
+      } else if (sampling) {
+        // Estimates over the whole population from the weighted sample
+        const sorted = [...(weightedBalancesByCurrency[curr] ?? [])].sort((a, b) => a.value - b.value);
+        const holders = sorted.reduce((s, b) => s + b.weight, 0);
+        median = computeWeightedMedian(sorted, holders);
+        mean = holders > 0 ? supply / holders : 0;
+        giniCoefficientByCurrency[curr] = computeWeightedGini(sorted);
+        top10PctShareByCurrency[curr] = computeWeightedTopShare(sorted, holders, 0.1);
+      } else {
+        const sorted = [...(balancesByCurrency[curr] ?? [])].sort((a, b) => a - b);
+        const count = sorted.length;
+        median = computeMedian(sorted);
+        mean = count > 0 ? supply / count : 0;
+        const top10Idx = Math.floor(count * 0.9);
+        const top10Sum = sorted.slice(top10Idx).reduce((s, b) => s + b, 0);
+        giniCoefficientByCurrency[curr] = computeGini(sorted);
+        top10PctShareByCurrency[curr] = supply > 0 ? top10Sum / supply : 0;
+      }
 
-      giniCoefficientByCurrency[curr] = computeGini(sorted);
       medianBalanceByCurrency[curr] = median;
       meanBalanceByCurrency[curr] = mean;
-      top10PctShareByCurrency[curr] = supply > 0 ? top10Sum / supply : 0;
       meanMedianDivergenceByCurrency[curr] = median > 0 ? Math.abs(mean - median) / median : 0;
     }
 
@@ -198,8 +237,13 @@ export class Observer {
     // ── Population ──
     const populationByRole: Record<string, number> = {};
     const roleShares: Record<string, number> = {};
-    for (const role of roles) {
-      populationByRole[role] = (populationByRole[role] ?? 0) + 1;
+    const exactPopulationByRole = aggregates?.populationByRole ?? sampling?.populationByRole;
+    if (exactPopulationByRole) {
+      Object.assign(populationByRole, exactPopulationByRole);
+    } else {
+      for (const role of roles) {
+        populationByRole[role] = (populationByRole[role] ?? 0) + 1;
+      }
     }
     for (const [role, count] of Object.entries(populationByRole)) {
       roleShares[role] = count / Math.max(1, totalAgents);
@@ -256,9 +300,15 @@ export class Observer {
 
     // Supply from agent inventories
     const supplyByResource: Record<string, number> = {};
-    for (const inv of Object.values(state.agentInventories)) {
-      for (const [resource, qty] of Object.entries(inv)) {
-        supplyByResource[resource] = (supplyByResource[resource] ?? 0) + qty;
+    const exactSupplyByResource = aggregates?.supplyByResource ?? sampling?.supplyByResource;
+    if (exactSupplyByResource) {
+      Object.assign(supplyByResource, exactSupplyByResource);
+    } else {
+      for (const [agentId, inv] of Object.entries(state.agentInventories)) {
+        const weight = sampling ? weightOf(agentId) : 1;
+        for (const [resource, qty] of Object.entries(inv)) {
+          supplyByResource[resource] = (supplyByResource[resource] ?? 0) + qty * weight;
+        }
       }
     }
 
@@ -291,13 +341,28 @@ export class Observer {
       maxPossibleProduction > 0 ? productionIndex / maxPossibleProduction : 0;
 
     // ── Satisfaction ──
-    const satisfactions = Object.values(state.agentSatisfaction ?? {});
-    const avgSatisfaction =
-      satisfactions.length > 0
-        ? satisfactions.reduce((s, v) => s + v, 0) / satisfactions.length
-        : 80;
-
-    const blockedAgentCount = satisfactions.filter(s => s < 20).length;
+    let avgSatisfaction: number;
+    let blockedAgentCount: number;
+    if (sampling) {
+      let weightSum = 0;
+      let satisfactionSum = 0;
+      let blockedWeight = 0;
+      for (const [agentId, sat] of Object.entries(state.agentSatisfaction ?? {})) {
+        const weight = weightOf(agentId);
+        weightSum += weight;
+        satisfactionSum += sat * weight;
+        if (sat < 20) blockedWeight += weight;
+      }
+      avgSatisfaction = weightSum > 0 ? satisfactionSum / weightSum : 80;
+      blockedAgentCount = Math.round(blockedWeight);
+    } else {
+      const satisfactions = Object.values(state.agentSatisfaction ?? {});
+      avgSatisfaction =
+        satisfactions.length > 0
+          ? satisfactions.reduce((s, v) => s + v, 0) / satisfactions.length
+          : 80;
+      blockedAgentCount = satisfactions.filter(s => s < 20).length;
+    }
     const timeToValue = totalAgents > 0 ? blockedAgentCount / totalAgents * 100 : 0;
 
     // ── Per-currency pools ──
@@ -493,6 +558,12 @@ export class Observer {
 
 // ── Math helpers ──────────────────────────────────────────────────────────────
 
+/** A sampled value standing for `weight` agents. */
+interface WeightedValue {
+  value: number;
+  weight: number;
+}
+
 function computeMedian(sorted: number[]): number {
   if (sorted.length === 0) return 0;
   const mid = Math.floor(sorted.length / 2);
@@ -512,3 +583,50 @@ function computeGini(sorted: number[]): number {
   }
   return Math.min(1, Math.abs(numerator) / (n * sum));
 }
+
+// Weighted forms of the above, over values sorted ascending. With every
+// weight 1 they give the same results as computeMedian / computeGini.
+
+function computeWeightedMedian(sorted: WeightedValue[], totalWeight: number): number {
+  if (sorted.length === 0 || totalWeight <= 0) return 0;
+  const half = totalWeight / 2;
+  let cumulative = 0;
+  for (let i = 0; i < sorted.length; i++) {
+    cumulative += sorted[i]!.weight;
+    if (cumulative > half) return sorted[i]!.value;
+    if (cumulative === half) return (sorted[i]!.value + (sorted[i + 1]?.value ?? sorted[i]!.value)) / 2;
+  }
+  return sorted[sorted.length - 1]!.value;
+}
+
+function computeWeightedGini(sorted: WeightedValue[]): number {
+  let totalWeight = 0;
+  let sum = 0;
+  for (const { value, weight } of sorted) {
+    totalWeight += weight;
+    sum += value * weight;
+  }
+  if (totalWeight === 0 || sum === 0) return 0;
+  // 1 − area under the Lorenz curve × 2, by trapezoids
+  let cumulative = 0;
+  let area = 0;
+  for (const { value, weight } of sorted) {
+    area += weight * (2 * cumulative + value * weight);
+    cumulative += value * weight;
+  }
+  return Math.min(1, Math.abs(1 - area / (totalWeight * sum)));
+}
+
+/** Share of the sample's weighted total held by the richest `fraction` of agents */
+function computeWeightedTopShare(sorted: WeightedValue[], totalWeight: number, fraction: number): number {
+  const sum = sorted.reduce((s, b) => s + b.value * b.weight, 0);
+  if (sum <= 0) return 0;
+  let remaining = totalWeight * fraction;
+  let top = 0;
+  for (let i = sorted.length - 1; i >= 0 && remaining > 0; i--) {
+    const take = Math.min(sorted[i]!.weight, remaining);
+    top += sorted[i]!.value * take;
+    remaining -= take;
+  }
+  return top / sum;
+}
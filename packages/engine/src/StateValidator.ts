@@ -294,6 +294,74 @@ export function validateEconomyState(state: unknown): ValidationResult {
     }
   }
 
+  // ── Optional: sampling ── { population, rateByRole, populationByRole, supplyByCurrency, supplyByResource? }
+  if (s['sampling'] !== undefined) {
+    if (isRecord(s['sampling'])) {
+      const sampling = s['sampling'] as Record<string, unknown>;
+      if (!isNonNegativeInteger(sampling['population'])) {
+        errors.push({
+          path: 'sampling.population',
+          expected: 'non-negative integer',
+          received: describeValue(sampling['population']),
+          message: 'sampling.population must be a non-negative integer',
+        });
+      }
+      validateNumberMap(errors, sampling['rateByRole'], 'sampling.rateByRole', roles,
+        v => v > 0 && v <= 1, 'number in (0, 1]');
+      validateNumberMap(errors, sampling['populationByRole'], 'sampling.populationByRole', roles,
+        v => Number.isInteger(v) && v >= 0, 'non-negative integer');
+      validateNumberMap(errors, sampling['supplyByCurrency'], 'sampling.supplyByCurrency', currencies,
+        v => v >= 0, 'number >= 0');
+      if (sampling['supplyByResource'] !== undefined) {
+        validateNumberMap(errors, sampling['supplyByResource'], 'sampling.supplyByResource', resources,
+          v => v >= 0, 'number >= 0');
+      }
+    } else {
+      errors.push({
+        path: 'sampling',
+        expected: 'object | undefined',
+        received: describeValue(s['sampling']),
+        message: 'sampling must be an object if provided',
+      });
+    }
+  }
+
+  // ── Optional: aggregates ── client-computed PreAggregates
+  if (s['aggregates'] !== undefined) {
+    if (isRecord(s['aggregates'])) {
+      const aggregates = s['aggregates'] as Record<string, unknown>;
+      if (!isNonNegativeInteger(aggregates['population'])) {
+        errors.push({
+          path: 'aggregates.population',
+          expected: 'non-negative integer',
+          received: describeValue(aggregates['population']),
+          message: 'aggregates.population must be a non-negative integer',
+        });
+      }
+      const nonNegative = (v: number) => v >= 0;
+      const share = (v: number) => v >= 0 && v <= 1;
+      validateNumberMap(errors, aggregates['populationByRole'], 'aggregates.populationByRole', roles,
+        v => Number.isInteger(v) && v >= 0, 'non-negative integer');
+      validateNumberMap(errors, aggregates['supplyByCurrency'], 'aggregates.supplyByCurrency', currencies,
+        nonNegative, 'number >= 0');
+      validateNumberMap(errors, aggregates['giniByCurrency'], 'aggregates.giniByCurrency', currencies,
+        share, 'number in [0, 1]');
+      validateNumberMap(errors, aggregates['medianBalanceByCurrency'], 'aggregates.medianBalanceByCurrency', currencies,
+        nonNegative, 'number >= 0');
+      validateNumberMap(errors, aggregates['top10PctShareByCurrency'], 'aggregates.top10PctShareByCurrency', currencies,
+        share, 'number in [0, 1]');
+      validateNumberMap(errors, aggregates['supplyByResource'], 'aggregates.supplyByResource', resources,
+        nonNegative, 'number >= 0');
+    } else {
+      errors.push({
+        path: 'aggregates',
+        expected: 'object | undefined',
+        received: describeValue(s['aggregates']),
+        message: 'aggregates must be an object if provided',
+      });
+    }
+  }
+
   // ── Warnings ──
 
   // Currency declared but no agent holds it
@@ -372,6 +440,44 @@ export function validateEconomyState(state: unknown): ValidationResult {
 
 // ── Helpers ──────────────────────────────────────────────────────────────────
 
+/** Record<string, number> whose keys come from `keys` (when non-empty) and values pass `ok`. */
+function validateNumberMap(
+  errors: ValidationError[],
+  value: unknown,
+  path: string,
+  keys: Set<string>,
+  ok: (v: number) => boolean,
+  expected: string,
+): void {
+  if (!isRecord(value)) {
+    errors.push({
+      path,
+      expected: 'Record<string, number>',
+      received: describeValue(value),
+      message: `${path} must be a Record<string, number>`,
+    });
+    return;
+  }
+  for (const [key, v] of Object.entries(value as Record<string, unknown>)) {
+    if (keys.size > 0 && !keys.has(key)) {
+      errors.push({
+        path: `${path}.${key}`,
+        expected: `one of [${[...keys].join(', ')}]`,
+        received: key,
+        message: `${path} key "${key}" is not declared`,
+      });
+    }
+    if (typeof v !== 'number' || !ok(v)) {
+      errors.push({
+        path: `${path}.${key}`,
+        expected,
+        received: describeValue(v),
+        message: `${path}.${key} must be a ${expected}`,
+      });
+    }
+  }
+}
+
 function isRecord(value: unknown): boolean {
   return value !== null && typeof value === 'object' && !Array.isArray(value);
 }
@@ -391,6 +391,38 @@ export interface EconomyState {
   sources?: string[];                                        // named faucet sources
   sinks?: string[];                                          // named sink channels
   customData?: Record<string, unknown>;
+  sampling?: SamplingInfo;                                   // present when agent maps hold a sample
+  aggregates?: PreAggregates;                                // client-computed, used in place of agent loops
+}
+
+/**
+ * Sent when the per-agent maps carry a stratified sample of the population
+ * instead of every agent. Totals and counts are exact (computed by the
+ * client over all agents); distribution metrics are estimated from the
+ * sample, each sampled agent standing for 1 / rateByRole[role] agents.
+ */
+export interface SamplingInfo {
+  population: number;                                        // agents in the whole economy
+  rateByRole: Record<string, number>;                        // role → fraction sampled, (0, 1]
+  populationByRole: Record<string, number>;                  // exact role → agent count
+  supplyByCurrency: Record<string, number>;                  // exact currency → total balance
+  supplyByResource?: Record<string, number>;                 // exact resource → total held
+}
+
+/**
+ * Distribution aggregates the client computed over all of its agents. When
+ * present, the Observer takes them as-is instead of looping over the agent
+ * maps, which may then be sampled. Same definitions as the Observer's own:
+ * Gini, median and top-10% share over each currency's sorted balances.
+ */
+export interface PreAggregates {
+  population: number;
+  populationByRole: Record<string, number>;
+  supplyByCurrency: Record<string, number>;
+  giniByCurrency: Record<string, number>;                    // [0, 1]
+  medianBalanceByCurrency: Record<string, number>;
+  top10PctShareByCurrency: Record<string, number>;           // [0, 1]
+  supplyByResource: Record<string, number>;
 }
 
 export interface EconomyAdapter {
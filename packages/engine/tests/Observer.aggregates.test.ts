@@ -0,0 +1,76 @@
+import { describe, it, expect } from 'vitest';
+import { Observer } from '../src/Observer.js';
+import type { EconomyState } from '../src/types.js';
+
+function fullState(): EconomyState {
+  return {
+    tick: 3,
+    roles: ['consumer', 'producer'],
+    resources: ['ore'],
+    currencies: ['gold', 'gems'],
+    agentBalances: {
+      a1: { gold: 10, gems: 1 }, a2: { gold: 30, gems: 0 }, a3: { gold: 60, gems: 4 }, a4: { gold: 100, gems: 5 },
+    },
+    agentRoles: { a1: 'consumer', a2: 'consumer', a3: 'producer', a4: 'producer' },
+    agentInventories: { a1: { ore: 1 }, a2: {}, a3: { ore: 5 }, a4: { ore: 2 } },
+    marketPrices: { gold: { ore: 4 }, gems: { ore: 1 } },
+    recentTransactions: [],
+  };
+}
+
+describe('Observer — pre-aggregated state', () => {
+  it('produces the same metrics from the block as from the agent maps', () => {
+    const full = new Observer().compute(fullState(), []);
+
+    const state: EconomyState = {
+      ...fullState(),
+      agentBalances: {},
+      agentRoles: {},
+      agentInventories: {},
+      aggregates: {
+        population: full.totalAgents,
+        populationByRole: full.populationByRole,
+        supplyByCurrency: full.totalSupplyByCurrency,
+        giniByCurrency: full.giniCoefficientByCurrency,
+        medianBalanceByCurrency: full.medianBalanceByCurrency,
+        top10PctShareByCurrency: full.top10PctShareByCurrency,
+        supplyByResource: full.supplyByResource,
+      },
+    };
+    const m = new Observer().compute(state, []);
+
+    expect(m.totalAgents).toBe(4);
+    expect(m.totalSupplyByCurrency).toEqual(full.totalSupplyByCurrency);
+    expect(m.giniCoefficient).toBe(full.giniCoefficient);
+    expect(m.medianBalanceByCurrency).toEqual(full.medianBalanceByCurrency);
+    expect(m.meanBalanceByCurrency).toEqual(full.meanBalanceByCurrency);
+    expect(m.top10PctShare).toBe(full.top10PctShare);
+    expect(m.populationByRole).toEqual({ consumer: 2, producer: 2 });
+    expect(m.supplyByResource).toEqual({ ore: 8 });
+  });
+
+  it('prefers the block over sampled estimates', () => {
+    const state: EconomyState = {
+      ...fullState(),
+      sampling: {
+        population: 400,
+        rateByRole: { consumer: 0.01, producer: 0.01 },
+        populationByRole: { consumer: 200, producer: 200 },
+        supplyByCurrency: { gold: 1, gems: 1 },
+      },
+      aggregates: {
+        population: 400,
+        populationByRole: { consumer: 200, producer: 200 },
+        supplyByCurrency: { gold: 20000, gems: 1000 },
+        giniByCurrency: { gold: 0.4, gems: 0.5 },
+        medianBalanceByCurrency: { gold: 45, gems: 2 },
+        top10PctShareByCurrency: { gold: 0.3, gems: 0.35 },
+        supplyByResource: { ore: 800 },
+      },
+    };
+    const m = new Observer().compute(state, []);
+    expect(m.totalSupplyByCurrency['gold']).toBe(20000);
+    expect(m.giniCoefficientByCurrency['gold']).toBe(0.4);
+    expect(m.meanBalanceByCurrency['gold']).toBe(50);
+  });
+});
@@ -0,0 +1,68 @@
+import { describe, it, expect } from 'vitest';
+import { Observer } from '../src/Observer.js';
+import type { EconomyState } from '../src/types.js';
+
+// Four consumers (10, 10, 20, 20 gold) and one producer (100 gold)
+function fullState(): EconomyState {
+  return {
+    tick: 5,
+    roles: ['consumer', 'producer'],
+    resources: ['ore'],
+    currencies: ['gold'],
+    agentBalances: {
+      c1: { gold: 10 }, c2: { gold: 10 }, c3: { gold: 20 }, c4: { gold: 20 }, p1: { gold: 100 },
+    },
+    agentRoles: { c1: 'consumer', c2: 'consumer', c3: 'consumer', c4: 'consumer', p1: 'producer' },
+    agentInventories: { c1: {}, c2: {}, c3: {}, c4: {}, p1: { ore: 7 } },
+    agentSatisfaction: { c1: 10, c2: 10, c3: 90, c4: 90, p1: 50 },
+    marketPrices: { gold: { ore: 3 } },
+    recentTransactions: [],
+  };
+}
+
+// Half the consumers, all producers — each sampled consumer stands for two
+function sampledState(): EconomyState {
+  return {
+    ...fullState(),
+    agentBalances: { c1: { gold: 10 }, c3: { gold: 20 }, p1: { gold: 100 } },
+    agentRoles: { c1: 'consumer', c3: 'consumer', p1: 'producer' },
+    agentInventories: { c1: {}, c3: {}, p1: { ore: 7 } },
+    agentSatisfaction: { c1: 10, c3: 90, p1: 50 },
+    sampling: {
+      population: 5,
+      rateByRole: { consumer: 0.5, producer: 1 },
+      populationByRole: { consumer: 4, producer: 1 },
+      supplyByCurrency: { gold: 160 },
+      supplyByResource: { ore: 7 },
+    },
+  };
+}
+
+describe('Observer — sampled state', () => {
+  it('uses exact totals and role counts from the sampling block', () => {
+    const m = new Observer().compute(sampledState(), []);
+    expect(m.totalAgents).toBe(5);
+    expect(m.totalSupplyByCurrency['gold']).toBe(160);
+    expect(m.populationByRole).toEqual({ consumer: 4, producer: 1 });
+    expect(m.supplyByResource['ore']).toBe(7);
+    expect(m.meanBalance).toBe(32);
+  });
+
+  it('weighted distribution metrics match the full population when the sample is representative', () => {
+    const full = new Observer().compute(fullState(), []);
+    const sampled = new Observer().compute(sampledState(), []);
+    expect(sampled.giniCoefficientByCurrency['gold']).toBeCloseTo(full.giniCoefficientByCurrency['gold']!, 10);
+    expect(sampled.medianBalanceByCurrency['gold']).toBe(full.medianBalanceByCurrency['gold']);
+    expect(sampled.meanBalanceByCurrency['gold']).toBe(full.meanBalanceByCurrency['gold']);
+    expect(sampled.avgSatisfaction).toBeCloseTo(full.avgSatisfaction, 10);
+    expect(sampled.blockedAgentCount).toBe(full.blockedAgentCount);
+  });
+
+  it('estimates resource supply from weights when no exact totals are sent', () => {
+    const state = sampledState();
+    state.agentInventories = { c1: { ore: 1 }, c3: {}, p1: { ore: 7 } };
+    delete state.sampling!.supplyByResource;
+    const m = new Observer().compute(state, []);
+    expect(m.supplyByResource['ore']).toBe(9);
+  });
+});
@@ -110,4 +110,52 @@ describe('StateValidator', () => {
     expect(result.valid).toBe(true);
     expect(result.errors).toHaveLength(0);
   });
+
+  it('sampling block with exact totals → valid', () => {
+    const state = {
+      ...validMinimalState(),
+      sampling: {
+        population: 1000,
+        rateByRole: { Fighter: 0.05 },
+        populationByRole: { Fighter: 1000 },
+        supplyByCurrency: { gold: 25000 },
+      },
+    };
+    const result = validateEconomyState(state);
+    expect(result.valid).toBe(true);
+  });
+
+  it('sampling rate outside (0, 1] or unknown role → error', () => {
+    const state = {
+      ...validMinimalState(),
+      sampling: {
+        population: 10,
+        rateByRole: { Fighter: 0, Mage: 0.5 },
+        populationByRole: { Fighter: 10 },
+        supplyByCurrency: { gold: 1 },
+      },
+    };
+    const result = validateEconomyState(state);
+    expect(result.valid).toBe(false);
+    expect(result.errors.some(e => e.path === 'sampling.rateByRole.Fighter')).toBe(true);
+    expect(result.errors.some(e => e.path === 'sampling.rateByRole.Mage')).toBe(true);
+  });
+
+  it('aggregates with a Gini outside [0, 1] → error', () => {
+    const state = {
+      ...validMinimalState(),
+      aggregates: {
+        population: 3,
+        populationByRole: { Fighter: 3 },
+        supplyByCurrency: { gold: 30 },
+        giniByCurrency: { gold: 1.5 },
+        medianBalanceByCurrency: { gold: 10 },
+        top10PctShareByCurrency: { gold: 0.4 },
+        supplyByResource: {},
+      },
+    };
+    const result = validateEconomyState(state);
+    expect(result.valid).toBe(false);
+    expect(result.errors.map(e => e.path)).toEqual(['aggregates.giniByCurrency.gold']);
+  });
 });
@@ -2,13 +2,12 @@
 
 import * as http from 'node:http';
 import {
-  AgentE,
+  type AgentE,
   Observer,
   Diagnoser,
   ALL_PRINCIPLES,
   DEFAULT_THRESHOLDS,
   type AgentEConfig,
-  type EconomyAdapter,
   type EconomyState,
   type EconomicEvent,
   type Diagnosis,
@@ -17,6 +16,15 @@ import {
 } from '@agent-e/engine';
 import { createRouteHandler } from './routes.js';
 import { createWebSocketHandler, type WebSocketHandle } from './websocket.js';
+import type { DeltaBase } from './delta.js';
+import { NameDictionary } from './binary.js';
+import { Economy, type EconomyConfig, type EnrichedAdjustment, type TickOutcome } from './economy.js';
+import { ShardTable, alertBodies, processTickBatch, type BatchSliceResult } from './batch.js';
+import { BatchWorkerPool, defaultWorkerCount, workerEconomyConfig } from './workers.js';
+import { validateEvent } from './validation.js';
+import { createSharedMemoryListener, sharedMemoryAvailable, type SharedMemoryHandle } from './sharedMemory.js';
+
+export type { EnrichedAdjustment } from './economy.js';
 
 export interface ServerConfig {
   port?: number;
@@ -27,34 +35,64 @@ export interface ServerConfig {
   serveDashboard?: boolean;
   /** API key for authenticating mutation routes. When set, POST routes and WebSocket require `Authorization: Bearer <key>`. */
   apiKey?: string;
+  /**
+   * Worker threads for the shard economies of batched ticks (0, the
+   * default, ticks them on the server thread; 'auto' uses one per core
+   * but one). Needs the built package — the workers load dist/batchWorker.js.
+   */
+  batchWorkers?: number | 'auto';
+  /**
+   * Loopback port for the shared-memory transport (same-host game servers,
+   * Linux only — see sharedMemory.ts). Off when unset; 0 picks a free port.
+   */
+  sharedMemoryPort?: number;
 }
 
-export interface EnrichedAdjustment {
-  parameter: string;
-  value: number;
-  scope?: import('@agent-e/engine').ParameterScope;
-  reasoning: string;
+/** Status and body of an approve / reject — HTTP answers with them as-is. */
+export interface DecisionOutcome {
+  status: number;
+  body: Record<string, unknown>;
 }
 
-interface QueuedAdjustment {
-  key: string;
-  value: number;
-  scope: import('@agent-e/engine').ParameterScope | undefined;
+/** What GET /health and the WebSocket `health` message report, minus uptime. */
+export interface HealthSnapshot {
+  health: number;
+  tick: number;
+  mode: AgentEMode;
+  activePlans: number;
+  /** Weak validator — changes whenever any field above may have (uptime aside) */
+  etag: string;
 }
 
 export class AgentEServer {
+  /** The economy `/tick` and the WebSocket `tick` message drive. */
+  private readonly economy: Economy;
   private readonly agentE: AgentE;
+  /** Economies of batched multi-shard ticks, by shard ID — created on first tick, dropped when idle. */
+  private readonly shards = new ShardTable<Economy>((_id, economy) => economy.stop());
+  /** When set, shard economies live in worker threads instead of `shards`. */
+  private readonly batchPool: BatchWorkerPool | null;
+  private readonly economyConfig: EconomyConfig;
+  /** Locks and constraints set through /config, replayed onto shards created later. */
+  private readonly locked = new Set<string>();
+  private readonly constraints = new Map<string, { min: number; max: number }>();
+  /** Decisions approved and waiting on the tick lock, so a second approval can't apply them again */
+  private readonly applying = new Set<string>();
   private readonly server: http.Server;
-  private lastState: EconomyState | null = null;
-  private adjustmentQueue: QueuedAdjustment[] = [];
-  private alerts: Diagnosis[] = [];
-  /** Serialization lock for processTick — prevents concurrent ticks from corrupting shared state. */
-  private tickLock: Promise<void> = Promise.resolve();
+  /** Interned names for binary HTTP ticks (WebSocket connections keep their own). */
+  private readonly binaryDictionary = new NameDictionary();
+  /** The same for binary HTTP ticks naming a shard — each sender has its own table. */
+  private readonly shardDictionaries = new ShardTable<NameDictionary>();
   readonly port: number;
   private readonly host: string;
   private readonly thresholds: Thresholds;
   private readonly startedAt = Date.now();
   private wsHandle: WebSocketHandle | null = null;
+  private readonly sharedMemoryPort: number | undefined;
+  private shmHandle: SharedMemoryHandle | null = null;
+  /** Bumped on every tick and mode change — the version in the health ETag. */
+  private stateVersion = 0;
+  private healthCache: HealthSnapshot | null = null;
   readonly validateState: boolean;
   readonly corsOrigin: string;
   readonly serveDashboard: boolean;
@@ -67,55 +105,23 @@ export class AgentEServer {
     this.validateState = config.validateState ?? true;
     this.corsOrigin = config.corsOrigin ?? 'http://localhost:3100';
     this.serveDashboard = config.serveDashboard ?? true;
-
-    // Build a "remote" adapter — state comes from HTTP/WS, not polled
-    const adapter: EconomyAdapter = {
-      getState: () => {
-        if (!this.lastState) {
-          return {
-            tick: 0,
-            roles: [],
-            resources: [],
-            currencies: ['default'],
-            agentBalances: {},
-            agentRoles: {},
-            agentInventories: {},
-            marketPrices: {},
-            recentTransactions: [],
-          };
-        }
-        return this.lastState;
-      },
-      setParam: (key: string, value: number, scope?: import('@agent-e/engine').ParameterScope) => {
-        this.adjustmentQueue.push({ key, value, scope });
-      },
-    };
+    this.sharedMemoryPort = config.sharedMemoryPort;
 
     const agentECfg = config.agentE ?? {};
-    const agentEConfig: AgentEConfig = {
-      adapter,
-      mode: agentECfg.mode ?? 'autonomous',
-      gracePeriod: agentECfg.gracePeriod ?? 0,
-      checkInterval: agentECfg.checkInterval ?? 1,
-      ...(agentECfg.dominantRoles ? { dominantRoles: agentECfg.dominantRoles } : {}),
-      ...(agentECfg.idealDistribution ? { idealDistribution: agentECfg.idealDistribution } : {}),
-      ...(agentECfg.maxAdjustmentPercent !== undefined ? { maxAdjustmentPercent: agentECfg.maxAdjustmentPercent } : {}),
-      ...(agentECfg.cooldownTicks !== undefined ? { cooldownTicks: agentECfg.cooldownTicks } : {}),
-      ...(agentECfg.thresholds ? { thresholds: agentECfg.thresholds } : {}),
-    };
-
+    this.economyConfig = agentECfg;
     this.thresholds = {
       ...DEFAULT_THRESHOLDS,
       ...(agentECfg.thresholds ?? {}),
       ...(agentECfg.maxAdjustmentPercent !== undefined ? { maxAdjustmentPercent: agentECfg.maxAdjustmentPercent } : {}),
       ...(agentECfg.cooldownTicks !== undefined ? { cooldownTicks: agentECfg.cooldownTicks } : {}),
     };
-    this.agentE = new AgentE(agentEConfig);
+    this.economy = new Economy(agentECfg);
+    this.agentE = this.economy.agentE;
 
-    // Capture alerts during tick
-    this.agentE.on('alert', (diagnosis: unknown) => {
-      this.alerts.push(diagnosis as Diagnosis);
-    });
+    const workers = config.batchWorkers === 'auto' ? defaultWorkerCount() : Math.floor(config.batchWorkers ?? 0);
+    this.batchPool = workers > 0
+      ? new BatchWorkerPool(workers, { economyConfig: workerEconomyConfig(agentECfg), validateState: this.validateState })
+      : null;
 
     // V1.8.1: Forward LLM events to WebSocket clients
     this.agentE.on('narration', (n: unknown) => {
@@ -124,7 +130,7 @@ export class AgentEServer {
         narration: string;
         confidence: number;
       };
-      const tick = this.lastState?.tick ?? 0;
+      const tick = this.economy.getLastState()?.tick ?? 0;
       this.broadcast({
         type: 'narration',
         tick,
@@ -144,7 +150,7 @@ export class AgentEServer {
       };
       this.broadcast({
         type: 'explanation',
-        tick: this.lastState?.tick ?? 0,
+        tick: this.economy.getLastState()?.tick ?? 0,
         text: explanation.explanation,
         parameter: explanation.plan.parameter,
         direction: explanation.plan.targetValue > explanation.plan.currentValue ? 'increase' : 'decrease',
@@ -173,8 +179,6 @@ export class AgentEServer {
       });
     });
 
-    this.agentE.connect(adapter).start();
-
     // Create HTTP server
     const routeHandler = createRouteHandler(this);
     this.server = http.createServer(routeHandler);
@@ -184,6 +188,15 @@ export class AgentEServer {
     // Wire up WebSocket upgrade
     this.wsHandle = createWebSocketHandler(this.server, this);
 
+    if (this.sharedMemoryPort !== undefined) {
+      if (sharedMemoryAvailable()) {
+        this.shmHandle = await createSharedMemoryListener(this, this.sharedMemoryPort);
+        console.log(`[AgentE Server] Shared-memory transport on 127.0.0.1:${this.shmHandle.port}`);
+      } else {
+        console.warn('[AgentE Server] Shared-memory transport needs /dev/shm — not started');
+      }
+    }
+
     return new Promise((resolve) => {
       this.server.listen(this.port, this.host, () => {
         const addr = this.getAddress();
@@ -194,8 +207,11 @@ export class AgentEServer {
   }
 
   async stop(): Promise<void> {
-    this.agentE.stop();
+    this.economy.stop();
+    for (const shard of this.shards.values()) shard.stop();
+    if (this.batchPool) await this.batchPool.stop();
     if (this.wsHandle) this.wsHandle.cleanup();
+    if (this.shmHandle) await this.shmHandle.close();
     return new Promise((resolve, reject) => {
       this.server.close((err) => {
         if (err) reject(err);
@@ -216,82 +232,173 @@ export class AgentEServer {
     return { port: this.port, host: this.host };
   }
 
+  /** Port of the shared-memory doorbell listener; null when it isn't running. */
+  getSharedMemoryPort(): number | null {
+    return this.shmHandle?.port ?? null;
+  }
+
   getUptime(): number {
     return Date.now() - this.startedAt;
   }
 
   /**
-   * Process a tick with the given state.
-   * 1. Clear adjustment queue
-   * 2. Set state
-   * 3. Ingest events
-   * 4. Run agentE.tick(state)
-   * 5. Drain adjustment queue, enrich with reasoning from decisions
-   * 6. Return response
+   * Health fields, computed once per state version so frequent polling
+   * costs a cached object. The ETag includes the start time, so a restarted
+   * server never matches a validator from its previous run.
    */
-  async processTick(
-    state: EconomyState,
-    events?: EconomicEvent[],
-  ): Promise<{
-    adjustments: EnrichedAdjustment[];
-    alerts: Diagnosis[];
-    health: number;
-    tick: number;
-    decisions: ReturnType<AgentE['getDecisions']>;
-  }> {
-    // Serialize tick processing — concurrent HTTP + WS ticks would corrupt shared queues
-    const prev = this.tickLock;
-    let unlock: () => void;
-    this.tickLock = new Promise<void>(resolve => { unlock = resolve; });
-    await prev;
+  getHealthSnapshot(): HealthSnapshot {
+    if (!this.healthCache) {
+      this.healthCache = {
+        health: this.agentE.getHealth(),
+        tick: this.agentE.metrics.latest()?.tick ?? 0,
+        mode: this.agentE.getMode(),
+        activePlans: this.agentE.getActivePlans().length,
+        etag: `W/"${this.startedAt.toString(36)}-${this.stateVersion}"`,
+      };
+    }
+    return this.healthCache;
+  }
 
-    try {
-      // Clear queues
-      this.adjustmentQueue = [];
-      this.alerts = [];
-
-      // Set state
-      this.lastState = state;
-
-      // Ingest events
-      if (events) {
-        for (const event of events) {
-          this.agentE.ingest(event);
-        }
-      }
+  private invalidateHealth(): void {
+    this.stateVersion++;
+    this.healthCache = null;
+  }
 
-      // Run tick
-      await this.agentE.tick(state);
-
-      // Drain adjustments
-      const rawAdj = [...this.adjustmentQueue];
-      this.adjustmentQueue = [];
-
-      // Cross-reference with decision log to attach reasoning
-      const decisions = this.agentE.getDecisions({ since: state.tick, until: state.tick });
-
-      const adjustments: EnrichedAdjustment[] = rawAdj.map(adj => {
-        const decision = decisions.find(d =>
-          d.plan.parameter === adj.key && d.result === 'applied',
-        );
-        return {
-          parameter: adj.key,
-          value: adj.value,
-          ...(adj.scope ? { scope: adj.scope } : {}),
-          reasoning: decision?.diagnosis.violation.suggestedAction.reasoning ?? '',
-        };
-      });
+  /**
+   * Run a tick of the main economy — see Economy.processTick. Its
+   * adjustments and alerts are pushed to WebSocket subscribers too, except
+   * `source`, the connection whose tick reply already carries them.
+   */
+  async processTick(state: EconomyState, events?: EconomicEvent[], source?: object): Promise<TickOutcome> {
+    const result = await this.economy.processTick(state, events).finally(() => this.invalidateHealth());
+    this.pushAdjustments(result.adjustments, result.tick, { source: 'tick' }, source);
+    if (result.alerts.length > 0) {
+      this.push({ type: 'alert', tick: result.tick, alerts: alertBodies(result.alerts) }, source);
+    }
+    return result;
+  }
 
-      return {
-        adjustments,
-        alerts: [...this.alerts],
-        health: this.agentE.getHealth(),
-        tick: state.tick,
-        decisions,
-      };
+  /**
+   * Ingest a batch of streamed events between ticks, into the main economy
+   * or a shard's. Invalid events are skipped. Returns how many were accepted.
+   */
+  ingestEvents(events: unknown[], shard?: string): number {
+    if (shard !== undefined && this.batchPool) {
+      const valid = events.filter(validateEvent);
+      return this.batchPool.ingestEvents(shard, valid) ? valid.length : 0;
+    }
+    // Events alone never create a shard; its first tick does
+    const economy = shard === undefined ? this.economy : this.shards.get(shard);
+    return economy ? economy.ingestEvents(events) : 0;
+  }
+
+  /**
+   * The economy behind a shard ID, created (with the current mode, locks and
+   * constraints) on first use. Undefined once MAX_SHARDS are in use — see
+   * ShardTable for when idle ones make room.
+   */
+  getShard(id: string): Economy | undefined {
+    return this.shards.use(id, () => {
+      const shard = new Economy({ ...this.economyConfig, mode: this.agentE.getMode() });
+      for (const param of this.locked) shard.agentE.lock(param);
+      for (const [param, bounds] of this.constraints) shard.agentE.constrain(param, bounds);
+      return shard;
+    });
+  }
+
+  getShardCount(): number {
+    return this.batchPool ? this.batchPool.getShardCount() : this.shards.size;
+  }
+
+  /** Worker threads ticking shard economies; 0 when they tick on this thread. */
+  getBatchWorkerCount(): number {
+    return this.batchPool?.size ?? 0;
+  }
+
+  /**
+   * Run a batched multi-shard tick — one result per slice, in order. With
+   * batch workers, slices of different workers run in parallel.
+   */
+  processTickBatch(slices: unknown[]): Promise<BatchSliceResult[]> {
+    return this.batchPool ? this.batchPool.processTickBatch(slices) : processTickBatch(this, slices);
+  }
+
+  /**
+   * One shard's tick outside a batch — a /tick body, WebSocket `tick` or
+   * shared-memory frame naming a `shard`. Same path and result as a
+   * one-slice batch.
+   */
+  async processShardTick(slice: Record<string, unknown>): Promise<BatchSliceResult> {
+    return (await this.processTickBatch([slice]))[0]!;
+  }
+
+  /**
+   * Apply a recommendation the advisor held back — POST /approve and the
+   * WebSocket `approve` message.
+   */
+  async approveDecision(decisionId: string): Promise<DecisionOutcome> {
+    const refused = this.checkPending(decisionId);
+    if (refused) return refused;
+    const entry = this.agentE.log.getById(decisionId)!;
+    this.applying.add(decisionId);
+    let adjustments: EnrichedAdjustment[];
+    try {
+      adjustments = await this.economy.applyDecision(entry);
+      this.agentE.log.updateResult(decisionId, 'applied');
     } finally {
-      unlock!();
+      // Still pending if apply threw; either way the plans may have changed
+      this.applying.delete(decisionId);
+      this.invalidateHealth();
     }
+    this.broadcast({ type: 'advisor_action', action: 'approved', decisionId });
+    // Without the push the game would only learn of them from its next tick reply
+    this.pushAdjustments(adjustments, this.economy.getLastState()?.tick ?? 0, { source: 'approve', decisionId });
+    return { status: 200, body: { ok: true, parameter: entry.plan.parameter, value: entry.plan.targetValue } };
+  }
+
+  /** Drop a held-back recommendation — POST /reject and the WebSocket `reject` message. */
+  rejectDecision(decisionId: string, reason?: string): DecisionOutcome {
+    const refused = this.checkPending(decisionId);
+    if (refused) return refused;
+    this.agentE.log.updateResult(decisionId, 'rejected', reason);
+    this.broadcast({ type: 'advisor_action', action: 'rejected', decisionId, reason });
+    return { status: 200, body: { ok: true, decisionId } };
+  }
+
+  /** Why a decision can't be approved or rejected; null when it is pending */
+  private checkPending(decisionId: string): DecisionOutcome | null {
+    if (this.agentE.getMode() !== 'advisor') {
+      return { status: 400, body: { error: 'not_in_advisor_mode' } };
+    }
+    const entry = this.agentE.log.getById(decisionId);
+    if (!entry) {
+      return { status: 404, body: { error: 'decision_not_found' } };
+    }
+    if (this.applying.has(decisionId)) {
+      return { status: 409, body: { error: 'decision_not_pending', currentResult: 'applying' } };
+    }
+    if (entry.result !== 'skipped_override') {
+      return { status: 409, body: { error: 'decision_not_pending', currentResult: entry.result } };
+    }
+    return null;
+  }
+
+  getBinaryDictionary(): NameDictionary {
+    return this.binaryDictionary;
+  }
+
+  /** A shard's name table for binary HTTP ticks; undefined once MAX_SHARDS tables are in use. */
+  getShardBinaryDictionary(shard: string): NameDictionary | undefined {
+    return this.shardDictionaries.use(shard, () => new NameDictionary());
+  }
+
+  getDeltaBase(): DeltaBase | null {
+    return this.economy.getDeltaBase();
+  }
+
+  /** Main economy — see Economy.commitDeltaBase. */
+  commitDeltaBase(seq: number, state: EconomyState, fromDelta = false): void {
+    this.economy.commitDeltaBase(seq, state, fromDelta);
   }
 
   /**
@@ -321,23 +428,52 @@ export class AgentEServer {
     return { diagnoses, health };
   }
 
+  // Mode, locks and constraints apply to every economy, shards included
+
   setMode(mode: AgentEMode): void {
     this.agentE.setMode(mode);
+    for (const shard of this.shards.values()) shard.agentE.setMode(mode);
+    this.batchPool?.broadcast({ type: 'mode', mode });
+    this.invalidateHealth();
   }
 
   lock(param: string): void {
+    this.locked.add(param);
     this.agentE.lock(param);
+    for (const shard of this.shards.values()) shard.agentE.lock(param);
+    this.batchPool?.broadcast({ type: 'lock', param });
   }
 
   unlock(param: string): void {
+    this.locked.delete(param);
     this.agentE.unlock(param);
+    for (const shard of this.shards.values()) shard.agentE.unlock(param);
+    this.batchPool?.broadcast({ type: 'unlock', param });
   }
 
   constrain(param: string, bounds: { min: number; max: number }): void {
+    this.constraints.set(param, bounds);
     this.agentE.constrain(param, bounds);
+    for (const shard of this.shards.values()) shard.agentE.constrain(param, bounds);
+    this.batchPool?.broadcast({ type: 'constrain', param, bounds });
   }
 
   broadcast(data: Record<string, unknown>): void {
     if (this.wsHandle) this.wsHandle.broadcast(data);
   }
+
+  /** Send to the WebSocket connections that subscribed, all but `except`. */
+  push(data: Record<string, unknown>, except?: object): void {
+    if (this.wsHandle) this.wsHandle.push(data, except);
+  }
+
+  private pushAdjustments(
+    adjustments: EnrichedAdjustment[],
+    tick: number,
+    origin: Record<string, unknown>,
+    except?: object,
+  ): void {
+    if (adjustments.length === 0) return;
+    this.push({ type: 'adjustment', ...origin, tick, adjustments }, except);
+  }
 }
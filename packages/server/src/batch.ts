@@ -0,0 +1,261 @@
+// Batched multi-shard ticks — one request carries a tick for each of several
+// economies (zone servers sharing one client uplink), each tagged with its
+// shard ID. Every shard is its own economy with its own AgentE instance and
+// delta base. Slices are answered in one response; each result carries the
+// status and body a lone /tick would have returned. Shard economies live in
+// the server process, or spread over worker threads (see workers.ts).
+//
+// Wire shape (POST /tick/batch, or the WebSocket `tick_batch` message):
+//   { shards: [ { shard: "zone-1", state: {...}, seq: 3, events: [...] },
+//               { shard: "zone-2", delta: {...}, seq: 8, baseSeq: 7 } ] }
+//   → { results: [ { shard: "zone-1", status: 200, body: {...} }, ... ] }
+
+import { validateEconomyState, type Diagnosis, type EconomyState } from '@agent-e/engine';
+import type { Economy, TickOutcome } from './economy.js';
+import { resolveTickState } from './delta.js';
+import { validateEvent } from './validation.js';
+
+export const MAX_BATCH_SHARDS = 64;
+
+/**
+ * Most shard economies one server keeps. A tick for another new shard
+ * evicts the least recently used one if it has been idle SHARD_IDLE_MS, and
+ * is refused otherwise.
+ */
+export const MAX_SHARDS = 256;
+
+/** A shard not ticked for this long is dropped once a new shard is created. */
+export const SHARD_IDLE_MS = 10 * 60_000;
+
+/** Shard IDs: 1–64 of letters, digits and `_ . : -` */
+const SHARD_ID = /^[A-Za-z0-9_.:-]{1,64}$/;
+
+export function isShardId(v: unknown): v is string {
+  return typeof v === 'string' && SHARD_ID.test(v);
+}
+
+/** Whatever owns shard economies — the server itself, or a batch worker. */
+export interface ShardHost {
+  readonly validateState: boolean;
+  getShard(id: string): Economy | undefined;
+}
+
+/**
+ * Shard entries by ID in least-recently-used order, for whatever owns the
+ * shard IDs (the server, or the batch worker pool). Creating a shard first
+ * drops the ones idle at least `idleMs`, then refuses once `maxShards` are
+ * left. Dropped entries are passed to `onEvict`.
+ */
+export class ShardTable<T> {
+  private readonly entries = new Map<string, { value: T; lastUsed: number }>();
+
+  constructor(
+    private readonly onEvict: (id: string, value: T) => void = () => {},
+    private readonly maxShards: number = MAX_SHARDS,
+    private readonly idleMs: number = SHARD_IDLE_MS,
+  ) {}
+
+  get size(): number {
+    return this.entries.size;
+  }
+
+  /** An existing shard, marked as used; never creates one. */
+  get(id: string, now: number = Date.now()): T | undefined {
+    const entry = this.entries.get(id);
+    if (!entry) return undefined;
+    // Re-inserting keeps the map in last-use order
+    this.entries.delete(id);
+    entry.lastUsed = now;
+    this.entries.set(id, entry);
+    return entry.value;
+  }
+
+  /** An existing or new shard, marked as used; undefined when the table is full of active shards. */
+  use(id: string, create: () => T, now: number = Date.now()): T | undefined {
+    const existing = this.get(id, now);
+    if (existing !== undefined) return existing;
+    this.evictIdle(now);
+    if (this.entries.size >= this.maxShards) return undefined;
+    const value = create();
+    this.entries.set(id, { value, lastUsed: now });
+    return value;
+  }
+
+  /** Remove without calling onEvict. */
+  delete(id: string): void {
+    this.entries.delete(id);
+  }
+
+  keys(): IterableIterator<string> {
+    return this.entries.keys();
+  }
+
+  values(): T[] {
+    return [...this.entries.values()].map(e => e.value);
+  }
+
+  private evictIdle(now: number): void {
+    for (const [id, entry] of this.entries) {
+      if (now - entry.lastUsed < this.idleMs) break;
+      this.entries.delete(id);
+      this.onEvict(id, entry.value);
+    }
+  }
+}
+
+export interface BatchSliceResult {
+  /** Null when the slice had no usable shard ID */
+  shard: string | null;
+  status: number;
+  body: Record<string, unknown>;
+}
+
+export type ParsedBatch =
+  | { ok: true; slices: unknown[] }
+  | { ok: false; error: 'invalid_batch' | 'batch_too_large'; message: string };
+
+function isRecord(v: unknown): v is Record<string, unknown> {
+  return v !== null && typeof v === 'object' && !Array.isArray(v);
+}
+
+export function parseBatch(payload: unknown): ParsedBatch {
+  const slices = isRecord(payload) ? payload['shards'] : undefined;
+  if (!Array.isArray(slices) || slices.length === 0) {
+    return { ok: false, error: 'invalid_batch', message: 'Body must be { "shards": [...] } with at least one shard' };
+  }
+  if (slices.length > MAX_BATCH_SHARDS) {
+    return { ok: false, error: 'batch_too_large', message: `At most ${MAX_BATCH_SHARDS} shards per batch` };
+  }
+  return { ok: true, slices };
+}
+
+/** Alerts as tick replies and `alert` pushes carry them. */
+export function alertBodies(alerts: Diagnosis[]): Record<string, unknown>[] {
+  return alerts.map(a => ({
+    principleId: a.principle.id,
+    principleName: a.principle.name,
+    severity: a.violation.severity,
+    evidence: a.violation.evidence,
+    reasoning: a.violation.suggestedAction.reasoning,
+  }));
+}
+
+/** Body of a successful tick reply — the same for /tick and every batch slice. */
+export function tickReplyBody(
+  result: TickOutcome,
+  seq: number | undefined,
+  warnings: unknown[],
+): Record<string, unknown> {
+  return {
+    adjustments: result.adjustments,
+    alerts: alertBodies(result.alerts),
+    health: result.health,
+    tick: result.tick,
+    processingMs: result.processingMs,
+    ...(seq !== undefined ? { seq } : {}),
+    ...(warnings.length > 0 ? { validationWarnings: warnings } : {}),
+  };
+}
+
+/** What a tick runs against — a shard's Economy, or the server's main economy. */
+export type TickTarget = Pick<Economy, 'getDeltaBase' | 'commitDeltaBase' | 'processTick'>;
+
+/**
+ * Run one tick payload (a batch slice, or a /tick body) against an economy;
+ * errors become the result, with the status /tick would have answered.
+ */
+export async function processSlice(
+  economy: TickTarget,
+  slice: Record<string, unknown>,
+  validateState: boolean,
+): Promise<{ status: number; body: Record<string, unknown> }> {
+  const resolved = resolveTickState(slice, economy.getDeltaBase());
+  if (!resolved.ok) {
+    return resolved.error === 'delta_base_mismatch'
+      ? { status: 409, body: { error: resolved.error, expectedBaseSeq: resolved.expectedBaseSeq } }
+      : { status: 400, body: { error: resolved.error, message: resolved.message } };
+  }
+  const state = resolved.state;
+
+  const validation = validateState ? validateEconomyState(state) : null;
+  if (validation && !validation.valid) {
+    return { status: 400, body: { error: 'invalid_state', validationErrors: validation.errors } };
+  }
+  if (resolved.seq !== undefined) {
+    economy.commitDeltaBase(resolved.seq, state as EconomyState, resolved.delta);
+  }
+
+  const events = slice['events'];
+  const validEvents = Array.isArray(events) ? (events as unknown[]).filter(validateEvent) : undefined;
+  const result = await economy.processTick(state as EconomyState, validEvents);
+  return { status: 200, body: tickReplyBody(result, resolved.seq, validation?.warnings ?? []) };
+}
+
+export interface AdmittedSlice {
+  /** Position in the batch — where the slice's result goes */
+  index: number;
+  shard: string;
+  slice: Record<string, unknown>;
+}
+
+/**
+ * Check the shard ID of every slice. Rejected slices get their result
+ * filled in; the rest are returned for processing. `admit` says whether a
+ * (valid, not duplicated) shard may be ticked — false once MAX_SHARDS exist.
+ */
+export function admitSlices(
+  slices: unknown[],
+  admit: (shard: string) => boolean,
+): { results: BatchSliceResult[]; admitted: AdmittedSlice[] } {
+  const results: BatchSliceResult[] = new Array(slices.length);
+  const admitted: AdmittedSlice[] = [];
+  const seen = new Set<string>();
+
+  slices.forEach((slice, index) => {
+    const shard = isRecord(slice) ? slice['shard'] : undefined;
+    if (!isRecord(slice) || !isShardId(shard)) {
+      results[index] = { shard: null, status: 400, body: { error: 'invalid_shard', message: 'Each slice needs a "shard" ID (1-64 of A-Z a-z 0-9 _ . : -)' } };
+      return;
+    }
+    if (seen.has(shard)) {
+      results[index] = { shard, status: 400, body: { error: 'duplicate_shard' } };
+      return;
+    }
+    seen.add(shard);
+    if (!admit(shard)) {
+      results[index] = { shard, status: 503, body: { error: 'too_many_shards', maxShards: MAX_SHARDS } };
+      return;
+    }
+    admitted.push({ index, shard, slice });
+  });
+  return { results, admitted };
+}
+
+/** Run admitted slices on a host's economies, in order. A failing slice never fails the rest. */
+export async function runSlices(host: ShardHost, admitted: AdmittedSlice[]): Promise<BatchSliceResult[]> {
+  const results: BatchSliceResult[] = [];
+  for (const { shard, slice } of admitted) {
+    const economy = host.getShard(shard);
+    if (!economy) {
+      results.push({ shard, status: 503, body: { error: 'too_many_shards', maxShards: MAX_SHARDS } });
+      continue;
+    }
+    try {
+      results.push({ shard, ...(await processSlice(economy, slice, host.validateState)) });
+    } catch {
+      results.push({ shard, status: 500, body: { error: 'tick_failed' } });
+    }
+  }
+  return results;
+}
+
+/**
+ * Run every slice against its shard's economy on this thread, in order.
+ * A bad slice gets an error result; it never fails the rest of the batch.
+ */
+export async function processTickBatch(host: ShardHost, slices: unknown[]): Promise<BatchSliceResult[]> {
+  const { results, admitted } = admitSlices(slices, () => true);
+  const processed = await runSlices(host, admitted);
+  admitted.forEach((a, i) => { results[a.index] = processed[i]!; });
+  return results;
+}
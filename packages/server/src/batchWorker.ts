@@ -0,0 +1,63 @@
+// Batch worker entry point — hosts the shard economies the pool pins to
+// this thread and ticks them as the main thread sends slices (see workers.ts).
+
+import { parentPort, workerData } from 'node:worker_threads';
+import { Economy } from './economy.js';
+import { runSlices, type ShardHost } from './batch.js';
+import type { BatchWorkerData, BatchWorkerReply, BatchWorkerRequest } from './workers.js';
+
+const { economyConfig, validateState } = workerData as BatchWorkerData;
+
+const shards = new Map<string, Economy>();
+let mode = economyConfig.mode;
+const locked = new Set<string>();
+const constraints = new Map<string, { min: number; max: number }>();
+
+// The main thread caps how many shards exist and says when one is dropped;
+// here every shard is created on its first tick
+const host: ShardHost = {
+  validateState,
+  getShard(id: string): Economy {
+    let shard = shards.get(id);
+    if (shard) return shard;
+    shard = new Economy({ ...economyConfig, ...(mode ? { mode } : {}) });
+    for (const param of locked) shard.agentE.lock(param);
+    for (const [param, bounds] of constraints) shard.agentE.constrain(param, bounds);
+    shards.set(id, shard);
+    return shard;
+  },
+};
+
+parentPort!.on('message', async (msg: BatchWorkerRequest) => {
+  switch (msg.type) {
+    case 'tick': {
+      const results = await runSlices(host, msg.slices.map((s, index) => ({ index, ...s })));
+      const reply: BatchWorkerReply = { id: msg.id, results };
+      parentPort!.postMessage(reply);
+      break;
+    }
+    case 'events':
+      shards.get(msg.shard)?.ingestEvents(msg.events);
+      break;
+    case 'evict':
+      shards.get(msg.shard)?.stop();
+      shards.delete(msg.shard);
+      break;
+    case 'mode':
+      mode = msg.mode;
+      for (const shard of shards.values()) shard.agentE.setMode(msg.mode);
+      break;
+    case 'lock':
+      locked.add(msg.param);
+      for (const shard of shards.values()) shard.agentE.lock(msg.param);
+      break;
+    case 'unlock':
+      locked.delete(msg.param);
+      for (const shard of shards.values()) shard.agentE.unlock(msg.param);
+      break;
+    case 'constrain':
+      constraints.set(msg.param, msg.bounds);
+      for (const shard of shards.values()) shard.agentE.constrain(msg.param, msg.bounds);
+      break;
+  }
+});
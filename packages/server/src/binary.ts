@@ -0,0 +1,290 @@
+// Binary (MessagePack) tick wire format.
+//
+// Negotiation:
+//   HTTP       — `Content-Type: application/x-msgpack` on POST /tick; the reply
+//                is MessagePack too when `Accept` includes it.
+//   WebSocket  — subprotocol `agente.msgpack.v1`; binary frames are MessagePack,
+//                text frames stay JSON.
+//
+// Names (agents, roles, resources, currencies, event actors) are interned:
+// each string is sent once in a `dict` section and referenced by index after
+// that. Per-agent values travel as little-endian column blobs, one per
+// currency / resource, instead of nested maps.
+//
+//   {
+//     dict?: { e: epoch, b: base, n: [names...] },   // appends n at index b
+//     seq?, tick,
+//     shard?,                                         // a shard's economy, not the main one
+//     roles: [id], resources: [id], currencies: [id], agents: [id],
+//     agentRoles: bin(u16 × agents),                  // index into roles
+//     balances: [bin(f64 × agents)] per currency,
+//     inventories: [bin(f64 × agents)] per resource,   // zeros dropped
+//     prices: [bin(f64 × resources)] per currency,
+//     events?: [{ y, ts, a, r?, res?, c?, amt?, p?, f?, to? }]  // name fields are ids
+//     sampling?: {                                    // agents above are a sample
+//       n: population,
+//       rate: bin(f64 × roles), count: bin(f64 × roles),
+//       supply: bin(f64 × currencies), stock?: bin(f64 × resources),
+//     }
+//     aggregates?: {                                  // client-computed, all agents
+//       n: population, count: bin(f64 × roles),
+//       supply, gini, median, top10: bin(f64 × currencies),
+//       stock: bin(f64 × resources),
+//     }
+//   }
+
+import type { EconomyState, EconomicEvent, PreAggregates, SamplingInfo } from '@agent-e/engine';
+import { decode } from './msgpack.js';
+
+export const MSGPACK_CONTENT_TYPE = 'application/x-msgpack';
+export const MSGPACK_SUBPROTOCOL = 'agente.msgpack.v1';
+
+/**
+ * Names become object keys of the decoded state (agent IDs, currencies, ...),
+ * so the keys sanitizeJson strips from JSON bodies are refused here.
+ */
+export function isReservedName(name: string): boolean {
+  return name === '__proto__' || name === 'constructor' || name === 'prototype';
+}
+
+/** Session name table. HTTP has one per shard (and one for the main economy); each WebSocket has its own. */
+export class NameDictionary {
+  epoch: number | null = null;
+  names: string[] = [];
+
+  /** Apply a `dict` section. Returns false if it does not line up with this table. */
+  apply(section: unknown): boolean {
+    if (!section || typeof section !== 'object') return false;
+    const s = section as Record<string, unknown>;
+    const epoch = s['e'];
+    const base = s['b'];
+    const names = s['n'];
+    if (typeof epoch !== 'number' || typeof base !== 'number' || !Array.isArray(names)) return false;
+    if (!names.every((n): n is string => typeof n === 'string')) return false;
+
+    if (base === 0) {
+      this.epoch = epoch;
+      this.names = [...names];
+      return true;
+    }
+    if (epoch !== this.epoch || base !== this.names.length) return false;
+    this.names.push(...names);
+    return true;
+  }
+}
+
+export type BinaryTickResult =
+  | { ok: true; payload: Record<string, unknown> }
+  | { ok: false; error: 'dictionary_mismatch'; expectedEpoch: number | null; expectedSize: number }
+  | { ok: false; error: 'invalid_binary'; message: string };
+
+class BinaryFormatError extends Error {}
+
+function name(dict: NameDictionary, id: unknown): string {
+  if (typeof id !== 'number' || !Number.isInteger(id) || id < 0 || id >= dict.names.length) {
+    throw new BinaryFormatError(`unknown name id ${String(id)}`);
+  }
+  return dict.names[id]!;
+}
+
+function names(dict: NameDictionary, ids: unknown, field: string): string[] {
+  if (!Array.isArray(ids)) throw new BinaryFormatError(`${field} must be an array of name ids`);
+  return ids.map(id => name(dict, id));
+}
+
+function column(blob: unknown, width: 2 | 8, count: number, field: string): DataView {
+  if (!(blob instanceof Uint8Array) || blob.byteLength !== count * width) {
+    throw new BinaryFormatError(`${field} must be a ${count * width}-byte blob`);
+  }
+  return new DataView(blob.buffer, blob.byteOffset, blob.byteLength);
+}
+
+function columns(blobs: unknown, expected: number, rows: number, field: string): DataView[] {
+  if (!Array.isArray(blobs) || blobs.length !== expected) {
+    throw new BinaryFormatError(`${field} must have ${expected} columns`);
+  }
+  return blobs.map((b, i) => column(b, 8, rows, `${field}[${i}]`));
+}
+
+function decodeEvent(dict: NameDictionary, raw: unknown): EconomicEvent {
+  if (!raw || typeof raw !== 'object') throw new BinaryFormatError('event must be a map');
+  const e = raw as Record<string, unknown>;
+  const event: Record<string, unknown> = {
+    type: e['y'],
+    timestamp: e['ts'],
+    actor: name(dict, e['a']),
+  };
+  if (e['r'] !== undefined) event['role'] = name(dict, e['r']);
+  if (e['res'] !== undefined) event['resource'] = name(dict, e['res']);
+  if (e['c'] !== undefined) event['currency'] = name(dict, e['c']);
+  if (e['amt'] !== undefined) event['amount'] = e['amt'];
+  if (e['p'] !== undefined) event['price'] = e['p'];
+  if (e['f'] !== undefined) event['from'] = name(dict, e['f']);
+  if (e['to'] !== undefined) event['to'] = name(dict, e['to']);
+  return event as unknown as EconomicEvent;
+}
+
+function byName(names: string[], col: DataView): Record<string, number> {
+  const out: Record<string, number> = {};
+  for (let i = 0; i < names.length; i++) out[names[i]!] = col.getFloat64(i * 8, true);
+  return out;
+}
+
+function decodeSampling(raw: unknown, roles: string[], currencies: string[], resources: string[]): SamplingInfo {
+  if (!raw || typeof raw !== 'object') throw new BinaryFormatError('sampling must be a map');
+  const s = raw as Record<string, unknown>;
+  const sampling: SamplingInfo = {
+    population: s['n'] as number,
+    rateByRole: byName(roles, column(s['rate'], 8, roles.length, 'sampling.rate')),
+    populationByRole: byName(roles, column(s['count'], 8, roles.length, 'sampling.count')),
+    supplyByCurrency: byName(currencies, column(s['supply'], 8, currencies.length, 'sampling.supply')),
+  };
+  if (s['stock'] !== undefined) {
+    sampling.supplyByResource = byName(resources, column(s['stock'], 8, resources.length, 'sampling.stock'));
+  }
+  return sampling;
+}
+
+function decodeAggregates(raw: unknown, roles: string[], currencies: string[], resources: string[]): PreAggregates {
+  if (!raw || typeof raw !== 'object') throw new BinaryFormatError('aggregates must be a map');
+  const a = raw as Record<string, unknown>;
+  const perCurrency = (key: string) => byName(currencies, column(a[key], 8, currencies.length, `aggregates.${key}`));
+  return {
+    population: a['n'] as number,
+    populationByRole: byName(roles, column(a['count'], 8, roles.length, 'aggregates.count')),
+    supplyByCurrency: perCurrency('supply'),
+    giniByCurrency: perCurrency('gini'),
+    medianBalanceByCurrency: perCurrency('median'),
+    top10PctShareByCurrency: perCurrency('top10'),
+    supplyByResource: byName(resources, column(a['stock'], 8, resources.length, 'aggregates.stock')),
+  };
+}
+
+/**
+ * Decode a binary tick into the same `{ state, seq, shard }` payload shape a
+ * JSON body has, so it flows through the regular resolve/validate/process path.
+ */
+export function decodeBinaryTick(body: Uint8Array, dict: NameDictionary): BinaryTickResult {
+  const read = readBinaryTick(body);
+  return read.ok ? decodeBinaryTickMessage(read.msg, dict) : read;
+}
+
+/**
+ * The top-level map of a binary tick, names not yet resolved — for picking
+ * the name table by `shard` before decoding the rest.
+ */
+export function readBinaryTick(body: Uint8Array):
+  | { ok: true; msg: Record<string, unknown> }
+  | { ok: false; error: 'invalid_binary'; message: string } {
+  try {
+    const decoded = decode(body);
+    if (!decoded || typeof decoded !== 'object' || Array.isArray(decoded)) {
+      return { ok: false, error: 'invalid_binary', message: 'Body must be a MessagePack map' };
+    }
+    return { ok: true, msg: decoded as Record<string, unknown> };
+  } catch (err) {
+    return { ok: false, error: 'invalid_binary', message: (err as Error).message };
+  }
+}
+
+/** decodeBinaryTick for a map readBinaryTick returned. */
+export function decodeBinaryTickMessage(msg: Record<string, unknown>, dict: NameDictionary): BinaryTickResult {
+  const dictNames = (msg['dict'] as Record<string, unknown> | null | undefined)?.['n'];
+  if (Array.isArray(dictNames) && dictNames.some(n => typeof n === 'string' && isReservedName(n))) {
+    return { ok: false, error: 'invalid_binary', message: 'dict names must not be __proto__, constructor or prototype' };
+  }
+  if (msg['dict'] !== undefined && !dict.apply(msg['dict'])) {
+    return { ok: false, error: 'dictionary_mismatch', expectedEpoch: dict.epoch, expectedSize: dict.names.length };
+  }
+
+  try {
+    const roles = names(dict, msg['roles'], 'roles');
+    const resources = names(dict, msg['resources'], 'resources');
+    const currencies = names(dict, msg['currencies'], 'currencies');
+    const agents = names(dict, msg['agents'], 'agents');
+    const n = agents.length;
+
+    const roleCol = column(msg['agentRoles'], 2, n, 'agentRoles');
+    const balanceCols = columns(msg['balances'], currencies.length, n, 'balances');
+    const inventoryCols = columns(msg['inventories'], resources.length, n, 'inventories');
+    const priceCols = columns(msg['prices'], currencies.length, resources.length, 'prices');
+
+    const agentBalances: Record<string, Record<string, number>> = {};
+    const agentRoles: Record<string, string> = {};
+    const agentInventories: Record<string, Record<string, number>> = {};
+
+    for (let a = 0; a < n; a++) {
+      const id = agents[a]!;
+
+      const balances: Record<string, number> = {};
+      for (let c = 0; c < currencies.length; c++) {
+        balances[currencies[c]!] = balanceCols[c]!.getFloat64(a * 8, true);
+      }
+      agentBalances[id] = balances;
+
+      const role = roleCol.getUint16(a * 2, true);
+      agentRoles[id] = roles[role] ?? '';
+
+      const inventory: Record<string, number> = {};
+      for (let r = 0; r < resources.length; r++) {
+        const qty = inventoryCols[r]!.getFloat64(a * 8, true);
+        if (qty !== 0) inventory[resources[r]!] = qty;
+      }
+      agentInventories[id] = inventory;
+    }
+
+    const marketPrices: Record<string, Record<string, number>> = {};
+    for (let c = 0; c < currencies.length; c++) {
+      const row: Record<string, number> = {};
+      for (let r = 0; r < resources.length; r++) {
+        row[resources[r]!] = priceCols[c]!.getFloat64(r * 8, true);
+      }
+      marketPrices[currencies[c]!] = row;
+    }
+
+    const rawEvents = msg['events'];
+    const recentTransactions = Array.isArray(rawEvents) ? rawEvents.map(e => decodeEvent(dict, e)) : [];
+
+    const state: EconomyState = {
+      tick: msg['tick'] as number,
+      roles,
+      resources,
+      currencies,
+      agentBalances,
+      agentRoles,
+      agentInventories,
+      marketPrices,
+      recentTransactions,
+    };
+    if (msg['sampling'] !== undefined) {
+      state.sampling = decodeSampling(msg['sampling'], roles, currencies, resources);
+    }
+    if (msg['aggregates'] !== undefined) {
+      state.aggregates = decodeAggregates(msg['aggregates'], roles, currencies, resources);
+    }
+
+    return {
+      ok: true,
+      payload: {
+        state,
+        ...(msg['seq'] !== undefined ? { seq: msg['seq'] } : {}),
+        ...(msg['shard'] !== undefined ? { shard: msg['shard'] } : {}),
+      },
+    };
+  } catch (err) {
+    if (err instanceof BinaryFormatError) {
+      return { ok: false, error: 'invalid_binary', message: err.message };
+    }
+    throw err;
+  }
+}
+
+/** True when an HTTP request body is MessagePack. */
+export function isMsgpackRequest(contentType: string | undefined): boolean {
+  return typeof contentType === 'string' && contentType.split(';')[0]!.trim().toLowerCase() === MSGPACK_CONTENT_TYPE;
+}
+
+/** True when the client accepts a MessagePack reply. */
+export function acceptsMsgpack(accept: string | undefined): boolean {
+  return typeof accept === 'string' && accept.toLowerCase().includes(MSGPACK_CONTENT_TYPE);
+}
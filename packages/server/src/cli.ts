@@ -10,11 +10,17 @@ import { AgentEServer } from './AgentEServer.js';
 const port = parseInt(process.env['AGENTE_PORT'] ?? '3100', 10);
 const host = process.env['AGENTE_HOST'] ?? '127.0.0.1';
 const mode = process.env['AGENTE_MODE'] === 'advisor' ? 'advisor' as const : 'autonomous' as const;
+const batchWorkers = process.env['AGENTE_BATCH_WORKERS'] === 'auto'
+  ? 'auto' as const
+  : parseInt(process.env['AGENTE_BATCH_WORKERS'] ?? '0', 10) || 0;
+const shmPort = process.env['AGENTE_SHM_PORT'];
 
 const server = new AgentEServer({
   port,
   host,
   agentE: { mode },
+  batchWorkers,
+  ...(shmPort ? { sharedMemoryPort: parseInt(shmPort, 10) } : {}),
 });
 
 server.start().catch((err) => {
@@ -0,0 +1,143 @@
+// Delta-encoded state snapshots — rebuilds a full EconomyState from the last
+// accepted state plus a diff, so clients can send only what changed.
+//
+// Wire shape (HTTP body or WS `tick` message):
+//   full:  { state: {...}, seq: 12 }
+//   delta: { delta: {...}, seq: 13, baseSeq: 12 }
+//
+// A delta only applies on top of the exact snapshot it was diffed against.
+// When `baseSeq` does not match the server's current base, the server rejects
+// it (`delta_base_mismatch`) and the client must send a full state next.
+
+import type { EconomyState, EconomicEvent, PreAggregates, SamplingInfo } from '@agent-e/engine';
+
+/** Per-field patch: a number sets the field, `null` removes it. */
+type FieldPatch = Record<string, number | null>;
+
+export interface StateDelta {
+  tick: number;
+  /** Changed or added agents, changed fields only (added agents: all fields). */
+  agentBalances?: Record<string, FieldPatch>;
+  agentRoles?: Record<string, string>;
+  agentInventories?: Record<string, FieldPatch>;
+  agentSatisfaction?: FieldPatch;
+  /** Replaces the whole price table when present (it is small). */
+  marketPrices?: Record<string, Record<string, number>>;
+  /** Replaces the sampling block when present (rates and exact totals move every tick). */
+  sampling?: SamplingInfo;
+  /** Replaces the client's aggregates block when present. */
+  aggregates?: PreAggregates;
+  /** Removed before upserts are applied. */
+  removedAgents?: string[];
+  recentTransactions?: EconomicEvent[];
+}
+
+export interface DeltaBase {
+  seq: number;
+  state: EconomyState;
+}
+
+export type ResolvedTickState =
+  | { ok: true; state: unknown; seq: number | undefined; delta: boolean }
+  | { ok: false; error: 'delta_base_mismatch'; expectedBaseSeq: number | null }
+  | { ok: false; error: 'invalid_delta'; message: string };
+
+function isRecord(v: unknown): v is Record<string, unknown> {
+  return v !== null && typeof v === 'object' && !Array.isArray(v);
+}
+
+function isSeq(v: unknown): v is number {
+  return typeof v === 'number' && Number.isInteger(v) && v >= 0;
+}
+
+function patchFields(target: Record<string, number>, patch: unknown): Record<string, number> {
+  const next = { ...target };
+  if (!isRecord(patch)) return next;
+  for (const [field, value] of Object.entries(patch)) {
+    if (value === null) delete next[field];
+    else next[field] = value as number;
+  }
+  return next;
+}
+
+/**
+ * Copies the outer map — agent IDs to record pointers, so O(agents) but no
+ * per-agent work; unchanged records are shared — rather than patching the
+ * base in place. The base must stay intact until the new state replaces it:
+ * resolveTickState runs before the economy's tick lock, so the base can be
+ * the state a previous tick is still processing, and a state that then fails
+ * validation is never committed, leaving the old base for the next delta.
+ */
+function patchNested(
+  base: Record<string, Record<string, number>>,
+  patch: Record<string, FieldPatch> | undefined,
+  removed: readonly string[],
+): Record<string, Record<string, number>> {
+  const next = { ...base };
+  for (const id of removed) delete next[id];
+  if (patch) {
+    for (const [id, fields] of Object.entries(patch)) {
+      next[id] = patchFields(next[id] ?? {}, fields);
+    }
+  }
+  return next;
+}
+
+/**
+ * Apply a delta on top of a base state. Never mutates `base` — unchanged
+ * per-agent records are shared between the two states.
+ */
+export function applyStateDelta(base: EconomyState, delta: StateDelta): EconomyState {
+  const removed = Array.isArray(delta.removedAgents)
+    ? delta.removedAgents.filter((id): id is string => typeof id === 'string')
+    : [];
+
+  const agentRoles = { ...base.agentRoles };
+  for (const id of removed) delete agentRoles[id];
+  if (isRecord(delta.agentRoles)) Object.assign(agentRoles, delta.agentRoles);
+
+  const next: EconomyState = {
+    ...base,
+    tick: delta.tick,
+    agentBalances: patchNested(base.agentBalances, delta.agentBalances, removed),
+    agentRoles,
+    agentInventories: patchNested(base.agentInventories, delta.agentInventories, removed),
+    marketPrices: isRecord(delta.marketPrices) ? delta.marketPrices : base.marketPrices,
+    recentTransactions: Array.isArray(delta.recentTransactions) ? delta.recentTransactions : [],
+  };
+  if (isRecord(delta.sampling)) next.sampling = delta.sampling;
+  if (isRecord(delta.aggregates)) next.aggregates = delta.aggregates;
+
+  if (base.agentSatisfaction || delta.agentSatisfaction) {
+    const satisfaction = patchFields(base.agentSatisfaction ?? {}, delta.agentSatisfaction);
+    for (const id of removed) delete satisfaction[id];
+    next.agentSatisfaction = satisfaction;
+  }
+
+  return next;
+}
+
+/**
+ * Turn a tick payload (full or delta) into a full state candidate.
+ * Pure — the caller commits the new base once the state has been validated.
+ */
+export function resolveTickState(
+  payload: Record<string, unknown>,
+  base: DeltaBase | null,
+): ResolvedTickState {
+  const seq = isSeq(payload['seq']) ? payload['seq'] : undefined;
+  const delta = payload['delta'];
+
+  if (delta === undefined) {
+    return { ok: true, state: payload['state'] ?? payload, seq, delta: false };
+  }
+
+  if (!isRecord(delta) || seq === undefined || !isSeq(payload['baseSeq'])) {
+    return { ok: false, error: 'invalid_delta', message: 'delta requires an object body plus integer seq and baseSeq' };
+  }
+  if (!base || base.seq !== payload['baseSeq']) {
+    return { ok: false, error: 'delta_base_mismatch', expectedBaseSeq: base?.seq ?? null };
+  }
+
+  return { ok: true, state: applyStateDelta(base.state, delta as unknown as StateDelta), seq, delta: true };
+}
@@ -0,0 +1,228 @@
+// One economy's AgentE instance and everything a tick needs next to it:
+// the last state (what the remote adapter reports), the delta base, and the
+// adjustment and alert queues filled during a tick. The server's main
+// economy is one of these; each shard of a batched tick gets its own.
+
+import {
+  AgentE,
+  type AgentEConfig,
+  type EconomyAdapter,
+  type EconomyState,
+  type EconomicEvent,
+  type Diagnosis,
+  type DecisionEntry,
+  type ParameterScope,
+} from '@agent-e/engine';
+import type { DeltaBase } from './delta.js';
+import { validateEvent } from './validation.js';
+
+export type EconomyConfig = Partial<Omit<AgentEConfig, 'adapter'>>;
+
+export interface EnrichedAdjustment {
+  parameter: string;
+  value: number;
+  scope?: ParameterScope;
+  /** Id of the principle whose decision made this adjustment, when the log has it */
+  principle?: string;
+  reasoning: string;
+}
+
+export interface TickOutcome {
+  adjustments: EnrichedAdjustment[];
+  alerts: Diagnosis[];
+  health: number;
+  tick: number;
+  decisions: ReturnType<AgentE['getDecisions']>;
+  /** Milliseconds the tick itself took, from taking the tick lock to the result */
+  processingMs: number;
+}
+
+interface QueuedAdjustment {
+  key: string;
+  value: number;
+  scope: ParameterScope | undefined;
+}
+
+const EMPTY_STATE: EconomyState = {
+  tick: 0,
+  roles: [],
+  resources: [],
+  currencies: ['default'],
+  agentBalances: {},
+  agentRoles: {},
+  agentInventories: {},
+  marketPrices: {},
+  recentTransactions: [],
+};
+
+export class Economy {
+  readonly agentE: AgentE;
+  private lastState: EconomyState | null = null;
+  /** Last accepted sequenced state — the base incoming deltas are applied to. */
+  private deltaBase: DeltaBase | null = null;
+  private adjustmentQueue: QueuedAdjustment[] = [];
+  private alerts: Diagnosis[] = [];
+  /** Serialization lock for processTick — prevents concurrent ticks from corrupting shared state. */
+  private tickLock: Promise<void> = Promise.resolve();
+
+  constructor(config: EconomyConfig = {}) {
+    // A "remote" adapter — state comes from HTTP/WS, not polled
+    const adapter: EconomyAdapter = {
+      getState: () => this.lastState ?? EMPTY_STATE,
+      setParam: (key: string, value: number, scope?: ParameterScope) => {
+        this.adjustmentQueue.push({ key, value, scope });
+      },
+    };
+
+    // Batch workers get only these fields (workerEconomyConfig) — keep the two in step
+    const agentEConfig: AgentEConfig = {
+      adapter,
+      mode: config.mode ?? 'autonomous',
+      gracePeriod: config.gracePeriod ?? 0,
+      checkInterval: config.checkInterval ?? 1,
+      ...(config.dominantRoles ? { dominantRoles: config.dominantRoles } : {}),
+      ...(config.idealDistribution ? { idealDistribution: config.idealDistribution } : {}),
+      ...(config.maxAdjustmentPercent !== undefined ? { maxAdjustmentPercent: config.maxAdjustmentPercent } : {}),
+      ...(config.cooldownTicks !== undefined ? { cooldownTicks: config.cooldownTicks } : {}),
+      ...(config.thresholds ? { thresholds: config.thresholds } : {}),
+    };
+    this.agentE = new AgentE(agentEConfig);
+
+    // Capture alerts during tick
+    this.agentE.on('alert', (diagnosis: unknown) => {
+      this.alerts.push(diagnosis as Diagnosis);
+    });
+
+    this.agentE.connect(adapter).start();
+  }
+
+  getLastState(): EconomyState | null {
+    return this.lastState;
+  }
+
+  /**
+   * Process a tick with the given state.
+   * 1. Clear adjustment queue
+   * 2. Set state
+   * 3. Ingest events
+   * 4. Run agentE.tick(state)
+   * 5. Drain adjustment queue, enrich with reasoning from decisions
+   * 6. Return response
+   */
+  async processTick(state: EconomyState, events?: EconomicEvent[]): Promise<TickOutcome> {
+    // Serialize tick processing — concurrent HTTP + WS ticks would corrupt shared queues
+    const prev = this.tickLock;
+    let unlock: () => void;
+    this.tickLock = new Promise<void>(resolve => { unlock = resolve; });
+    await prev;
+    const started = performance.now();
+
+    try {
+      // Clear queues
+      this.adjustmentQueue = [];
+      this.alerts = [];
+
+      // Set state
+      this.lastState = state;
+
+      // Ingest events
+      if (events) {
+        for (const event of events) {
+          this.agentE.ingest(event);
+        }
+      }
+
+      // Run tick
+      await this.agentE.tick(state);
+
+      // Drain adjustments
+      const rawAdj = [...this.adjustmentQueue];
+      this.adjustmentQueue = [];
+
+      // Cross-reference with decision log to attach reasoning
+      const decisions = this.agentE.getDecisions({ since: state.tick, until: state.tick });
+
+      const adjustments = rawAdj.map(adj => enrich(adj, decisions.find(d =>
+        d.plan.parameter === adj.key && d.result === 'applied',
+      )));
+
+      return {
+        adjustments,
+        alerts: [...this.alerts],
+        health: this.agentE.getHealth(),
+        tick: state.tick,
+        decisions,
+        processingMs: Math.round((performance.now() - started) * 1000) / 1000,
+      };
+    } finally {
+      unlock!();
+    }
+  }
+
+  /**
+   * Apply a decision's plan between ticks — an advisor recommendation being
+   * approved — and return the adjustments it made. Serialized with ticks,
+   * so they can't be drained by (or cleared from under) one in progress.
+   */
+  async applyDecision(entry: DecisionEntry): Promise<EnrichedAdjustment[]> {
+    const prev = this.tickLock;
+    let unlock: () => void;
+    this.tickLock = new Promise<void>(resolve => { unlock = resolve; });
+    await prev;
+
+    try {
+      this.adjustmentQueue = [];
+      await this.agentE.apply(entry.plan);
+      const rawAdj = this.adjustmentQueue;
+      this.adjustmentQueue = [];
+      return rawAdj.map(adj => enrich(adj, adj.key === entry.plan.parameter ? entry : undefined));
+    } finally {
+      unlock!();
+    }
+  }
+
+  /**
+   * Ingest a batch of streamed events between ticks. Invalid events are
+   * skipped. Returns how many were accepted.
+   */
+  ingestEvents(events: unknown[]): number {
+    let accepted = 0;
+    for (const event of events) {
+      if (validateEvent(event)) {
+        this.agentE.ingest(event);
+        accepted++;
+      }
+    }
+    return accepted;
+  }
+
+  getDeltaBase(): DeltaBase | null {
+    return this.deltaBase;
+  }
+
+  /**
+   * Record a validated, sequenced state as the base for the next delta.
+   * A full state always becomes the base — a restarted client counts from 0
+   * again. A delta with an older sequence number (a late or reordered
+   * request) is ignored.
+   */
+  commitDeltaBase(seq: number, state: EconomyState, fromDelta = false): void {
+    if (fromDelta && this.deltaBase && seq < this.deltaBase.seq) return;
+    this.deltaBase = { seq, state };
+  }
+
+  stop(): void {
+    this.agentE.stop();
+  }
+}
+
+/** A queued adjustment with the principle and reasoning of the decision behind it. */
+function enrich(adj: QueuedAdjustment, decision: DecisionEntry | undefined): EnrichedAdjustment {
+  return {
+    parameter: adj.key,
+    value: adj.value,
+    ...(adj.scope ? { scope: adj.scope } : {}),
+    ...(decision ? { principle: decision.diagnosis.principle.id } : {}),
+    reasoning: decision?.diagnosis.violation.suggestedAction.reasoning ?? '',
+  };
+}
@@ -0,0 +1,249 @@
+// Minimal MessagePack codec — the subset AgentE's binary wire format uses.
+// nil, bool, int, float64, str, bin, array, map. No ext types.
+// Decoding is bounds-checked and depth-limited; malformed input throws.
+
+const MAX_DEPTH = 32;
+
+// ── Encoder ─────────────────────────────────────────────────────────────────
+
+class Encoder {
+  private buf = Buffer.allocUnsafe(256);
+  private pos = 0;
+
+  private ensure(n: number): void {
+    if (this.pos + n <= this.buf.length) return;
+    let size = this.buf.length * 2;
+    while (size < this.pos + n) size *= 2;
+    const next = Buffer.allocUnsafe(size);
+    this.buf.copy(next, 0, 0, this.pos);
+    this.buf = next;
+  }
+
+  private u8(v: number): void {
+    this.ensure(1);
+    this.buf[this.pos++] = v;
+  }
+
+  /** Length-prefixed header: fix form when it fits, else the 8/16/32-bit code (0 = no such form). */
+  private header(fixBase: number, fixMax: number, code8: number, code16: number, code32: number, len: number): void {
+    if (len <= fixMax) { this.u8(fixBase | len); return; }
+    if (len < 0x100 && code8 !== 0) { this.u8(code8); this.u8(len); return; }
+    if (len < 0x10000) {
+      this.ensure(3);
+      this.buf[this.pos++] = code16;
+      this.buf.writeUInt16BE(len, this.pos);
+      this.pos += 2;
+      return;
+    }
+    this.ensure(5);
+    this.buf[this.pos++] = code32;
+    this.buf.writeUInt32BE(len, this.pos);
+    this.pos += 4;
+  }
+
+  write(value: unknown, depth = 0): void {
+    if (depth > MAX_DEPTH) throw new Error('msgpack: nesting too deep');
+
+    if (value === null || value === undefined) { this.u8(0xc0); return; }
+    if (value === false) { this.u8(0xc2); return; }
+    if (value === true) { this.u8(0xc3); return; }
+
+    if (typeof value === 'number') {
+      this.number(value);
+      return;
+    }
+
+    if (typeof value === 'string') {
+      const len = Buffer.byteLength(value, 'utf8');
+      this.header(0xa0, 31, 0xd9, 0xda, 0xdb, len);
+      this.ensure(len);
+      this.pos += this.buf.write(value, this.pos, 'utf8');
+      return;
+    }
+
+    if (value instanceof Uint8Array) {
+      this.header(0, -1, 0xc4, 0xc5, 0xc6, value.length);
+      this.ensure(value.length);
+      this.buf.set(value, this.pos);
+      this.pos += value.length;
+      return;
+    }
+
+    if (Array.isArray(value)) {
+      this.header(0x90, 15, 0, 0xdc, 0xdd, value.length);
+      for (const item of value) this.write(item, depth + 1);
+      return;
+    }
+
+    if (typeof value === 'object') {
+      const entries = Object.entries(value as Record<string, unknown>).filter(([, v]) => v !== undefined);
+      this.header(0x80, 15, 0, 0xde, 0xdf, entries.length);
+      for (const [k, v] of entries) {
+        this.write(k, depth + 1);
+        this.write(v, depth + 1);
+      }
+      return;
+    }
+
+    this.u8(0xc0); // functions, symbols, bigint — not representable
+  }
+
+  private number(v: number): void {
+    if (Number.isInteger(v) && Number.isSafeInteger(v)) {
+      if (v >= 0 && v <= 0x7f) { this.u8(v); return; }
+      if (v < 0 && v >= -32) { this.u8(0xe0 | (v + 32)); return; }
+      this.ensure(9);
+      if (v >= 0) {
+        if (v <= 0xff) { this.buf[this.pos++] = 0xcc; this.buf[this.pos++] = v; return; }
+        if (v <= 0xffff) { this.buf[this.pos++] = 0xcd; this.buf.writeUInt16BE(v, this.pos); this.pos += 2; return; }
+        if (v <= 0xffffffff) { this.buf[this.pos++] = 0xce; this.buf.writeUInt32BE(v, this.pos); this.pos += 4; return; }
+        this.buf[this.pos++] = 0xcf;
+        this.buf.writeBigUInt64BE(BigInt(v), this.pos);
+        this.pos += 8;
+        return;
+      }
+      if (v >= -0x80) { this.buf[this.pos++] = 0xd0; this.buf.writeInt8(v, this.pos); this.pos += 1; return; }
+      if (v >= -0x8000) { this.buf[this.pos++] = 0xd1; this.buf.writeInt16BE(v, this.pos); this.pos += 2; return; }
+      if (v >= -0x80000000) { this.buf[this.pos++] = 0xd2; this.buf.writeInt32BE(v, this.pos); this.pos += 4; return; }
+      this.buf[this.pos++] = 0xd3;
+      this.buf.writeBigInt64BE(BigInt(v), this.pos);
+      this.pos += 8;
+      return;
+    }
+    this.ensure(9);
+    this.buf[this.pos++] = 0xcb;
+    this.buf.writeDoubleBE(v, this.pos);
+    this.pos += 8;
+  }
+
+  finish(): Buffer {
+    return this.buf.subarray(0, this.pos);
+  }
+}
+
+export function encode(value: unknown): Buffer {
+  const encoder = new Encoder();
+  encoder.write(value);
+  return encoder.finish();
+}
+
+// ── Decoder ─────────────────────────────────────────────────────────────────
+
+class Decoder {
+  private pos = 0;
+  private readonly view: Buffer;
+
+  constructor(input: Uint8Array) {
+    this.view = Buffer.from(input.buffer, input.byteOffset, input.byteLength);
+  }
+
+  private need(n: number): void {
+    if (this.pos + n > this.view.length) throw new Error('msgpack: unexpected end of input');
+  }
+
+  private u8(): number {
+    this.need(1);
+    return this.view[this.pos++]!;
+  }
+
+  private u16(): number {
+    this.need(2);
+    const v = this.view.readUInt16BE(this.pos);
+    this.pos += 2;
+    return v;
+  }
+
+  private u32(): number {
+    this.need(4);
+    const v = this.view.readUInt32BE(this.pos);
+    this.pos += 4;
+    return v;
+  }
+
+  private str(len: number): string {
+    this.need(len);
+    const s = this.view.toString('utf8', this.pos, this.pos + len);
+    this.pos += len;
+    return s;
+  }
+
+  private bin(len: number): Uint8Array {
+    this.need(len);
+    const b = this.view.subarray(this.pos, this.pos + len);
+    this.pos += len;
+    return b;
+  }
+
+  private array(len: number, depth: number): unknown[] {
+    // Every element takes at least one byte — reject impossible lengths before allocating
+    this.need(len);
+    const out = new Array<unknown>(len);
+    for (let i = 0; i < len; i++) out[i] = this.read(depth + 1);
+    return out;
+  }
+
+  private map(len: number, depth: number): Record<string, unknown> {
+    this.need(len * 2);
+    const out: Record<string, unknown> = {};
+    for (let i = 0; i < len; i++) {
+      const key = this.read(depth + 1);
+      if (typeof key !== 'string' && typeof key !== 'number') throw new Error('msgpack: unsupported map key');
+      const value = this.read(depth + 1);
+      const k = String(key);
+      // Same policy as sanitizeJson for parsed JSON bodies
+      if (k === '__proto__' || k === 'constructor' || k === 'prototype') continue;
+      out[k] = value;
+    }
+    return out;
+  }
+
+  read(depth = 0): unknown {
+    if (depth > MAX_DEPTH) throw new Error('msgpack: nesting too deep');
+    const b = this.u8();
+
+    if (b <= 0x7f) return b;
+    if (b >= 0xe0) return b - 0x100;
+    if ((b & 0xe0) === 0xa0) return this.str(b & 0x1f);
+    if ((b & 0xf0) === 0x90) return this.array(b & 0x0f, depth);
+    if ((b & 0xf0) === 0x80) return this.map(b & 0x0f, depth);
+
+    switch (b) {
+      case 0xc0: return null;
+      case 0xc2: return false;
+      case 0xc3: return true;
+      case 0xc4: return this.bin(this.u8());
+      case 0xc5: return this.bin(this.u16());
+      case 0xc6: return this.bin(this.u32());
+      case 0xca: { this.need(4); const v = this.view.readFloatBE(this.pos); this.pos += 4; return v; }
+      case 0xcb: { this.need(8); const v = this.view.readDoubleBE(this.pos); this.pos += 8; return v; }
+      case 0xcc: return this.u8();
+      case 0xcd: return this.u16();
+      case 0xce: return this.u32();
+      case 0xcf: { this.need(8); const v = Number(this.view.readBigUInt64BE(this.pos)); this.pos += 8; return v; }
+      case 0xd0: { this.need(1); const v = this.view.readInt8(this.pos); this.pos += 1; return v; }
+      case 0xd1: { this.need(2); const v = this.view.readInt16BE(this.pos); this.pos += 2; return v; }
+      case 0xd2: { this.need(4); const v = this.view.readInt32BE(this.pos); this.pos += 4; return v; }
+      case 0xd3: { this.need(8); const v = Number(this.view.readBigInt64BE(this.pos)); this.pos += 8; return v; }
+      case 0xd9: return this.str(this.u8());
+      case 0xda: return this.str(this.u16());
+      case 0xdb: return this.str(this.u32());
+      case 0xdc: return this.array(this.u16(), depth);
+      case 0xdd: return this.array(this.u32(), depth);
+      case 0xde: return this.map(this.u16(), depth);
+      case 0xdf: return this.map(this.u32(), depth);
+      default:
+        throw new Error(`msgpack: unsupported type 0x${b.toString(16)}`);
+    }
+  }
+
+  done(): boolean {
+    return this.pos === this.view.length;
+  }
+}
+
+export function decode(input: Uint8Array): unknown {
+  const decoder = new Decoder(input);
+  const value = decoder.read();
+  if (!decoder.done()) throw new Error('msgpack: trailing bytes');
+  return value;
+}
@@ -2,11 +2,17 @@
 // Node http module with manual body parsing. CORS on all responses.
 
 import type * as http from 'node:http';
-import { timingSafeEqual, randomBytes } from 'node:crypto';
+import { timingSafeEqual, randomBytes, createHash } from 'node:crypto';
+import type { Readable } from 'node:stream';
+import { createGunzip, createInflate } from 'node:zlib';
 import { validateEconomyState } from '@agent-e/engine';
 import type { AgentEServer } from './AgentEServer.js';
 import { getDashboardHtml } from './dashboard.js';
-import { validateEvent } from './validation.js';
+import { MAX_EVENT_BATCH, validateEvent } from './validation.js';
+import { resolveTickState } from './delta.js';
+import { MSGPACK_CONTENT_TYPE, acceptsMsgpack, decodeBinaryTickMessage, isMsgpackRequest, readBinaryTick } from './binary.js';
+import { encode as encodeMsgpack } from './msgpack.js';
+import { MAX_SHARDS, isShardId, parseBatch, tickReplyBody } from './batch.js';
 
 function setSecurityHeaders(res: http.ServerResponse): void {
   res.setHeader('X-Content-Type-Options', 'nosniff');
@@ -33,7 +39,8 @@ function setCorsHeaders(res: http.ServerResponse, allowedOrigin: string, request
     res.setHeader('Access-Control-Allow-Origin', origin);
   }
   res.setHeader('Access-Control-Allow-Methods', 'GET, POST, OPTIONS');
-  res.setHeader('Access-Control-Allow-Headers', 'Content-Type, Authorization');
+  res.setHeader('Access-Control-Allow-Headers', 'Content-Type, Content-Encoding, Authorization, If-None-Match');
+  res.setHeader('Access-Control-Expose-Headers', 'ETag');
 }
 
 /** Strips prototype-polluting keys from parsed JSON objects (recursive). */
@@ -57,17 +64,66 @@ function checkAuth(req: http.IncomingMessage, apiKey: string | undefined): boole
   return timingSafeEqual(Buffer.from(header), Buffer.from(expected));
 }
 
-function json(res: http.ServerResponse, status: number, data: unknown, origin: string, reqOrigin?: string): void {
+function json(
+  res: http.ServerResponse,
+  status: number,
+  data: unknown,
+  origin: string,
+  reqOrigin?: string,
+  headers?: http.OutgoingHttpHeaders,
+): void {
   setCorsHeaders(res, origin, reqOrigin);
-  res.writeHead(status, { 'Content-Type': 'application/json' });
+  res.writeHead(status, { 'Content-Type': 'application/json', ...headers });
   res.end(JSON.stringify(data));
 }
 
-const MAX_BODY_BYTES = 1_048_576; // 1 MB
+/** If-None-Match against a weak ETag (weak comparison, lists and `*` allowed). */
+function etagMatches(header: string | string[] | undefined, etag: string): boolean {
+  if (typeof header !== 'string') return false;
+  const opaque = (tag: string) => tag.trim().replace(/^W\//, '');
+  const target = opaque(etag);
+  return header.split(',').some(tag => tag.trim() === '*' || opaque(tag) === target);
+}
+
+function msgpack(res: http.ServerResponse, status: number, data: unknown, origin: string, reqOrigin?: string): void {
+  setCorsHeaders(res, origin, reqOrigin);
+  res.writeHead(status, { 'Content-Type': MSGPACK_CONTENT_TYPE });
+  res.end(encodeMsgpack(data));
+}
+
+const MAX_BODY_BYTES = 1_048_576; // 1 MB, counted after decompression
+const MAX_BATCH_BODY_BYTES = 8_388_608; // 8 MB — a tick batch carries up to MAX_BATCH_SHARDS states
 const READ_BODY_TIMEOUT_MS = 30_000; // 30 seconds — mitigates slow-loris attacks
 const MAX_CONFIG_ARRAY = 1000; // cap lock/unlock/constrain array lengths
 
 function readBody(req: http.IncomingMessage): Promise<string> {
+  return readBodyBuffer(req).then(buf => buf.toString('utf-8'));
+}
+
+/** Body read failure the client should hear about (status + error code) */
+class BodyError extends Error {
+  constructor(readonly status: number, readonly code: string, message: string) {
+    super(message);
+  }
+}
+
+/**
+ * Read the whole body, inflating it when the client sent Content-Encoding
+ * gzip or deflate. The size limit applies to the decompressed bytes, so a
+ * small compressed body cannot expand past the limit.
+ */
+function readBodyBuffer(req: http.IncomingMessage, maxBytes = MAX_BODY_BYTES): Promise<Buffer> {
+  const encoding = (req.headers['content-encoding'] ?? 'identity').trim().toLowerCase();
+  let source: Readable = req;
+  if (encoding === 'gzip' || encoding === 'x-gzip') {
+    source = req.pipe(createGunzip());
+  } else if (encoding === 'deflate') {
+    source = req.pipe(createInflate());
+  } else if (encoding !== 'identity') {
+    req.resume();
+    return Promise.reject(new BodyError(415, 'unsupported_encoding', `Unsupported Content-Encoding: ${encoding}`));
+  }
+
   return new Promise((resolve, reject) => {
     const chunks: Buffer[] = [];
     let totalBytes = 0;
@@ -75,24 +131,43 @@ function readBody(req: http.IncomingMessage): Promise<string> {
       req.destroy();
       reject(new Error('Request body read timeout'));
     }, READ_BODY_TIMEOUT_MS);
-    req.on('data', (chunk: Buffer) => {
+    source.on('data', (chunk: Buffer) => {
       totalBytes += chunk.length;
-      if (totalBytes > MAX_BODY_BYTES) {
+      if (totalBytes > maxBytes) {
         clearTimeout(timeout);
-        req.destroy();
-        reject(new Error('Request body too large'));
+        if (source === req) {
+          req.destroy();
+        } else {
+          // The compressed body may be fully sent; drain it so the 413 gets through
+          req.unpipe();
+          req.resume();
+          source.destroy();
+        }
+        reject(new BodyError(413, 'body_too_large', 'Request body too large'));
         return;
       }
       chunks.push(chunk);
     });
-    req.on('end', () => {
+    source.on('end', () => {
       clearTimeout(timeout);
-      resolve(Buffer.concat(chunks).toString('utf-8'));
+      resolve(Buffer.concat(chunks));
     });
-    req.on('error', (err) => {
+    source.on('error', (err: Error) => {
       clearTimeout(timeout);
-      reject(err);
+      if (source === req) {
+        reject(err);
+        return;
+      }
+      req.unpipe();
+      req.resume();
+      reject(new BodyError(400, 'invalid_encoding', err.message));
     });
+    if (source !== req) {
+      req.on('error', (err) => {
+        clearTimeout(timeout);
+        reject(err);
+      });
+    }
   });
 }
 
@@ -102,6 +177,9 @@ export function createRouteHandler(
   const cors = server.corsOrigin;
   const apiKey = server.apiKey;
 
+  // Last /diagnose response by body hash — dashboards re-post the same state
+  let lastDiagnose: { key: string; response: unknown } | null = null;
+
   return async (req, res) => {
     const url = new URL(req.url ?? '/', `http://${req.headers.host ?? 'localhost'}`);
     const path = url.pathname;
@@ -109,7 +187,8 @@ export function createRouteHandler(
     const reqOrigin = req.headers['origin'] as string | undefined;
 
     // Scoped json helper — captures cors + reqOrigin for this request
-    const respond = (status: number, data: unknown) => json(res, status, data, cors, reqOrigin);
+    const respond = (status: number, data: unknown, headers?: http.OutgoingHttpHeaders) =>
+      json(res, status, data, cors, reqOrigin, headers);
 
     // CORS preflight
     if (method === 'OPTIONS') {
@@ -126,13 +205,55 @@ export function createRouteHandler(
           respond(401, { error: 'Unauthorized' });
           return;
         }
-        const body = await readBody(req);
+        // Binary clients get binary replies (when they ask for them)
+        const tickRespond = acceptsMsgpack(req.headers['accept'])
+          ? (status: number, data: unknown) => msgpack(res, status, data, cors, reqOrigin)
+          : respond;
+
+        const raw = await readBodyBuffer(req);
         let parsed: unknown;
-        try {
-          parsed = sanitizeJson(JSON.parse(body));
-        } catch {
-          respond(400, { error: 'Invalid JSON' });
-          return;
+        if (isMsgpackRequest(req.headers['content-type'])) {
+          const read = readBinaryTick(raw);
+          if (!read.ok) {
+            tickRespond(400, { error: read.error, message: read.message });
+            return;
+          }
+          // A shard's sender keeps its own name table
+          const shard = read.msg['shard'];
+          let dict = server.getBinaryDictionary();
+          if (shard !== undefined) {
+            if (!isShardId(shard)) {
+              tickRespond(400, { error: 'invalid_shard' });
+              return;
+            }
+            const shardDict = server.getShardBinaryDictionary(shard);
+            if (!shardDict) {
+              tickRespond(503, { error: 'too_many_shards', maxShards: MAX_SHARDS });
+              return;
+            }
+            dict = shardDict;
+          }
+          const decoded = decodeBinaryTickMessage(read.msg, dict);
+          if (!decoded.ok) {
+            if (decoded.error === 'dictionary_mismatch') {
+              tickRespond(409, {
+                error: decoded.error,
+                expectedEpoch: decoded.expectedEpoch,
+                expectedSize: decoded.expectedSize,
+              });
+            } else {
+              tickRespond(400, { error: decoded.error, message: decoded.message });
+            }
+            return;
+          }
+          parsed = decoded.payload;
+        } else {
+          try {
+            parsed = sanitizeJson(JSON.parse(raw.toString('utf-8')));
+          } catch {
+            respond(400, { error: 'Invalid JSON' });
+            return;
+          }
         }
 
         if (!parsed || typeof parsed !== 'object') {
@@ -141,19 +262,42 @@ export function createRouteHandler(
         }
 
         const payload = parsed as Record<string, unknown>;
-        const state = payload['state'] ?? parsed;
+
+        // A shard's tick runs on that shard's economy, as a one-slice batch would
+        if (payload['shard'] !== undefined) {
+          const { status, body } = await server.processShardTick(payload);
+          tickRespond(status, body);
+          return;
+        }
+
         const events = payload['events'];
 
+        // Full state, or a delta against the last accepted sequenced state
+        const resolved = resolveTickState(payload, server.getDeltaBase());
+        if (!resolved.ok) {
+          if (resolved.error === 'delta_base_mismatch') {
+            tickRespond(409, { error: resolved.error, expectedBaseSeq: resolved.expectedBaseSeq });
+          } else {
+            tickRespond(400, { error: resolved.error, message: resolved.message });
+          }
+          return;
+        }
+        const state = resolved.state;
+
         // Validate state (if enabled)
         const validation = server.validateState ? validateEconomyState(state) : null;
         if (validation && !validation.valid) {
-          respond(400, {
+          tickRespond(400, {
             error: 'invalid_state',
             validationErrors: validation.errors,
           });
           return;
         }
 
+        if (resolved.seq !== undefined) {
+          server.commitDeltaBase(resolved.seq, state as import('@agent-e/engine').EconomyState, resolved.delta);
+        }
+
         // Validate individual events before ingestion
         const validEvents = Array.isArray(events)
           ? (events as unknown[]).filter(validateEvent)
@@ -164,34 +308,93 @@ export function createRouteHandler(
           validEvents,
         );
 
-        const warnings = validation?.warnings ?? [];
+        tickRespond(200, tickReplyBody(result, resolved.seq, validation?.warnings ?? []));
+        return;
+      }
 
-        respond(200, {
-          adjustments: result.adjustments,
-          alerts: result.alerts.map(a => ({
-            principleId: a.principle.id,
-            principleName: a.principle.name,
-            severity: a.violation.severity,
-            evidence: a.violation.evidence,
-            reasoning: a.violation.suggestedAction.reasoning,
-          })),
-          health: result.health,
-          tick: result.tick,
-          ...(warnings.length > 0 ? { validationWarnings: warnings } : {}),
-        });
+      // POST /tick/batch — one tick per shard economy, answered in one response
+      if (path === '/tick/batch' && method === 'POST') {
+        if (!checkAuth(req, apiKey)) {
+          respond(401, { error: 'Unauthorized' });
+          return;
+        }
+        // Binary name dictionaries are per sender, not per shard — batches are JSON only
+        if (isMsgpackRequest(req.headers['content-type'])) {
+          req.resume();
+          respond(415, { error: 'unsupported_media_type', message: 'Tick batches are JSON only' });
+          return;
+        }
+        const raw = await readBodyBuffer(req, MAX_BATCH_BODY_BYTES);
+        let parsed: unknown;
+        try {
+          parsed = sanitizeJson(JSON.parse(raw.toString('utf-8')));
+        } catch {
+          respond(400, { error: 'Invalid JSON' });
+          return;
+        }
+        const batch = parseBatch(parsed);
+        if (!batch.ok) {
+          respond(400, { error: batch.error, message: batch.message });
+          return;
+        }
+        respond(200, { results: await server.processTickBatch(batch.slices) });
+        return;
+      }
+
+      // POST /events — streamed events between ticks, ingested into the next tick
+      if (path === '/events' && method === 'POST') {
+        if (!checkAuth(req, apiKey)) {
+          respond(401, { error: 'Unauthorized' });
+          return;
+        }
+        const body = await readBody(req);
+        let parsed: unknown;
+        try {
+          parsed = sanitizeJson(JSON.parse(body));
+        } catch {
+          respond(400, { error: 'Invalid JSON' });
+          return;
+        }
+
+        const batch = (parsed as Record<string, unknown> | null)?.['events'];
+        if (!Array.isArray(batch)) {
+          respond(400, { error: 'Body must be { "events": [...] }' });
+          return;
+        }
+        if (batch.length > MAX_EVENT_BATCH) {
+          respond(400, { error: 'batch_too_large', maxEvents: MAX_EVENT_BATCH });
+          return;
+        }
+        // Events for a shard economy name it, as batch slices do
+        const shard = (parsed as Record<string, unknown>)['shard'];
+        if (shard !== undefined && !isShardId(shard)) {
+          respond(400, { error: 'invalid_shard' });
+          return;
+        }
+
+        const accepted = server.ingestEvents(batch, shard);
+        respond(200, { accepted, rejected: batch.length - accepted });
         return;
       }
 
-      // GET /health — health, tick, mode, activePlans, uptime
+      // GET /health — health, tick, mode, activePlans, uptime.
+      // Weak ETag per tick/mode change: pollers revalidate and get 304 with no body.
       if (path === '/health' && method === 'GET') {
-        const agentE = server.getAgentE();
+        const snapshot = server.getHealthSnapshot();
+        const headers = { ETag: snapshot.etag, 'Cache-Control': 'no-cache' };
+        if (etagMatches(req.headers['if-none-match'], snapshot.etag)) {
+          setCorsHeaders(res, cors, reqOrigin);
+          res.writeHead(304, headers);
+          res.end();
+          return;
+        }
         respond(200, {
-          health: agentE.getHealth(),
-          tick: agentE.metrics.latest()?.tick ?? 0,
-          mode: agentE.getMode(),
-          activePlans: agentE.getActivePlans().length,
+          health: snapshot.health,
+          tick: snapshot.tick,
+          mode: snapshot.mode,
+          activePlans: snapshot.activePlans,
           uptime: server.getUptime(),
-        });
+        }, headers);
         return;
       }
 
@@ -316,6 +519,14 @@ export function createRouteHandler(
           return;
         }
         const body = await readBody(req);
+
+        // diagnoseOnly is a pure function of the state
+        const key = createHash('sha1').update(body).digest('base64');
+        if (lastDiagnose?.key === key) {
+          respond(200, lastDiagnose.response);
+          return;
+        }
+
         let parsed: unknown;
         try {
           parsed = sanitizeJson(JSON.parse(body));
@@ -337,7 +548,7 @@ export function createRouteHandler(
 
         const result = server.diagnoseOnly(state as import('@agent-e/engine').EconomyState);
 
-        respond(200, {
+        const response = {
           health: result.health,
           diagnoses: result.diagnoses.map(d => ({
             principleId: d.principle.id,
@@ -346,7 +557,9 @@ export function createRouteHandler(
             evidence: d.violation.evidence,
             suggestedAction: d.violation.suggestedAction,
           })),
-        });
+        };
+        lastDiagnose = { key, response };
+        respond(200, response);
         return;
       }
 
@@ -419,30 +632,8 @@ export function createRouteHandler(
           return;
         }
 
-        const agentE = server.getAgentE();
-        if (agentE.getMode() !== 'advisor') {
-          respond(400, { error: 'not_in_advisor_mode' });
-          return;
-        }
-
-        const entry = agentE.log.getById(decisionId);
-        if (!entry) {
-          respond(404, { error: 'decision_not_found' });
-          return;
-        }
-        if (entry.result !== 'skipped_override') {
-          respond(409, { error: 'decision_not_pending', currentResult: entry.result });
-          return;
-        }
-
-        await agentE.apply(entry.plan);
-        agentE.log.updateResult(decisionId, 'applied');
-        server.broadcast({ type: 'advisor_action', action: 'approved', decisionId });
-        respond(200, {
-          ok: true,
-          parameter: entry.plan.parameter,
-          value: entry.plan.targetValue,
-        });
+        const outcome = await server.approveDecision(decisionId);
+        respond(outcome.status, outcome.body);
         return;
       }
 
@@ -466,25 +657,8 @@ export function createRouteHandler(
           return;
         }
 
-        const agentE = server.getAgentE();
-        if (agentE.getMode() !== 'advisor') {
-          respond(400, { error: 'not_in_advisor_mode' });
-          return;
-        }
-
-        const entry = agentE.log.getById(decisionId);
-        if (!entry) {
-          respond(404, { error: 'decision_not_found' });
-          return;
-        }
-        if (entry.result !== 'skipped_override') {
-          respond(409, { error: 'decision_not_pending', currentResult: entry.result });
-          return;
-        }
-
-        agentE.log.updateResult(decisionId, 'rejected', reason);
-        server.broadcast({ type: 'advisor_action', action: 'rejected', decisionId, reason });
-        respond(200, { ok: true, decisionId });
+        const outcome = server.rejectDecision(decisionId, reason);
+        respond(outcome.status, outcome.body);
         return;
       }
 
@@ -507,6 +681,12 @@ export function createRouteHandler(
       // 404
       respond(404, { error: 'Not found' });
     } catch (err) {
+      if (err instanceof BodyError) {
+        if (!res.headersSent) {
+          respond(err.status, { error: err.code, message: err.message });
+        }
+        return;
+      }
       console.error('[AgentE Server] Unhandled route error:', err);
       respond(500, { error: 'Internal server error' });
     }
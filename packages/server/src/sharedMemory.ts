@@ -0,0 +1,328 @@
+// Shared-memory transport for a game server on the same host.
+//
+// The client creates a POSIX shared-memory region (/dev/shm/agente-*) with
+// two rings — requests it writes, replies the server writes — and connects
+// a loopback TCP socket that only carries the handshake and doorbells.
+// Frames never touch the socket, and ticks use the binary format, so a
+// round trip costs two small socket writes and no JSON on either side.
+//
+// Region (little-endian):
+//   0   u32 magic 'AGSM'   4  u32 version (1)
+//   8   u32 request ring bytes   12  u32 reply ring bytes   (powers of two)
+//   64  request ring, then reply ring
+//
+// Frames are { u32 length, u32 kind | status, payload } padded to 8 bytes;
+// payloads may wrap around the end of a ring. Kinds: 1 = binary tick body
+// (as POST /tick with application/x-msgpack), 2 = JSON events body (as
+// POST /events); either may name a `shard`. A reply carries the HTTP
+// status /tick would have answered and a MessagePack body.
+//
+// Ring positions are u32 byte counters that wrap. Neither side reads the
+// other's positions from the region: they travel in the doorbells, 8-byte
+// packets { u32, u32 } — client → server { request head, reply tail },
+// server → client { request tail, reply head } — so a position is never
+// read half-written and a doorbell orders the data it announces.
+//
+// Handshake: the client sends `AGSM1 <region name> <api key or ->\n` and the
+// server answers with its first doorbell, or closes the socket. Linux only
+// (POSIX shm under /dev/shm); the listener binds to 127.0.0.1.
+
+import * as fs from 'node:fs';
+import * as net from 'node:net';
+import { timingSafeEqual } from 'node:crypto';
+import type { AgentEServer } from './AgentEServer.js';
+import { NameDictionary, decodeBinaryTick } from './binary.js';
+import { encode as encodeMsgpack } from './msgpack.js';
+import { isShardId, processSlice } from './batch.js';
+import { MAX_EVENT_BATCH } from './validation.js';
+
+export const SHM_MAGIC = 0x4d534741; // 'AGSM'
+export const SHM_VERSION = 1;
+export const SHM_HEADER_BYTES = 64;
+export const SHM_FRAME_TICK = 1;
+export const SHM_FRAME_EVENTS = 2;
+
+const SHM_DIR = '/dev/shm';
+const REGION_NAME = /^agente-[A-Za-z0-9_.-]{1,64}$/;
+const MIN_RING_BYTES = 65_536;
+const MAX_RING_BYTES = 268_435_456; // 256 MB
+const MAX_HELLO_BYTES = 256;
+const HELLO_TIMEOUT_MS = 5_000;
+const MAX_SHM_CONNECTIONS = 16;
+
+export interface SharedMemoryHandle {
+  readonly port: number;
+  close: () => Promise<void>;
+}
+
+/** Frame size on the ring: 8-byte header plus payload, padded to 8 bytes */
+export function shmFrameBytes(payloadBytes: number): number {
+  return (8 + payloadBytes + 7) & ~7;
+}
+
+function isRingSize(n: number): boolean {
+  return n >= MIN_RING_BYTES && n <= MAX_RING_BYTES && (n & (n - 1)) === 0;
+}
+
+/** One attached region: the server's side of both rings */
+class RegionSession {
+  private reqTail = 0;
+  private repHead = 0;
+  /** Latest positions from the client's doorbells */
+  private reqHead = 0;
+  private repTail = 0;
+  private readonly replies: Buffer[] = [];
+  private readonly dictionary = new NameDictionary();
+  private draining = false;
+  private rungAgain = false;
+  private closed = false;
+  private readonly header = Buffer.alloc(8);
+
+  constructor(
+    private readonly server: AgentEServer,
+    private readonly socket: net.Socket,
+    private readonly fd: number,
+    private readonly reqCap: number,
+    private readonly repCap: number,
+  ) {}
+
+  /** Client doorbell: new request head and reply tail */
+  ring(reqHead: number, repTail: number): void {
+    this.reqHead = reqHead >>> 0;
+    this.repTail = repTail >>> 0;
+    this.writeReplies();
+    void this.drain();
+  }
+
+  close(): void {
+    if (this.closed) return;
+    this.closed = true;
+    fs.closeSync(this.fd);
+  }
+
+  doorbell(): void {
+    if (this.closed) return;
+    const packet = Buffer.alloc(8);
+    packet.writeUInt32LE(this.reqTail, 0);
+    packet.writeUInt32LE(this.repHead, 4);
+    this.socket.write(packet);
+  }
+
+  private readRing(base: number, cap: number, pos: number, out: Buffer, length: number): void {
+    const offset = pos & (cap - 1);
+    const first = Math.min(length, cap - offset);
+    fs.readSync(this.fd, out, 0, first, base + offset);
+    if (length > first) fs.readSync(this.fd, out, first, length - first, base);
+  }
+
+  private writeRing(base: number, cap: number, pos: number, data: Buffer): void {
+    const offset = pos & (cap - 1);
+    const first = Math.min(data.length, cap - offset);
+    fs.writeSync(this.fd, data, 0, first, base + offset);
+    if (data.length > first) fs.writeSync(this.fd, data, first, data.length - first, base);
+  }
+
+  /** Process request frames up to the client's head, one at a time, in order */
+  private async drain(): Promise<void> {
+    if (this.draining) {
+      this.rungAgain = true;
+      return;
+    }
+    this.draining = true;
+    try {
+      do {
+        this.rungAgain = false;
+        while (!this.closed && this.reqTail !== this.reqHead) {
+          this.readRing(SHM_HEADER_BYTES, this.reqCap, this.reqTail, this.header, 8);
+          const length = this.header.readUInt32LE(0);
+          const kind = this.header.readUInt32LE(4);
+          const available = (this.reqHead - this.reqTail) >>> 0;
+          if (shmFrameBytes(length) > available) {
+            // A frame past the announced head can only be a corrupt region
+            console.warn('[AgentE Server] Shared-memory frame overruns the ring — closing');
+            this.socket.destroy();
+            return;
+          }
+          const payload = Buffer.allocUnsafe(length);
+          this.readRing(SHM_HEADER_BYTES, this.reqCap, this.reqTail + 8, payload, length);
+          this.reqTail = (this.reqTail + shmFrameBytes(length)) >>> 0;
+
+          if (kind === SHM_FRAME_TICK) {
+            const { status, body } = await this.processTick(payload);
+            this.queueReply(status, encodeMsgpack(body));
+          } else if (kind === SHM_FRAME_EVENTS) {
+            this.ingestEvents(payload);
+          }
+          // Tell the client its request space is free again
+          this.doorbell();
+        }
+      } while (this.rungAgain && !this.closed);
+    } finally {
+      this.draining = false;
+    }
+  }
+
+  private async processTick(payload: Buffer): Promise<{ status: number; body: Record<string, unknown> }> {
+    const decoded = decodeBinaryTick(payload, this.dictionary);
+    if (!decoded.ok) {
+      return decoded.error === 'dictionary_mismatch'
+        ? { status: 409, body: { error: decoded.error, expectedEpoch: decoded.expectedEpoch, expectedSize: decoded.expectedSize } }
+        : { status: 400, body: { error: decoded.error, message: decoded.message } };
+    }
+    try {
+      // A frame naming a shard ticks that shard's economy, like /tick does
+      return decoded.payload['shard'] !== undefined
+        ? await this.server.processShardTick(decoded.payload)
+        : await processSlice(this.server, decoded.payload, this.server.validateState);
+    } catch {
+      return { status: 500, body: { error: 'tick_failed' } };
+    }
+  }
+
+  private ingestEvents(payload: Buffer): void {
+    let parsed: unknown;
+    try {
+      parsed = JSON.parse(payload.toString('utf-8'));
+    } catch {
+      return;
+    }
+    const body = parsed as Record<string, unknown> | null;
+    const events = body?.['events'];
+    const shard = body?.['shard'];
+    if (Array.isArray(events) && events.length <= MAX_EVENT_BATCH && (shard === undefined || isShardId(shard))) {
+      this.server.ingestEvents(events, shard);
+    }
+  }
+
+  private queueReply(status: number, body: Buffer): void {
+    if (shmFrameBytes(body.length) > this.repCap) {
+      status = 500;
+      body = encodeMsgpack({ error: 'reply_too_large' });
+    }
+    const frame = Buffer.alloc(shmFrameBytes(body.length));
+    frame.writeUInt32LE(body.length, 0);
+    frame.writeUInt32LE(status, 4);
+    body.copy(frame, 8);
+    this.replies.push(frame);
+    this.writeReplies();
+  }
+
+  /** Write queued replies while the reply ring has room; the rest wait for the client */
+  private writeReplies(): void {
+    let wrote = false;
+    while (!this.closed && this.replies.length > 0) {
+      const frame = this.replies[0]!;
+      const used = (this.repHead - this.repTail) >>> 0;
+      if (this.repCap - used < frame.length) break;
+      this.writeRing(SHM_HEADER_BYTES + this.reqCap, this.repCap, this.repHead, frame);
+      this.repHead = (this.repHead + frame.length) >>> 0;
+      this.replies.shift();
+      wrote = true;
+    }
+    if (wrote) this.doorbell();
+  }
+}
+
+/** Open and check a client's region. Null if it is missing or not an AgentE region. */
+function openRegion(name: string): { fd: number; reqCap: number; repCap: number } | null {
+  let fd: number;
+  try {
+    fd = fs.openSync(`${SHM_DIR}/${name}`, fs.constants.O_RDWR | fs.constants.O_NOFOLLOW);
+  } catch {
+    return null;
+  }
+  const header = Buffer.alloc(16);
+  const ok = fs.readSync(fd, header, 0, 16, 0) === 16
+    && header.readUInt32LE(0) === SHM_MAGIC
+    && header.readUInt32LE(4) === SHM_VERSION;
+  const reqCap = header.readUInt32LE(8);
+  const repCap = header.readUInt32LE(12);
+  if (!ok || !isRingSize(reqCap) || !isRingSize(repCap)
+    || fs.fstatSync(fd).size < SHM_HEADER_BYTES + reqCap + repCap) {
+    fs.closeSync(fd);
+    return null;
+  }
+  return { fd, reqCap, repCap };
+}
+
+function checkToken(token: string, apiKey: string | undefined): boolean {
+  if (!apiKey) return true;
+  return token.length === apiKey.length && timingSafeEqual(Buffer.from(token), Buffer.from(apiKey));
+}
+
+export function createSharedMemoryListener(server: AgentEServer, port: number, host = '127.0.0.1'): Promise<SharedMemoryHandle> {
+  const sockets = new Set<net.Socket>();
+  const listener = net.createServer((socket) => {
+    if (sockets.size >= MAX_SHM_CONNECTIONS) {
+      socket.destroy();
+      return;
+    }
+    sockets.add(socket);
+    socket.setNoDelay(true);
+
+    let session: RegionSession | null = null;
+    let pending = Buffer.alloc(0);
+    const helloTimer = setTimeout(() => socket.destroy(), HELLO_TIMEOUT_MS);
+
+    socket.on('data', (chunk: Buffer) => {
+      pending = pending.length === 0 ? chunk : Buffer.concat([pending, chunk]);
+
+      if (!session) {
+        const end = pending.indexOf(0x0a);
+        if (end < 0) {
+          if (pending.length > MAX_HELLO_BYTES) socket.destroy();
+          return;
+        }
+        clearTimeout(helloTimer);
+        const [magic, name, token] = pending.subarray(0, end).toString('utf-8').trim().split(' ');
+        pending = pending.subarray(end + 1);
+        const region = magic === 'AGSM1' && name && REGION_NAME.test(name) && checkToken(token ?? '', server.apiKey)
+          ? openRegion(name)
+          : null;
+        if (!region) {
+          console.warn('[AgentE Server] Shared-memory handshake refused');
+          socket.destroy();
+          return;
+        }
+        session = new RegionSession(server, socket, region.fd, region.reqCap, region.repCap);
+        console.log(`[AgentE Server] Shared-memory client attached: ${name}`);
+        session.doorbell();
+      }
+
+      // Doorbells coalesce on the stream; only the newest positions matter
+      const packets = Math.floor(pending.length / 8);
+      if (packets > 0) {
+        const last = (packets - 1) * 8;
+        session.ring(pending.readUInt32LE(last), pending.readUInt32LE(last + 4));
+        pending = pending.subarray(packets * 8);
+      }
+    });
+
+    socket.on('close', () => {
+      sockets.delete(socket);
+      clearTimeout(helloTimer);
+      session?.close();
+    });
+    socket.on('error', () => { /* close follows */ });
+  });
+
+  return new Promise((resolve, reject) => {
+    listener.once('error', reject);
+    listener.listen(port, host, () => {
+      const addr = listener.address();
+      resolve({
+        port: addr && typeof addr === 'object' ? addr.port : port,
+        close: () => new Promise<void>((done) => {
+          listener.close(() => done());
+          // Attached clients would keep the listener open
+          for (const socket of sockets) socket.destroy();
+        }),
+      });
+    });
+  });
+}
+
+/** Whether this host has POSIX shared memory where the transport looks for it */
+export function sharedMemoryAvailable(): boolean {
+  return fs.existsSync(SHM_DIR);
+}
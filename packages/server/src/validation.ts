@@ -7,6 +7,9 @@ export const VALID_EVENT_TYPES = new Set([
   'trade', 'mint', 'burn', 'transfer', 'produce', 'consume', 'role_change', 'enter', 'churn',
 ]);
 
+/** Most events a single batch (POST /events, WS `events`) may carry. */
+export const MAX_EVENT_BATCH = 1000;
+
 /** Validates an event has the required shape before ingestion. */
 export function validateEvent(e: unknown): e is EconomicEvent {
   if (!e || typeof e !== 'object') return false;
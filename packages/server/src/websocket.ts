@@ -1,12 +1,29 @@
 // WebSocket handler for AgentE Server
 // Same port via HTTP upgrade. JSON messages with `type` field.
+//
+// A client may split a large message into chunk frames so that small
+// control messages (health, approve, reject) can go out between its
+// pieces instead of queueing behind it. A chunk is a binary frame:
+//   u8 0xc1 (never a MessagePack type byte)   u8 flags (1 = last, 2 = binary)
+//   u32 message id (little-endian)             payload bytes
+// Pieces of one id are reassembled in order and the whole is handled as if
+// it had arrived as one text (or binary) frame.
+//
+// A connection that sends `subscribe` is pushed `adjustment` and `alert`
+// frames as the main economy produces them — by ticks from any transport,
+// and by approved recommendations — instead of only in its own tick replies.
+// Subscriptions end with the connection.
 
 import type * as http from 'node:http';
 import { timingSafeEqual } from 'node:crypto';
 import { WebSocketServer, WebSocket } from 'ws';
 import { validateEconomyState, type EconomyState } from '@agent-e/engine';
 import type { AgentEServer } from './AgentEServer.js';
-import { validateEvent } from './validation.js';
+import { MAX_EVENT_BATCH, validateEvent } from './validation.js';
+import { resolveTickState } from './delta.js';
+import { MSGPACK_SUBPROTOCOL, NameDictionary, decodeBinaryTick } from './binary.js';
+import { encode as encodeMsgpack } from './msgpack.js';
+import { isShardId, parseBatch } from './batch.js';
 
 interface IncomingMessage {
   type: string;
@@ -19,12 +36,26 @@ function send(ws: WebSocket, data: Record<string, unknown>): void {
   }
 }
 
+function sendBinary(ws: WebSocket, data: Record<string, unknown>): void {
+  if (ws.readyState === WebSocket.OPEN) {
+    ws.send(encodeMsgpack(data), { binary: true });
+  }
+}
+
 export interface WebSocketHandle {
   cleanup: () => void;
   broadcast: (data: Record<string, unknown>) => void;
+  /** Send to subscribed connections, all but `except` */
+  push: (data: Record<string, unknown>, except?: object) => void;
 }
 
 const MAX_WS_PAYLOAD = 1_048_576; // 1 MB
+const CHUNK_MARKER = 0xc1;
+const CHUNK_HEADER_BYTES = 6;
+const CHUNK_LAST = 1;
+const CHUNK_BINARY = 2;
+const MAX_CHUNKED_MESSAGE = 8_388_608; // 8 MB, like a POST /tick/batch body
+const MAX_PARTIAL_MESSAGES = 4;
 const MAX_WS_CONNECTIONS = 100;
 const MIN_TICK_INTERVAL_MS = 100; // rate limit: max 10 ticks/sec per connection
 const GLOBAL_MIN_TICK_INTERVAL_MS = 50; // global rate limit: max 20 ticks/sec across all connections
@@ -45,7 +76,12 @@ export function createWebSocketHandler(
   httpServer: http.Server,
   server: AgentEServer,
 ): WebSocketHandle {
-  const wss = new WebSocketServer({ server: httpServer, maxPayload: MAX_WS_PAYLOAD });
+  const wss = new WebSocketServer({
+    server: httpServer,
+    maxPayload: MAX_WS_PAYLOAD,
+    // Clients asking for the binary subprotocol may send MessagePack tick frames
+    handleProtocols: (protocols) => (protocols.has(MSGPACK_SUBPROTOCOL) ? MSGPACK_SUBPROTOCOL : false),
+  });
 
   // Global tick rate limiter — shared across all connections to prevent CPU saturation
   let globalLastTickTime = 0;
@@ -53,6 +89,9 @@ export function createWebSocketHandler(
   // Heartbeat: ping every 30s, disconnect if no pong within 10s
   const aliveMap = new WeakMap<WebSocket, boolean>();
 
+  // Connections that asked for adjustment / alert pushes
+  const subscribers = new Set<WebSocket>();
+
   const heartbeatInterval = setInterval(() => {
     for (const ws of wss.clients) {
       if (ws.readyState === WebSocket.OPEN) {
@@ -101,59 +140,163 @@ export function createWebSocketHandler(
     aliveMap.set(ws, true);
 
     let lastTickTime = 0;
+    const binaryEnabled = ws.protocol === MSGPACK_SUBPROTOCOL;
+    const dictionary = new NameDictionary();
 
     ws.on('pong', () => {
       aliveMap.set(ws, true);
     });
 
     ws.on('close', () => {
+      subscribers.delete(ws);
       console.log('[AgentE Server] Client disconnected');
     });
 
-    ws.on('message', async (raw) => {
-      let msg: IncomingMessage;
-      try {
-        msg = sanitizeJson(JSON.parse(raw.toString())) as IncomingMessage;
-      } catch {
-        send(ws, { type: 'error', message: 'Malformed JSON' });
+    // Chunked messages being reassembled, by message id
+    const partials = new Map<number, { parts: Buffer[]; bytes: number }>();
+
+    ws.on('message', (raw, isBinary) => {
+      const data = raw as Buffer;
+      if (!isBinary || data.length === 0 || data[0] !== CHUNK_MARKER) {
+        void handleMessage(data, isBinary);
+        return;
+      }
+      if (data.length < CHUNK_HEADER_BYTES) {
+        send(ws, { type: 'error', code: 'invalid_chunk', message: 'Truncated chunk header' });
+        return;
+      }
+      const flags = data[1]!;
+      const id = data.readUInt32LE(2);
+      let partial = partials.get(id);
+      if (!partial) {
+        if (partials.size >= MAX_PARTIAL_MESSAGES) {
+          send(ws, { type: 'error', code: 'invalid_chunk', message: `Too many chunked messages in progress — max ${MAX_PARTIAL_MESSAGES}` });
+          return;
+        }
+        partial = { parts: [], bytes: 0 };
+        partials.set(id, partial);
+      }
+      partial.parts.push(data.subarray(CHUNK_HEADER_BYTES));
+      partial.bytes += data.length - CHUNK_HEADER_BYTES;
+      if (partial.bytes > MAX_CHUNKED_MESSAGE) {
+        partials.delete(id);
+        send(ws, { type: 'error', code: 'body_too_large', message: 'Chunked message too large' });
         return;
       }
+      if (flags & CHUNK_LAST) {
+        partials.delete(id);
+        void handleMessage(Buffer.concat(partial.parts, partial.bytes), (flags & CHUNK_BINARY) !== 0);
+      }
+    });
+
+    const handleMessage = async (raw: Buffer, isBinary: boolean): Promise<void> => {
+      // Replies mirror the request's encoding
+      const reply = isBinary
+        ? (data: Record<string, unknown>) => sendBinary(ws, data)
+        : (data: Record<string, unknown>) => send(ws, data);
+      // Errors answering a tick name it (and echo its seq), so clients can
+      // tell them from errors about events, chunks or unknown messages
+      const replyError = (replyTo: 'tick' | 'tick_batch', fields: Record<string, unknown>, seq?: unknown) => {
+        reply({ type: 'error', replyTo, ...(typeof seq === 'number' ? { seq } : {}), ...fields });
+      };
+
+      let msg: IncomingMessage;
+      if (isBinary) {
+        if (!binaryEnabled) {
+          send(ws, { type: 'error', replyTo: 'tick', message: `Binary frames require the ${MSGPACK_SUBPROTOCOL} subprotocol` });
+          return;
+        }
+        const decoded = decodeBinaryTick(raw, dictionary);
+        if (!decoded.ok) {
+          replyError('tick', decoded.error === 'dictionary_mismatch'
+            ? { code: decoded.error, message: 'Name dictionary mismatch — resend from base 0', expectedEpoch: decoded.expectedEpoch, expectedSize: decoded.expectedSize }
+            : { code: decoded.error, message: decoded.message });
+          return;
+        }
+        msg = { type: 'tick', ...decoded.payload };
+      } else {
+        try {
+          msg = sanitizeJson(JSON.parse(raw.toString())) as IncomingMessage;
+        } catch {
+          send(ws, { type: 'error', message: 'Malformed JSON' });
+          return;
+        }
+      }
 
       if (!msg.type || typeof msg.type !== 'string') {
-        send(ws, { type: 'error', message: 'Missing "type" field' });
+        reply({ type: 'error', message: 'Missing "type" field' });
         return;
       }
 
       switch (msg.type) {
         case 'tick': {
+          // A shard's tick runs like a one-slice batch — off this thread
+          // with batch workers, so only the per-connection limit applies
+          const sharded = msg['shard'] !== undefined;
+          const offThread = sharded && server.getBatchWorkerCount() > 0;
           const now = Date.now();
           if (now - lastTickTime < MIN_TICK_INTERVAL_MS) {
-            send(ws, { type: 'error', message: 'Rate limited — min 100ms between ticks' });
+            replyError('tick', { code: 'rate_limited', message: 'Rate limited — min 100ms between ticks' }, msg['seq']);
             break;
           }
-          if (now - globalLastTickTime < GLOBAL_MIN_TICK_INTERVAL_MS) {
-            send(ws, { type: 'error', message: 'Rate limited — server tick capacity exceeded' });
+          if (!offThread && now - globalLastTickTime < GLOBAL_MIN_TICK_INTERVAL_MS) {
+            replyError('tick', { code: 'rate_limited', message: 'Rate limited — server tick capacity exceeded' }, msg['seq']);
             break;
           }
           lastTickTime = now;
-          globalLastTickTime = now;
+          if (!offThread) globalLastTickTime = now;
+
+          if (sharded) {
+            const { status, body } = await server.processShardTick(msg);
+            const { error, validationErrors, validationWarnings, ...rest } = body;
+            if (status === 200) {
+              if (Array.isArray(validationWarnings)) {
+                reply({ type: 'validation_warning', validationWarnings });
+              }
+              reply({ type: 'tick_result', ...rest });
+            } else if (error === 'invalid_state') {
+              reply({ type: 'validation_error', validationErrors });
+            } else {
+              replyError('tick', { code: error, ...rest }, msg['seq']);
+            }
+            break;
+          }
 
-          const state = msg['state'];
           const events = msg['events'];
 
+          // Full state, or a delta against the last accepted sequenced state
+          const resolved = resolveTickState(msg, server.getDeltaBase());
+          if (!resolved.ok) {
+            if (resolved.error === 'delta_base_mismatch') {
+              replyError('tick', {
+                code: resolved.error,
+                message: 'Delta base mismatch — send a full state',
+                expectedBaseSeq: resolved.expectedBaseSeq,
+              }, msg['seq']);
+            } else {
+              replyError('tick', { code: resolved.error, message: resolved.message }, msg['seq']);
+            }
+            break;
+          }
+          const state = resolved.state;
+
           if (server.validateState) {
             const validation = validateEconomyState(state);
             if (!validation.valid) {
-              send(ws, { type: 'validation_error', validationErrors: validation.errors });
+              reply({ type: 'validation_error', validationErrors: validation.errors });
               return;
             }
 
             // Forward warnings even if valid
             if (validation.warnings.length > 0) {
-              send(ws, { type: 'validation_warning', validationWarnings: validation.warnings });
+              reply({ type: 'validation_warning', validationWarnings: validation.warnings });
             }
           }
 
+          if (resolved.seq !== undefined) {
+            server.commitDeltaBase(resolved.seq, state as EconomyState, resolved.delta);
+          }
+
           try {
             // Validate individual events before ingestion
             const validEvents = Array.isArray(events)
@@ -163,9 +306,10 @@ export function createWebSocketHandler(
             const result = await server.processTick(
               state as EconomyState,
               validEvents,
+              ws,
             );
 
-            send(ws, {
+            reply({
               type: 'tick_result',
               adjustments: result.adjustments,
               alerts: result.alerts.map(a => ({
@@ -176,37 +320,90 @@ export function createWebSocketHandler(
               })),
               health: result.health,
               tick: result.tick,
+              processingMs: result.processingMs,
+              ...(resolved.seq !== undefined ? { seq: resolved.seq } : {}),
             });
           } catch (_err) {
-            send(ws, { type: 'error', message: 'Tick processing failed' });
+            replyError('tick', { message: 'Tick processing failed' }, msg['seq']);
+          }
+          break;
+        }
+
+        case 'tick_batch': {
+          // A whole batch spends one slot of each rate limit, like a single tick.
+          // With batch workers it ticks off this thread, so only the
+          // per-connection limit applies.
+          const now = Date.now();
+          const offThread = server.getBatchWorkerCount() > 0;
+          if (now - lastTickTime < MIN_TICK_INTERVAL_MS) {
+            replyError('tick_batch', { code: 'rate_limited', message: 'Rate limited — min 100ms between ticks' });
+            break;
           }
+          if (!offThread && now - globalLastTickTime < GLOBAL_MIN_TICK_INTERVAL_MS) {
+            replyError('tick_batch', { code: 'rate_limited', message: 'Rate limited — server tick capacity exceeded' });
+            break;
+          }
+          const batch = parseBatch(msg);
+          if (!batch.ok) {
+            replyError('tick_batch', { code: batch.error, message: batch.message });
+            break;
+          }
+          lastTickTime = now;
+          if (!offThread) globalLastTickTime = now;
+          reply({ type: 'tick_batch_result', results: await server.processTickBatch(batch.slices) });
           break;
         }
 
         case 'event': {
           const rawEvent = msg['event'];
           if (!rawEvent) {
-            send(ws, { type: 'error', message: 'Missing "event" field' });
+            reply({ type: 'error', message: 'Missing "event" field' });
             break;
           }
           if (!validateEvent(rawEvent)) {
-            send(ws, { type: 'error', message: 'Invalid event — requires type (valid event type), timestamp (number), and actor (string)' });
+            reply({ type: 'error', message: 'Invalid event — requires type (valid event type), timestamp (number), and actor (string)' });
             break;
           }
           server.getAgentE().ingest(rawEvent);
-          send(ws, { type: 'event_ack' });
+          reply({ type: 'event_ack' });
+          break;
+        }
+
+        case 'events': {
+          const batch = msg['events'];
+          if (!Array.isArray(batch)) {
+            reply({ type: 'error', message: 'Missing "events" array' });
+            break;
+          }
+          if (batch.length > MAX_EVENT_BATCH) {
+            reply({ type: 'error', message: `Too many events — max ${MAX_EVENT_BATCH} per batch` });
+            break;
+          }
+          const shard = msg['shard'];
+          if (shard !== undefined && !isShardId(shard)) {
+            reply({ type: 'error', code: 'invalid_shard', message: 'Invalid "shard" ID' });
+            break;
+          }
+          const accepted = server.ingestEvents(batch, shard);
+          reply({ type: 'events_ack', accepted, rejected: batch.length - accepted });
           break;
         }
 
         case 'health': {
-          const agentE = server.getAgentE();
-          send(ws, {
+          // Same validator as the HTTP ETag; a match is answered without the fields
+          const snapshot = server.getHealthSnapshot();
+          if (msg['ifNoneMatch'] === snapshot.etag) {
+            reply({ type: 'health_result', notModified: true, etag: snapshot.etag });
+            break;
+          }
+          reply({
             type: 'health_result',
-            health: agentE.getHealth(),
-            tick: agentE.metrics.latest()?.tick ?? 0,
-            mode: agentE.getMode(),
-            activePlans: agentE.getActivePlans().length,
+            health: snapshot.health,
+            tick: snapshot.tick,
+            mode: snapshot.mode,
+            activePlans: snapshot.activePlans,
             uptime: server.getUptime(),
+            etag: snapshot.etag,
           });
           break;
         }
@@ -217,13 +414,13 @@ export function createWebSocketHandler(
           if (server.validateState) {
             const validation = validateEconomyState(state);
             if (!validation.valid) {
-              send(ws, { type: 'validation_error', validationErrors: validation.errors });
+              reply({ type: 'validation_error', validationErrors: validation.errors });
               return;
             }
           }
 
           const result = server.diagnoseOnly(state as EconomyState);
-          send(ws, {
+          reply({
             type: 'diagnose_result',
             health: result.health,
             diagnoses: result.diagnoses.map(d => ({
@@ -236,10 +433,38 @@ export function createWebSocketHandler(
           break;
         }
 
+        case 'approve':
+        case 'reject': {
+          // Answered as decision_result, never `error`, so a client can't take it for a failed tick
+          const action = msg.type;
+          const decisionId = msg['decisionId'];
+          if (typeof decisionId !== 'string' || !decisionId) {
+            reply({ type: 'decision_result', action, status: 400, error: 'missing_decision_id' });
+            break;
+          }
+          const reason = typeof msg['reason'] === 'string' ? msg['reason'] : undefined;
+          const outcome = action === 'approve'
+            ? await server.approveDecision(decisionId)
+            : server.rejectDecision(decisionId, reason);
+          reply({ type: 'decision_result', action, decisionId, status: outcome.status, ...outcome.body });
+          break;
+        }
+
+        case 'subscribe':
+        case 'unsubscribe': {
+          if (msg.type === 'subscribe') {
+            subscribers.add(ws);
+          } else {
+            subscribers.delete(ws);
+          }
+          reply({ type: 'subscribed', subscribed: subscribers.has(ws) });
+          break;
+        }
+
         default:
-          send(ws, { type: 'error', message: `Unknown message type: "${String(msg.type).slice(0, 100)}"` });
+          reply({ type: 'error', message: `Unknown message type: "${String(msg.type).slice(0, 100)}"` });
       }
-    });
+    };
   });
 
   function broadcast(data: Record<string, unknown>): void {
@@ -251,11 +476,23 @@ export function createWebSocketHandler(
     }
   }
 
+  function push(data: Record<string, unknown>, except?: object): void {
+    if (subscribers.size === 0) return;
+    const payload = JSON.stringify(data);
+    for (const ws of subscribers) {
+      if (ws !== except && ws.readyState === WebSocket.OPEN) {
+        ws.send(payload);
+      }
+    }
+  }
+
   return {
     cleanup: () => {
       clearInterval(heartbeatInterval);
+      subscribers.clear();
       wss.close();
     },
     broadcast,
+    push,
   };
 }
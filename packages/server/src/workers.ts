@@ -0,0 +1,265 @@
+// Batch worker pool — shard economies of batched ticks spread over worker
+// threads, so a batch's independent economies tick in parallel and batch
+// throughput grows with the machine's cores. Each shard is pinned to one
+// worker by a hash of its ID: its economy (AgentE instance, delta base)
+// lives there for the life of the server, and its ticks stay in order.
+//
+// The main thread only checks shard IDs, splits each batch by worker and
+// puts the results back in request order. Mode, locks and constraints are
+// broadcast to every worker. Which shards exist is decided here too: when
+// the main thread drops an idle shard, its worker is told to drop it.
+//
+// A worker that exits is replaced: its in-flight batches fail at once
+// (503 worker_failed), its shards start over with fresh economies on the
+// new thread, and the mode, locks and constraints broadcast so far are
+// replayed to it. A batch a worker doesn't answer within batchTimeoutMs
+// fails with 504 worker_timeout.
+
+import { Worker } from 'node:worker_threads';
+import * as os from 'node:os';
+import * as path from 'node:path';
+import type { AgentEMode } from '@agent-e/engine';
+import type { EconomyConfig } from './economy.js';
+import { ShardTable, admitSlices, type BatchSliceResult } from './batch.js';
+
+export interface BatchWorkerData {
+  economyConfig: EconomyConfig;
+  validateState: boolean;
+}
+
+/** How long a worker gets to answer one batch. */
+export const DEFAULT_BATCH_TIMEOUT_MS = 30_000;
+
+/** Respawns of a worker that keeps dying without answering back off up to this. */
+const MAX_RESPAWN_DELAY_MS = 30_000;
+
+/**
+ * The part of an EconomyConfig a worker's Economy reads. workerData is
+ * structured-cloned, so options holding functions or class instances
+ * (custom principles, an LLM provider) must stay on the main thread.
+ */
+export function workerEconomyConfig(config: EconomyConfig): EconomyConfig {
+  const out: EconomyConfig = {};
+  if (config.mode !== undefined) out.mode = config.mode;
+  if (config.gracePeriod !== undefined) out.gracePeriod = config.gracePeriod;
+  if (config.checkInterval !== undefined) out.checkInterval = config.checkInterval;
+  if (config.dominantRoles !== undefined) out.dominantRoles = [...config.dominantRoles];
+  if (config.idealDistribution !== undefined) out.idealDistribution = { ...config.idealDistribution };
+  if (config.maxAdjustmentPercent !== undefined) out.maxAdjustmentPercent = config.maxAdjustmentPercent;
+  if (config.cooldownTicks !== undefined) out.cooldownTicks = config.cooldownTicks;
+  if (config.thresholds !== undefined) out.thresholds = { ...config.thresholds };
+  return out;
+}
+
+/** Main thread → worker */
+export type BatchWorkerRequest =
+  | { type: 'tick'; id: number; slices: { shard: string; slice: Record<string, unknown> }[] }
+  | { type: 'events'; shard: string; events: unknown[] }
+  | { type: 'evict'; shard: string }
+  | { type: 'mode'; mode: AgentEMode }
+  | { type: 'lock' | 'unlock'; param: string }
+  | { type: 'constrain'; param: string; bounds: { min: number; max: number } };
+
+/** Worker → main thread */
+export interface BatchWorkerReply {
+  id: number;
+  results: BatchSliceResult[];
+}
+
+/** Workers for `batchWorkers: 'auto'` — one per core, one core left for the HTTP/WS thread. */
+export function defaultWorkerCount(): number {
+  const cores = typeof os.availableParallelism === 'function' ? os.availableParallelism() : os.cpus().length;
+  return Math.max(1, cores - 1);
+}
+
+/** FNV-1a — stable across restarts, so a shard keeps its worker. */
+export function shardWorkerIndex(shard: string, workers: number): number {
+  let hash = 0x811c9dc5;
+  for (let i = 0; i < shard.length; i++) {
+    hash ^= shard.charCodeAt(i);
+    hash = Math.imul(hash, 0x01000193);
+  }
+  return (hash >>> 0) % workers;
+}
+
+/** A batch the pool couldn't get an answer for; status and code become each slice's result. */
+export class BatchWorkerError extends Error {
+  constructor(readonly status: number, readonly code: string, message: string) {
+    super(message);
+    this.name = 'BatchWorkerError';
+  }
+}
+
+interface Pending {
+  resolve: (results: BatchSliceResult[]) => void;
+  reject: (err: Error) => void;
+  timer: ReturnType<typeof setTimeout>;
+}
+
+type BroadcastRequest = Exclude<BatchWorkerRequest, { type: 'tick' } | { type: 'events' } | { type: 'evict' }>;
+
+export class BatchWorkerPool {
+  private readonly workers: Worker[] = [];
+  /** False while a dead worker waits for its replacement. */
+  private readonly alive: boolean[] = [];
+  private readonly pending: Map<number, Pending>[] = [];
+  /** Exits since each worker last answered, for respawn backoff. */
+  private readonly failures: number[] = [];
+  /** Shards that exist — MAX_SHARDS and idle eviction are enforced here, not per worker. */
+  private readonly known = new ShardTable<true>((shard) => {
+    this.post(shardWorkerIndex(shard, this.workers.length), { type: 'evict', shard });
+  });
+  /** Broadcast state, replayed to respawned workers. */
+  private mode: AgentEMode | undefined;
+  private readonly locked = new Set<string>();
+  private readonly constraints = new Map<string, { min: number; max: number }>();
+  private nextId = 1;
+  private stopped = false;
+
+  constructor(
+    size: number,
+    private readonly data: BatchWorkerData,
+    private readonly script: string = path.join(__dirname, 'batchWorker.js'),
+    private readonly batchTimeoutMs: number = DEFAULT_BATCH_TIMEOUT_MS,
+  ) {
+    for (let i = 0; i < size; i++) {
+      this.pending.push(new Map());
+      this.failures.push(0);
+      this.spawn(i);
+    }
+  }
+
+  get size(): number {
+    return this.workers.length;
+  }
+
+  getShardCount(): number {
+    return this.known.size;
+  }
+
+  /** Same contract as processTickBatch: one result per slice, in order. */
+  async processTickBatch(slices: unknown[]): Promise<BatchSliceResult[]> {
+    const { results, admitted } = admitSlices(slices, (shard) => this.known.use(shard, () => true) !== undefined);
+
+    const groups = new Map<number, typeof admitted>();
+    for (const a of admitted) {
+      const w = shardWorkerIndex(a.shard, this.workers.length);
+      const group = groups.get(w);
+      if (group) group.push(a);
+      else groups.set(w, [a]);
+    }
+
+    await Promise.all([...groups].map(async ([w, group]) => {
+      let processed: BatchSliceResult[];
+      try {
+        processed = await this.run(w, group.map(({ shard, slice }) => ({ shard, slice })));
+      } catch (err) {
+        const failed = err instanceof BatchWorkerError
+          ? { status: err.status, body: { error: err.code } }
+          : { status: 500, body: { error: 'tick_failed' } };
+        processed = group.map(({ shard }) => ({ shard, ...failed }));
+      }
+      group.forEach((a, i) => {
+        results[a.index] = processed[i] ?? { shard: a.shard, status: 500, body: { error: 'tick_failed' } };
+      });
+    }));
+    return results;
+  }
+
+  /** Hand events to the shard's worker. False if the shard hasn't ticked yet (or was dropped). */
+  ingestEvents(shard: string, events: unknown[]): boolean {
+    if (this.known.get(shard) === undefined) return false;
+    this.post(shardWorkerIndex(shard, this.workers.length), { type: 'events', shard, events });
+    return true;
+  }
+
+  /** Send a mode, lock or constraint change to every worker. */
+  broadcast(msg: BroadcastRequest): void {
+    switch (msg.type) {
+      case 'mode': this.mode = msg.mode; break;
+      case 'lock': this.locked.add(msg.param); break;
+      case 'unlock': this.locked.delete(msg.param); break;
+      case 'constrain': this.constraints.set(msg.param, msg.bounds); break;
+    }
+    for (let i = 0; i < this.workers.length; i++) this.post(i, msg);
+  }
+
+  async stop(): Promise<void> {
+    this.stopped = true;
+    for (let w = 0; w < this.workers.length; w++) {
+      this.failPending(w, new Error('Batch worker pool stopped'));
+    }
+    await Promise.all(this.workers.map(w => w.terminate()));
+  }
+
+  private spawn(w: number): void {
+    const worker = new Worker(this.script, { workerData: this.data });
+    worker.on('message', (reply: BatchWorkerReply) => {
+      this.failures[w] = 0;
+      const pending = this.pending[w]!;
+      const p = pending.get(reply.id);
+      if (!p) return;
+      pending.delete(reply.id);
+      clearTimeout(p.timer);
+      p.resolve(reply.results);
+    });
+    // 'exit' follows; that's where the worker is replaced
+    worker.on('error', (err) => {
+      console.error(`[AgentE Server] Batch worker ${w} failed:`, err);
+    });
+    worker.on('exit', (code) => {
+      if (this.stopped || this.workers[w] !== worker) return;
+      this.alive[w] = false;
+      this.failPending(w, new BatchWorkerError(503, 'worker_failed', `Batch worker ${w} exited with code ${code}`));
+      // Its economies are gone; the shards come back fresh on the replacement
+      for (const shard of [...this.known.keys()]) {
+        if (shardWorkerIndex(shard, this.workers.length) === w) this.known.delete(shard);
+      }
+      const failures = this.failures[w] ?? 0;
+      this.failures[w] = failures + 1;
+      const delay = failures === 0 ? 0 : Math.min(MAX_RESPAWN_DELAY_MS, 1000 * 2 ** (failures - 1));
+      console.error(`[AgentE Server] Batch worker ${w} exited with code ${code}; restarting${delay ? ` in ${delay}ms` : ''}`);
+      if (delay === 0) this.spawn(w);
+      else setTimeout(() => { if (!this.stopped) this.spawn(w); }, delay).unref();
+    });
+    worker.unref();
+    this.workers[w] = worker;
+    this.alive[w] = true;
+
+    if (this.mode) this.post(w, { type: 'mode', mode: this.mode });
+    for (const param of this.locked) this.post(w, { type: 'lock', param });
+    for (const [param, bounds] of this.constraints) this.post(w, { type: 'constrain', param, bounds });
+  }
+
+  private run(w: number, slices: { shard: string; slice: Record<string, unknown> }[]): Promise<BatchSliceResult[]> {
+    if (this.stopped) return Promise.reject(new Error('Batch worker pool stopped'));
+    if (!this.alive[w]) {
+      return Promise.reject(new BatchWorkerError(503, 'worker_failed', `Batch worker ${w} is restarting`));
+    }
+    const id = this.nextId++;
+    const pending = this.pending[w]!;
+    return new Promise((resolve, reject) => {
+      // A late reply finds no entry and is dropped
+      const timer = setTimeout(() => {
+        pending.delete(id);
+        reject(new BatchWorkerError(504, 'worker_timeout', `Batch worker ${w} did not answer within ${this.batchTimeoutMs}ms`));
+      }, this.batchTimeoutMs);
+      timer.unref();
+      pending.set(id, { resolve, reject, timer });
+      this.post(w, { type: 'tick', id, slices });
+    });
+  }
+
+  private failPending(w: number, err: Error): void {
+    const pending = this.pending[w]!;
+    for (const p of pending.values()) {
+      clearTimeout(p.timer);
+      p.reject(err);
+    }
+    pending.clear();
+  }
+
+  private post(w: number, msg: BatchWorkerRequest): void {
+    if (!this.stopped && this.alive[w]) this.workers[w]!.postMessage(msg);
+  }
+}
@@ -0,0 +1,220 @@
+import { describe, it, expect, beforeAll, afterAll } from 'vitest';
+import { WebSocket } from 'ws';
+import { AgentEServer } from '../src/AgentEServer.js';
+import { MSGPACK_CONTENT_TYPE, MSGPACK_SUBPROTOCOL, NameDictionary, decodeBinaryTick } from '../src/binary.js';
+import { decode, encode } from '../src/msgpack.js';
+
+function f64(values: number[]): Uint8Array {
+  const buf = Buffer.alloc(values.length * 8);
+  values.forEach((v, i) => buf.writeDoubleLE(v, i * 8));
+  return buf;
+}
+
+function u16(values: number[]): Uint8Array {
+  const buf = Buffer.alloc(values.length * 2);
+  values.forEach((v, i) => buf.writeUInt16LE(v, i * 2));
+  return buf;
+}
+
+// Names: 0 Fighter, 1 Crafter, 2 ore, 3 weapons, 4 gold, 5 a1, 6 a2
+const NAMES = ['Fighter', 'Crafter', 'ore', 'weapons', 'gold', 'a1', 'a2'];
+
+function binaryTick(tick = 100, dict: unknown = { e: 1, b: 0, n: NAMES }) {
+  return {
+    ...(dict ? { dict } : {}),
+    seq: tick,
+    tick,
+    roles: [0, 1],
+    resources: [2, 3],
+    currencies: [4],
+    agents: [5, 6],
+    agentRoles: u16([0, 1]),
+    balances: [f64([100, 50])],
+    inventories: [f64([0, 5]), f64([2, 0])],
+    prices: [f64([15, 50])],
+    events: [{ y: 'trade', ts: tick, a: 5, res: 2, amt: 1, p: 15, f: 6, to: 5 }],
+  };
+}
+
+// ── MessagePack codec ───────────────────────────────────────────────────────
+
+describe('msgpack', () => {
+  it('round-trips the types the wire format uses', () => {
+    const value = {
+      nil: null,
+      yes: true,
+      small: 7,
+      negative: -200,
+      big: 2 ** 40,
+      float: 1.5,
+      str: 'é'.repeat(40),
+      bin: new Uint8Array([1, 2, 3]),
+      list: Array.from({ length: 20 }, (_, i) => i),
+    };
+    const decoded = decode(encode(value)) as Record<string, unknown>;
+    expect({ ...decoded, bin: Array.from(decoded['bin'] as Uint8Array) }).toEqual({ ...value, bin: [1, 2, 3] });
+  });
+
+  it('rejects truncated input and drops prototype keys', () => {
+    const bytes = encode({ a: 'hello' });
+    expect(() => decode(bytes.subarray(0, bytes.length - 1))).toThrow();
+    expect(Object.keys(decode(encode({ __proto__x: 1, constructor: 2 })) as object)).toEqual(['__proto__x']);
+  });
+});
+
+// ── decodeBinaryTick ────────────────────────────────────────────────────────
+
+describe('decodeBinaryTick', () => {
+  it('expands ids and columns into a regular EconomyState', () => {
+    const result = decodeBinaryTick(encode(binaryTick()), new NameDictionary());
+    expect(result.ok).toBe(true);
+    if (!result.ok) return;
+
+    const state = result.payload['state'] as Record<string, unknown>;
+    expect(result.payload['seq']).toBe(100);
+    expect(state['agentBalances']).toEqual({ a1: { gold: 100 }, a2: { gold: 50 } });
+    expect(state['agentRoles']).toEqual({ a1: 'Fighter', a2: 'Crafter' });
+    expect(state['agentInventories']).toEqual({ a1: { weapons: 2 }, a2: { ore: 5 } });
+    expect(state['marketPrices']).toEqual({ gold: { ore: 15, weapons: 50 } });
+    expect(state['recentTransactions']).toEqual([
+      { type: 'trade', timestamp: 100, actor: 'a1', resource: 'ore', amount: 1, price: 15, from: 'a2', to: 'a1' },
+    ]);
+  });
+
+  it('reuses the session table when the dict section is omitted', () => {
+    const dict = new NameDictionary();
+    expect(decodeBinaryTick(encode(binaryTick(100)), dict).ok).toBe(true);
+    expect(decodeBinaryTick(encode(binaryTick(101, null)), dict).ok).toBe(true);
+  });
+
+  it('reports a dict that does not extend the current table', () => {
+    const dict = new NameDictionary();
+    decodeBinaryTick(encode(binaryTick()), dict);
+    const result = decodeBinaryTick(encode(binaryTick(101, { e: 1, b: 3, n: ['a3'] })), dict);
+    expect(result).toEqual({ ok: false, error: 'dictionary_mismatch', expectedEpoch: 1, expectedSize: 7 });
+  });
+
+  it('refuses prototype keys as names, and leaves the table alone', () => {
+    const dict = new NameDictionary();
+    const names = ['Fighter', 'Crafter', 'ore', 'weapons', '__proto__', 'a1', 'a2'];
+    const result = decodeBinaryTick(encode(binaryTick(100, { e: 1, b: 0, n: names })), dict);
+    expect(result).toMatchObject({ ok: false, error: 'invalid_binary' });
+    expect(dict.names).toEqual([]);
+
+    const extend = decodeBinaryTick(encode(binaryTick(100, { e: 1, b: 0, n: [...NAMES, 'constructor'] })), dict);
+    expect(extend).toMatchObject({ ok: false, error: 'invalid_binary' });
+  });
+
+  it('decodes the sampling section into exact totals by name', () => {
+    const sampling = { n: 40, rate: f64([0.5, 1]), count: f64([38, 2]), supply: f64([1200]) };
+    const result = decodeBinaryTick(encode({ ...binaryTick(), sampling }), new NameDictionary());
+    expect(result.ok).toBe(true);
+    if (!result.ok) return;
+    expect((result.payload['state'] as Record<string, unknown>)['sampling']).toEqual({
+      population: 40,
+      rateByRole: { Fighter: 0.5, Crafter: 1 },
+      populationByRole: { Fighter: 38, Crafter: 2 },
+      supplyByCurrency: { gold: 1200 },
+    });
+  });
+
+  it('decodes the aggregates section', () => {
+    const aggregates = {
+      n: 2, count: f64([1, 1]), supply: f64([150]), gini: f64([0.1667]), median: f64([75]),
+      top10: f64([0.6667]), stock: f64([5, 2]),
+    };
+    const result = decodeBinaryTick(encode({ ...binaryTick(), aggregates }), new NameDictionary());
+    expect(result.ok).toBe(true);
+    if (!result.ok) return;
+    expect((result.payload['state'] as Record<string, unknown>)['aggregates']).toEqual({
+      population: 2,
+      populationByRole: { Fighter: 1, Crafter: 1 },
+      supplyByCurrency: { gold: 150 },
+      giniByCurrency: { gold: 0.1667 },
+      medianBalanceByCurrency: { gold: 75 },
+      top10PctShareByCurrency: { gold: 0.6667 },
+      supplyByResource: { ore: 5, weapons: 2 },
+    });
+  });
+
+  it('rejects columns of the wrong length', () => {
+    const result = decodeBinaryTick(encode({ ...binaryTick(), balances: [f64([100])] }), new NameDictionary());
+    expect(result.ok).toBe(false);
+    if (!result.ok) expect(result.error).toBe('invalid_binary');
+  });
+});
+
+// ── Transports ──────────────────────────────────────────────────────────────
+
+describe('binary ticks over HTTP and WebSocket', () => {
+  let server: AgentEServer;
+  let port: number;
+
+  beforeAll(async () => {
+    server = new AgentEServer({ port: 0, agentE: { gracePeriod: 0, checkInterval: 1 } });
+    await server.start();
+    port = server.getAddress().port;
+  });
+
+  afterAll(async () => {
+    await server.stop();
+  });
+
+  it('accepts a MessagePack POST /tick and replies in MessagePack', async () => {
+    const res = await fetch(`http://127.0.0.1:${port}/tick`, {
+      method: 'POST',
+      headers: { 'Content-Type': MSGPACK_CONTENT_TYPE, Accept: MSGPACK_CONTENT_TYPE },
+      body: encode(binaryTick(100)),
+    });
+    expect(res.status).toBe(200);
+    expect(res.headers.get('content-type')).toBe(MSGPACK_CONTENT_TYPE);
+    const data = decode(new Uint8Array(await res.arrayBuffer())) as Record<string, unknown>;
+    expect(data['tick']).toBe(100);
+    expect(data['seq']).toBe(100);
+    expect(Array.isArray(data['adjustments'])).toBe(true);
+  });
+
+  it('returns 409 dictionary_mismatch for a dict gap', async () => {
+    const res = await fetch(`http://127.0.0.1:${port}/tick`, {
+      method: 'POST',
+      headers: { 'Content-Type': MSGPACK_CONTENT_TYPE },
+      body: encode(binaryTick(101, { e: 9, b: 50, n: [] })),
+    });
+    expect(res.status).toBe(409);
+    expect((await res.json()).error).toBe('dictionary_mismatch');
+  });
+
+  it('keeps a name table per shard', async () => {
+    const post = (body: unknown) => fetch(`http://127.0.0.1:${port}/tick`, {
+      method: 'POST',
+      headers: { 'Content-Type': MSGPACK_CONTENT_TYPE },
+      body: encode(body),
+    });
+    expect((await post({ ...binaryTick(300, { e: 5, b: 0, n: NAMES }), shard: 'bin-1' })).status).toBe(200);
+    expect((await post({ ...binaryTick(300, { e: 6, b: 0, n: NAMES }), shard: 'bin-2' })).status).toBe(200);
+    // Each extends its own table; neither reset the other's
+    expect((await post({ ...binaryTick(301, { e: 5, b: 7, n: ['a3'] }), shard: 'bin-1' })).status).toBe(200);
+    expect((await post({ ...binaryTick(301, { e: 6, b: 7, n: ['a3'] }), shard: 'bin-2' })).status).toBe(200);
+    expect([5, 6]).not.toContain(server.getBinaryDictionary().epoch);
+  });
+
+  it('answers binary WebSocket frames with binary tick_result frames', async () => {
+    const ws = new WebSocket(`ws://127.0.0.1:${port}`, MSGPACK_SUBPROTOCOL);
+    await new Promise((resolve, reject) => {
+      ws.on('open', resolve);
+      ws.on('error', reject);
+    });
+    expect(ws.protocol).toBe(MSGPACK_SUBPROTOCOL);
+
+    const reply = await new Promise<Record<string, unknown>>((resolve) => {
+      ws.once('message', (raw, isBinary) => {
+        expect(isBinary).toBe(true);
+        resolve(decode(raw as Buffer) as Record<string, unknown>);
+      });
+      ws.send(encode(binaryTick(200)));
+    });
+    expect(reply['type']).toBe('tick_result');
+    expect(reply['tick']).toBe(200);
+    ws.close();
+  });
+});
@@ -0,0 +1,167 @@
+import { describe, it, expect, beforeAll, afterAll } from 'vitest';
+import { AgentEServer } from '../src/AgentEServer.js';
+import { applyStateDelta, resolveTickState } from '../src/delta.js';
+
+function validState(tick = 100) {
+  return {
+    tick,
+    roles: ['Fighter', 'Crafter'],
+    resources: ['ore', 'weapons'],
+    currencies: ['gold'],
+    agentBalances: { a1: { gold: 100 }, a2: { gold: 50 } },
+    agentRoles: { a1: 'Fighter', a2: 'Crafter' },
+    agentInventories: { a1: { weapons: 2 }, a2: { ore: 5 } },
+    agentSatisfaction: { a1: 80, a2: 70 },
+    marketPrices: { gold: { ore: 15, weapons: 50 } },
+    recentTransactions: [],
+  };
+}
+
+// ── applyStateDelta ─────────────────────────────────────────────────────────
+
+describe('applyStateDelta', () => {
+  it('patches changed fields and keeps untouched agents shared', () => {
+    const base = validState();
+    const next = applyStateDelta(base, {
+      tick: 101,
+      agentBalances: { a1: { gold: 120 } },
+      agentInventories: { a2: { ore: null, weapons: 1 } },
+    });
+
+    expect(next.tick).toBe(101);
+    expect(next.agentBalances['a1']).toEqual({ gold: 120 });
+    expect(next.agentInventories['a2']).toEqual({ weapons: 1 });
+    expect(next.agentBalances['a2']).toBe(base.agentBalances['a2']);
+    // Base is never mutated
+    expect(base.agentBalances['a1']).toEqual({ gold: 100 });
+    expect(base.agentInventories['a2']).toEqual({ ore: 5 });
+  });
+
+  it('removes agents before applying upserts', () => {
+    const next = applyStateDelta(validState(), {
+      tick: 101,
+      removedAgents: ['a2'],
+      agentBalances: { a3: { gold: 10 } },
+      agentRoles: { a3: 'Crafter' },
+      agentInventories: { a3: {} },
+    });
+
+    expect(Object.keys(next.agentBalances).sort()).toEqual(['a1', 'a3']);
+    expect(next.agentRoles).toEqual({ a1: 'Fighter', a3: 'Crafter' });
+    expect(next.agentInventories['a2']).toBeUndefined();
+    expect(next.agentSatisfaction).toEqual({ a1: 80 });
+  });
+
+  it('replaces the sampling block when the delta carries one', () => {
+    const sampling = {
+      population: 10,
+      rateByRole: { Fighter: 0.5, Crafter: 1 },
+      populationByRole: { Fighter: 8, Crafter: 2 },
+      supplyByCurrency: { gold: 900 },
+    };
+    const base = { ...validState(), sampling };
+    expect(applyStateDelta(base, { tick: 101 }).sampling).toBe(sampling);
+    const next = applyStateDelta(base, { tick: 102, sampling: { ...sampling, population: 11 } });
+    expect(next.sampling?.population).toBe(11);
+  });
+
+  it('replaces events rather than accumulating them', () => {
+    const base = { ...validState(), recentTransactions: [{ type: 'mint' as const, timestamp: 1, actor: 'a1' }] };
+    expect(applyStateDelta(base, { tick: 101 }).recentTransactions).toEqual([]);
+  });
+});
+
+// ── resolveTickState ────────────────────────────────────────────────────────
+
+describe('resolveTickState', () => {
+  it('passes full states through with their seq', () => {
+    const state = validState();
+    const resolved = resolveTickState({ state, seq: 3 }, null);
+    expect(resolved).toEqual({ ok: true, state, seq: 3, delta: false });
+  });
+
+  it('rejects a delta whose base does not match', () => {
+    const resolved = resolveTickState(
+      { delta: { tick: 101 }, seq: 5, baseSeq: 4 },
+      { seq: 3, state: validState() },
+    );
+    expect(resolved).toEqual({ ok: false, error: 'delta_base_mismatch', expectedBaseSeq: 3 });
+  });
+
+  it('rejects a delta without sequence numbers', () => {
+    const resolved = resolveTickState({ delta: { tick: 101 } }, { seq: 3, state: validState() });
+    expect(resolved.ok).toBe(false);
+  });
+});
+
+// ── HTTP round trip ─────────────────────────────────────────────────────────
+
+describe('HTTP: delta ticks', () => {
+  let server: AgentEServer;
+  let baseUrl: string;
+
+  beforeAll(async () => {
+    server = new AgentEServer({ port: 0, agentE: { gracePeriod: 0, checkInterval: 1 } });
+    await server.start();
+    baseUrl = `http://127.0.0.1:${server.getAddress().port}`;
+  });
+
+  afterAll(async () => {
+    await server.stop();
+  });
+
+  function post(body: unknown) {
+    return fetch(`${baseUrl}/tick`, {
+      method: 'POST',
+      headers: { 'Content-Type': 'application/json' },
+      body: JSON.stringify(body),
+    });
+  }
+
+  it('returns 409 for a delta before any full state', async () => {
+    const res = await post({ delta: { tick: 1 }, seq: 1, baseSeq: 0 });
+    expect(res.status).toBe(409);
+    const data = await res.json();
+    expect(data.error).toBe('delta_base_mismatch');
+    expect(data.expectedBaseSeq).toBeNull();
+  });
+
+  it('rebuilds the full state from a full snapshot plus delta', async () => {
+    const full = await post({ state: validState(100), seq: 10 });
+    expect(full.status).toBe(200);
+    expect((await full.json()).seq).toBe(10);
+
+    const delta = await post({
+      delta: { tick: 101, agentBalances: { a1: { gold: 90 } } },
+      seq: 11,
+      baseSeq: 10,
+    });
+    expect(delta.status).toBe(200);
+    const data = await delta.json();
+    expect(data.tick).toBe(101);
+    expect(data.seq).toBe(11);
+
+    const base = server.getDeltaBase();
+    expect(base?.seq).toBe(11);
+    expect(base?.state.agentBalances['a1']).toEqual({ gold: 90 });
+    expect(base?.state.agentBalances['a2']).toEqual({ gold: 50 });
+  });
+
+  it('reports the expected base after a gap', async () => {
+    const res = await post({ delta: { tick: 103 }, seq: 13, baseSeq: 12 });
+    expect(res.status).toBe(409);
+    expect((await res.json()).expectedBaseSeq).toBe(11);
+  });
+
+  it('takes a full state from a client that restarted at a lower seq', async () => {
+    // The game restarted and counts from 0 again, while the base is still 11
+    const full = await post({ state: validState(5), seq: 0 });
+    expect(full.status).toBe(200);
+    expect(server.getDeltaBase()?.seq).toBe(0);
+
+    const delta = await post({ delta: { tick: 6, agentBalances: { a2: { gold: 40 } } }, seq: 1, baseSeq: 0 });
+    expect(delta.status).toBe(200);
+    expect(server.getDeltaBase()?.seq).toBe(1);
+    expect(server.getDeltaBase()?.state.agentBalances['a2']).toEqual({ gold: 40 });
+  });
+});
@@ -0,0 +1,24 @@
+// Stand-in for dist/batchWorker.js in the pool tests: answers every slice
+// with the thread that ran it and the config and broadcasts it was given.
+// A slice with `crash` kills the thread; one with `hang` is never answered.
+
+import { parentPort, threadId, workerData } from 'node:worker_threads';
+
+const broadcasts = [];
+
+parentPort.on('message', (msg) => {
+  if (msg.type !== 'tick') {
+    broadcasts.push(msg);
+    return;
+  }
+  if (msg.slices.some(s => s.slice.crash)) process.exit(3);
+  if (msg.slices.some(s => s.slice.hang)) return;
+  parentPort.postMessage({
+    id: msg.id,
+    results: msg.slices.map(({ shard, slice }) => ({
+      shard,
+      status: 200,
+      body: { thread: threadId, tick: slice.tick, config: workerData.economyConfig, broadcasts },
+    })),
+  });
+});
@@ -1,6 +1,8 @@
 import { describe, it, expect, beforeAll, afterAll } from 'vitest';
 import { AgentEServer } from '../src/AgentEServer.js';
+import { ALL_PRINCIPLES, emptyMetrics, type AgentE, type ActionPlan, type Diagnosis } from '@agent-e/engine';
 import { WebSocket } from 'ws';
+import { gzipSync } from 'node:zlib';
 
 let server: AgentEServer;
 let baseUrl: string;
@@ -89,6 +91,18 @@ describe('HTTP: POST /tick', () => {
     const data = await res.json();
     expect(Array.isArray(data.adjustments)).toBe(true);
   });
+
+  it('reports how long the tick took on the server', async () => {
+    const res = await fetch(`${baseUrl}/tick`, {
+      method: 'POST',
+      headers: { 'Content-Type': 'application/json' },
+      body: JSON.stringify({ state: validState(300) }),
+    });
+    expect(res.status).toBe(200);
+    const data = await res.json();
+    expect(typeof data.processingMs).toBe('number');
+    expect(data.processingMs).toBeGreaterThanOrEqual(0);
+  });
 });
 
 describe('HTTP: GET /health', () => {
@@ -103,6 +117,26 @@ describe('HTTP: GET /health', () => {
     expect(data).toHaveProperty('activePlans');
     expect(typeof data.uptime).toBe('number');
   });
+
+  it('answers a matching If-None-Match with 304 until a tick lands', async () => {
+    const first = await fetch(`${baseUrl}/health`);
+    const etag = first.headers.get('etag');
+    expect(etag).toMatch(/^W\/"/);
+
+    const cached = await fetch(`${baseUrl}/health`, { headers: { 'If-None-Match': etag! } });
+    expect(cached.status).toBe(304);
+    expect(await cached.text()).toBe('');
+
+    await fetch(`${baseUrl}/tick`, {
+      method: 'POST',
+      headers: { 'Content-Type': 'application/json' },
+      body: JSON.stringify({ state: validState(900) }),
+    });
+    const fresh = await fetch(`${baseUrl}/health`, { headers: { 'If-None-Match': etag! } });
+    expect(fresh.status).toBe(200);
+    expect(fresh.headers.get('etag')).not.toBe(etag);
+    expect(await fresh.json()).toHaveProperty('health');
+  });
 });
 
 describe('HTTP: GET /decisions', () => {
@@ -160,6 +194,187 @@ describe('HTTP: POST /diagnose', () => {
   });
 });
 
+describe('HTTP: compressed bodies', () => {
+  it('accepts a gzip tick body', async () => {
+    const res = await fetch(`${baseUrl}/tick`, {
+      method: 'POST',
+      headers: { 'Content-Type': 'application/json', 'Content-Encoding': 'gzip' },
+      body: gzipSync(JSON.stringify({ state: validState() })),
+    });
+    expect(res.status).toBe(200);
+    const data = await res.json();
+    expect(data).toHaveProperty('health');
+  });
+
+  it('rejects an unsupported Content-Encoding with 415', async () => {
+    const res = await fetch(`${baseUrl}/tick`, {
+      method: 'POST',
+      headers: { 'Content-Type': 'application/json', 'Content-Encoding': 'br' },
+      body: 'x',
+    });
+    expect(res.status).toBe(415);
+    const data = await res.json();
+    expect(data.error).toBe('unsupported_encoding');
+  });
+
+  it('counts the decompressed size against the body limit', async () => {
+    // ~2 MB of zeros compresses to a few KB
+    const res = await fetch(`${baseUrl}/tick`, {
+      method: 'POST',
+      headers: { 'Content-Type': 'application/json', 'Content-Encoding': 'gzip' },
+      body: gzipSync(Buffer.alloc(2 * 1_048_576, 0x20)),
+    });
+    expect(res.status).toBe(413);
+    const data = await res.json();
+    expect(data.error).toBe('body_too_large');
+  });
+
+  it('rejects a corrupt gzip body with 400', async () => {
+    const res = await fetch(`${baseUrl}/tick`, {
+      method: 'POST',
+      headers: { 'Content-Type': 'application/json', 'Content-Encoding': 'gzip' },
+      body: 'not gzip at all',
+    });
+    expect(res.status).toBe(400);
+    const data = await res.json();
+    expect(data.error).toBe('invalid_encoding');
+  });
+});
+
+describe('HTTP: POST /events', () => {
+  it('ingests a batch of events', async () => {
+    const res = await fetch(`${baseUrl}/events`, {
+      method: 'POST',
+      headers: { 'Content-Type': 'application/json' },
+      body: JSON.stringify({
+        events: [
+          { type: 'trade', actor: 'a1', timestamp: 100, resource: 'ore', price: 15 },
+          { type: 'bogus', actor: 'a1', timestamp: 100 },
+        ],
+      }),
+    });
+    expect(res.status).toBe(200);
+    expect(await res.json()).toEqual({ accepted: 1, rejected: 1 });
+  });
+
+  it('rejects oversized batches', async () => {
+    const events = Array.from({ length: 1001 }, (_, i) => ({ type: 'mint', actor: 'a1', timestamp: i }));
+    const res = await fetch(`${baseUrl}/events`, {
+      method: 'POST',
+      headers: { 'Content-Type': 'application/json' },
+      body: JSON.stringify({ events }),
+    });
+    expect(res.status).toBe(400);
+    expect((await res.json()).error).toBe('batch_too_large');
+  });
+});
+
+describe('HTTP: POST /tick/batch', () => {
+  const post = (body: unknown) => fetch(`${baseUrl}/tick/batch`, {
+    method: 'POST',
+    headers: { 'Content-Type': 'application/json' },
+    body: JSON.stringify(body),
+  });
+
+  it('runs each shard against its own economy and answers per shard', async () => {
+    const res = await post({
+      shards: [
+        { shard: 'zone-1', state: validState(10), seq: 1 },
+        { shard: 'zone-2', state: validState(20), seq: 1 },
+        { shard: 'zone-3', state: { tick: -1 } },
+      ],
+    });
+    expect(res.status).toBe(200);
+    const { results } = await res.json();
+    expect(results.map((r: { shard: string }) => r.shard)).toEqual(['zone-1', 'zone-2', 'zone-3']);
+    expect(results[0]).toMatchObject({ status: 200, body: { tick: 10, seq: 1 } });
+    expect(results[1]).toMatchObject({ status: 200, body: { tick: 20, seq: 1 } });
+    expect(results[0].body).toHaveProperty('adjustments');
+    expect(results[2]).toMatchObject({ status: 400, body: { error: 'invalid_state' } });
+  });
+
+  it('keeps a delta base per shard', async () => {
+    await post({ shards: [{ shard: 'delta-a', state: validState(30), seq: 5 }, { shard: 'delta-b', state: validState(30), seq: 9 }] });
+    const res = await post({
+      shards: [
+        { shard: 'delta-a', delta: { tick: 31 }, seq: 6, baseSeq: 5 },
+        { shard: 'delta-b', delta: { tick: 31 }, seq: 6, baseSeq: 5 },
+      ],
+    });
+    const { results } = await res.json();
+    expect(results[0]).toMatchObject({ status: 200, body: { tick: 31, seq: 6 } });
+    expect(results[1]).toMatchObject({ status: 409, body: { error: 'delta_base_mismatch', expectedBaseSeq: 9 } });
+  });
+
+  it('rejects bad slices without failing the batch', async () => {
+    const res = await post({
+      shards: [
+        { state: validState() },
+        { shard: 'zone-1', state: validState(11) },
+        { shard: 'zone-1', state: validState(11) },
+      ],
+    });
+    const { results } = await res.json();
+    expect(results[0]).toMatchObject({ shard: null, status: 400, body: { error: 'invalid_shard' } });
+    expect(results[1].status).toBe(200);
+    expect(results[2]).toMatchObject({ status: 400, body: { error: 'duplicate_shard' } });
+  });
+
+  it('rejects an empty or oversized batch', async () => {
+    expect((await post({ shards: [] })).status).toBe(400);
+    const shards = Array.from({ length: 65 }, (_, i) => ({ shard: `s${i}`, state: validState() }));
+    const res = await post({ shards });
+    expect(res.status).toBe(400);
+    expect((await res.json()).error).toBe('batch_too_large');
+  });
+
+  it('routes shard events to the shard economy', async () => {
+    const res = await fetch(`${baseUrl}/events`, {
+      method: 'POST',
+      headers: { 'Content-Type': 'application/json' },
+      body: JSON.stringify({ shard: 'zone-1', events: [{ type: 'trade', actor: 'a1', timestamp: 100 }] }),
+    });
+    expect(await res.json()).toEqual({ accepted: 1, rejected: 0 });
+  });
+
+  it('does not create a shard from events alone', async () => {
+    const before = server.getShardCount();
+    const res = await fetch(`${baseUrl}/events`, {
+      method: 'POST',
+      headers: { 'Content-Type': 'application/json' },
+      body: JSON.stringify({ shard: 'never-ticked', events: [{ type: 'trade', actor: 'a1', timestamp: 100 }] }),
+    });
+    expect(await res.json()).toEqual({ accepted: 0, rejected: 1 });
+    expect(server.getShardCount()).toBe(before);
+  });
+});
+
+describe('HTTP: POST /tick with a shard', () => {
+  const post = (body: unknown) => fetch(`${baseUrl}/tick`, {
+    method: 'POST',
+    headers: { 'Content-Type': 'application/json' },
+    body: JSON.stringify(body),
+  });
+
+  it('ticks the shard economy and leaves the main one alone', async () => {
+    const mainBase = server.getDeltaBase();
+    const first = await post({ shard: 'solo-1', state: validState(40), seq: 1 });
+    expect(first.status).toBe(200);
+    expect(await first.json()).toMatchObject({ tick: 40, seq: 1 });
+
+    const delta = await post({ shard: 'solo-1', delta: { tick: 41 }, seq: 2, baseSeq: 1 });
+    expect(await delta.json()).toMatchObject({ tick: 41, seq: 2 });
+    expect((await post({ shard: 'solo-2', delta: { tick: 41 }, seq: 2, baseSeq: 1 })).status).toBe(409);
+    expect(server.getDeltaBase()).toBe(mainBase);
+  });
+
+  it('rejects an invalid shard ID', async () => {
+    const res = await post({ shard: 'not a shard', state: validState() });
+    expect(res.status).toBe(400);
+    expect((await res.json()).error).toBe('invalid_shard');
+  });
+});
+
 describe('HTTP: CORS', () => {
   it('includes CORS headers in response', async () => {
     const res = await fetch(`${baseUrl}/health`);
@@ -264,6 +479,100 @@ describe('HTTP: POST /reject', () => {
   });
 });
 
+// ── Approving Decisions (separate server in advisor mode) ───────────────────
+
+/** Log an advisor recommendation as the engine would, and return its ID. */
+function seedPendingDecision(target: AgentEServer, parameter: string): string {
+  const agentE = (target as unknown as { agentE: AgentE }).agentE;
+  const metrics = emptyMetrics(1);
+  const diagnosis: Diagnosis = {
+    principle: ALL_PRINCIPLES[0]!,
+    violation: {
+      violated: true,
+      severity: 5,
+      evidence: {},
+      suggestedAction: { parameterType: 'cost', direction: 'decrease', reasoning: 'test' },
+      confidence: 0.9,
+    },
+    tick: 1,
+  };
+  const plan: ActionPlan = {
+    id: `plan_${parameter}`,
+    diagnosis,
+    parameter,
+    currentValue: 10,
+    targetValue: 9,
+    maxChangePercent: 0.15,
+    cooldownTicks: 10,
+    rollbackCondition: { metric: 'avgSatisfaction', direction: 'below', threshold: 0, checkAfterTick: 1000 },
+    simulationResult: {
+      proposedAction: diagnosis.violation.suggestedAction,
+      iterations: 1,
+      forwardTicks: 1,
+      outcomes: { p10: metrics, p50: metrics, p90: metrics, mean: metrics },
+      netImprovement: true,
+      noNewProblems: true,
+      confidenceInterval: [0, 1],
+      estimatedEffectTick: 2,
+      overshootRisk: 0,
+    },
+    estimatedLag: 1,
+  };
+  return agentE.log.record(diagnosis, plan, 'skipped_override', metrics).id;
+}
+
+describe('HTTP: approving a decision', () => {
+  let advisor: AgentEServer;
+  let advisorUrl: string;
+
+  beforeAll(async () => {
+    advisor = new AgentEServer({ port: 0, agentE: { mode: 'advisor', gracePeriod: 0, checkInterval: 1 } });
+    await advisor.start();
+    advisorUrl = `http://127.0.0.1:${advisor.getAddress().port}`;
+  });
+
+  afterAll(async () => {
+    await advisor.stop();
+  });
+
+  const approve = (decisionId: string) => fetch(`${advisorUrl}/approve`, {
+    method: 'POST',
+    headers: { 'Content-Type': 'application/json' },
+    body: JSON.stringify({ decisionId }),
+  });
+
+  it('changes the health ETag and activePlans', async () => {
+    const before = await fetch(`${advisorUrl}/health`);
+    const etag = before.headers.get('etag')!;
+    const { activePlans } = await before.json();
+
+    const res = await approve(seedPendingDecision(advisor, 'craftingCost'));
+    expect(res.status).toBe(200);
+
+    const after = await fetch(`${advisorUrl}/health`, { headers: { 'If-None-Match': etag } });
+    expect(after.status).toBe(200);
+    expect(after.headers.get('etag')).not.toBe(etag);
+    expect((await after.json()).activePlans).toBe(activePlans + 1);
+  });
+
+  it('applies a decision once when two approvals race a tick', async () => {
+    const id = seedPendingDecision(advisor, 'tradeFee');
+    // The tick holds the economy's lock, so both approvals wait on it
+    const tick = fetch(`${advisorUrl}/tick`, {
+      method: 'POST',
+      headers: { 'Content-Type': 'application/json' },
+      body: JSON.stringify({ state: validState(5) }),
+    });
+    const [first, second] = await Promise.all([approve(id), approve(id)]);
+    await tick;
+
+    expect([first.status, second.status].sort()).toEqual([200, 409]);
+    const refused = await (first.status === 409 ? first : second).json();
+    expect(refused).toMatchObject({ error: 'decision_not_pending' });
+    expect(['applying', 'applied']).toContain(refused.currentResult);
+  });
+});
+
 // ── Auth Tests (separate server with apiKey) ────────────────────────────────
 
 describe('Auth: API key enforcement', () => {
@@ -571,6 +880,18 @@ describe('WebSocket', () => {
     ws.close();
   });
 
+  it('answers a health message with a matching ifNoneMatch as notModified', async () => {
+    const ws = await connectWs();
+    const first = await sendAndReceive(ws, { type: 'health' });
+    const etag = first['etag'];
+    expect(typeof etag).toBe('string');
+    const second = await sendAndReceive(ws, { type: 'health', ifNoneMatch: etag });
+    expect(second['type']).toBe('health_result');
+    expect(second['notModified']).toBe(true);
+    expect(second).not.toHaveProperty('health');
+    ws.close();
+  });
+
   it('returns error with message field for malformed input', async () => {
     const ws = await connectWs();
     const response = await sendAndReceive(ws, { notType: 'hello' });
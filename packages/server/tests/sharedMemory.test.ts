@@ -0,0 +1,186 @@
+import { describe, it, expect, beforeAll, afterAll } from 'vitest';
+import * as fs from 'node:fs';
+import * as net from 'node:net';
+import { AgentEServer } from '../src/AgentEServer.js';
+import { decode, encode } from '../src/msgpack.js';
+import {
+  SHM_FRAME_TICK,
+  SHM_HEADER_BYTES,
+  SHM_MAGIC,
+  SHM_VERSION,
+  sharedMemoryAvailable,
+  shmFrameBytes,
+} from '../src/sharedMemory.js';
+
+const RING = 65_536;
+
+function f64(values: number[]): Uint8Array {
+  const buf = Buffer.alloc(values.length * 8);
+  values.forEach((v, i) => buf.writeDoubleLE(v, i * 8));
+  return buf;
+}
+
+function u16(values: number[]): Uint8Array {
+  const buf = Buffer.alloc(values.length * 2);
+  values.forEach((v, i) => buf.writeUInt16LE(v, i * 2));
+  return buf;
+}
+
+function binaryTick(tick: number) {
+  return {
+    ...(tick === 1 ? { dict: { e: 1, b: 0, n: ['Fighter', 'Crafter', 'ore', 'weapons', 'gold', 'a1', 'a2'] } } : {}),
+    seq: tick,
+    tick,
+    roles: [0, 1],
+    resources: [2, 3],
+    currencies: [4],
+    agents: [5, 6],
+    agentRoles: u16([0, 1]),
+    balances: [f64([100, 50])],
+    inventories: [f64([0, 5]), f64([2, 0])],
+    prices: [f64([15, 50])],
+  };
+}
+
+/** Test stand-in for the game client: owns the region and both rings' client side */
+class RegionClient {
+  readonly path: string;
+  private readonly fd: number;
+  private socket!: net.Socket;
+  private reqHead = 0;
+  private repTail = 0;
+  private bells: Buffer = Buffer.alloc(0);
+  private waiters: (() => void)[] = [];
+  /** Latest server positions */
+  reqTail = 0;
+  repHead = 0;
+
+  constructor(readonly name: string) {
+    this.path = `/dev/shm/${name}`;
+    this.fd = fs.openSync(this.path, 'w+');
+    fs.ftruncateSync(this.fd, SHM_HEADER_BYTES + RING * 2);
+    const header = Buffer.alloc(16);
+    header.writeUInt32LE(SHM_MAGIC, 0);
+    header.writeUInt32LE(SHM_VERSION, 4);
+    header.writeUInt32LE(RING, 8);
+    header.writeUInt32LE(RING, 12);
+    fs.writeSync(this.fd, header, 0, 16, 0);
+  }
+
+  /** Connect and handshake; resolves on the server's first doorbell, rejects if refused */
+  connect(port: number, hello = `AGSM1 ${this.name} -\n`): Promise<void> {
+    return new Promise((resolve, reject) => {
+      this.socket = net.connect(port, '127.0.0.1', () => this.socket.write(hello));
+      this.socket.on('data', (chunk: Buffer) => {
+        this.bells = Buffer.concat([this.bells, chunk]);
+        while (this.bells.length >= 8) {
+          this.reqTail = this.bells.readUInt32LE(0);
+          this.repHead = this.bells.readUInt32LE(4);
+          this.bells = this.bells.subarray(8);
+        }
+        resolve();
+        for (const w of this.waiters.splice(0)) w();
+      });
+      this.socket.on('close', () => reject(new Error('refused')));
+    });
+  }
+
+  sendTick(body: Buffer): void {
+    const frame = Buffer.alloc(shmFrameBytes(body.length));
+    frame.writeUInt32LE(body.length, 0);
+    frame.writeUInt32LE(SHM_FRAME_TICK, 4);
+    body.copy(frame, 8);
+    fs.writeSync(this.fd, frame, 0, frame.length, SHM_HEADER_BYTES + (this.reqHead % RING));
+    this.reqHead += frame.length;
+    this.ring();
+  }
+
+  /** Next reply frame, waiting for its doorbell */
+  async nextReply(): Promise<{ status: number; body: Record<string, unknown> }> {
+    while (this.repHead === this.repTail) {
+      await new Promise<void>(resolve => this.waiters.push(resolve));
+    }
+    const header = Buffer.alloc(8);
+    const base = SHM_HEADER_BYTES + RING;
+    fs.readSync(this.fd, header, 0, 8, base + (this.repTail % RING));
+    const length = header.readUInt32LE(0);
+    const body = Buffer.alloc(length);
+    fs.readSync(this.fd, body, 0, length, base + ((this.repTail + 8) % RING));
+    this.repTail += shmFrameBytes(length);
+    this.ring();
+    return { status: header.readUInt32LE(4), body: decode(body) as Record<string, unknown> };
+  }
+
+  close(): void {
+    this.socket?.destroy();
+    fs.closeSync(this.fd);
+    fs.rmSync(this.path, { force: true });
+  }
+
+  private ring(): void {
+    const bell = Buffer.alloc(8);
+    bell.writeUInt32LE(this.reqHead, 0);
+    bell.writeUInt32LE(this.repTail, 4);
+    this.socket.write(bell);
+  }
+}
+
+describe.skipIf(!sharedMemoryAvailable())('shared-memory transport', () => {
+  let server: AgentEServer;
+  let port: number;
+
+  beforeAll(async () => {
+    server = new AgentEServer({ port: 0, sharedMemoryPort: 0 });
+    await server.start();
+    port = server.getSharedMemoryPort()!;
+  });
+
+  afterAll(async () => {
+    await server.stop();
+  });
+
+  it('answers binary ticks through the reply ring', async () => {
+    const client = new RegionClient(`agente-test-${process.pid}-a`);
+    try {
+      await client.connect(port);
+
+      client.sendTick(encode(binaryTick(1)));
+      const first = await client.nextReply();
+      expect(first.status).toBe(200);
+      expect(first.body['tick']).toBe(1);
+      expect(typeof first.body['health']).toBe('number');
+
+      // The name table persists for the attachment, like a WebSocket's
+      client.sendTick(encode(binaryTick(2)));
+      const second = await client.nextReply();
+      expect(second.status).toBe(200);
+      expect(second.body['seq']).toBe(2);
+      expect(client.reqTail).toBeGreaterThan(0);
+    } finally {
+      client.close();
+    }
+  });
+
+  it('answers a bad frame with the status /tick would have used', async () => {
+    const client = new RegionClient(`agente-test-${process.pid}-b`);
+    try {
+      await client.connect(port);
+      // References names this attachment has never been sent
+      client.sendTick(encode({ ...binaryTick(2), dict: { e: 9, b: 7, n: ['x'] } }));
+      const reply = await client.nextReply();
+      expect(reply.status).toBe(409);
+      expect(reply.body['error']).toBe('dictionary_mismatch');
+    } finally {
+      client.close();
+    }
+  });
+
+  it('refuses regions outside the agente- namespace', async () => {
+    const client = new RegionClient(`agente-test-${process.pid}-c`);
+    try {
+      await expect(client.connect(port, 'AGSM1 ../etc/passwd -\n')).rejects.toThrow('refused');
+    } finally {
+      client.close();
+    }
+  });
+});
@@ -64,9 +64,13 @@ describe('WebSocket: rate limiting', () => {
     expect(first['type']).toBe('tick_result');
 
     // Immediate second tick (within 100ms) should be rate-limited
-    const second = await sendAndReceive(ws, { type: 'tick', state: validState(501) });
+    const second = await sendAndReceive(ws, { type: 'tick', seq: 7, state: validState(501) });
     expect(second['type']).toBe('error');
     expect(second['message']).toContain('Rate limited');
+    expect(second['code']).toBe('rate_limited');
+    // Marked as the answer to that tick
+    expect(second['replyTo']).toBe('tick');
+    expect(second['seq']).toBe(7);
 
     ws.close();
   });
@@ -90,6 +94,8 @@ describe('WebSocket: event ingestion', () => {
     const response = await sendAndReceive(ws, { type: 'event' });
     expect(response['type']).toBe('error');
     expect(response['message']).toContain('Missing');
+    // Not a tick error, so clients don't count it against a tick in flight
+    expect(response).not.toHaveProperty('replyTo');
     ws.close();
   });
 
@@ -114,6 +120,20 @@ describe('WebSocket: event ingestion', () => {
     expect(response['message']).toContain('Invalid event');
     ws.close();
   });
+
+  it('ingests a batch and counts rejected events', async () => {
+    const ws = await connect();
+    const response = await sendAndReceive(ws, {
+      type: 'events',
+      events: [
+        { type: 'mint', actor: 'a1', timestamp: 100, amount: 5 },
+        { type: 'trade', actor: 'a2', timestamp: 101 },
+        { type: 'trade', actor: 'a2' }, // missing timestamp
+      ],
+    });
+    expect(response).toEqual({ type: 'events_ack', accepted: 2, rejected: 1 });
+    ws.close();
+  });
 });
 
 // ── Diagnose Message ────────────────────────────────────────────────────────
@@ -179,6 +199,122 @@ describe('WebSocket: malformed JSON', () => {
   });
 });
 
+// ── Chunked Messages ────────────────────────────────────────────────────────
+
+function chunk(id: number, flags: number, payload: Buffer): Buffer {
+  const header = Buffer.alloc(6);
+  header[0] = 0xc1;
+  header[1] = flags;
+  header.writeUInt32LE(id, 2);
+  return Buffer.concat([header, payload]);
+}
+
+describe('WebSocket: chunked messages', () => {
+  it('reassembles a chunked tick and answers control messages between its pieces', async () => {
+    const ws = await connect();
+    const body = Buffer.from(JSON.stringify({ type: 'tick', state: validState(700) }));
+    const half = Math.floor(body.length / 2);
+
+    const replies: Record<string, unknown>[] = [];
+    const done = new Promise<void>((resolve) => {
+      ws.on('message', (raw) => {
+        replies.push(JSON.parse(raw.toString()));
+        if (replies.length === 2) resolve();
+      });
+    });
+
+    ws.send(chunk(7, 0, body.subarray(0, half)));
+    ws.send(JSON.stringify({ type: 'health' }));
+    ws.send(chunk(7, 1, body.subarray(half)));
+    await done;
+
+    expect(replies[0]!['type']).toBe('health_result');
+    expect(replies[1]!['type']).toBe('tick_result');
+    ws.close();
+  });
+
+  it('rejects a truncated chunk header', async () => {
+    const ws = await connect();
+    const response = await new Promise<Record<string, unknown>>((resolve) => {
+      ws.once('message', (raw) => resolve(JSON.parse(raw.toString())));
+      ws.send(Buffer.from([0xc1, 1]));
+    });
+    expect(response['type']).toBe('error');
+    expect(response['code']).toBe('invalid_chunk');
+    ws.close();
+  });
+});
+
+// ── Decisions ───────────────────────────────────────────────────────────────
+
+describe('WebSocket: approve / reject', () => {
+  it('answers decision_result outside advisor mode', async () => {
+    const ws = await connect();
+    const response = await sendAndReceive(ws, { type: 'approve', decisionId: 'd1' });
+    expect(response['type']).toBe('decision_result');
+    expect(response['action']).toBe('approve');
+    expect(response['status']).toBe(400);
+    expect(response['error']).toBe('not_in_advisor_mode');
+    ws.close();
+  });
+
+  it('requires a decision id', async () => {
+    const ws = await connect();
+    const response = await sendAndReceive(ws, { type: 'reject' });
+    expect(response['type']).toBe('decision_result');
+    expect(response['status']).toBe(400);
+    expect(response['error']).toBe('missing_decision_id');
+    ws.close();
+  });
+});
+
+// ── Subscriptions ───────────────────────────────────────────────────────────
+
+describe('WebSocket: subscribe', () => {
+  it('pushes to subscribed connections only', async () => {
+    const subscriber = await connect();
+    const other = await connect();
+    const ack = await sendAndReceive(subscriber, { type: 'subscribe' });
+    expect(ack['type']).toBe('subscribed');
+    expect(ack['subscribed']).toBe(true);
+
+    const pushed = new Promise<Record<string, unknown>>((resolve) => {
+      subscriber.once('message', (raw) => resolve(JSON.parse(raw.toString())));
+    });
+    server.push({ type: 'adjustment', source: 'approve', tick: 7, adjustments: [{ parameter: 'craftingCost', value: 2 }] });
+    const frame = await pushed;
+    expect(frame['type']).toBe('adjustment');
+    expect(frame['adjustments']).toEqual([{ parameter: 'craftingCost', value: 2 }]);
+
+    // Frames arrive in order: a push to `other` would come before its health reply
+    const health = await sendAndReceive(other, { type: 'health' });
+    expect(health['type']).toBe('health_result');
+
+    subscriber.close();
+    other.close();
+  });
+
+  it('skips the connection named as the source', async () => {
+    const ws = await connect();
+    await sendAndReceive(ws, { type: 'subscribe' });
+    server.push({ type: 'alert', tick: 1, alerts: [] }, ws);
+    const health = await sendAndReceive(ws, { type: 'health' });
+    expect(health['type']).toBe('health_result');
+    ws.close();
+  });
+
+  it('stops pushing after unsubscribe', async () => {
+    const ws = await connect();
+    await sendAndReceive(ws, { type: 'subscribe' });
+    const ack = await sendAndReceive(ws, { type: 'unsubscribe' });
+    expect(ack['subscribed']).toBe(false);
+    server.push({ type: 'alert', tick: 1, alerts: [] });
+    const health = await sendAndReceive(ws, { type: 'health' });
+    expect(health['type']).toBe('health_result');
+    ws.close();
+  });
+});
+
 // ── Pong / Heartbeat ────────────────────────────────────────────────────────
 
 describe('WebSocket: heartbeat', () => {
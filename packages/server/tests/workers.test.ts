@@ -0,0 +1,201 @@
+import { describe, it, expect, afterEach } from 'vitest';
+import { fileURLToPath } from 'node:url';
+import {
+  BatchWorkerPool, defaultWorkerCount, shardWorkerIndex, workerEconomyConfig,
+} from '../src/workers.js';
+import { ShardTable, admitSlices, type BatchSliceResult } from '../src/batch.js';
+import type { EconomyConfig } from '../src/economy.js';
+
+const ECHO_WORKER = fileURLToPath(new URL('./fixtures/echoWorker.mjs', import.meta.url));
+
+// ── shardWorkerIndex ────────────────────────────────────────────────────────
+
+describe('shardWorkerIndex', () => {
+  it('pins a shard to the same worker every time', () => {
+    for (const shard of ['zone-1', 'zone-2', 'eu:west.3']) {
+      expect(shardWorkerIndex(shard, 7)).toBe(shardWorkerIndex(shard, 7));
+    }
+  });
+
+  it('stays in range and spreads shards over the workers', () => {
+    const counts = new Array(4).fill(0);
+    for (let i = 0; i < 400; i++) {
+      const w = shardWorkerIndex(`zone-${i}`, 4);
+      expect(w).toBeGreaterThanOrEqual(0);
+      expect(w).toBeLessThan(4);
+      counts[w]++;
+    }
+    for (const c of counts) expect(c).toBeGreaterThan(50);
+  });
+
+  it('uses worker 0 when there is one worker', () => {
+    expect(shardWorkerIndex('anything', 1)).toBe(0);
+  });
+});
+
+describe('defaultWorkerCount', () => {
+  it('is at least one', () => {
+    expect(defaultWorkerCount()).toBeGreaterThanOrEqual(1);
+  });
+});
+
+// ── admitSlices ─────────────────────────────────────────────────────────────
+
+describe('admitSlices', () => {
+  it('fills in rejected slices and returns the rest with their positions', () => {
+    const { results, admitted } = admitSlices(
+      [{ shard: 'a' }, { shard: 'bad id' }, { shard: 'a' }, { shard: 'b' }, { shard: 'c' }],
+      (shard) => shard !== 'c',
+    );
+    expect(admitted.map(a => [a.index, a.shard])).toEqual([[0, 'a'], [3, 'b']]);
+    expect(results[1]).toMatchObject({ shard: null, status: 400, body: { error: 'invalid_shard' } });
+    expect(results[2]).toMatchObject({ shard: 'a', status: 400, body: { error: 'duplicate_shard' } });
+    expect(results[4]).toMatchObject({ shard: 'c', status: 503, body: { error: 'too_many_shards' } });
+    expect(results[0]).toBeUndefined();
+  });
+});
+
+// ── ShardTable ──────────────────────────────────────────────────────────────
+
+describe('ShardTable', () => {
+  it('drops idle shards to make room and refuses while all are active', () => {
+    const evicted: string[] = [];
+    const table = new ShardTable<string>((id) => evicted.push(id), 2, 1000);
+    expect(table.use('a', () => 'A', 0)).toBe('A');
+    expect(table.use('b', () => 'B', 500)).toBe('B');
+    expect(table.use('c', () => 'C', 900)).toBeUndefined();
+
+    // 'a' is idle now; 'b' was used more recently
+    expect(table.use('c', () => 'C', 1200)).toBe('C');
+    expect(evicted).toEqual(['a']);
+    expect([...table.keys()]).toEqual(['b', 'c']);
+  });
+
+  it('counts a use as activity and never creates from get', () => {
+    const evicted: string[] = [];
+    const table = new ShardTable<string>((id) => evicted.push(id), 2, 1000);
+    table.use('a', () => 'A', 0);
+    table.use('b', () => 'B', 100);
+    expect(table.get('a', 1050)).toBe('A');
+    expect(table.get('missing', 1050)).toBeUndefined();
+    expect(table.size).toBe(2);
+
+    // 'b' is the least recently used now
+    table.use('c', () => 'C', 1200);
+    expect(evicted).toEqual(['b']);
+    expect(table.get('a', 1300)).toBe('A');
+  });
+
+  it('drops every idle shard when one is created', () => {
+    const evicted: string[] = [];
+    const table = new ShardTable<string>((id) => evicted.push(id), 10, 1000);
+    table.use('a', () => 'A', 0);
+    table.use('b', () => 'B', 10);
+    table.use('c', () => 'C', 5000);
+    expect(evicted).toEqual(['a', 'b']);
+    expect(table.size).toBe(1);
+  });
+});
+
+// ── workerEconomyConfig ─────────────────────────────────────────────────────
+
+describe('workerEconomyConfig', () => {
+  it('keeps the plain-data fields and drops functions and instances', () => {
+    const config = {
+      mode: 'advisor',
+      gracePeriod: 3,
+      thresholds: { giniWarnThreshold: 0.4 },
+      principles: [{ id: 'custom', check: () => ({ violated: false }) }],
+      onDecision: () => {},
+    } as unknown as EconomyConfig;
+    const out = workerEconomyConfig(config);
+    expect(out).toEqual({ mode: 'advisor', gracePeriod: 3, thresholds: { giniWarnThreshold: 0.4 } });
+    expect(() => structuredClone(out)).not.toThrow();
+  });
+});
+
+// ── BatchWorkerPool ─────────────────────────────────────────────────────────
+
+describe('BatchWorkerPool', () => {
+  let pool: BatchWorkerPool | null = null;
+
+  afterEach(async () => {
+    await pool?.stop();
+    pool = null;
+  });
+
+  function start(batchTimeoutMs?: number): BatchWorkerPool {
+    pool = new BatchWorkerPool(2, {
+      economyConfig: workerEconomyConfig({
+        mode: 'advisor',
+        principles: [{ check: () => ({}) }],
+      } as unknown as EconomyConfig),
+      validateState: true,
+    }, ECHO_WORKER, batchTimeoutMs);
+    return pool;
+  }
+
+  /** Shards on worker 0 and on worker 1 */
+  function shardsByWorker(): [string[], string[]] {
+    const byWorker: [string[], string[]] = [[], []];
+    for (let i = 0; byWorker[0].length < 3 || byWorker[1].length < 3; i++) {
+      const shard = `zone-${i}`;
+      const list = byWorker[shardWorkerIndex(shard, 2)]!;
+      if (list.length < 3) list.push(shard);
+    }
+    return byWorker;
+  }
+
+  const thread = (r: BatchSliceResult) => (r.body as { thread: number }).thread;
+
+  it('ticks a batch on both workers and returns the results in order', async () => {
+    const p = start();
+    const [w0, w1] = shardsByWorker();
+    const shards = [w0[0]!, w1[0]!, w0[1]!, w1[1]!, w0[2]!, w1[2]!];
+    const results = await p.processTickBatch(shards.map((shard, tick) => ({ shard, tick })));
+
+    expect(results.map(r => r.shard)).toEqual(shards);
+    expect(results.map(r => r.status)).toEqual(shards.map(() => 200));
+    expect(results.map(r => (r.body as { tick: number }).tick)).toEqual([0, 1, 2, 3, 4, 5]);
+    // Same worker for a worker's shards, a different one for the other's
+    expect(thread(results[0]!)).toBe(thread(results[2]!));
+    expect(thread(results[1]!)).toBe(thread(results[3]!));
+    expect(thread(results[0]!)).not.toBe(thread(results[1]!));
+    // Only the cloneable config reached the workers
+    expect((results[0]!.body as { config: unknown }).config).toEqual({ mode: 'advisor' });
+    expect(p.getShardCount()).toBe(6);
+    // Events only reach shards that have ticked
+    expect(p.ingestEvents(shards[0]!, [])).toBe(true);
+    expect(p.ingestEvents('never-ticked', [])).toBe(false);
+    expect(p.getShardCount()).toBe(6);
+  });
+
+  it('fails a crashed worker\'s slices fast and respawns it with the broadcast state', async () => {
+    const p = start();
+    const [w0, w1] = shardsByWorker();
+    const before = await p.processTickBatch([{ shard: w0[0], tick: 1 }, { shard: w1[0], tick: 1 }]);
+    p.broadcast({ type: 'lock', param: 'taxRate' });
+
+    const crashed = await p.processTickBatch([{ shard: w0[0], crash: true }, { shard: w1[0], tick: 2 }]);
+    expect(crashed[0]).toMatchObject({ shard: w0[0], status: 503, body: { error: 'worker_failed' } });
+    expect(crashed[1]).toMatchObject({ shard: w1[0], status: 200 });
+    // The dead worker's shards are forgotten, the other worker's kept
+    expect(p.getShardCount()).toBe(1);
+
+    const after = await p.processTickBatch([{ shard: w0[0], tick: 3 }]);
+    expect(after[0]).toMatchObject({ shard: w0[0], status: 200 });
+    expect(thread(after[0]!)).not.toBe(thread(before[0]!));
+    expect((after[0]!.body as { broadcasts: unknown[] }).broadcasts)
+      .toEqual([{ type: 'lock', param: 'taxRate' }]);
+  });
+
+  it('times out a batch its worker never answers', async () => {
+    const p = start(100);
+    const [w0, w1] = shardsByWorker();
+    const started = Date.now();
+    const results = await p.processTickBatch([{ shard: w0[0], hang: true }, { shard: w1[0], tick: 1 }]);
+    expect(results[0]).toMatchObject({ shard: w0[0], status: 504, body: { error: 'worker_timeout' } });
+    expect(results[1]).toMatchObject({ shard: w1[0], status: 200 });
+    expect(Date.now() - started).toBeLessThan(5000);
+  });
+});
@@ -1,6 +1,8 @@
 import { defineConfig } from 'tsup';
 export default defineConfig({
-  entry: ['src/index.ts', 'src/cli.ts'],
+  entry: ['src/index.ts', 'src/cli.ts', 'src/batchWorker.ts'],
+  // __dirname in the ESM build, so the pool finds dist/batchWorker.js
+  shims: true,
   format: ['esm', 'cjs'],
   dts: true,
   sourcemap: true,